@@ -24,7 +24,8 @@ class ops_partials_edge<Dx, std::vector<fvar<Dx> > > {
         operands_(ops) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -50,7 +51,8 @@ class ops_partials_edge<Dx, Eigen::Matrix<fvar<Dx>, R, C> > {
         operands_(ops) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -78,7 +80,8 @@ class ops_partials_edge<Dx, std::vector<Eigen::Matrix<fvar<Dx>, R, C> > > {
   }
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -107,7 +110,8 @@ class ops_partials_edge<Dx, std::vector<std::vector<fvar<Dx> > > > {
   }
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -35,6 +35,8 @@
 #include <stan/math/prim/arr/functor/mpi_command.hpp>
 #include <stan/math/prim/arr/functor/mpi_distributed_apply.hpp>
 #include <stan/math/prim/arr/functor/mpi_cluster.hpp>
+#include <stan/math/prim/arr/functor/ode_statistics.hpp>
+#include <stan/math/prim/arr/functor/ode_store_sensitivities.hpp>
 
 #include <stan/math/prim/scal.hpp>
 
@@ -5,6 +5,7 @@
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/scal/err/check_less.hpp>
 #include <stan/math/prim/arr/fun/sum.hpp>
+#include <stan/math/prim/arr/functor/ode_store_sensitivities.hpp>
 
 #include <vector>
 
@@ -21,6 +22,11 @@ namespace math {
  * coupled_ode_system. The sensitivities at each time-point is simply
  * the ODE RHS evaluated at that time point.
  *
+ * The coupled states are collected until the last time-point is
+ * observed and then stored at once with
+ * <code>ode_store_sensitivities</code>, which puts the whole solution
+ * on the AD stack as a single node.
+ *
  * The output of this class is for all time-points in the ts vector
  * which does not contain the initial time-point by the convention
  * used in stan-math.
@@ -30,9 +36,6 @@ template <typename F, typename T1, typename T2, typename T_t0, typename T_ts>
 struct coupled_ode_observer {
   typedef typename stan::return_type<T1, T2, T_t0, T_ts>::type return_t;
 
-  typedef operands_and_partials<std::vector<T1>, std::vector<T2>, T_t0, T_ts>
-      ops_partials_t;
-
   const F& f_;
   const std::vector<T1>& y0_;
   const T_t0& t0_;
@@ -44,8 +47,9 @@ struct coupled_ode_observer {
   std::vector<std::vector<return_t>>& y_;
   const std::size_t N_;
   const std::size_t M_;
-  const std::size_t index_offset_theta_;
   int next_ts_index_;
+  std::vector<double> coupled_states_;
+  std::vector<double> dy_dt_;
 
   /**
    * Construct a coupled ODE observer for the specified coupled
@@ -84,7 +88,6 @@ struct coupled_ode_observer {
         y_(y),
         N_(y0.size()),
         M_(theta.size()),
-        index_offset_theta_(is_constant_all<T1>::value ? 0 : N_ * N_),
         next_ts_index_(0) {}
 
   /**
@@ -104,42 +107,21 @@ struct coupled_ode_observer {
     check_less("coupled_ode_observer", "time-state number", next_ts_index_,
                ts_.size());
 
-    std::vector<return_t> yt;
-    yt.reserve(N_);
+    coupled_states_.insert(coupled_states_.end(), coupled_state.begin(),
+                           coupled_state.end());
 
-    ops_partials_t ops_partials(y0_, theta_, t0_, ts_[next_ts_index_]);
-
-    std::vector<double> dy_dt;
     if (!is_constant_all<T_ts>::value) {
       std::vector<double> y_dbl(coupled_state.begin(),
                                 coupled_state.begin() + N_);
-      dy_dt = f_(value_of(ts_[next_ts_index_]), y_dbl, value_of(theta_), x_,
-                 x_int_, msgs_);
+      std::vector<double> dy_dt = f_(value_of(ts_[next_ts_index_]), y_dbl,
+                                     value_of(theta_), x_, x_int_, msgs_);
       check_size_match("coupled_ode_observer", "dy_dt", dy_dt.size(), "states",
                        N_);
+      dy_dt_.insert(dy_dt_.end(), dy_dt.begin(), dy_dt.end());
     }
 
-    for (size_t j = 0; j < N_; j++) {
-      // iterate over parameters for each equation
-      if (!is_constant_all<T1>::value) {
-        for (std::size_t k = 0; k < N_; k++)
-          ops_partials.edge1_.partials_[k] = coupled_state[N_ + N_ * k + j];
-      }
-
-      if (!is_constant_all<T2>::value) {
-        for (std::size_t k = 0; k < M_; k++)
-          ops_partials.edge2_.partials_[k]
-              = coupled_state[N_ + index_offset_theta_ + N_ * k + j];
-      }
-
-      if (!is_constant_all<T_ts>::value) {
-        ops_partials.edge4_.partials_[0] = dy_dt[j];
-      }
-
-      yt.emplace_back(ops_partials.build(coupled_state[j]));
-    }
-
-    y_.emplace_back(yt);
+    if (next_ts_index_ + 1 == static_cast<int>(ts_.size()))
+      ode_store_sensitivities(y0_, theta_, ts_, coupled_states_, dy_dt_, y_);
     next_ts_index_++;
   }
 };
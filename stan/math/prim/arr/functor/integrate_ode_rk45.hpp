@@ -6,6 +6,7 @@
 #include <stan/math/prim/arr/err/check_ordered.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_system.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_observer.hpp>
+#include <stan/math/prim/arr/functor/ode_statistics.hpp>
 #include <stan/math/prim/scal/fun/value_of.hpp>
 #include <stan/math/prim/scal/err/check_less.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
@@ -24,6 +25,121 @@
 namespace stan {
 namespace math {
 
+namespace internal {
+/**
+ * Solve the specified system of ordinary differential equations
+ * with <code>integrate_ode_rk45</code> and pass the coupled state at
+ * each output time to the observer, in the layout of the
+ * <code>coupled_ode_system</code>, instead of storing the solutions.
+ *
+ * @tparam F type of ODE system function.
+ * @tparam T1 type of scalars for initial values.
+ * @tparam T2 type of scalars for parameters.
+ * @tparam Observer type of the observer, called with the coupled
+ * state and the output time
+ * @param[in, out] observer observer of the coupled states
+ * @see integrate_ode_rk45 for the other arguments
+ */
+template <typename F, typename T1, typename T2, typename Observer>
+void integrate_ode_rk45_observe(const F& f, const std::vector<T1>& y0,
+                                double t0, const std::vector<double>& ts,
+                                const std::vector<T2>& theta,
+                                const std::vector<double>& x,
+                                const std::vector<int>& x_int,
+                                std::ostream* msgs, double relative_tolerance,
+                                double absolute_tolerance, int max_num_steps,
+                                Observer& observer) {
+  using boost::numeric::odeint::integrate_times;
+  using boost::numeric::odeint::make_dense_output;
+  using boost::numeric::odeint::max_step_checker;
+  using boost::numeric::odeint::runge_kutta_dopri5;
+
+  check_finite("integrate_ode_rk45", "initial state", y0);
+  check_finite("integrate_ode_rk45", "initial time", t0);
+  check_finite("integrate_ode_rk45", "times", ts);
+  check_finite("integrate_ode_rk45", "parameter vector", theta);
+  check_finite("integrate_ode_rk45", "continuous data", x);
+
+  check_nonzero_size("integrate_ode_rk45", "initial state", y0);
+  check_nonzero_size("integrate_ode_rk45", "times", ts);
+  check_ordered("integrate_ode_rk45", "times", ts);
+  check_less("integrate_ode_rk45", "initial time", t0, ts[0]);
+
+  if (relative_tolerance <= 0)
+    invalid_argument("integrate_ode_rk45", "relative_tolerance,",
+                     relative_tolerance, "", ", must be greater than 0");
+  if (absolute_tolerance <= 0)
+    invalid_argument("integrate_ode_rk45", "absolute_tolerance,",
+                     absolute_tolerance, "", ", must be greater than 0");
+  if (max_num_steps <= 0)
+    invalid_argument("integrate_ode_rk45", "max_num_steps,", max_num_steps, "",
+                     ", must be greater than 0");
+
+  // creates basic or coupled system by template specializations
+  coupled_ode_system<F, T1, T2> coupled_system(f, y0, theta, x, x_int, msgs);
+
+  // first time in the vector must be time of initial state
+  std::vector<double> ts_vec(ts.size() + 1);
+  ts_vec[0] = t0;
+  std::copy(ts.begin(), ts.end(), ts_vec.begin() + 1);
+
+  bool observer_initial_recorded = false;
+
+  // avoid recording of the initial state which is included by the
+  // conventions of odeint in the output
+  auto filtered_observer
+      = [&](const std::vector<double>& coupled_state, double t) -> void {
+    if (!observer_initial_recorded) {
+      observer_initial_recorded = true;
+      return;
+    }
+    observer(coupled_state, t);
+  };
+
+  // the coupled system creates the coupled initial state
+  std::vector<double> initial_coupled_state = coupled_system.initial_state();
+
+  const bool collect_statistics = ode_statistics::enabled();
+  const bool has_sensitivities = initial_coupled_state.size() > y0.size();
+  ode_solver_statistics statistics;
+  double* rhs_seconds = collect_statistics && has_sensitivities
+                            ? &statistics.sensitivity_seconds_
+                            : nullptr;
+
+  // counts and times the evaluations of the coupled right hand side
+  // if statistics are collected
+  auto system = [&](const std::vector<double>& z, std::vector<double>& dz_dt,
+                    double t) -> void {
+    if (collect_statistics) {
+      ++statistics.num_rhs_evals_;
+      if (has_sensitivities)
+        ++statistics.num_sensitivity_rhs_evals_;
+    }
+    ode_statistics::timer rhs_timer(rhs_seconds);
+    coupled_system(z, dz_dt, t);
+  };
+
+  const double step_size = 0.1;
+  try {
+    ode_statistics::timer forward_timer(
+        collect_statistics ? &statistics.forward_seconds_ : nullptr);
+    statistics.num_steps_ = integrate_times(
+        make_dense_output(absolute_tolerance, relative_tolerance,
+                          runge_kutta_dopri5<std::vector<double>, double,
+                                             std::vector<double>, double>()),
+        system, initial_coupled_state, std::begin(ts_vec), std::end(ts_vec),
+        step_size, filtered_observer, max_step_checker(max_num_steps));
+  } catch (const std::exception& e) {
+    if (collect_statistics)
+      ode_statistics::record("integrate_ode_rk45", statistics, true);
+    throw;
+  }
+  if (collect_statistics)
+    ode_statistics::record("integrate_ode_rk45", statistics, false);
+}
+
+}  // namespace internal
+
 /**
  * Return the solutions for the specified system of ordinary
  * differential equations given the specified initial state,
@@ -47,6 +163,10 @@ namespace math {
  * method</a> as implemented in Boost's <code>
  * boost::numeric::odeint::runge_kutta_dopri5</code> integrator.
  *
+ * If collection is switched on for the calling thread, the number of
+ * steps and right hand side evaluations and the wall times of the
+ * solve are recorded, see <code>ode_statistics</code>.
+ *
  * @tparam F type of ODE system function.
  * @tparam T1 type of scalars for initial values.
  * @tparam T2 type of scalars for parameters.
@@ -78,72 +198,14 @@ integrate_ode_rk45(const F& f, const std::vector<T1>& y0, const T_t0& t0,
                    std::ostream* msgs = nullptr,
                    double relative_tolerance = 1e-6,
                    double absolute_tolerance = 1e-6, int max_num_steps = 1E6) {
-  using boost::numeric::odeint::integrate_times;
-  using boost::numeric::odeint::make_dense_output;
-  using boost::numeric::odeint::max_step_checker;
-  using boost::numeric::odeint::runge_kutta_dopri5;
-
-  const double t0_dbl = value_of(t0);
-  const std::vector<double> ts_dbl = value_of(ts);
-
-  check_finite("integrate_ode_rk45", "initial state", y0);
-  check_finite("integrate_ode_rk45", "initial time", t0_dbl);
-  check_finite("integrate_ode_rk45", "times", ts_dbl);
-  check_finite("integrate_ode_rk45", "parameter vector", theta);
-  check_finite("integrate_ode_rk45", "continuous data", x);
-
-  check_nonzero_size("integrate_ode_rk45", "initial state", y0);
-  check_nonzero_size("integrate_ode_rk45", "times", ts_dbl);
-  check_ordered("integrate_ode_rk45", "times", ts_dbl);
-  check_less("integrate_ode_rk45", "initial time", t0_dbl, ts_dbl[0]);
-
-  if (relative_tolerance <= 0)
-    invalid_argument("integrate_ode_rk45", "relative_tolerance,",
-                     relative_tolerance, "", ", must be greater than 0");
-  if (absolute_tolerance <= 0)
-    invalid_argument("integrate_ode_rk45", "absolute_tolerance,",
-                     absolute_tolerance, "", ", must be greater than 0");
-  if (max_num_steps <= 0)
-    invalid_argument("integrate_ode_rk45", "max_num_steps,", max_num_steps, "",
-                     ", must be greater than 0");
-
-  // creates basic or coupled system by template specializations
-  coupled_ode_system<F, T1, T2> coupled_system(f, y0, theta, x, x_int, msgs);
-
-  // first time in the vector must be time of initial state
-  std::vector<double> ts_vec(ts.size() + 1);
-  ts_vec[0] = t0_dbl;
-  std::copy(ts_dbl.begin(), ts_dbl.end(), ts_vec.begin() + 1);
-
   std::vector<std::vector<typename stan::return_type<T1, T2, T_t0, T_ts>::type>>
       y;
   coupled_ode_observer<F, T1, T2, T_t0, T_ts> observer(f, y0, theta, t0, ts, x,
                                                        x_int, msgs, y);
-  bool observer_initial_recorded = false;
-
-  // avoid recording of the initial state which is included by the
-  // conventions of odeint in the output
-  auto filtered_observer
-      = [&](const std::vector<double>& coupled_state, double t) -> void {
-    if (!observer_initial_recorded) {
-      observer_initial_recorded = true;
-      return;
-    }
-    observer(coupled_state, t);
-  };
-
-  // the coupled system creates the coupled initial state
-  std::vector<double> initial_coupled_state = coupled_system.initial_state();
-
-  const double step_size = 0.1;
-  integrate_times(
-      make_dense_output(absolute_tolerance, relative_tolerance,
-                        runge_kutta_dopri5<std::vector<double>, double,
-                                           std::vector<double>, double>()),
-      std::ref(coupled_system), initial_coupled_state, std::begin(ts_vec),
-      std::end(ts_vec), step_size, filtered_observer,
-      max_step_checker(max_num_steps));
-
+  internal::integrate_ode_rk45_observe(f, y0, value_of(t0), value_of(ts), theta,
+                                       x, x_int, msgs, relative_tolerance,
+                                       absolute_tolerance, max_num_steps,
+                                       observer);
   return y;
 }
 
@@ -0,0 +1,261 @@
+#ifndef STAN_MATH_PRIM_ARR_FUNCTOR_ODE_STATISTICS_HPP
+#define STAN_MATH_PRIM_ARR_FUNCTOR_ODE_STATISTICS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#ifdef STAN_THREADS
+#include <mutex>
+#endif
+
+namespace stan {
+namespace math {
+
+/**
+ * Counters and wall times of ODE solves.
+ *
+ * The counters are those CVODES reports for its solves.  The odeint
+ * integrators have no Newton iterations and do not report rejected
+ * steps, so the Jacobian evaluations, nonlinear iterations and error
+ * test failures of their solves stay zero.
+ *
+ * The forward time is the wall time of the integration including
+ * the sensitivities.  The sensitivity time is the part of it spent in
+ * the right hand side of the sensitivities.  The coupled system of
+ * the odeint integrators evaluates the states and sensitivities
+ * together, so all of its right hand side time counts as sensitivity
+ * time if there are sensitivities.
+ */
+struct ode_solver_statistics {
+  size_t num_solves_;
+  size_t num_failures_;
+  long int num_steps_;                  // NOLINT(runtime/int)
+  long int num_rhs_evals_;              // NOLINT(runtime/int)
+  long int num_sensitivity_rhs_evals_;  // NOLINT(runtime/int)
+  long int num_jacobian_evals_;         // NOLINT(runtime/int)
+  long int num_nonlinear_iterations_;   // NOLINT(runtime/int)
+  long int num_error_test_failures_;    // NOLINT(runtime/int)
+  double forward_seconds_;
+  double sensitivity_seconds_;
+
+  ode_solver_statistics()
+      : num_solves_(0),
+        num_failures_(0),
+        num_steps_(0),
+        num_rhs_evals_(0),
+        num_sensitivity_rhs_evals_(0),
+        num_jacobian_evals_(0),
+        num_nonlinear_iterations_(0),
+        num_error_test_failures_(0),
+        forward_seconds_(0),
+        sensitivity_seconds_(0) {}
+
+  ode_solver_statistics& operator+=(const ode_solver_statistics& other) {
+    num_solves_ += other.num_solves_;
+    num_failures_ += other.num_failures_;
+    num_steps_ += other.num_steps_;
+    num_rhs_evals_ += other.num_rhs_evals_;
+    num_sensitivity_rhs_evals_ += other.num_sensitivity_rhs_evals_;
+    num_jacobian_evals_ += other.num_jacobian_evals_;
+    num_nonlinear_iterations_ += other.num_nonlinear_iterations_;
+    num_error_test_failures_ += other.num_error_test_failures_;
+    forward_seconds_ += other.forward_seconds_;
+    sensitivity_seconds_ += other.sensitivity_seconds_;
+    return *this;
+  }
+};
+
+/**
+ * Per thread sink of the statistics of ODE solves, aggregated per
+ * call site.
+ *
+ * Collection is off by default and is switched on and off for the
+ * calling thread only, such that solves which do not opt in pay no
+ * more than a check of a flag.  The call site of a solve is the
+ * innermost <code>ode_statistics::call_site</code> alive on the
+ * thread, or the name of the integrator otherwise.
+ *
+ * The ODE batches and <code>map_rect</code> hand an
+ * <code>ode_statistics::context</code> of the calling thread to the
+ * threads they solve on, which record their solves into the sink of
+ * the calling thread while an <code>ode_statistics::scope</code> of
+ * it is alive.  With collection off, this costs a check of the flag.
+ * The statistics of a thread should only be read or reset while no
+ * other thread records into them.
+ */
+class ode_statistics {
+ public:
+  typedef std::map<std::string, ode_solver_statistics> sites_t;
+
+ private:
+  struct sink {
+    bool enabled_;
+    std::string call_site_;
+    sites_t sites_;
+    sink* target_;  // the sink solves are recorded into
+#ifdef STAN_THREADS
+    std::mutex mutex_;
+#endif
+    sink() : enabled_(false), target_(this) {}
+  };
+
+  static sink& local() {
+#ifdef STAN_THREADS
+    static thread_local sink instance;
+#else
+    static sink instance;
+#endif
+    return instance;
+  }
+
+ public:
+  /**
+   * Label the ODE solves of the calling thread with the specified
+   * call site during the lifetime of this object.
+   */
+  class call_site {
+    std::string previous_;
+
+   public:
+    explicit call_site(const std::string& name)
+        : previous_(local().call_site_) {
+      local().call_site_ = name;
+    }
+    ~call_site() { local().call_site_ = previous_; }
+
+    call_site(const call_site&) = delete;
+    call_site& operator=(const call_site&) = delete;
+  };
+
+  class scope;
+
+  /**
+   * The call site and the sink of the thread this is created on, to
+   * be handed to threads which solve on its behalf.  Holds nothing if
+   * collection is off for that thread.
+   */
+  class context {
+    friend class scope;
+    sink* target_;
+    std::string call_site_;
+
+   public:
+    context() : target_(nullptr) {
+      sink& s = local();
+      if (s.enabled_) {
+        target_ = s.target_;
+        call_site_ = s.call_site_;
+      }
+    }
+  };
+
+  /**
+   * Record the ODE solves of the calling thread into the sink of the
+   * thread the specified context was created on, under its call site,
+   * during the lifetime of this object.  Does nothing if collection
+   * was off for that thread.
+   */
+  class scope {
+    const bool active_;
+    bool enabled_;
+    std::string call_site_;
+    sink* target_;
+
+   public:
+    explicit scope(const context& c)
+        : active_(c.target_ != nullptr), enabled_(false), target_(nullptr) {
+      if (!active_)
+        return;
+      sink& s = local();
+      enabled_ = s.enabled_;
+      call_site_.swap(s.call_site_);
+      target_ = s.target_;
+      s.enabled_ = true;
+      s.call_site_ = c.call_site_;
+      s.target_ = c.target_;
+    }
+    ~scope() {
+      if (!active_)
+        return;
+      sink& s = local();
+      s.enabled_ = enabled_;
+      s.call_site_.swap(call_site_);
+      s.target_ = target_;
+    }
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+  };
+
+  /**
+   * Add the elapsed wall time during the lifetime of this object to
+   * the specified seconds, or do nothing if they are a null pointer.
+   */
+  class timer {
+    double* seconds_;
+    std::chrono::steady_clock::time_point start_;
+
+   public:
+    explicit timer(double* seconds) : seconds_(seconds) {
+      if (seconds_ != nullptr)
+        start_ = std::chrono::steady_clock::now();
+    }
+    ~timer() {
+      if (seconds_ != nullptr)
+        *seconds_ += std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start_)
+                         .count();
+    }
+
+    timer(const timer&) = delete;
+    timer& operator=(const timer&) = delete;
+  };
+
+  /**
+   * Switch collection on or off for the calling thread.
+   */
+  static void enable(bool enabled = true) { local().enabled_ = enabled; }
+
+  /**
+   * Return true if collection is on for the calling thread.
+   */
+  static bool enabled() { return local().enabled_; }
+
+  /**
+   * Return the statistics of the calling thread by call site.
+   */
+  static const sites_t& sites() { return local().sites_; }
+
+  /**
+   * Discard the statistics of the calling thread.
+   */
+  static void reset() { local().sites_.clear(); }
+
+  /**
+   * Add the statistics of one solve to its call site.
+   *
+   * @param[in] function name of the integrator, the call site if no
+   * other is set
+   * @param[in] statistics counters and times of the solve
+   * @param[in] failed true if the solve threw
+   */
+  static void record(const char* function,
+                     const ode_solver_statistics& statistics, bool failed) {
+    sink& s = local();
+#ifdef STAN_THREADS
+    std::lock_guard<std::mutex> lock(s.target_->mutex_);
+#endif
+    ode_solver_statistics& site
+        = s.target_->sites_[s.call_site_.empty() ? std::string(function)
+                                                 : s.call_site_];
+    site += statistics;
+    ++site.num_solves_;
+    if (failed)
+      ++site.num_failures_;
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
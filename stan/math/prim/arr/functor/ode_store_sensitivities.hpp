@@ -0,0 +1,71 @@
+#ifndef STAN_MATH_PRIM_ARR_FUNCTOR_ODE_STORE_SENSITIVITIES_HPP
+#define STAN_MATH_PRIM_ARR_FUNCTOR_ODE_STORE_SENSITIVITIES_HPP
+
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Store the solution of an ODE whose initial state, parameters and
+ * times are all data.  The coupled states then only consist of the
+ * states of the base ODE.
+ *
+ * @tparam T1 type of scalars for initial values.
+ * @tparam T2 type of scalars for parameters.
+ * @tparam T_ts type of time-points where ODE solution is returned.
+ * @param[in] y0 initial state.
+ * @param[in] theta parameter vector for the ODE.
+ * @param[in] ts times of the solutions.
+ * @param[in] coupled_states coupled states at the output times,
+ * stacked
+ * @param[in] dy_dt not used
+ * @param[out] y solution, one vector of states for each time
+ */
+template <typename T1, typename T2, typename T_ts>
+inline void ode_store_sensitivities(const std::vector<T1>& y0,
+                                    const std::vector<T2>& theta,
+                                    const std::vector<T_ts>& ts,
+                                    const std::vector<double>& coupled_states,
+                                    const std::vector<double>& dy_dt,
+                                    std::vector<std::vector<double>>& y) {
+  const size_t N = y0.size();
+  y.resize(ts.size());
+  for (size_t n = 0; n < ts.size(); ++n)
+    y[n].assign(coupled_states.begin() + n * N,
+                coupled_states.begin() + (n + 1) * N);
+}
+
+/**
+ * Store the solution of an ODE with events whose initial state,
+ * increments and parameters are all data, see
+ * <code>ode_store_event_sensitivities</code>.
+ *
+ * @tparam T1 type of scalars for initial values.
+ * @tparam T_event type of scalars for the increments.
+ * @tparam T2 type of scalars for parameters.
+ * @param[in] y0 initial state.
+ * @param[in] increments increments of the events.
+ * @param[in] theta parameter vector for the ODE.
+ * @param[in] num_ts number of output times.
+ * @param[in] coupled_states coupled states at the output times,
+ * stacked
+ * @param[out] y solution, one vector of states for each time
+ */
+template <typename T1, typename T_event, typename T2>
+inline void ode_store_event_sensitivities(
+    const std::vector<T1>& y0,
+    const std::vector<std::vector<T_event>>& increments,
+    const std::vector<T2>& theta, size_t num_ts,
+    const std::vector<double>& coupled_states,
+    std::vector<std::vector<double>>& y) {
+  const size_t N = y0.size();
+  y.resize(num_ts);
+  for (size_t n = 0; n < num_ts; ++n)
+    y[n].assign(coupled_states.begin() + n * N,
+                coupled_states.begin() + (n + 1) * N);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
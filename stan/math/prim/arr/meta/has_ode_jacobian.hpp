@@ -0,0 +1,65 @@
+#ifndef STAN_MATH_PRIM_ARR_META_HAS_ODE_JACOBIAN_HPP
+#define STAN_MATH_PRIM_ARR_META_HAS_ODE_JACOBIAN_HPP
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stan {
+
+/**
+ * Extends std::true_type if the ODE functor F provides the analytic
+ * Jacobian of its right hand side with respect to the states as a
+ * const member
+ *
+ * <code>std::vector<std::vector<double>> jacobian_y(double t,
+ *   const std::vector<double>& y, const std::vector<double>& theta,
+ *   const std::vector<double>& x, const std::vector<int>& x_int,
+ *   std::ostream* msgs) const</code>
+ *
+ * returning one row per equation.  Extends std::false_type otherwise.
+ *
+ * @tparam F type of ODE functor
+ */
+template <typename F, typename = void>
+struct has_ode_jacobian_y : std::false_type {};
+
+template <typename F>
+struct has_ode_jacobian_y<
+    F, typename std::enable_if<std::is_convertible<
+           decltype(std::declval<const F&>().jacobian_y(
+               0.0, std::declval<const std::vector<double>&>(),
+               std::declval<const std::vector<double>&>(),
+               std::declval<const std::vector<double>&>(),
+               std::declval<const std::vector<int>&>(),
+               std::declval<std::ostream*>())),
+           std::vector<std::vector<double>>>::value>::type>
+    : std::true_type {};
+
+/**
+ * Extends std::true_type if the ODE functor F provides the analytic
+ * Jacobian of its right hand side with respect to the parameters as
+ * a const member <code>jacobian_theta</code> with the same signature
+ * as <code>jacobian_y</code>, see <code>has_ode_jacobian_y</code>.
+ * Extends std::false_type otherwise.
+ *
+ * @tparam F type of ODE functor
+ */
+template <typename F, typename = void>
+struct has_ode_jacobian_theta : std::false_type {};
+
+template <typename F>
+struct has_ode_jacobian_theta<
+    F, typename std::enable_if<std::is_convertible<
+           decltype(std::declval<const F&>().jacobian_theta(
+               0.0, std::declval<const std::vector<double>&>(),
+               std::declval<const std::vector<double>&>(),
+               std::declval<const std::vector<double>&>(),
+               std::declval<const std::vector<int>&>(),
+               std::declval<std::ostream*>())),
+           std::vector<std::vector<double>>>::value>::type>
+    : std::true_type {};
+
+}  // namespace stan
+#endif
@@ -69,6 +69,7 @@
 #include <stan/math/prim/mat/fun/cholesky_corr_constrain.hpp>
 #include <stan/math/prim/mat/fun/cholesky_corr_free.hpp>
 #include <stan/math/prim/mat/fun/cholesky_decompose.hpp>
+#include <stan/math/prim/mat/fun/cholesky_tiled.hpp>
 #include <stan/math/prim/mat/fun/cholesky_factor_constrain.hpp>
 #include <stan/math/prim/mat/fun/cholesky_factor_free.hpp>
 #include <stan/math/prim/mat/fun/col.hpp>
@@ -90,6 +91,7 @@
 #include <stan/math/prim/mat/fun/csr_extract_v.hpp>
 #include <stan/math/prim/mat/fun/csr_extract_w.hpp>
 #include <stan/math/prim/mat/fun/csr_matrix_times_vector.hpp>
+#include <stan/math/prim/mat/fun/csr_structure.hpp>
 #include <stan/math/prim/mat/fun/csr_to_dense_matrix.hpp>
 #include <stan/math/prim/mat/fun/csr_u_to_z.hpp>
 #include <stan/math/prim/mat/fun/cumulative_sum.hpp>
@@ -218,6 +220,8 @@
 #include <stan/math/prim/mat/fun/sort_indices.hpp>
 #include <stan/math/prim/mat/fun/sort_indices_asc.hpp>
 #include <stan/math/prim/mat/fun/sort_indices_desc.hpp>
+#include <stan/math/prim/mat/fun/sparse_cholesky_decompose.hpp>
+#include <stan/math/prim/mat/fun/sparse_llt_cache.hpp>
 #include <stan/math/prim/mat/fun/sqrt.hpp>
 #include <stan/math/prim/mat/fun/square.hpp>
 #include <stan/math/prim/mat/fun/squared_distance.hpp>
@@ -253,6 +257,7 @@
 #include <stan/math/prim/mat/fun/welford_covar_estimator.hpp>
 #include <stan/math/prim/mat/fun/welford_var_estimator.hpp>
 
+#include <stan/math/prim/mat/functor/apply_fixed_size.hpp>
 #include <stan/math/prim/mat/functor/finite_diff_gradient.hpp>
 #include <stan/math/prim/mat/functor/finite_diff_gradient_auto.hpp>
 #include <stan/math/prim/mat/functor/finite_diff_hessian.hpp>
@@ -262,6 +267,8 @@
 #include <stan/math/prim/mat/functor/map_rect_combine.hpp>
 #include <stan/math/prim/mat/functor/map_rect_concurrent.hpp>
 #include <stan/math/prim/mat/functor/map_rect_reduce.hpp>
+#include <stan/math/prim/mat/functor/parallel_ranges.hpp>
+#include <stan/math/prim/mat/functor/task_graph.hpp>
 #include <stan/math/prim/mat/prob/bernoulli_logit_glm_log.hpp>
 #include <stan/math/prim/mat/prob/bernoulli_logit_glm_lpmf.hpp>
 #include <stan/math/prim/mat/prob/bernoulli_logit_glm_rng.hpp>
@@ -278,6 +285,8 @@
 #include <stan/math/prim/mat/prob/gaussian_dlm_obs_log.hpp>
 #include <stan/math/prim/mat/prob/gaussian_dlm_obs_lpdf.hpp>
 #include <stan/math/prim/mat/prob/gaussian_dlm_obs_rng.hpp>
+#include <stan/math/prim/mat/prob/hmm_hidden_state_prob.hpp>
+#include <stan/math/prim/mat/prob/hmm_marginal.hpp>
 #include <stan/math/prim/mat/prob/inv_wishart_log.hpp>
 #include <stan/math/prim/mat/prob/inv_wishart_lpdf.hpp>
 #include <stan/math/prim/mat/prob/inv_wishart_rng.hpp>
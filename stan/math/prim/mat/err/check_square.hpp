@@ -25,6 +25,22 @@ inline void check_square(
                    y.rows(), "columns of ", name, y.cols());
 }
 
+/**
+ * Check if the specified sparse matrix is square. This check allows
+ * 0x0 matrices.
+ * @tparam T Type of scalar
+ * @param function Function name (for error messages)
+ * @param name Variable name (for error messages)
+ * @param y Sparse matrix to test
+ * @throw <code>std::invalid_argument</code> if the matrix is not square
+ */
+template <typename T_y>
+inline void check_square(const char* function, const char* name,
+                         const Eigen::SparseMatrix<T_y>& y) {
+  check_size_match(function, "Expecting a square matrix; rows of ", name,
+                   y.rows(), "columns of ", name, y.cols());
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
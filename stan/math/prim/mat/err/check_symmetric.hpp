@@ -57,6 +57,50 @@ inline void check_symmetric(
   }
 }
 
+/**
+ * Check if the specified sparse matrix is symmetric.  Every stored
+ * entry is compared with its transposed entry, which is zero when
+ * it is not stored.
+ * The error message is either 0 or 1 indexed, specified by
+ * <code>stan::error_index::value</code>.
+ * @tparam T_y Type of scalar
+ * @param function Function name (for error messages)
+ * @param name Variable name (for error messages)
+ * @param y Sparse matrix to test
+ * @throw <code>std::invalid_argument</code> if the matrix is not square.
+ * @throw <code>std::domain_error</code> if any stored element not on
+ *   the main diagonal differs from its transposed element or is
+ *   <code>NaN</code>
+ */
+template <typename T_y>
+inline void check_symmetric(const char* function, const char* name,
+                            const Eigen::SparseMatrix<T_y>& y) {
+  check_square(function, name, y);
+  for (int k = 0; k < y.outerSize(); ++k) {
+    for (typename Eigen::SparseMatrix<T_y>::InnerIterator it(y, k); it;
+         ++it) {
+      int m = it.row();
+      int n = it.col();
+      if (m == n)
+        continue;
+      if (!(fabs(value_of(it.value()) - value_of(y.coeff(n, m)))
+            <= CONSTRAINT_TOLERANCE)) {
+        std::ostringstream msg1;
+        msg1 << "is not symmetric. " << name << "["
+             << stan::error_index::value + m << ","
+             << stan::error_index::value + n << "] = ";
+        std::string msg1_str(msg1.str());
+        std::ostringstream msg2;
+        msg2 << ", but " << name << "[" << stan::error_index::value + n << ","
+             << stan::error_index::value + m << "] = " << y.coeff(n, m);
+        std::string msg2_str(msg2.str());
+        domain_error(function, name, it.value(), msg1_str.c_str(),
+                     msg2_str.c_str());
+      }
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
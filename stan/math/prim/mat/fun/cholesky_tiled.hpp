@@ -0,0 +1,137 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_CHOLESKY_TILED_HPP
+#define STAN_MATH_PRIM_MAT_FUN_CHOLESKY_TILED_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/functor/map_rect_concurrent.hpp>
+#include <stan/math/prim/mat/functor/task_graph.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * Tuning parameters of the multithreaded CPU Cholesky
+ * decomposition and its adjoint.
+ *
+ * Matrices with fewer than <code>parallel_min_size</code> rows are
+ * factored serially.  Larger matrices are processed in tiles of
+ * <code>tile_size</code> rows and columns, each operation on a tile
+ * being a task of a <code>task_graph</code> run on the threads given
+ * by STAN_NUM_THREADS.  Only used when STAN_THREADS is defined.
+ */
+struct cholesky_cpu_tuning {
+  int parallel_min_size = 1024;
+  int tile_size = 256;
+};
+}  // namespace internal
+
+/**
+ * Return the tuning parameters of the multithreaded CPU Cholesky
+ * decomposition, which can be modified in place.
+ *
+ * @return Reference to the tuning parameters
+ */
+inline internal::cholesky_cpu_tuning& cholesky_cpu_tuning_opts() {
+  static internal::cholesky_cpu_tuning opts;
+  return opts;
+}
+
+namespace internal {
+/**
+ * Return the number of threads the Cholesky decomposition and its
+ * adjoint should use for a matrix with the specified number of
+ * rows.
+ *
+ * @param M Number of rows of the matrix
+ * @return Number of threads, 1 when threading is disabled or the
+ *   matrix is below the size threshold
+ */
+inline int cholesky_num_threads(int M) {
+  if (M < cholesky_cpu_tuning_opts().parallel_min_size)
+    return 1;
+  return get_num_threads(std::max(1, M / 16));
+}
+
+/**
+ * Return the specified tile of a square matrix split into square
+ * tiles, the last row and column of tiles being smaller if the tile
+ * size does not divide the size of the matrix.
+ *
+ * @param A Matrix
+ * @param tile_size Number of rows and columns of a tile
+ * @param i Row of the tile
+ * @param j Column of the tile
+ * @return Block of the tile
+ */
+inline Eigen::Block<Eigen::MatrixXd> cholesky_tile(Eigen::MatrixXd& A,
+                                                   int tile_size, int i,
+                                                   int j) {
+  const int M = A.rows();
+  return A.block(i * tile_size, j * tile_size,
+                 std::min(tile_size, M - i * tile_size),
+                 std::min(tile_size, M - j * tile_size));
+}
+
+/**
+ * Overwrite the lower triangle of the specified symmetric matrix
+ * with its Cholesky factor, using a right-looking tiled algorithm
+ * run as a task graph over the tiles of the lower triangle.
+ *
+ * The tasks are the factorization of a diagonal tile, the
+ * triangular solve of a tile below it and the update of a trailing
+ * tile with the product of two solved tiles, such that the next
+ * diagonal tile can be factored while the trailing updates of the
+ * previous step are still running.  The strictly upper triangle is
+ * left in an unspecified state.
+ *
+ * @param A Symmetric matrix, only its lower triangle is read
+ * @param tile_size Number of rows and columns of a tile
+ * @param num_threads Maximum number of threads to use
+ * @return false if a diagonal tile is not positive definite
+ */
+inline bool cholesky_tiled_inplace(Eigen::MatrixXd& A, int tile_size,
+                                   int num_threads) {
+  using Eigen::Lower;
+  using Eigen::OnTheRight;
+  using Eigen::Upper;
+  const int T = (A.rows() + tile_size - 1) / tile_size;
+  auto tile = [&A, tile_size](int i, int j) {
+    return cholesky_tile(A, tile_size, i, j);
+  };
+  auto id = [T](int i, int j) { return i * T + j; };
+
+  task_graph graph(T * T);
+  for (int k = 0; k < T; ++k) {
+    graph.add({}, {id(k, k)}, [=]() {
+      Eigen::Ref<Eigen::MatrixXd> A_kk = tile(k, k);
+      Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>, Lower> llt(A_kk);
+      return llt.info() == Eigen::Success
+             && (A_kk.diagonal().array() > 0).all();
+    });
+    for (int i = k + 1; i < T; ++i)
+      graph.add({id(k, k)}, {id(i, k)}, [=]() {
+        tile(k, k).transpose().triangularView<Upper>().solveInPlace<OnTheRight>(
+            tile(i, k));
+        return true;
+      });
+    for (int j = k + 1; j < T; ++j) {
+      graph.add({id(j, k)}, {id(j, j)}, [=]() {
+        tile(j, j).selfadjointView<Lower>().rankUpdate(tile(j, k), -1.0);
+        return true;
+      });
+      for (int i = j + 1; i < T; ++i)
+        graph.add({id(i, k), id(j, k)}, {id(i, j)}, [=]() {
+          tile(i, j).noalias() -= tile(i, k) * tile(j, k).transpose();
+          return true;
+        });
+    }
+  }
+  return graph.run(num_threads);
+}
+}  // namespace internal
+
+}  // namespace math
+}  // namespace stan
+#endif
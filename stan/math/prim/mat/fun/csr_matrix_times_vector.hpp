@@ -1,6 +1,8 @@
 #ifndef STAN_MATH_PRIM_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
 #define STAN_MATH_PRIM_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
 
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/mat/fun/csr_structure.hpp>
 #include <stan/math/prim/mat/fun/csr_u_to_z.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/dot_product.hpp>
@@ -8,6 +10,7 @@
 #include <stan/math/prim/scal/err/check_positive.hpp>
 #include <stan/math/prim/mat/err/check_range.hpp>
 #include <boost/math/tools/promotion.hpp>
+#include <type_traits>
 #include <vector>
 
 namespace stan {
@@ -73,8 +76,10 @@ namespace math {
 /** \addtogroup csr_format
  */
 template <typename T1, typename T2>
-inline Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type,
-                     Eigen::Dynamic, 1>
+inline typename std::enable_if<
+    !is_var<T1>::value && !is_var<T2>::value,
+    Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type,
+                  Eigen::Dynamic, 1> >::type
 csr_matrix_times_vector(int m, int n,
                         const Eigen::Matrix<T1, Eigen::Dynamic, 1>& w,
                         const std::vector<int>& v, const std::vector<int>& u,
@@ -110,6 +115,49 @@ csr_matrix_times_vector(int m, int n,
   }
   return result;
 }
+
+/**
+ * Return the multiplication of the sparse matrix with the
+ * specified pre-validated structure and values by the specified
+ * dense vector.
+ *
+ * Only the sizes of w and b are checked, so this is the overload
+ * to use when the same sparsity pattern is multiplied repeatedly.
+ *
+ * @tparam T1 Type of sparse matrix entries.
+ * @tparam T2 Type of dense vector entries.
+ * @param X Validated structure of the sparse matrix.
+ * @param w Vector of non-zero values in matrix.
+ * @param b Eigen vector which the matrix is multiplied by.
+ * @return Dense vector for the product.
+ * @throw std::invalid_argument if the size of w does not match
+ *   the structure or the size of b does not match its columns.
+ */
+template <typename T1, typename T2>
+inline typename std::enable_if<
+    !is_var<T1>::value && !is_var<T2>::value,
+    Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type,
+                  Eigen::Dynamic, 1> >::type
+csr_matrix_times_vector(const csr_structure& X,
+                        const Eigen::Matrix<T1, Eigen::Dynamic, 1>& w,
+                        const Eigen::Matrix<T2, Eigen::Dynamic, 1>& b) {
+  typedef typename boost::math::tools::promote_args<T1, T2>::type result_t;
+
+  check_size_match("csr_matrix_times_vector", "n", X.cols(), "b", b.size());
+  check_size_match("csr_matrix_times_vector", "w", w.size(), "v",
+                   X.nonzeros());
+  const std::vector<int>& v = X.col_idx();
+  const std::vector<int>& u = X.row_start();
+
+  Eigen::Matrix<result_t, Eigen::Dynamic, 1> result(X.rows());
+  for (int row = 0; row < X.rows(); ++row) {
+    result_t sum(0);
+    for (int nze = u[row]; nze < u[row + 1]; ++nze)
+      sum += w.coeff(nze) * b.coeff(v[nze]);
+    result.coeffRef(row) = sum;
+  }
+  return result;
+}
 /** @}*/  // end of csr_format group
 
 }  // namespace math
@@ -0,0 +1,88 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_CSR_STRUCTURE_HPP
+#define STAN_MATH_PRIM_MAT_FUN_CSR_STRUCTURE_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/mat/fun/csr_u_to_z.hpp>
+#include <stan/math/prim/mat/err/check_range.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/** \addtogroup csr_format
+ *  @{
+ */
+
+/**
+ * The validated indexing (v and u) of a sparse matrix in
+ * compressed sparse row format, stored zero-based.
+ *
+ * The structure is checked once on construction, so that a
+ * sparse matrix whose sparsity pattern does not change between
+ * evaluations can be multiplied repeatedly with only O(1) size
+ * checks of the values and of the dense operand.
+ */
+class csr_structure {
+  int m_;
+  int n_;
+  std::vector<int> v_;
+  std::vector<int> u_;
+
+ public:
+  /**
+   * Construct and validate the structure of an m by n sparse
+   * matrix in CSR format.
+   *
+   * @param m Number of rows in matrix.
+   * @param n Number of columns in matrix.
+   * @param v Column index of each non-zero value.
+   * @param u Index of where each row starts in w, length equal to
+   *          the number of rows plus one.
+   * @throw std::domain_error if m and n are not positive.
+   * @throw std::invalid_argument if m/v/u are not internally
+   *   consistent, as defined by the indexing scheme.
+   * @throw std::out_of_range if any of the indexes are out of range.
+   */
+  csr_structure(int m, int n, const std::vector<int>& v,
+                const std::vector<int>& u)
+      : m_(m), n_(n), v_(v.size()), u_(u.size()) {
+    static const char* function = "csr_structure";
+    check_positive(function, "m", m);
+    check_positive(function, "n", n);
+    check_size_match(function, "m", m, "u", u.size() - 1);
+    check_size_match(function, "u/z", u[m - 1] + csr_u_to_z(u, m - 1) - 1,
+                     "v", v.size());
+    for (size_t k = 0; k < v.size(); ++k) {
+      check_range(function, "v[]", n, v[k]);
+      v_[k] = v[k] - stan::error_index::value;
+    }
+    for (size_t k = 0; k < u.size(); ++k)
+      u_[k] = u[k] - stan::error_index::value;
+  }
+
+  /** Return the number of rows. */
+  int rows() const { return m_; }
+
+  /** Return the number of columns. */
+  int cols() const { return n_; }
+
+  /** Return the number of stored values, the required size of w. */
+  int nonzeros() const { return v_.size(); }
+
+  /** Return the zero-based column index of each stored value. */
+  const std::vector<int>& col_idx() const { return v_; }
+
+  /**
+   * Return the zero-based position in w where each row starts,
+   * followed by one past the end of the last row.
+   */
+  const std::vector<int>& row_start() const { return u_; }
+};
+
+/** @}*/  // end of csr_format group
+
+}  // namespace math
+}  // namespace stan
+#endif
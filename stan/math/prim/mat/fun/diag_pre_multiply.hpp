@@ -3,14 +3,19 @@
 
 #include <stan/math/prim/mat/err/check_vector.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <boost/math/tools/promotion.hpp>
+#include <type_traits>
 
 namespace stan {
 namespace math {
 
 template <typename T1, typename T2, int R1, int C1, int R2, int C2>
-Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type, R2, C2>
+typename std::enable_if<
+    !is_var<T1>::value && !is_var<T2>::value,
+    Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type, R2,
+                  C2> >::type
 diag_pre_multiply(const Eigen::Matrix<T1, R1, C1>& m1,
                   const Eigen::Matrix<T2, R2, C2>& m2) {
   check_vector("diag_pre_multiply", "m1", m1);
@@ -2,8 +2,10 @@
 #define STAN_MATH_PRIM_MAT_FUN_ELT_MULTIPLY_HPP
 
 #include <boost/math/tools/promotion.hpp>
+#include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/err/check_matching_dims.hpp>
+#include <type_traits>
 
 namespace stan {
 namespace math {
@@ -21,7 +23,10 @@ namespace math {
  * @return Elementwise product of matrices.
  */
 template <typename T1, typename T2, int R, int C>
-Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type, R, C>
+typename std::enable_if<
+    !is_var<T1>::value && !is_var<T2>::value,
+    Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type, R,
+                  C> >::type
 elt_multiply(const Eigen::Matrix<T1, R, C>& m1,
              const Eigen::Matrix<T2, R, C>& m2) {
   check_matching_dims("elt_multiply", "m1", m1, "m2", m2);
@@ -8,7 +8,7 @@ namespace math {
 
 // Returns log(abs(det(A))) given a LDLT_factor of A
 template <int R, int C, typename T>
-inline T log_determinant_ldlt(LDLT_factor<T, R, C> &A) {
+inline T log_determinant_ldlt(const LDLT_factor<T, R, C> &A) {
   return A.log_abs_det();
 }
 
@@ -3,6 +3,9 @@
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/mat/err/check_symmetric.hpp>
+#include <stan/math/prim/mat/fun/sparse_llt_cache.hpp>
+#include <stan/math/prim/scal/err/domain_error.hpp>
 #include <cmath>
 
 namespace stan {
@@ -28,6 +31,35 @@ inline T log_determinant_spd(const Eigen::Matrix<T, R, C>& m) {
   return m.ldlt().vectorD().array().log().sum();
 }
 
+/**
+ * Returns the log determinant of the specified symmetric, positive
+ * definite sparse matrix.
+ *
+ * The matrix is factored with a fill-reducing (AMD) sparse
+ * Cholesky decomposition whose symbolic analysis is reused while
+ * the sparsity pattern does not change.
+ *
+ * @param m Specified sparse matrix.
+ * @return log determinant of the matrix.
+ * @throw std::invalid_argument if matrix is not square.
+ * @throw std::domain_error if matrix is not symmetric or not
+ *   positive definite.
+ */
+inline double log_determinant_spd(const Eigen::SparseMatrix<double>& m) {
+  static const char* function = "log_determinant_spd";
+  check_symmetric(function, "m", m);
+  if (m.rows() == 0)
+    return 0;
+  Eigen::SparseMatrix<double> m_c(m);
+  m_c.makeCompressed();
+  const auto& llt
+      = internal::cached_sparse_llt<Eigen::AMDOrdering<int> >(m_c);
+  if (llt.info() != Eigen::Success)
+    domain_error(function, "m", "is not positive definite.", "");
+  Eigen::SparseMatrix<double> L = llt.matrixL();
+  return 2 * L.diagonal().array().log().sum();
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -4,6 +4,7 @@
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/arr/err/check_matching_sizes.hpp>
 #include <stan/math/prim/mat/err/check_multiplicable.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <type_traits>
 
 namespace stan {
@@ -73,6 +74,22 @@ inline double multiply(const Eigen::Matrix<double, 1, C1>& rv,
   return rv.dot(v);
 }
 
+/**
+ * Return the product of the specified sparse matrix and the
+ * specified dense column vector.
+ * @param m Sparse matrix.
+ * @param v Column vector.
+ * @return Dense product of the sparse matrix and the vector.
+ * @throw std::invalid_argument if the number of columns of m does
+ *   not match the size of v.
+ */
+inline Eigen::VectorXd multiply(const Eigen::SparseMatrix<double>& m,
+                                const Eigen::VectorXd& v) {
+  check_size_match("multiply", "Columns of m", m.cols(), "Rows of v",
+                   v.rows());
+  return m * v;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
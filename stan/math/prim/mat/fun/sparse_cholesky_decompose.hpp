@@ -0,0 +1,48 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_SPARSE_CHOLESKY_DECOMPOSE_HPP
+#define STAN_MATH_PRIM_MAT_FUN_SPARSE_CHOLESKY_DECOMPOSE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/sparse_llt_cache.hpp>
+#include <stan/math/prim/mat/err/check_symmetric.hpp>
+#include <stan/math/prim/scal/err/domain_error.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the lower-triangular Cholesky factor (i.e., matrix
+ * square root) of the specified symmetric, positive definite
+ * sparse matrix.  The return value L will be a lower-triangular
+ * sparse matrix such that the original matrix A is given by
+ * <p>A = L * L.transpose().
+ *
+ * The rows are not reordered, so L is the factor of A itself and
+ * its sparsity pattern includes the fill-in of that ordering.  The
+ * symbolic analysis of the pattern is reused across calls while
+ * the pattern does not change.
+ *
+ * @param m Symmetric sparse matrix.
+ * @return Square root of matrix.
+ * @throw std::invalid_argument if m is not square.
+ * @throw std::domain_error if m is not symmetric or not positive
+ *   definite (up to error 1e-8)
+ */
+inline Eigen::SparseMatrix<double> sparse_cholesky_decompose(
+    const Eigen::SparseMatrix<double>& m) {
+  static const char* function = "sparse_cholesky_decompose";
+  check_symmetric(function, "m", m);
+  if (m.rows() == 0)
+    return Eigen::SparseMatrix<double>(0, 0);
+  Eigen::SparseMatrix<double> m_c(m);
+  m_c.makeCompressed();
+  const auto& llt
+      = internal::cached_sparse_llt<Eigen::NaturalOrdering<int> >(m_c);
+  if (llt.info() != Eigen::Success)
+    domain_error(function, "m", "is not positive definite.", "");
+  Eigen::SparseMatrix<double> L = llt.matrixL();
+  return L;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
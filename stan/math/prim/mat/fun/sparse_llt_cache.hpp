@@ -0,0 +1,144 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_SPARSE_LLT_CACHE_HPP
+#define STAN_MATH_PRIM_MAT_FUN_SPARSE_LLT_CACHE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * Sparse Cholesky factorization that keeps the symbolic analysis
+ * (fill-reducing ordering and elimination tree) of the last
+ * sparsity pattern it factored.
+ *
+ * Models that factor a matrix with a fixed sparsity pattern on
+ * every log density evaluation only pay for the numeric
+ * factorization after the first call.  The pattern is compared
+ * index by index, so a changed pattern is always re-analyzed.
+ *
+ * @tparam Ordering Eigen fill-reducing ordering
+ */
+template <typename Ordering>
+class sparse_llt_cache {
+ public:
+  typedef Eigen::SimplicialLLT<Eigen::SparseMatrix<double>, Eigen::Lower,
+                               Ordering>
+      llt_t;
+
+ private:
+  llt_t llt_;
+  Eigen::Index rows_;
+  std::vector<int> outer_;
+  std::vector<int> inner_;
+
+  bool same_pattern(const Eigen::SparseMatrix<double>& A) const {
+    return rows_ == A.rows()
+           && outer_.size() == static_cast<size_t>(A.outerSize() + 1)
+           && inner_.size() == static_cast<size_t>(A.nonZeros())
+           && std::equal(outer_.begin(), outer_.end(), A.outerIndexPtr())
+           && std::equal(inner_.begin(), inner_.end(), A.innerIndexPtr());
+  }
+
+ public:
+  sparse_llt_cache() : rows_(-1) {}
+
+  /**
+   * Return the Cholesky factorization of the specified matrix,
+   * reusing the symbolic analysis when its sparsity pattern
+   * matches the previous call.
+   *
+   * Only the lower triangle of A is read.  The caller checks
+   * <code>info()</code> of the result for success.
+   *
+   * @param A Compressed symmetric sparse matrix
+   * @return Factorization of A, valid until the next call
+   */
+  const llt_t& factorize(const Eigen::SparseMatrix<double>& A) {
+    if (!same_pattern(A)) {
+      llt_.analyzePattern(A);
+      rows_ = A.rows();
+      outer_.assign(A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1);
+      inner_.assign(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros());
+    }
+    llt_.factorize(A);
+    return llt_;
+  }
+};
+
+/**
+ * Return the Cholesky factorization of the specified compressed
+ * symmetric sparse matrix using the calling thread's
+ * <code>sparse_llt_cache</code> for the ordering.
+ *
+ * @tparam Ordering Eigen fill-reducing ordering
+ * @param A Compressed symmetric sparse matrix
+ * @return Factorization of A, valid until the next call on this
+ *   thread with the same ordering
+ */
+template <typename Ordering>
+inline const typename sparse_llt_cache<Ordering>::llt_t& cached_sparse_llt(
+    const Eigen::SparseMatrix<double>& A) {
+#ifdef STAN_THREADS
+  static thread_local sparse_llt_cache<Ordering> cache;
+#else
+  static sparse_llt_cache<Ordering> cache;
+#endif
+  return cache.factorize(A);
+}
+
+/**
+ * Return the entries of the inverse of L * L^T on the sparsity
+ * pattern of the lower triangular Cholesky factor L (the sparse
+ * or "selected" inverse), computed with the Takahashi recursion.
+ *
+ * The pattern of a Cholesky factor is closed under the recursion,
+ * so only entries of the pattern are ever needed.  The result
+ * has the same structure as L.
+ *
+ * @param L Compressed lower triangular column-major Cholesky
+ *   factor with sorted row indices and the diagonal stored first
+ *   in each column
+ * @return Entries of (L * L^T)^-1 on the pattern of L
+ */
+inline Eigen::SparseMatrix<double> sparse_selected_inverse(
+    const Eigen::SparseMatrix<double>& L) {
+  Eigen::SparseMatrix<double> Z = L;
+  const int* outer = L.outerIndexPtr();
+  const int* inner = L.innerIndexPtr();
+  const double* Lv = L.valuePtr();
+  double* Zv = Z.valuePtr();
+
+  // position of (row, col) in the pattern, row >= col
+  auto find = [&](int row, int col) {
+    return static_cast<int>(
+        std::lower_bound(inner + outer[col], inner + outer[col + 1], row)
+        - inner);
+  };
+
+  for (int j = L.cols() - 1; j >= 0; --j) {
+    int diag = outer[j];
+    double L_jj = Lv[diag];
+    for (int a = diag + 1; a < outer[j + 1]; ++a) {
+      int i = inner[a];
+      double sum = 0;
+      for (int b = diag + 1; b < outer[j + 1]; ++b) {
+        int k = inner[b];
+        sum += Lv[b] * Zv[i > k ? find(i, k) : find(k, i)];
+      }
+      Zv[a] = -sum / L_jj;
+    }
+    double sum = 0;
+    for (int b = diag + 1; b < outer[j + 1]; ++b)
+      sum += Lv[b] * Zv[b];
+    Zv[diag] = (1 / L_jj - sum) / L_jj;
+  }
+  return Z;
+}
+}  // namespace internal
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -6,9 +6,6 @@
 #include <stan/math/prim/mat/fun/LDLT_factor.hpp>
 #include <stan/math/prim/mat/err/check_multiplicable.hpp>
 #include <stan/math/prim/mat/fun/mdivide_left_ldlt.hpp>
-#include <stan/math/prim/mat/fun/trace.hpp>
-#include <stan/math/prim/mat/fun/transpose.hpp>
-#include <stan/math/prim/mat/fun/multiply.hpp>
 
 namespace stan {
 namespace math {
@@ -16,7 +13,8 @@ namespace math {
 /*
  * Compute the trace of an inverse quadratic form.  I.E., this computes
  *       trace(B^T A^-1 B)
- * where the LDLT_factor of A is provided.
+ * where the LDLT_factor of A is provided.  The trace is summed
+ * elementwise, so B may have many columns.
  */
 template <typename T1, typename T2, int R2, int C2, int R3, int C3>
 inline typename std::enable_if<
@@ -26,7 +24,12 @@ trace_inv_quad_form_ldlt(const LDLT_factor<T1, R2, C2> &A,
                          const Eigen::Matrix<T2, R3, C3> &B) {
   check_multiplicable("trace_inv_quad_form_ldlt", "A", A, "B", B);
 
-  return trace(multiply(transpose(B), mdivide_left_ldlt(A, B)));
+  typedef typename boost::math::tools::promote_args<T1, T2>::type T_return;
+  const Eigen::Matrix<T_return, R2, C3> AinvB = mdivide_left_ldlt(A, B);
+  T_return result(0);
+  for (int i = 0; i < B.size(); ++i)
+    result += B(i) * AinvB(i);
+  return result;
 }
 
 }  // namespace math
@@ -46,6 +46,33 @@ inline const Eigen::Matrix<double, R, C>& value_of(
     const Eigen::Matrix<double, R, C>& x) {
   return x;
 }
+
+/**
+ * Convert a sparse matrix of type T to a sparse matrix of doubles
+ * with the same sparsity pattern.
+ *
+ * @tparam T Scalar type in sparse matrix
+ * @param[in] M Sparse matrix to be converted
+ * @return Sparse matrix of values
+ **/
+template <typename T>
+inline Eigen::SparseMatrix<typename child_type<T>::type> value_of(
+    const Eigen::SparseMatrix<T>& M) {
+  Eigen::SparseMatrix<typename child_type<T>::type> Md
+      = M.unaryExpr([](const T& x) { return value_of(x); });
+  return Md;
+}
+
+/**
+ * Return the specified argument.
+ *
+ * @param x Specified sparse matrix.
+ * @return Specified sparse matrix.
+ */
+inline const Eigen::SparseMatrix<double>& value_of(
+    const Eigen::SparseMatrix<double>& x) {
+  return x;
+}
 }  // namespace math
 }  // namespace stan
 
@@ -0,0 +1,57 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_APPLY_FIXED_SIZE_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_APPLY_FIXED_SIZE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <utility>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Return <code>F<N>::apply(args...)</code> where the compile-time
+ * size N equals the specified run-time size if it is between 1
+ * and 8 and is <code>Eigen::Dynamic</code> otherwise.
+ *
+ * Kernels written in terms of <code>Eigen::Matrix<double, N,
+ * N></code> are then instantiated with fixed-size matrices, whose
+ * loops Eigen unrolls and whose temporaries live on the stack,
+ * for the small matrices that dominate batched operations.
+ *
+ * @tparam F Class template over the size with a static
+ *   <code>apply</code> function returning the same type for all
+ *   sizes
+ * @tparam Args Types of the arguments
+ * @param n Run-time size
+ * @param args Arguments forwarded to <code>apply</code>
+ * @return Result of <code>apply</code>
+ */
+template <template <int> class F, typename... Args>
+inline auto apply_fixed_size(int n, Args&&... args)
+    -> decltype(F<Eigen::Dynamic>::apply(std::forward<Args>(args)...)) {
+  switch (n) {
+    case 1:
+      return F<1>::apply(std::forward<Args>(args)...);
+    case 2:
+      return F<2>::apply(std::forward<Args>(args)...);
+    case 3:
+      return F<3>::apply(std::forward<Args>(args)...);
+    case 4:
+      return F<4>::apply(std::forward<Args>(args)...);
+    case 5:
+      return F<5>::apply(std::forward<Args>(args)...);
+    case 6:
+      return F<6>::apply(std::forward<Args>(args)...);
+    case 7:
+      return F<7>::apply(std::forward<Args>(args)...);
+    case 8:
+      return F<8>::apply(std::forward<Args>(args)...);
+    default:
+      return F<Eigen::Dynamic>::apply(std::forward<Args>(args)...);
+  }
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
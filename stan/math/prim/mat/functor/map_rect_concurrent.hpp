@@ -8,6 +8,8 @@
 #include <boost/lexical_cast.hpp>
 
 #include <cstdlib>
+#include <future>
+#include <type_traits>
 #include <vector>
 #include <thread>
 
@@ -66,6 +68,47 @@ inline int get_num_threads(int num_jobs) {
   return num_threads;
 }
 
+/**
+ * Split the jobs into one chunk of consecutive jobs per thread, see
+ * <code>get_num_threads</code>, and start the functor on each
+ * chunk. The first chunk is deferred and runs on the calling thread
+ * once its result is requested. If compiled with STAN_THREADS, each
+ * other chunk runs on a thread of its own and the last chunks take
+ * one job more if the jobs do not split evenly.
+ *
+ * @tparam F type of the functor, called with the start and the size
+ * of a chunk
+ * @param num_jobs number of jobs
+ * @param execute_chunk functor executing the jobs of a chunk
+ * @return futures of the results of the chunks in the order of the
+ * jobs
+ */
+template <typename F>
+std::vector<std::future<typename std::result_of<const F&(int, int)>::type>>
+concurrent_chunks(int num_jobs, const F& execute_chunk) {
+  std::vector<std::future<typename std::result_of<const F&(int, int)>::type>>
+      futures;
+  const int num_threads = get_num_threads(num_jobs);
+  const int num_jobs_per_thread = num_jobs / num_threads;
+  futures.emplace_back(
+      std::async(std::launch::deferred, execute_chunk, 0, num_jobs_per_thread));
+
+#ifdef STAN_THREADS
+  if (num_threads > 1) {
+    const int num_big_threads = num_jobs % num_threads;
+    const int first_big_thread = num_threads - num_big_threads;
+    for (int i = 1, job_start = num_jobs_per_thread, job_size = 0;
+         i < num_threads; ++i, job_start += job_size) {
+      job_size = i >= first_big_thread ? num_jobs_per_thread + 1
+                                       : num_jobs_per_thread;
+      futures.emplace_back(
+          std::async(std::launch::async, execute_chunk, job_start, job_size));
+    }
+  }
+#endif
+  return futures;
+}
+
 template <int call_id, typename F, typename T_shared_param,
           typename T_job_param>
 Eigen::Matrix<typename stan::return_type<T_shared_param, T_job_param>::type,
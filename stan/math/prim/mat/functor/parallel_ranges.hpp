@@ -0,0 +1,58 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_PARALLEL_RANGES_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_PARALLEL_RANGES_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Apply the specified functor to consecutive ranges covering
+ * [0, size), spread over up to <code>num_threads</code> threads.
+ *
+ * The range is cut into about four pieces per thread (but no
+ * piece shorter than 16) and the threads take the next piece as
+ * they become free, so pieces of uneven cost are balanced.  The
+ * calling thread works on pieces as well.  With a single thread
+ * the functor is called once on the whole range.
+ *
+ * @tparam F Type of functor, called as <code>f(start, length)</code>
+ * @param size Length of the range
+ * @param num_threads Maximum number of threads to use
+ * @param f Functor applied to each piece, must be safe to call
+ *   concurrently on disjoint pieces
+ */
+template <typename F>
+inline void parallel_ranges(int size, int num_threads, const F& f) {
+  if (size <= 0)
+    return;
+  const int grain = std::max(16, (size + 4 * num_threads - 1)
+                                     / std::max(1, 4 * num_threads));
+  const int num_pieces = (size + grain - 1) / grain;
+  if (num_threads <= 1 || num_pieces <= 1) {
+    f(0, size);
+    return;
+  }
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    for (int piece = next++; piece < num_pieces; piece = next++) {
+      const int start = piece * grain;
+      f(start, std::min(grain, size - start));
+    }
+  };
+  std::vector<std::future<void> > futures;
+  for (int t = 1; t < std::min(num_threads, num_pieces); ++t)
+    futures.emplace_back(std::async(std::launch::async, worker));
+  worker();
+  for (auto& future : futures)
+    future.get();
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,176 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_TASK_GRAPH_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_TASK_GRAPH_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Graph of tasks which read and write numbered resources, such as
+ * the tiles of a matrix, and which runs them concurrently as soon
+ * as their dependencies are done.
+ *
+ * Tasks are added in the order of a serial program.  A task depends
+ * on the last earlier task writing any resource it reads or writes,
+ * and a task writing a resource also depends on the earlier tasks
+ * reading it since its last write.  Running the graph therefore
+ * gives the same results as running the tasks in the order they
+ * were added, which is what happens with a single thread.
+ *
+ * The threads are started with <code>std::async</code> like in
+ * <code>map_rect_concurrent</code> and take the ready tasks from a
+ * shared queue; the calling thread runs tasks as well.
+ */
+class task_graph {
+  std::vector<std::function<bool()> > tasks_;
+  std::vector<std::vector<int> > successors_;
+  std::vector<int> num_dependencies_;
+  std::vector<int> last_writer_;
+  std::vector<std::vector<int> > readers_;
+
+  void add_dependency(int from, int to) {
+    if (from < 0 || (!successors_[from].empty()
+                     && successors_[from].back() == to))
+      return;
+    successors_[from].push_back(to);
+    ++num_dependencies_[to];
+  }
+
+ public:
+  /**
+   * Construct an empty graph.
+   *
+   * @param num_resources Number of resources, numbered from zero
+   */
+  explicit task_graph(int num_resources)
+      : last_writer_(num_resources, -1), readers_(num_resources) {}
+
+  /**
+   * Add a task after all tasks added before.
+   *
+   * @tparam F Type of task, called without arguments and returning
+   *   false if the remaining tasks should not be run
+   * @param reads Resources read by the task
+   * @param writes Resources written by the task, which may also
+   *   be read
+   * @param f Task
+   */
+  template <typename F>
+  void add(const std::vector<int>& reads, const std::vector<int>& writes,
+           F&& f) {
+    const int id = tasks_.size();
+    tasks_.emplace_back(std::forward<F>(f));
+    successors_.emplace_back();
+    num_dependencies_.push_back(0);
+    for (int r : reads) {
+      add_dependency(last_writer_[r], id);
+      readers_[r].push_back(id);
+    }
+    for (int w : writes) {
+      add_dependency(last_writer_[w], id);
+      for (int reader : readers_[w])
+        if (reader != id)
+          add_dependency(reader, id);
+      readers_[w].clear();
+      last_writer_[w] = id;
+    }
+  }
+
+  /**
+   * Return the number of tasks.
+   */
+  int size() const { return tasks_.size(); }
+
+  /**
+   * Run the tasks on up to the specified number of threads.  If a
+   * task returns false or throws, no further tasks are started.
+   *
+   * @param num_threads Maximum number of threads to use
+   * @return false if a task returned false
+   * @throw the first exception thrown by a task
+   */
+  bool run(int num_threads) {
+    const int num_tasks = tasks_.size();
+    if (num_threads <= 1) {
+      for (int t = 0; t < num_tasks; ++t)
+        if (!tasks_[t]())
+          return false;
+      return true;
+    }
+
+    std::vector<int> pending = num_dependencies_;
+    std::deque<int> ready;
+    for (int t = 0; t < num_tasks; ++t)
+      if (pending[t] == 0)
+        ready.push_back(t);
+    int remaining = num_tasks;
+    bool stop = false;
+    bool success = true;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    auto worker = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        cv.wait(lock,
+                [&]() { return stop || remaining == 0 || !ready.empty(); });
+        if (stop || remaining == 0)
+          return;
+        const int t = ready.front();
+        ready.pop_front();
+        lock.unlock();
+        bool task_success = false;
+        try {
+          task_success = tasks_[t]();
+        } catch (...) {
+          lock.lock();
+          if (!error)
+            error = std::current_exception();
+          stop = true;
+          cv.notify_all();
+          return;
+        }
+        lock.lock();
+        if (!task_success) {
+          success = false;
+          stop = true;
+          cv.notify_all();
+          return;
+        }
+        --remaining;
+        for (int s : successors_[t])
+          if (--pending[s] == 0)
+            ready.push_back(s);
+        if (remaining == 0 || ready.size() > 1)
+          cv.notify_all();
+        else if (!ready.empty())
+          cv.notify_one();
+      }
+    };
+
+    std::vector<std::future<void> > futures;
+    for (int t = 1; t < num_threads; ++t)
+      futures.emplace_back(std::async(std::launch::async, worker));
+    worker();
+    for (auto& future : futures)
+      future.get();
+    if (error)
+      std::rethrow_exception(error);
+    return success;
+  }
+};
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
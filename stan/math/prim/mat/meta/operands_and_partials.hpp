@@ -25,7 +25,8 @@ class ops_partials_edge<ViewElt, Eigen::Matrix<Op, R, C>> {
   explicit ops_partials_edge(const Eigen::Matrix<Op, R, C>& /* ops */) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
 
   void dump_partials(double* /* partials */) const {}  // reverse mode
@@ -44,7 +45,8 @@ class ops_partials_edge<ViewElt, std::vector<Eigen::Matrix<Op, R, C>>> {
       const std::vector<Eigen::Matrix<Op, R, C>>& /* ops */) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
 
   void dump_partials(double* /* partials */) const {}  // reverse mode
@@ -64,7 +66,8 @@ class ops_partials_edge<ViewElt, std::vector<std::vector<Op>>> {
   explicit ops_partials_edge(const std::vector<std::vector<Op>>& /* ops */) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
 
   void dump_partials(double* /* partials */) const {}  // reverse mode
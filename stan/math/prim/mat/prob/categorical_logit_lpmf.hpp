@@ -8,6 +8,8 @@
 #include <stan/math/prim/mat/fun/log_softmax.hpp>
 #include <stan/math/prim/mat/fun/log_sum_exp.hpp>
 #include <stan/math/prim/mat/fun/sum.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <boost/math/tools/promotion.hpp>
 #include <vector>
 
@@ -73,6 +75,77 @@ categorical_logit_lpmf(const std::vector<int>& ns,
   return categorical_logit_lpmf<false>(ns, beta);
 }
 
+/**
+ * Return the log of the categorical density of each outcome given
+ * the logits in the corresponding row of the specified matrix,
+ * summed over the observations.
+ *
+ * All rows are normalized in one blocked pass over the values of
+ * the logits and the partials, the one-hot outcome minus the
+ * softmax of each row, are attached to a single node.
+ *
+ * @tparam propto Flag that drops constant terms when true
+ * @tparam T_prob type of the logits
+ * @param ns outcomes, one per row of beta, each in 1:cols(beta)
+ * @param beta matrix of logits with one row per observation
+ * @return sum of the log probabilities of the outcomes
+ * @throw std::invalid_argument if the number of outcomes differs
+ * from the number of rows of beta
+ * @throw std::domain_error if an outcome is out of support or a
+ * logit is not finite
+ */
+template <bool propto, typename T_prob>
+typename return_type<T_prob>::type categorical_logit_lpmf(
+    const std::vector<int>& ns,
+    const Eigen::Matrix<T_prob, Eigen::Dynamic, Eigen::Dynamic>& beta) {
+  static const char* function = "categorical_logit_lpmf";
+  typedef typename partials_return_type<T_prob>::type T_partials_return;
+  typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, Eigen::Dynamic>
+      T_partials_mat;
+  typedef Eigen::Array<T_partials_return, Eigen::Dynamic, 1> T_partials_arr;
+  using std::exp;
+  using std::log;
+
+  check_size_match(function, "Size of outcomes", ns.size(),
+                   "rows of log odds parameter", beta.rows());
+  for (const auto& x : ns)
+    check_bounded(function, "categorical outcome out of support", x, 1,
+                  beta.cols());
+  check_finite(function, "log odds parameter", beta);
+
+  operands_and_partials<Eigen::Matrix<T_prob, Eigen::Dynamic, Eigen::Dynamic> >
+      ops_partials(beta);
+  if (!include_summand<propto, T_prob>::value || ns.empty())
+    return ops_partials.build(0.0);
+
+  const T_partials_mat beta_dbl = value_of(beta);
+  const T_partials_arr beta_max = beta_dbl.rowwise().maxCoeff().array();
+  const T_partials_mat exp_beta
+      = (beta_dbl.colwise() - beta_max.matrix()).array().exp().matrix();
+  const T_partials_arr sum_exp = exp_beta.rowwise().sum().array();
+
+  T_partials_return lp = -(beta_max + sum_exp.log()).sum();
+  for (size_t i = 0; i < ns.size(); ++i)
+    lp += beta_dbl(i, ns[i] - 1);
+
+  if (!is_constant_all<T_prob>::value) {
+    // one-hot outcomes minus the softmax of each row
+    T_partials_mat beta_deriv
+        = -(exp_beta.array().colwise() / sum_exp).matrix();
+    for (size_t i = 0; i < ns.size(); ++i)
+      beta_deriv(i, ns[i] - 1) += 1;
+    ops_partials.edge1_.partials_ = beta_deriv;
+  }
+  return ops_partials.build(lp);
+}
+
+template <typename T_prob>
+inline typename return_type<T_prob>::type categorical_logit_lpmf(
+    const std::vector<int>& ns,
+    const Eigen::Matrix<T_prob, Eigen::Dynamic, Eigen::Dynamic>& beta) {
+  return categorical_logit_lpmf<false>(ns, beta);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
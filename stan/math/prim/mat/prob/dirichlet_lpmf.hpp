@@ -3,11 +3,13 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/scal/err/check_consistent_sizes.hpp>
+#include <stan/math/prim/mat/err/check_consistent_sizes_mvt.hpp>
 #include <stan/math/prim/scal/err/check_positive.hpp>
 #include <stan/math/prim/mat/err/check_simplex.hpp>
 #include <stan/math/prim/mat/fun/lgamma.hpp>
 #include <stan/math/prim/mat/fun/digamma.hpp>
 #include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/value_of_rec.hpp>
 
 namespace stan {
 namespace math {
@@ -35,8 +37,12 @@ namespace math {
  * \frac{\partial}{\partial\alpha_x}\log(p(\theta\,|\,\alpha_1,\ldots,\alpha_k))=\psi_{(0)}(\sum\alpha)-\psi_{(0)}(\alpha_x)+\log\theta_x
  * \f]
  *
- * @param theta A scalar vector.
- * @param alpha Prior sample sizes.
+ * Either argument may also be a standard vector of vectors, in which
+ * case the result is the sum of the log densities of each simplex
+ * and the partials of all of them are attached to one node.
+ *
+ * @param theta A scalar vector or an array of them.
+ * @param alpha Prior sample sizes or an array of them.
  * @return The log of the Dirichlet density.
  * @throw std::domain_error if any element of alpha is less than
  * or equal to 0.
@@ -54,37 +60,49 @@ typename return_type<T_prob, T_prior_size>::type dirichlet_lpmf(
       T_partials_return;
   typedef typename Eigen::Matrix<T_partials_return, -1, 1> T_partials_vec;
 
-  check_consistent_sizes(function, "probabilities", theta, "prior sample sizes",
-                         alpha);
-  check_positive(function, "prior sample sizes", alpha);
-  check_simplex(function, "probabilities", theta);
-
+  check_consistent_sizes_mvt(function, "probabilities", theta,
+                             "prior sample sizes", alpha);
   vector_seq_view<T_prob> theta_vec(theta);
-  T_partials_vec theta_dbl = value_of(theta_vec[0]);
-
   vector_seq_view<T_prior_size> alpha_vec(alpha);
-  T_partials_vec alpha_dbl = value_of(alpha_vec[0]);
+  const size_t t_length = max_size_mvt(theta, alpha);
+  for (size_t t = 0; t < t_length; ++t) {
+    check_consistent_sizes(function, "probabilities", theta_vec[t],
+                           "prior sample sizes", alpha_vec[t]);
+    check_positive(function, "prior sample sizes", alpha_vec[t]);
+    check_simplex(function, "probabilities", value_of_rec(theta_vec[t]));
+  }
 
   T_partials_return lp(0.0);
-
-  if (include_summand<propto, T_prior_size>::value)
-    lp += lgamma(alpha_dbl.sum()) - lgamma(alpha_dbl).sum();
-
-  if (include_summand<propto, T_prob, T_prior_size>::value)
-    lp += (theta_dbl.array().log() * (alpha_dbl.array() - 1.0)).sum();
-
-  T_partials_vec theta_deriv = (alpha_dbl.array() - 1.0) / theta_dbl.array();
-
-  T_partials_vec alpha_deriv = digamma(alpha_dbl.sum())
-                               - digamma(alpha_dbl).array()
-                               + theta_dbl.array().log();
-
   operands_and_partials<T_prob, T_prior_size> ops_partials(theta, alpha);
-  if (!is_constant_all<T_prob>::value)
-    ops_partials.edge1_.partials_ = theta_deriv;
 
-  if (!is_constant_all<T_prior_size>::value)
-    ops_partials.edge2_.partials_ = alpha_deriv;
+  // The terms that only depend on alpha are computed once when a
+  // single alpha is shared by all the simplexes.
+  T_partials_vec alpha_dbl;
+  T_partials_return alpha_lgamma(0.0);
+  T_partials_vec alpha_digamma;
+  for (size_t t = 0; t < t_length; ++t) {
+    if (t == 0 || alpha_vec.size() > 1) {
+      alpha_dbl = value_of(alpha_vec[t]);
+      if (include_summand<propto, T_prior_size>::value)
+        alpha_lgamma = lgamma(alpha_dbl.sum()) - lgamma(alpha_dbl).sum();
+      if (!is_constant_all<T_prior_size>::value)
+        alpha_digamma
+            = digamma(alpha_dbl.sum()) - digamma(alpha_dbl).array();
+    }
+    const T_partials_vec theta_dbl = value_of(theta_vec[t]);
+    const T_partials_vec log_theta = theta_dbl.array().log();
+
+    if (include_summand<propto, T_prior_size>::value)
+      lp += alpha_lgamma;
+    if (include_summand<propto, T_prob, T_prior_size>::value)
+      lp += (log_theta.array() * (alpha_dbl.array() - 1.0)).sum();
+
+    if (!is_constant_all<T_prob>::value)
+      ops_partials.edge1_.partials_vec_[t]
+          += ((alpha_dbl.array() - 1.0) / theta_dbl.array()).matrix();
+    if (!is_constant_all<T_prior_size>::value)
+      ops_partials.edge2_.partials_vec_[t] += alpha_digamma + log_theta;
+  }
 
   return ops_partials.build(lp);
 }
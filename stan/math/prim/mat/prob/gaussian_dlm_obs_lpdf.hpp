@@ -8,19 +8,13 @@
 #include <stan/math/prim/scal/err/check_finite.hpp>
 #include <stan/math/prim/scal/err/check_nonnegative.hpp>
 #include <stan/math/prim/scal/err/check_not_nan.hpp>
-#include <stan/math/prim/mat/fun/add.hpp>
-#include <stan/math/prim/mat/fun/dot_product.hpp>
 #include <stan/math/prim/mat/fun/inverse_spd.hpp>
-#include <stan/math/prim/mat/fun/log.hpp>
 #include <stan/math/prim/mat/fun/log_determinant_spd.hpp>
-#include <stan/math/prim/mat/fun/multiply.hpp>
-#include <stan/math/prim/mat/fun/quad_form.hpp>
-#include <stan/math/prim/mat/fun/quad_form_sym.hpp>
-#include <stan/math/prim/mat/fun/subtract.hpp>
-#include <stan/math/prim/mat/fun/tcrossprod.hpp>
-#include <stan/math/prim/mat/fun/trace_quad_form.hpp>
-#include <stan/math/prim/mat/fun/transpose.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/square.hpp>
+#include <cmath>
+#include <vector>
 
 /*
   TODO: time-varying system matrices
@@ -42,6 +36,12 @@ namespace math {
  * If V is a vector, then the Kalman filter is applied
  * sequentially.
  *
+ * The filter runs on the values of the arguments.  The gradients
+ * with respect to all arguments are computed by an adjoint
+ * (backward) Kalman recursion over the stored filtered states, and
+ * enter the autodiff stack as the partials of a single result, so
+ * the memory used does not grow with the work per time step.
+ *
  * @param y A r x T matrix of observations. Rows are variables,
  * columns are observations.
  * @param F A n x r matrix. The design matrix.
@@ -76,9 +76,10 @@ gaussian_dlm_obs_lpdf(
     const Eigen::Matrix<T_m0, Eigen::Dynamic, 1>& m0,
     const Eigen::Matrix<T_C0, Eigen::Dynamic, Eigen::Dynamic>& C0) {
   static const char* function = "gaussian_dlm_obs_lpdf";
-  typedef
-      typename return_type<T_y, typename return_type<T_F, T_G, T_V, T_W, T_m0,
-                                                     T_C0>::type>::type T_lp;
+  typedef typename partials_return_type<T_y, T_F, T_G, T_V, T_W, T_m0,
+                                        T_C0>::type T_partials;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, Eigen::Dynamic> matrix_t;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, 1> vector_t;
   int r = y.rows();  // number of variables
   int T = y.cols();  // number of observations
   int n = G.rows();  // number of states
@@ -107,60 +108,134 @@ gaussian_dlm_obs_lpdf(
   if (size_zero(y))
     return 0;
 
-  T_lp lp(0);
+  T_partials lp(0);
   if (include_summand<propto>::value) {
     lp -= 0.5 * LOG_TWO_PI * r * T;
   }
 
+  operands_and_partials<Eigen::Matrix<T_y, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_F, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_G, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_V, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_W, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_m0, Eigen::Dynamic, 1>,
+                        Eigen::Matrix<T_C0, Eigen::Dynamic, Eigen::Dynamic> >
+      ops_partials(y, F, G, V, W, m0, C0);
+
   if (include_summand<propto, T_y, T_F, T_G, T_V, T_W, T_m0, T_C0>::value) {
-    Eigen::Matrix<T_lp, Eigen::Dynamic, 1> m(n);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> C(n, n);
+    const bool need_grad
+        = !is_constant_all<T_y, T_F, T_G, T_V, T_W, T_m0, T_C0>::value;
+    const matrix_t y_val = value_of(y);
+    const matrix_t F_val = value_of(F);
+    const matrix_t G_val = value_of(G);
+    const matrix_t V_val = value_of(V);
+    const matrix_t W_val = value_of(W);
 
-    // TODO(anyone): how to recast matrices
-    for (int i = 0; i < m0.size(); i++) {
-      m(i) = m0(i);
+    // The filtered states entering each step are kept for the
+    // adjoint recursion, which recomputes the rest of the step.
+    std::vector<vector_t> m_prev;
+    std::vector<matrix_t> C_prev;
+    if (need_grad) {
+      m_prev.resize(T);
+      C_prev.resize(T);
     }
-    for (int i = 0; i < C0.rows(); i++) {
-      for (int j = 0; j < C0.cols(); j++) {
-        C(i, j) = C0(i, j);
+
+    vector_t m = value_of(m0);
+    matrix_t C = value_of(C0);
+    vector_t a(n);
+    matrix_t R(n, n);
+    matrix_t Q(r, r);
+    matrix_t Q_inv(r, r);
+    vector_t e(r);
+    matrix_t RF(n, r);
+
+    // a_t = G m_{t-1}, R_t = G C_{t-1} G' + W, Q_t = F' R_t F + V,
+    // e_t = y_t - F' a_t
+    auto predict = [&](const vector_t& m_in, const matrix_t& C_in, int t) {
+      a = G_val * m_in;
+      R = G_val * C_in * G_val.transpose();
+      R = (0.5 * (R + R.transpose()) + W_val).eval();
+      RF = R * F_val;
+      Q = F_val.transpose() * RF;
+      Q = (0.5 * (Q + Q.transpose()) + V_val).eval();
+      Q_inv = inverse_spd(Q);
+      e = y_val.col(t) - F_val.transpose() * a;
+    };
+
+    for (int t = 0; t < T; ++t) {
+      if (need_grad) {
+        m_prev[t] = m;
+        C_prev[t] = C;
       }
+      predict(m, C, t);
+      // m_t = a_t + R_t F Q_t^{-1} e_t
+      m = a + RF * (Q_inv * e);
+      // C_t = R_t - R_t F Q_t^{-1} F' R_t
+      C = R - RF * Q_inv * RF.transpose();
+      C = (0.5 * (C + C.transpose())).eval();
+      lp -= 0.5 * (log_determinant_spd(Q) + e.dot(Q_inv * e));
     }
 
-    Eigen::Matrix<typename return_type<T_y>::type, Eigen::Dynamic, 1> yi(r);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, 1> a(n);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> R(n, n);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, 1> f(r);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> Q(r, r);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> Q_inv(r, r);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, 1> e(r);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> A(n, r);
-
-    for (int i = 0; i < y.cols(); i++) {
-      yi = y.col(i);
-      // // Predict state
-      // a_t = G_t m_{t-1}
-      a = multiply(G, m);
-      // R_t = G_t C_{t-1} G_t' + W_t
-      R = add(quad_form_sym(C, transpose(G)), W);
-      // // predict observation
-      // f_t = F_t' a_t
-      f = multiply(transpose(F), a);
-      // Q_t = F'_t R_t F_t + V_t
-      Q = add(quad_form_sym(R, F), V);
-      Q_inv = inverse_spd(Q);
-      // // filtered state
-      // e_t = y_t - f_t
-      e = subtract(yi, f);
-      // A_t = R_t F_t Q^{-1}_t
-      A = multiply(multiply(R, F), Q_inv);
-      // m_t = a_t + A_t e_t
-      m = add(a, multiply(A, e));
-      // C = R_t - A_t Q_t A_t'
-      C = subtract(R, quad_form_sym(Q, transpose(A)));
-      lp -= 0.5 * (log_determinant_spd(Q) + trace_quad_form(Q_inv, e));
+    if (need_grad) {
+      // adjoints of the filtered state after the current step
+      vector_t m_adj = vector_t::Zero(n);
+      matrix_t C_adj = matrix_t::Zero(n, n);
+      matrix_t y_adj(r, T);
+      matrix_t F_adj = matrix_t::Zero(n, r);
+      matrix_t G_adj = matrix_t::Zero(n, n);
+      matrix_t V_adj = matrix_t::Zero(r, r);
+      matrix_t W_adj = matrix_t::Zero(n, n);
+
+      for (int t = T - 1; t >= 0; --t) {
+        predict(m_prev[t], C_prev[t], t);
+        const vector_t Q_inv_e = Q_inv * e;
+        const vector_t RF_m_adj = RF.transpose() * m_adj;
+
+        // log density of the step
+        matrix_t Q_adj = 0.5 * (Q_inv_e * Q_inv_e.transpose() - Q_inv);
+        vector_t e_adj = Q_inv * RF_m_adj - Q_inv_e;
+
+        // m_t and C_t through R F and Q^{-1}
+        matrix_t RF_adj = m_adj * Q_inv_e.transpose()
+                          - 2.0 * C_adj * RF * Q_inv;
+        const matrix_t Q_inv_adj = RF_m_adj * e.transpose()
+                                   - RF.transpose() * C_adj * RF;
+        Q_adj -= Q_inv * Q_inv_adj * Q_inv;
+        Q_adj = (0.5 * (Q_adj + Q_adj.transpose())).eval();
+        matrix_t R_adj = C_adj + RF_adj * F_val.transpose()
+                         + F_val * Q_adj * F_val.transpose();
+        R_adj = (0.5 * (R_adj + R_adj.transpose())).eval();
+        vector_t a_adj = m_adj - F_val * e_adj;
+
+        y_adj.col(t) = e_adj;
+        F_adj += R * RF_adj + 2.0 * RF * Q_adj - a * e_adj.transpose();
+        V_adj += Q_adj;
+        W_adj += R_adj;
+        G_adj += 2.0 * R_adj * G_val * C_prev[t]
+                 + a_adj * m_prev[t].transpose();
+
+        // back to the filtered state of the previous step
+        C_adj = G_val.transpose() * R_adj * G_val;
+        m_adj = G_val.transpose() * a_adj;
+      }
+
+      if (!is_constant_all<T_y>::value)
+        ops_partials.edge1_.partials_ = y_adj;
+      if (!is_constant_all<T_F>::value)
+        ops_partials.edge2_.partials_ = F_adj;
+      if (!is_constant_all<T_G>::value)
+        ops_partials.edge3_.partials_ = G_adj;
+      if (!is_constant_all<T_V>::value)
+        ops_partials.edge4_.partials_ = V_adj;
+      if (!is_constant_all<T_W>::value)
+        ops_partials.edge5_.partials_ = W_adj;
+      if (!is_constant_all<T_m0>::value)
+        ops_partials.edge6_.partials_ = m_adj;
+      if (!is_constant_all<T_C0>::value)
+        ops_partials.edge7_.partials_ = C_adj;
     }
   }
-  return lp;
+  return ops_partials.build(lp);
 }
 
 template <typename T_y, typename T_F, typename T_G, typename T_V, typename T_W,
@@ -189,7 +264,8 @@ gaussian_dlm_obs_lpdf(
  * \f}
  *
  * If V is a vector, then the Kalman filter is applied
- * sequentially.
+ * sequentially.  Gradients are computed by the adjoint recursion
+ * of the sequential filter, as for a matrix V.
  *
  * @param y A r x T matrix of observations. Rows are variables,
  * columns are observations.
@@ -226,9 +302,10 @@ gaussian_dlm_obs_lpdf(
     const Eigen::Matrix<T_m0, Eigen::Dynamic, 1>& m0,
     const Eigen::Matrix<T_C0, Eigen::Dynamic, Eigen::Dynamic>& C0) {
   static const char* function = "gaussian_dlm_obs_lpdf";
-  typedef
-      typename return_type<T_y, typename return_type<T_F, T_G, T_V, T_W, T_m0,
-                                                     T_C0>::type>::type T_lp;
+  typedef typename partials_return_type<T_y, T_F, T_G, T_V, T_W, T_m0,
+                                        T_C0>::type T_partials;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, Eigen::Dynamic> matrix_t;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, 1> vector_t;
   using std::log;
 
   int r = y.rows();  // number of variables
@@ -265,64 +342,142 @@ gaussian_dlm_obs_lpdf(
   if (y.cols() == 0 || y.rows() == 0)
     return 0;
 
-  T_lp lp(0);
+  T_partials lp(0);
   if (include_summand<propto>::value) {
     lp += 0.5 * NEG_LOG_TWO_PI * r * T;
   }
 
+  operands_and_partials<Eigen::Matrix<T_y, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_F, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_G, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_V, Eigen::Dynamic, 1>,
+                        Eigen::Matrix<T_W, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_m0, Eigen::Dynamic, 1>,
+                        Eigen::Matrix<T_C0, Eigen::Dynamic, Eigen::Dynamic> >
+      ops_partials(y, F, G, V, W, m0, C0);
+
   if (include_summand<propto, T_y, T_F, T_G, T_V, T_W, T_m0, T_C0>::value) {
-    T_lp f;
-    T_lp Q;
-    T_lp Q_inv;
-    T_lp e;
-    Eigen::Matrix<T_lp, Eigen::Dynamic, 1> A(n);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, 1> Fj(n);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, 1> m(n);
-    Eigen::Matrix<T_lp, Eigen::Dynamic, Eigen::Dynamic> C(n, n);
-
-    // TODO(anyone): how to recast matrices
-    for (int i = 0; i < m0.size(); i++) {
-      m(i) = m0(i);
+    const bool need_grad
+        = !is_constant_all<T_y, T_F, T_G, T_V, T_W, T_m0, T_C0>::value;
+    const matrix_t y_val = value_of(y);
+    const matrix_t F_val = value_of(F);
+    const matrix_t G_val = value_of(G);
+    const vector_t V_val = value_of(V);
+    const matrix_t W_val = value_of(W);
+
+    // The filtered states entering each step are kept for the
+    // adjoint recursion, which recomputes the rest of the step.
+    std::vector<vector_t> m_prev;
+    std::vector<matrix_t> C_prev;
+    if (need_grad) {
+      m_prev.resize(T);
+      C_prev.resize(T);
     }
-    for (int i = 0; i < C0.rows(); i++) {
-      for (int j = 0; j < C0.cols(); j++) {
-        C(i, j) = C0(i, j);
+
+    vector_t m = value_of(m0);
+    matrix_t C = value_of(C0);
+    vector_t CF(n);
+
+    // m_t = G m_{t-1}, C_t = G C_{t-1} G' + W
+    auto predict = [&]() {
+      m = G_val * m;
+      C = G_val * C * G_val.transpose();
+      C = (0.5 * (C + C.transpose()) + W_val).eval();
+    };
+
+    // update with observation j of step t, return its log density
+    auto update = [&](int j, int t) {
+      CF = C * F_val.col(j);
+      // Q_{t, j} = F_j' C F_j + V_j, e_{t, j} = y_{t, j} - F_j' m
+      const T_partials Q = F_val.col(j).dot(CF) + V_val(j);
+      const T_partials e = y_val(j, t) - F_val.col(j).dot(m);
+      // m += C F_j e / Q, C -= C F_j F_j' C / Q
+      m += CF * (e / Q);
+      C -= CF * CF.transpose() / Q;
+      C = (0.5 * (C + C.transpose())).eval();
+      return -0.5 * (log(Q) + square(e) / Q);
+    };
+
+    for (int t = 0; t < T; ++t) {
+      if (need_grad) {
+        m_prev[t] = m;
+        C_prev[t] = C;
       }
+      predict();
+      for (int j = 0; j < r; ++j)
+        lp += update(j, t);
     }
 
-    for (int i = 0; i < y.cols(); i++) {
-      // Predict state
-      // reuse m and C instead of using a and R
-      m = multiply(G, m);
-      C = add(quad_form_sym(C, transpose(G)), W);
-      for (int j = 0; j < y.rows(); ++j) {
-        // predict observation
-        T_lp yij(y(j, i));
-        // dim Fj = (n, 1)
-        for (int k = 0; k < F.rows(); ++k) {
-          Fj(k) = F(k, j);
+    if (need_grad) {
+      // adjoints of the filtered state after the current update
+      vector_t m_adj = vector_t::Zero(n);
+      matrix_t C_adj = matrix_t::Zero(n, n);
+      matrix_t y_adj(r, T);
+      matrix_t F_adj = matrix_t::Zero(n, r);
+      matrix_t G_adj = matrix_t::Zero(n, n);
+      vector_t V_adj = vector_t::Zero(r);
+      matrix_t W_adj = matrix_t::Zero(n, n);
+      std::vector<vector_t> m_seq(r);
+      std::vector<matrix_t> C_seq(r);
+
+      for (int t = T - 1; t >= 0; --t) {
+        m = m_prev[t];
+        C = C_prev[t];
+        predict();
+        for (int j = 0; j < r; ++j) {
+          m_seq[j] = m;
+          C_seq[j] = C;
+          update(j, t);
         }
-        // f_{t, i} = F_{t, i}' m_{t, i-1}
-        f = dot_product(Fj, m);
-        Q = trace_quad_form(C, Fj) + V(j);
-        Q_inv = 1.0 / Q;
-        // filtered observation
-        // e_{t, i} = y_{t, i} - f_{t, i}
-        e = yij - f;
-        // A_{t, i} = C_{t, i-1} F_{t, i} Q_{t, i}^{-1}
-        A = multiply(multiply(C, Fj), Q_inv);
-        // m_{t, i} = m_{t, i-1} + A_{t, i} e_{t, i}
-        m += multiply(A, e);
-        // c_{t, i} = C_{t, i-1} - Q_{t, i} A_{t, i} A_{t, i}'
-        // tcrossprod throws an error (ambiguous)
-        // C = subtract(C, multiply(Q, tcrossprod(A)));
-        C -= multiply(Q, multiply(A, transpose(A)));
-        C = 0.5 * add(C, transpose(C));
-        lp -= 0.5 * (log(Q) + pow(e, 2) * Q_inv);
+
+        for (int j = r - 1; j >= 0; --j) {
+          const matrix_t& C_j = C_seq[j];
+          CF = C_j * F_val.col(j);
+          const T_partials Q = F_val.col(j).dot(CF) + V_val(j);
+          const T_partials e = y_val(j, t) - F_val.col(j).dot(m_seq[j]);
+          const T_partials CF_m_adj = CF.dot(m_adj);
+          const T_partials CF_C_adj_CF = CF.dot(C_adj * CF);
+
+          const T_partials e_adj = (CF_m_adj - e) / Q;
+          const T_partials Q_adj
+              = (-0.5 * Q + 0.5 * square(e) - CF_m_adj * e + CF_C_adj_CF)
+                / square(Q);
+          const vector_t CF_adj = (m_adj * e - 2.0 * C_adj * CF) / Q;
+
+          y_adj(j, t) = e_adj;
+          V_adj(j) += Q_adj;
+          F_adj.col(j) += 2.0 * Q_adj * CF + C_j * CF_adj - e_adj * m_seq[j];
+          m_adj -= e_adj * F_val.col(j);
+          C_adj += Q_adj * F_val.col(j) * F_val.col(j).transpose()
+                   + 0.5
+                         * (CF_adj * F_val.col(j).transpose()
+                            + F_val.col(j) * CF_adj.transpose());
+        }
+
+        W_adj += C_adj;
+        G_adj += 2.0 * C_adj * G_val * C_prev[t]
+                 + m_adj * m_prev[t].transpose();
+        C_adj = G_val.transpose() * C_adj * G_val;
+        m_adj = G_val.transpose() * m_adj;
       }
+
+      if (!is_constant_all<T_y>::value)
+        ops_partials.edge1_.partials_ = y_adj;
+      if (!is_constant_all<T_F>::value)
+        ops_partials.edge2_.partials_ = F_adj;
+      if (!is_constant_all<T_G>::value)
+        ops_partials.edge3_.partials_ = G_adj;
+      if (!is_constant_all<T_V>::value)
+        ops_partials.edge4_.partials_ = V_adj;
+      if (!is_constant_all<T_W>::value)
+        ops_partials.edge5_.partials_ = W_adj;
+      if (!is_constant_all<T_m0>::value)
+        ops_partials.edge6_.partials_ = m_adj;
+      if (!is_constant_all<T_C0>::value)
+        ops_partials.edge7_.partials_ = C_adj;
     }
   }
-  return lp;
+  return ops_partials.build(lp);
 }
 
 template <typename T_y, typename T_F, typename T_G, typename T_V, typename T_W,
@@ -0,0 +1,65 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_HMM_HIDDEN_STATE_PROB_HPP
+#define STAN_MATH_PRIM_MAT_PROB_HMM_HIDDEN_STATE_PROB_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of_rec.hpp>
+#include <stan/math/prim/mat/prob/hmm_marginal.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the posterior probabilities of the hidden states of a
+ * hidden Markov model given all observations, computed by the
+ * forward-backward algorithm.  The result is not differentiable
+ * and is computed from the values of the arguments.
+ *
+ * @tparam T_omega type of the log densities
+ * @tparam T_Gamma type of the transition matrix
+ * @tparam T_rho type of the initial state distribution
+ * @param log_omegas K x N matrix whose entry (k, n) is the log
+ * density of observation n when the hidden state is k
+ * @param Gamma K x K transition matrix, each row a simplex
+ * @param rho initial state distribution
+ * @return K x N matrix whose column n is the distribution of the
+ * hidden state at observation n
+ * @throw std::invalid_argument if the sizes do not match
+ * @throw std::domain_error if log_omegas has NaN entries, or rho or
+ * a row of Gamma is not a simplex, or if the observations have
+ * probability zero, so that the posterior is not defined
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho>
+inline Eigen::MatrixXd hmm_hidden_state_prob(
+    const Eigen::Matrix<T_omega, Eigen::Dynamic, Eigen::Dynamic>& log_omegas,
+    const Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic>& Gamma,
+    const Eigen::Matrix<T_rho, Eigen::Dynamic, 1>& rho) {
+  static const char* function = "hmm_hidden_state_prob";
+  internal::hmm_check(function, log_omegas, Gamma, rho);
+
+  const int K = log_omegas.rows();
+  const int N = log_omegas.cols();
+  const Eigen::MatrixXd Gamma_val = value_of_rec(Gamma);
+  Eigen::MatrixXd omegas;
+  Eigen::MatrixXd probs;
+  const double log_marginal = internal::hmm_forward(
+      Eigen::MatrixXd(value_of_rec(log_omegas)), Gamma_val,
+      Eigen::VectorXd(value_of_rec(rho)), omegas, probs);
+  check_finite(function, "log marginal density", log_marginal);
+
+  Eigen::VectorXd beta = Eigen::VectorXd::Ones(K);
+  for (int n = N - 1; n >= 0; --n) {
+    probs.col(n) = probs.col(n).cwiseProduct(beta);
+    probs.col(n) /= probs.col(n).sum();
+    if (n > 0) {
+      beta = Gamma_val * omegas.col(n).cwiseProduct(beta);
+      beta /= beta.sum();
+    }
+  }
+  return probs;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,206 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_HMM_MARGINAL_HPP
+#define STAN_MATH_PRIM_MAT_PROB_HMM_MARGINAL_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/arr/err/check_nonzero_size.hpp>
+#include <stan/math/prim/mat/err/check_simplex.hpp>
+#include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/value_of_rec.hpp>
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <cmath>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Check the arguments of the hidden Markov model functions.
+ *
+ * @tparam T_omega type of the log densities
+ * @tparam T_Gamma type of the transition matrix
+ * @tparam T_rho type of the initial state distribution
+ * @param function name of the calling function
+ * @param log_omegas K x N matrix of log densities of each
+ * observation under each hidden state
+ * @param Gamma K x K transition matrix
+ * @param rho initial state distribution
+ * @throw std::invalid_argument if the sizes do not match or
+ * Gamma is empty
+ * @throw std::domain_error if log_omegas has NaN entries, or rho or
+ * a row of Gamma is not a simplex
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho>
+inline void hmm_check(
+    const char* function,
+    const Eigen::Matrix<T_omega, Eigen::Dynamic, Eigen::Dynamic>& log_omegas,
+    const Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic>& Gamma,
+    const Eigen::Matrix<T_rho, Eigen::Dynamic, 1>& rho) {
+  check_nonzero_size(function, "Gamma", Gamma);
+  check_square(function, "Gamma", Gamma);
+  check_size_match(function, "rows of log_omegas", log_omegas.rows(),
+                   "rows of Gamma", Gamma.rows());
+  check_size_match(function, "size of rho", rho.size(), "rows of Gamma",
+                   Gamma.rows());
+  check_not_nan(function, "log_omegas", log_omegas);
+  // checked on values so that no autodiff nodes are created
+  const Eigen::VectorXd rho_val = value_of_rec(rho);
+  check_simplex(function, "rho", rho_val);
+  const Eigen::MatrixXd Gamma_val = value_of_rec(Gamma);
+  for (int i = 0; i < Gamma.rows(); ++i) {
+    const Eigen::VectorXd Gamma_row = Gamma_val.row(i).transpose();
+    check_simplex(function, "Gamma[i, ]", Gamma_row);
+  }
+}
+
+/**
+ * Run the forward algorithm of a hidden Markov model.
+ *
+ * Each column of the densities is scaled by its largest entry and
+ * each forward probability by its sum, so the returned columns of
+ * alphas are the filtered state probabilities and nothing under-
+ * or overflows for long series.  If the observations up to some
+ * step have probability zero, because the densities of a column
+ * are all zero or only unreachable states have nonzero densities,
+ * the forward pass stops there and returns negative infinity.
+ *
+ * @tparam T scalar type
+ * @param[in] log_omegas K x N matrix of log densities
+ * @param[in] Gamma K x K transition matrix
+ * @param[in] rho initial state distribution
+ * @param[out] omegas scaled densities
+ * @param[out] alphas normalized forward probabilities
+ * @return log marginal density of the observations, or negative
+ * infinity if they have probability zero
+ */
+template <typename T>
+inline T hmm_forward(
+    const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& log_omegas,
+    const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& Gamma,
+    const Eigen::Matrix<T, Eigen::Dynamic, 1>& rho,
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& omegas,
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& alphas) {
+  using std::exp;
+  using std::log;
+  const int K = log_omegas.rows();
+  const int N = log_omegas.cols();
+  omegas.resize(K, N);
+  alphas.resize(K, N);
+
+  T log_norm(0);
+  for (int n = 0; n < N; ++n) {
+    const T max_log_omega = log_omegas.col(n).maxCoeff();
+    if (max_log_omega == NEGATIVE_INFTY)
+      return NEGATIVE_INFTY;
+    for (int k = 0; k < K; ++k)
+      omegas(k, n) = exp(log_omegas(k, n) - max_log_omega);
+    if (n == 0)
+      alphas.col(0) = omegas.col(0).cwiseProduct(rho);
+    else
+      alphas.col(n)
+          = omegas.col(n).cwiseProduct(Gamma.transpose() * alphas.col(n - 1));
+    const T norm = alphas.col(n).sum();
+    if (norm == 0)
+      return NEGATIVE_INFTY;
+    alphas.col(n) /= norm;
+    log_norm += max_log_omega + log(norm);
+  }
+  return log_norm;
+}
+
+}  // namespace internal
+
+/**
+ * Return the log marginal density of a hidden Markov model,
+ * summing over all sequences of the K hidden states.
+ *
+ * The forward algorithm runs on the values of the arguments and
+ * the gradients are obtained from one backward pass, so the cost
+ * is O(N K^2) in double precision and the result is a single
+ * node on the autodiff stack.
+ *
+ * If the observations have probability zero under the model, for
+ * example because a column of log_omegas is all negative infinity,
+ * the result is negative infinity with zero gradients.
+ *
+ * @tparam T_omega type of the log densities
+ * @tparam T_Gamma type of the transition matrix
+ * @tparam T_rho type of the initial state distribution
+ * @param log_omegas K x N matrix whose entry (k, n) is the log
+ * density of observation n when the hidden state is k
+ * @param Gamma K x K transition matrix, each row a simplex whose
+ * entry j is the probability of moving to state j
+ * @param rho initial state distribution
+ * @return log marginal density, or negative infinity if the
+ * observations have probability zero
+ * @throw std::invalid_argument if the sizes do not match
+ * @throw std::domain_error if log_omegas has NaN entries, or rho or
+ * a row of Gamma is not a simplex
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho>
+inline typename return_type<T_omega, T_Gamma, T_rho>::type hmm_marginal(
+    const Eigen::Matrix<T_omega, Eigen::Dynamic, Eigen::Dynamic>& log_omegas,
+    const Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic>& Gamma,
+    const Eigen::Matrix<T_rho, Eigen::Dynamic, 1>& rho) {
+  static const char* function = "hmm_marginal";
+  typedef typename partials_return_type<T_omega, T_Gamma, T_rho>::type
+      T_partials;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, Eigen::Dynamic> matrix_t;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, 1> vector_t;
+
+  internal::hmm_check(function, log_omegas, Gamma, rho);
+
+  operands_and_partials<Eigen::Matrix<T_omega, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic>,
+                        Eigen::Matrix<T_rho, Eigen::Dynamic, 1> >
+      ops_partials(log_omegas, Gamma, rho);
+
+  const int K = log_omegas.rows();
+  const int N = log_omegas.cols();
+  if (N == 0)
+    return ops_partials.build(0.0);
+
+  const matrix_t Gamma_val = value_of(Gamma);
+  const vector_t rho_val = value_of(rho);
+  matrix_t omegas;
+  matrix_t alphas;
+  const T_partials log_marginal = internal::hmm_forward(
+      matrix_t(value_of(log_omegas)), Gamma_val, rho_val, omegas, alphas);
+  if (log_marginal == NEGATIVE_INFTY)
+    return ops_partials.build(log_marginal);
+
+  if (!is_constant_all<T_omega, T_Gamma, T_rho>::value) {
+    // backward probabilities, rescaled to sum to one at each step
+    vector_t beta = vector_t::Ones(K);
+    vector_t omega_beta(K);
+    vector_t Gamma_omega_beta(K);
+    matrix_t Gamma_adj = matrix_t::Zero(K, K);
+    for (int n = N - 1; n >= 0; --n) {
+      if (!is_constant_all<T_omega>::value) {
+        // posterior state probabilities
+        vector_t state_prob = alphas.col(n).cwiseProduct(beta);
+        ops_partials.edge1_.partials_.col(n) = state_prob / state_prob.sum();
+      }
+      omega_beta = omegas.col(n).cwiseProduct(beta);
+      if (n > 0) {
+        Gamma_omega_beta = Gamma_val * omega_beta;
+        if (!is_constant_all<T_Gamma>::value)
+          Gamma_adj += alphas.col(n - 1) * omega_beta.transpose()
+                       / alphas.col(n - 1).dot(Gamma_omega_beta);
+        beta = Gamma_omega_beta / Gamma_omega_beta.sum();
+      }
+    }
+    if (!is_constant_all<T_Gamma>::value)
+      ops_partials.edge2_.partials_ = Gamma_adj;
+    if (!is_constant_all<T_rho>::value)
+      ops_partials.edge3_.partials_ = omega_beta / rho_val.dot(omega_beta);
+  }
+  return ops_partials.build(log_marginal);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
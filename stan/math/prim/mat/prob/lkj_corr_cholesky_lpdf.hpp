@@ -2,58 +2,81 @@
 #define STAN_MATH_PRIM_MAT_PROB_LKJ_CORR_CHOLESKY_LPDF_HPP
 
 #include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/mat/err/check_lower_triangular.hpp>
 #include <stan/math/prim/scal/err/check_positive.hpp>
-#include <stan/math/prim/mat/fun/make_nu.hpp>
 #include <stan/math/prim/mat/prob/lkj_corr_log.hpp>
-#include <stan/math/prim/mat/fun/multiply.hpp>
+#include <stan/math/prim/scal/fun/digamma.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <cmath>
 
 namespace stan {
 namespace math {
 
 // LKJ_Corr(L|eta) [ L Cholesky factor of correlation matrix
 //                  eta > 0; eta == 1 <-> uniform]
+//
+// The density only depends on the diagonal of L, so the value and
+// the partials are computed in closed form in O(K) and returned as
+// a single node.
 template <bool propto, typename T_covar, typename T_shape>
-typename boost::math::tools::promote_args<T_covar, T_shape>::type
-lkj_corr_cholesky_lpdf(
+typename return_type<T_covar, T_shape>::type lkj_corr_cholesky_lpdf(
     const Eigen::Matrix<T_covar, Eigen::Dynamic, Eigen::Dynamic>& L,
     const T_shape& eta) {
   static const char* function = "lkj_corr_cholesky_lpdf";
+  typedef typename partials_return_type<T_covar, T_shape>::type T_partials;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, Eigen::Dynamic> matrix_t;
+  using std::log;
 
-  using boost::math::tools::promote_args;
-
-  typedef typename promote_args<T_covar, T_shape>::type lp_ret;
-  lp_ret lp(0.0);
   check_positive(function, "Shape parameter", eta);
   check_lower_triangular(function, "Random variable", L);
 
-  const unsigned int K = L.rows();
+  const int K = L.rows();
   if (K == 0)
     return 0.0;
 
-  if (include_summand<propto, T_shape>::value)
-    lp += do_lkj_constant(eta, K);
+  operands_and_partials<Eigen::Matrix<T_covar, Eigen::Dynamic, Eigen::Dynamic>,
+                        T_shape>
+      ops_partials(L, eta);
+  const T_partials eta_val = value_of(eta);
+  T_partials lp(0.0);
+
+  if (include_summand<propto, T_shape>::value) {
+    lp += do_lkj_constant(eta_val, K);
+    if (!is_constant_all<T_shape>::value) {
+      // derivative of the normalizing constant for eta != 1, which
+      // is continuous in eta
+      T_partials constant_deriv = (K - 1) * digamma(eta_val + 0.5 * (K - 1));
+      for (int k = 1; k < K; ++k)
+        constant_deriv -= digamma(eta_val + 0.5 * (K - 1 - k));
+      ops_partials.edge2_.partials_[0] += constant_deriv;
+    }
+  }
+
   if (include_summand<propto, T_covar, T_shape>::value) {
-    const int Km1 = K - 1;
-    Eigen::Matrix<T_covar, Eigen::Dynamic, 1> log_diagonals
-        = L.diagonal().tail(Km1).array().log();
-    Eigen::Matrix<lp_ret, Eigen::Dynamic, 1> values(Km1);
-    for (int k = 0; k < Km1; k++)
-      values(k) = (Km1 - k - 1) * log_diagonals(k);
-    if ((eta == 1.0)
-        && stan::is_constant_all<typename stan::scalar_type<T_shape> >::value) {
-      lp += sum(values);
-      return (lp);
+    matrix_t L_adj;
+    if (!is_constant_all<T_covar>::value)
+      L_adj = matrix_t::Zero(K, K);
+    T_partials sum_log_diag(0.0);
+    for (int i = 1; i < K; ++i) {
+      const T_partials L_ii = value_of(L(i, i));
+      const T_partials log_L_ii = log(L_ii);
+      const T_partials power = K - i - 1 + 2.0 * (eta_val - 1.0);
+      lp += power * log_L_ii;
+      sum_log_diag += log_L_ii;
+      if (!is_constant_all<T_covar>::value)
+        L_adj(i, i) = power / L_ii;
     }
-    values += multiply(2.0 * eta - 2.0, log_diagonals);
-    lp += sum(values);
+    if (!is_constant_all<T_covar>::value)
+      ops_partials.edge1_.partials_ = L_adj;
+    if (!is_constant_all<T_shape>::value)
+      ops_partials.edge2_.partials_[0] += 2.0 * sum_log_diag;
   }
 
-  return lp;
+  return ops_partials.build(lp);
 }
 
 template <typename T_covar, typename T_shape>
-inline typename boost::math::tools::promote_args<T_covar, T_shape>::type
-lkj_corr_cholesky_lpdf(
+inline typename return_type<T_covar, T_shape>::type lkj_corr_cholesky_lpdf(
     const Eigen::Matrix<T_covar, Eigen::Dynamic, Eigen::Dynamic>& L,
     const T_shape& eta) {
   return lkj_corr_cholesky_lpdf<false>(L, eta);
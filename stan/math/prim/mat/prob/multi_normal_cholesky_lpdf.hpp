@@ -3,17 +3,43 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/mat/err/check_consistent_sizes_mvt.hpp>
-#include <stan/math/prim/mat/fun/dot_self.hpp>
-#include <stan/math/prim/mat/fun/log.hpp>
-#include <stan/math/prim/mat/fun/mdivide_left_tri.hpp>
-#include <stan/math/prim/mat/fun/transpose.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/functor/map_rect_concurrent.hpp>
+#include <stan/math/prim/mat/functor/parallel_ranges.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
 #include <stan/math/prim/scal/err/check_not_nan.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
+#include <type_traits>
 
 namespace stan {
 namespace math {
+namespace internal {
+/**
+ * Apply the specified functor to blocks of consecutive observations
+ * covering [0, size).  If compiled with STAN_THREADS, the partials
+ * are plain doubles and there are at least 4096 observations, the
+ * blocks are spread over the threads given by STAN_NUM_THREADS, see
+ * <code>parallel_ranges</code>.  Otherwise the functor is called once
+ * on all observations.
+ *
+ * @tparam T_partials_return Type of the partials
+ * @tparam F Type of functor, called as <code>f(start, length)</code>
+ * @param size Number of observations
+ * @param f Functor applied to each block
+ */
+template <typename T_partials_return, typename F>
+inline void multi_normal_cholesky_blocks(int size, const F& f) {
+#ifdef STAN_THREADS
+  if (std::is_same<T_partials_return, double>::value && size >= 4096) {
+    parallel_ranges(size, get_num_threads(size / 1024), f);
+    return;
+  }
+#endif
+  f(0, size);
+}
+}  // namespace internal
+
 /**
  * The log of the multivariate normal density for the given y, mu, and
  * a Cholesky factor L of the variance matrix.
@@ -24,7 +50,12 @@ namespace math {
  * written by Jason D. M. Rennie.
  *
  * All expressions are adapted to avoid (most) inversions and maximal
- * reuse of intermediates.
+ * reuse of intermediates.  The observations are stacked into a
+ * matrix with one column per observation, so that the quadratic
+ * forms take one triangular solve and the gradient with respect to
+ * L takes one matrix-matrix product.  With STAN_THREADS defined the
+ * solves are split over column blocks for large numbers of
+ * observations.
  *
  * @param y A scalar vector
  * @param mu The mean vector of the multivariate normal distribution.
@@ -47,9 +78,6 @@ typename return_type<T_y, T_loc, T_covar>::type multi_normal_cholesky_lpdf(
       T_partials_return;
   typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, Eigen::Dynamic>
       matrix_partials_t;
-  typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1> vector_partials_t;
-  typedef Eigen::Matrix<T_partials_return, 1, Eigen::Dynamic>
-      row_vector_partials_t;
 
   check_consistent_sizes_mvt(function, "y", y, "mu", mu);
   size_t number_of_y = length_mvt(y);
@@ -112,42 +140,54 @@ typename return_type<T_y, T_loc, T_covar>::type multi_normal_cholesky_lpdf(
   if (include_summand<propto>::value)
     logp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
 
-  const matrix_partials_t inv_L_dbl
-      = mdivide_left_tri<Eigen::Lower>(value_of(L));
+  const matrix_partials_t L_dbl = value_of(L);
 
+  matrix_partials_t half;
   if (include_summand<propto, T_y, T_loc, T_covar_elem>::value) {
-    for (size_t i = 0; i < size_vec; i++) {
-      vector_partials_t y_minus_mu_dbl(size_y);
+    half.resize(size_y, size_vec);
+    for (size_t i = 0; i < size_vec; i++)
       for (int j = 0; j < size_y; j++)
-        y_minus_mu_dbl(j) = value_of(y_vec[i](j)) - value_of(mu_vec[i](j));
-
-      const row_vector_partials_t half
-          = (inv_L_dbl.template triangularView<Eigen::Lower>() * y_minus_mu_dbl)
-                .transpose();
-      const vector_partials_t scaled_diff
-          = (half * inv_L_dbl.template triangularView<Eigen::Lower>())
-                .transpose();
-
-      logp -= 0.5 * dot_self(half);
-
-      if (!is_constant_all<T_y>::value) {
-        for (int j = 0; j < size_y; j++)
-          ops_partials.edge1_.partials_vec_[i](j) -= scaled_diff(j);
-      }
-      if (!is_constant_all<T_loc>::value) {
-        for (int j = 0; j < size_y; j++)
-          ops_partials.edge2_.partials_vec_[i](j) += scaled_diff(j);
-      }
-      if (!is_constant_all<T_covar>::value) {
-        ops_partials.edge3_.partials_ += scaled_diff * half;
+        half(j, i) = value_of(y_vec[i](j)) - value_of(mu_vec[i](j));
+
+    internal::multi_normal_cholesky_blocks<T_partials_return>(
+        size_vec, [&](int start, int size) {
+          L_dbl.template triangularView<Eigen::Lower>().solveInPlace(
+              half.middleCols(start, size));
+        });
+
+    logp -= 0.5 * half.squaredNorm();
+
+    if (!is_constant_all<T_y, T_loc>::value) {
+      matrix_partials_t scaled_diff = half;
+      internal::multi_normal_cholesky_blocks<T_partials_return>(
+          size_vec, [&](int start, int size) {
+            L_dbl.transpose()
+                .template triangularView<Eigen::Upper>()
+                .solveInPlace(scaled_diff.middleCols(start, size));
+          });
+      for (size_t i = 0; i < size_vec; i++) {
+        if (!is_constant_all<T_y>::value) {
+          for (int j = 0; j < size_y; j++)
+            ops_partials.edge1_.partials_vec_[i](j) -= scaled_diff(j, i);
+        }
+        if (!is_constant_all<T_loc>::value) {
+          for (int j = 0; j < size_y; j++)
+            ops_partials.edge2_.partials_vec_[i](j) += scaled_diff(j, i);
+        }
       }
     }
   }
 
   if (include_summand<propto, T_covar_elem>::value) {
-    logp += inv_L_dbl.diagonal().array().log().sum() * size_vec;
+    logp -= L_dbl.diagonal().array().log().sum() * size_vec;
     if (!is_constant_all<T_covar>::value) {
-      ops_partials.edge3_.partials_ -= size_vec * inv_L_dbl.transpose();
+      // L^{-T} (half * half' - N * I) combines the gradients of the
+      // quadratic form and of the log determinant
+      matrix_partials_t grad_L = half * half.transpose();
+      grad_L.diagonal().array() -= static_cast<double>(size_vec);
+      L_dbl.transpose().template triangularView<Eigen::Upper>().solveInPlace(
+          grad_L);
+      ops_partials.edge3_.partials_ += grad_L;
     }
   }
 
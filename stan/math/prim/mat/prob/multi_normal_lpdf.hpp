@@ -16,19 +16,40 @@
 namespace stan {
 namespace math {
 
-template <bool propto, typename T_y, typename T_loc, typename T_covar>
+/**
+ * The log of the multivariate normal density for the given y, mu,
+ * and an LDLT factorization of the covariance matrix.
+ *
+ * The factorization can be computed once and shared by several
+ * calls, so the covariance matrix is factored only once and, in
+ * reverse mode, the adjoint of the factorization is propagated to
+ * the covariance matrix only once.
+ *
+ * @tparam propto Carry out calculations up to a proportion
+ * @tparam T_y Type of the random variable
+ * @tparam T_loc Type of the location
+ * @tparam T_covar Scalar type of the covariance matrix
+ * @tparam R Rows of the covariance matrix
+ * @tparam C Columns of the covariance matrix
+ * @param y A vector or array of vectors
+ * @param mu The mean vector or array of mean vectors
+ * @param ldlt_Sigma The LDLT factorization of the covariance matrix
+ * @return The log of the multivariate normal density.
+ * @throw std::domain_error if the factorization is not of a
+ *   positive definite matrix or the location is not finite or the
+ *   random variable is nan
+ * @throw std::invalid_argument if the sizes do not match
+ */
+template <bool propto, typename T_y, typename T_loc, typename T_covar, int R,
+          int C>
 typename return_type<T_y, T_loc, T_covar>::type multi_normal_lpdf(
-    const T_y& y, const T_loc& mu, const T_covar& Sigma) {
+    const T_y& y, const T_loc& mu,
+    const LDLT_factor<T_covar, R, C>& ldlt_Sigma) {
   static const char* function = "multi_normal_lpdf";
-  typedef typename scalar_type<T_covar>::type T_covar_elem;
   typedef typename return_type<T_y, T_loc, T_covar>::type lp_type;
 
   using Eigen::Dynamic;
 
-  check_positive(function, "Covariance matrix rows", Sigma.rows());
-  check_symmetric(function, "Covariance matrix", Sigma);
-
-  LDLT_factor<T_covar_elem, Dynamic, Dynamic> ldlt_Sigma(Sigma);
   check_ldlt_factor(function, "LDLT_Factor of covariance parameter",
                     ldlt_Sigma);
 
@@ -81,9 +102,7 @@ typename return_type<T_y, T_loc, T_covar>::type multi_normal_lpdf(
   check_size_match(function, "Size of random variable", size_y,
                    "size of location parameter", size_mu);
   check_size_match(function, "Size of random variable", size_y,
-                   "rows of covariance parameter", Sigma.rows());
-  check_size_match(function, "Size of random variable", size_y,
-                   "columns of covariance parameter", Sigma.cols());
+                   "rows of covariance parameter", ldlt_Sigma.rows());
 
   for (size_t i = 0; i < size_vec; i++) {
     check_finite(function, "Location parameter", mu_vec[i]);
@@ -96,29 +115,48 @@ typename return_type<T_y, T_loc, T_covar>::type multi_normal_lpdf(
   if (include_summand<propto>::value)
     lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
 
-  if (include_summand<propto, T_covar_elem>::value)
+  if (include_summand<propto, T_covar>::value)
     lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * size_vec;
 
-  if (include_summand<propto, T_y, T_loc, T_covar_elem>::value) {
-    lp_type sum_lp_vec(0.0);
-    for (size_t i = 0; i < size_vec; i++) {
-      Eigen::Matrix<typename return_type<T_y, T_loc>::type, Dynamic, 1>
-          y_minus_mu(size_y);
+  if (include_summand<propto, T_y, T_loc, T_covar>::value) {
+    // the sum of the quadratic forms is the trace of the quadratic
+    // form of all differences stacked as columns
+    Eigen::Matrix<typename return_type<T_y, T_loc>::type, Dynamic, Dynamic>
+        y_minus_mu(size_y, size_vec);
+    for (size_t i = 0; i < size_vec; i++)
       for (int j = 0; j < size_y; j++)
-        y_minus_mu(j) = y_vec[i](j) - mu_vec[i](j);
-      sum_lp_vec += trace_inv_quad_form_ldlt(ldlt_Sigma, y_minus_mu);
-    }
-    lp -= 0.5 * sum_lp_vec;
+        y_minus_mu(j, i) = y_vec[i](j) - mu_vec[i](j);
+    lp -= 0.5 * trace_inv_quad_form_ldlt(ldlt_Sigma, y_minus_mu);
   }
   return lp;
 }
 
+template <bool propto, typename T_y, typename T_loc, typename T_covar>
+typename return_type<T_y, T_loc, T_covar>::type multi_normal_lpdf(
+    const T_y& y, const T_loc& mu, const T_covar& Sigma) {
+  static const char* function = "multi_normal_lpdf";
+  typedef typename scalar_type<T_covar>::type T_covar_elem;
+
+  check_positive(function, "Covariance matrix rows", Sigma.rows());
+  check_symmetric(function, "Covariance matrix", Sigma);
+
+  LDLT_factor<T_covar_elem, Eigen::Dynamic, Eigen::Dynamic> ldlt_Sigma(Sigma);
+  return multi_normal_lpdf<propto>(y, mu, ldlt_Sigma);
+}
+
 template <typename T_y, typename T_loc, typename T_covar>
 inline typename return_type<T_y, T_loc, T_covar>::type multi_normal_lpdf(
     const T_y& y, const T_loc& mu, const T_covar& Sigma) {
   return multi_normal_lpdf<false>(y, mu, Sigma);
 }
 
+template <typename T_y, typename T_loc, typename T_covar, int R, int C>
+inline typename return_type<T_y, T_loc, T_covar>::type multi_normal_lpdf(
+    const T_y& y, const T_loc& mu,
+    const LDLT_factor<T_covar, R, C>& ldlt_Sigma) {
+  return multi_normal_lpdf<false>(y, mu, ldlt_Sigma);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
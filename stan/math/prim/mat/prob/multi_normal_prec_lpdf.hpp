@@ -5,7 +5,10 @@
 #include <stan/math/prim/mat/err/check_consistent_sizes_mvt.hpp>
 #include <stan/math/prim/mat/err/check_ldlt_factor.hpp>
 #include <stan/math/prim/mat/err/check_symmetric.hpp>
+#include <stan/math/prim/mat/fun/dot_product.hpp>
 #include <stan/math/prim/mat/fun/log_determinant_ldlt.hpp>
+#include <stan/math/prim/mat/fun/log_determinant_spd.hpp>
+#include <stan/math/prim/mat/fun/multiply.hpp>
 #include <stan/math/prim/mat/fun/sum.hpp>
 #include <stan/math/prim/mat/fun/trace_quad_form.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
@@ -114,6 +117,80 @@ typename return_type<T_y, T_loc, T_covar>::type multi_normal_prec_lpdf(
   return lp;
 }
 
+/**
+ * The log of the multivariate normal density for the given y and
+ * mu and a sparse precision matrix Q.
+ *
+ * The log determinant of Q comes from a fill-reducing sparse
+ * Cholesky factorization and the quadratic forms from sparse
+ * matrix-vector products, so the cost grows with the number of
+ * non-zeros of Q and its factor rather than with the cube of its
+ * size.  Only the stored entries of Q are parameters.
+ *
+ * @tparam propto Carry out only proportional computations
+ * @tparam T_y Type of the random variable (vector or array of
+ *   vectors)
+ * @tparam T_loc Type of the location (vector or array of vectors)
+ * @tparam T_covar Type of the entries of the precision matrix
+ * @param y A scalar vector or array of vectors
+ * @param mu The mean vector or array of vectors
+ * @param Q The sparse precision matrix
+ * @return The log of the multivariate normal density.
+ * @throw std::domain_error if Q is not symmetric, or (when its log
+ *   determinant is required) not positive definite, if mu is not
+ *   finite or if y contains NaN
+ * @throw std::invalid_argument if the sizes do not match
+ */
+template <bool propto, typename T_y, typename T_loc, typename T_covar>
+typename return_type<T_y, T_loc, T_covar>::type multi_normal_prec_lpdf(
+    const T_y& y, const T_loc& mu, const Eigen::SparseMatrix<T_covar>& Q) {
+  static const char* function = "multi_normal_prec_lpdf";
+  typedef typename return_type<T_y, T_loc, T_covar>::type lp_type;
+  typedef typename return_type<T_y, T_loc>::type T_diff;
+
+  check_positive(function, "Precision matrix rows", Q.rows());
+  check_symmetric(function, "Precision matrix", Q);
+
+  size_t number_of_y = length_mvt(y);
+  size_t number_of_mu = length_mvt(mu);
+  if (number_of_y == 0 || number_of_mu == 0)
+    return 0;
+  check_consistent_sizes_mvt(function, "y", y, "mu", mu);
+
+  lp_type lp(0);
+  vector_seq_view<T_y> y_vec(y);
+  vector_seq_view<T_loc> mu_vec(mu);
+  size_t size_vec = max_size_mvt(y, mu);
+
+  int size_y = y_vec[0].size();
+  for (size_t i = 0; i < size_vec; i++) {
+    check_size_match(function, "Size of random variable", y_vec[i].size(),
+                     "rows of precision parameter", Q.rows());
+    check_size_match(function, "Size of location parameter", mu_vec[i].size(),
+                     "rows of precision parameter", Q.rows());
+    check_finite(function, "Location parameter", mu_vec[i]);
+    check_not_nan(function, "Random variable", y_vec[i]);
+  }
+
+  if (include_summand<propto, T_covar>::value)
+    lp += 0.5 * log_determinant_spd(Q) * size_vec;
+
+  if (include_summand<propto>::value)
+    lp += NEG_LOG_SQRT_TWO_PI * size_y * size_vec;
+
+  if (include_summand<propto, T_y, T_loc, T_covar>::value) {
+    lp_type sum_lp_vec(0.0);
+    for (size_t i = 0; i < size_vec; i++) {
+      Eigen::Matrix<T_diff, Eigen::Dynamic, 1> y_minus_mu(size_y);
+      for (int j = 0; j < size_y; j++)
+        y_minus_mu(j) = y_vec[i](j) - mu_vec[i](j);
+      sum_lp_vec += dot_product(y_minus_mu, multiply(Q, y_minus_mu));
+    }
+    lp -= 0.5 * sum_lp_vec;
+  }
+  return lp;
+}
+
 template <typename T_y, typename T_loc, typename T_covar>
 inline typename return_type<T_y, T_loc, T_covar>::type multi_normal_prec_lpdf(
     const T_y& y, const T_loc& mu, const T_covar& Sigma) {
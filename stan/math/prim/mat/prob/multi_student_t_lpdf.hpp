@@ -6,6 +6,7 @@
 #include <stan/math/prim/mat/err/check_ldlt_factor.hpp>
 #include <stan/math/prim/mat/err/check_symmetric.hpp>
 #include <stan/math/prim/mat/prob/multi_normal_log.hpp>
+#include <stan/math/prim/mat/prob/multi_normal_lpdf.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
 #include <stan/math/prim/scal/err/check_not_nan.hpp>
@@ -22,27 +23,43 @@ namespace math {
 
 /**
  * Return the log of the multivariate Student t distribution
- * at the specified arguments.
+ * at the specified arguments, given an LDLT factorization of the
+ * scale matrix.
+ *
+ * The factorization can be computed once and shared by several
+ * calls, so the scale matrix is factored only once and, in reverse
+ * mode, the adjoint of the factorization is propagated to the scale
+ * matrix only once.
  *
  * @tparam propto Carry out calculations up to a proportion
+ * @tparam T_y Type of the random variable
+ * @tparam T_dof Type of the degrees of freedom
+ * @tparam T_loc Type of the location
+ * @tparam T_scale Scalar type of the scale matrix
+ * @tparam R Rows of the scale matrix
+ * @tparam C Columns of the scale matrix
+ * @param y A vector or array of vectors
+ * @param nu Degrees of freedom
+ * @param mu The location vector or array of location vectors
+ * @param ldlt_Sigma The LDLT factorization of the scale matrix
+ * @return The log of the multivariate Student t density.
  */
 template <bool propto, typename T_y, typename T_dof, typename T_loc,
-          typename T_scale>
+          typename T_scale, int R, int C>
 typename return_type<T_y, T_dof, T_loc, T_scale>::type multi_student_t_lpdf(
-    const T_y& y, const T_dof& nu, const T_loc& mu, const T_scale& Sigma) {
+    const T_y& y, const T_dof& nu, const T_loc& mu,
+    const LDLT_factor<T_scale, R, C>& ldlt_Sigma) {
   static const char* function = "multi_student_t";
   using std::log;
-  typedef typename scalar_type<T_scale>::type T_scale_elem;
   typedef typename return_type<T_y, T_dof, T_loc, T_scale>::type lp_type;
 
   check_not_nan(function, "Degrees of freedom parameter", nu);
   check_positive(function, "Degrees of freedom parameter", nu);
 
   if (is_inf(nu))
-    return multi_normal_log(y, mu, Sigma);
+    return multi_normal_lpdf(y, mu, ldlt_Sigma);
 
-  using Eigen::Matrix;
-  using std::vector;
+  check_ldlt_factor(function, "LDLT_Factor of scale parameter", ldlt_Sigma);
 
   size_t number_of_y = length_mvt(y);
   size_t number_of_mu = length_mvt(mu);
@@ -89,18 +106,12 @@ typename return_type<T_y, T_dof, T_loc, T_scale>::type multi_student_t_lpdf(
   check_size_match(function, "Size of random variable", size_y,
                    "size of location parameter", size_mu);
   check_size_match(function, "Size of random variable", size_y,
-                   "rows of scale parameter", Sigma.rows());
-  check_size_match(function, "Size of random variable", size_y,
-                   "columns of scale parameter", Sigma.cols());
+                   "rows of scale parameter", ldlt_Sigma.rows());
 
   for (size_t i = 0; i < size_vec; i++) {
     check_finite(function, "Location parameter", mu_vec[i]);
     check_not_nan(function, "Random variable", y_vec[i]);
   }
-  check_symmetric(function, "Scale parameter", Sigma);
-
-  LDLT_factor<T_scale_elem, Eigen::Dynamic, Eigen::Dynamic> ldlt_Sigma(Sigma);
-  check_ldlt_factor(function, "LDLT_Factor of scale parameter", ldlt_Sigma);
 
   if (size_y == 0)
     return 0;
@@ -116,13 +127,11 @@ typename return_type<T_y, T_dof, T_loc, T_scale>::type multi_student_t_lpdf(
   if (include_summand<propto>::value)
     lp -= (0.5 * size_y) * LOG_PI * size_vec;
 
-  using Eigen::Array;
-
-  if (include_summand<propto, T_scale_elem>::value) {
+  if (include_summand<propto, T_scale>::value) {
     lp -= 0.5 * log_determinant_ldlt(ldlt_Sigma) * size_vec;
   }
 
-  if (include_summand<propto, T_y, T_dof, T_loc, T_scale_elem>::value) {
+  if (include_summand<propto, T_y, T_dof, T_loc, T_scale>::value) {
     lp_type sum_lp_vec(0.0);
     for (size_t i = 0; i < size_vec; i++) {
       Eigen::Matrix<typename return_type<T_y, T_loc>::type, Eigen::Dynamic, 1>
@@ -137,6 +146,35 @@ typename return_type<T_y, T_dof, T_loc, T_scale>::type multi_student_t_lpdf(
   return lp;
 }
 
+/**
+ * Return the log of the multivariate Student t distribution
+ * at the specified arguments.
+ *
+ * @tparam propto Carry out calculations up to a proportion
+ */
+template <bool propto, typename T_y, typename T_dof, typename T_loc,
+          typename T_scale>
+typename return_type<T_y, T_dof, T_loc, T_scale>::type multi_student_t_lpdf(
+    const T_y& y, const T_dof& nu, const T_loc& mu, const T_scale& Sigma) {
+  static const char* function = "multi_student_t";
+  typedef typename scalar_type<T_scale>::type T_scale_elem;
+
+  check_not_nan(function, "Degrees of freedom parameter", nu);
+  check_positive(function, "Degrees of freedom parameter", nu);
+
+  if (is_inf(nu))
+    return multi_normal_log(y, mu, Sigma);
+
+  size_t number_of_y = length_mvt(y);
+  size_t number_of_mu = length_mvt(mu);
+  if (number_of_y == 0 || number_of_mu == 0)
+    return 0;
+
+  check_symmetric(function, "Scale parameter", Sigma);
+  LDLT_factor<T_scale_elem, Eigen::Dynamic, Eigen::Dynamic> ldlt_Sigma(Sigma);
+  return multi_student_t_lpdf<propto>(y, nu, mu, ldlt_Sigma);
+}
+
 template <typename T_y, typename T_dof, typename T_loc, typename T_scale>
 inline typename return_type<T_y, T_dof, T_loc, T_scale>::type
 multi_student_t_lpdf(const T_y& y, const T_dof& nu, const T_loc& mu,
@@ -144,6 +182,14 @@ multi_student_t_lpdf(const T_y& y, const T_dof& nu, const T_loc& mu,
   return multi_student_t_lpdf<false>(y, nu, mu, Sigma);
 }
 
+template <typename T_y, typename T_dof, typename T_loc, typename T_scale,
+          int R, int C>
+inline typename return_type<T_y, T_dof, T_loc, T_scale>::type
+multi_student_t_lpdf(const T_y& y, const T_dof& nu, const T_loc& mu,
+                     const LDLT_factor<T_scale, R, C>& ldlt_Sigma) {
+  return multi_student_t_lpdf<false>(y, nu, mu, ldlt_Sigma);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
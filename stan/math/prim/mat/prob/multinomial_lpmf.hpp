@@ -3,6 +3,8 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/mat/err/check_simplex.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/value_of_rec.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/scal/err/check_nonnegative.hpp>
 #include <stan/math/prim/scal/fun/multiply_log.hpp>
@@ -13,39 +15,80 @@ namespace stan {
 namespace math {
 // Multinomial(ns|N, theta)   [0 <= n <= N;  SUM ns = N;
 //                            0 <= theta[n] <= 1;  SUM theta = 1]
+//
+// Vectorized over an array of count vectors, with either a single
+// simplex shared by all of them or an array of simplexes.  The
+// partials with respect to theta are n / theta.
 template <bool propto, typename T_prob>
-typename boost::math::tools::promote_args<T_prob>::type multinomial_lpmf(
-    const std::vector<int>& ns,
-    const Eigen::Matrix<T_prob, Eigen::Dynamic, 1>& theta) {
+typename return_type<T_prob>::type multinomial_lpmf(
+    const std::vector<std::vector<int> >& ns, const T_prob& theta) {
   static const char* function = "multinomial_lpmf";
+  typedef typename partials_return_type<T_prob>::type T_partials_return;
+  typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1> T_partials_vec;
 
-  using boost::math::tools::promote_args;
-
-  typename promote_args<T_prob>::type lp(0.0);
-  check_nonnegative(function, "Number of trials variable", ns);
-  check_simplex(function, "Probabilities parameter", theta);
-  check_size_match(function, "Size of number of trials variable", ns.size(),
-                   "rows of probabilities parameter", theta.rows());
-
-  if (include_summand<propto>::value) {
-    double sum = 1.0;
-    for (int n : ns)
-      sum += n;
-    lp += lgamma(sum);
-    for (int n : ns)
-      lp -= lgamma(n + 1.0);
+  vector_seq_view<T_prob> theta_vec(theta);
+  if (theta_vec.size() != 1)
+    check_size_match(function, "Size of number of trials variables",
+                     ns.size(), "size of probabilities parameters",
+                     theta_vec.size());
+  for (size_t t = 0; t < ns.size(); ++t) {
+    check_nonnegative(function, "Number of trials variable", ns[t]);
+    check_size_match(function, "Size of number of trials variable",
+                     ns[t].size(), "rows of probabilities parameter",
+                     theta_vec[t].rows());
   }
-  if (include_summand<propto, T_prob>::value) {
-    for (unsigned int i = 0; i < ns.size(); ++i)
-      lp += multiply_log(ns[i], theta[i]);
+  for (int t = 0; t < theta_vec.size(); ++t)
+    check_simplex(function, "Probabilities parameter",
+                  value_of_rec(theta_vec[t]));
+
+  T_partials_return lp(0.0);
+  operands_and_partials<T_prob> ops_partials(theta);
+
+  T_partials_vec theta_dbl;
+  for (size_t t = 0; t < ns.size(); ++t) {
+    const std::vector<int>& n = ns[t];
+    if (include_summand<propto>::value) {
+      double sum = 1.0;
+      for (int n_i : n)
+        sum += n_i;
+      lp += lgamma(sum);
+      for (int n_i : n)
+        lp -= lgamma(n_i + 1.0);
+    }
+    if (include_summand<propto, T_prob>::value) {
+      if (t == 0 || theta_vec.size() > 1)
+        theta_dbl = value_of(theta_vec[t]);
+      for (size_t i = 0; i < n.size(); ++i)
+        lp += multiply_log(n[i], theta_dbl(i));
+      if (!is_constant_all<T_prob>::value) {
+        T_partials_vec theta_deriv(n.size());
+        for (size_t i = 0; i < n.size(); ++i)
+          theta_deriv(i) = n[i] == 0 ? 0 : n[i] / theta_dbl(i);
+        ops_partials.edge1_.partials_vec_[t] += theta_deriv;
+      }
+    }
   }
-  return lp;
+  return ops_partials.build(lp);
+}
+
+template <bool propto, typename T_prob>
+typename return_type<Eigen::Matrix<T_prob, Eigen::Dynamic, 1> >::type
+multinomial_lpmf(const std::vector<int>& ns,
+                 const Eigen::Matrix<T_prob, Eigen::Dynamic, 1>& theta) {
+  return multinomial_lpmf<propto>(std::vector<std::vector<int> >(1, ns),
+                                  theta);
+}
+
+template <typename T_prob>
+typename return_type<Eigen::Matrix<T_prob, Eigen::Dynamic, 1> >::type
+multinomial_lpmf(const std::vector<int>& ns,
+                 const Eigen::Matrix<T_prob, Eigen::Dynamic, 1>& theta) {
+  return multinomial_lpmf<false>(ns, theta);
 }
 
 template <typename T_prob>
-typename boost::math::tools::promote_args<T_prob>::type multinomial_lpmf(
-    const std::vector<int>& ns,
-    const Eigen::Matrix<T_prob, Eigen::Dynamic, 1>& theta) {
+typename return_type<T_prob>::type multinomial_lpmf(
+    const std::vector<std::vector<int> >& ns, const T_prob& theta) {
   return multinomial_lpmf<false>(ns, theta);
 }
 
@@ -6,10 +6,11 @@
 #include <stan/math/prim/mat/err/check_ldlt_factor.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
 #include <stan/math/prim/scal/err/check_greater.hpp>
+#include <stan/math/prim/scal/fun/digamma.hpp>
 #include <stan/math/prim/scal/fun/lmgamma.hpp>
-#include <stan/math/prim/mat/fun/trace.hpp>
 #include <stan/math/prim/mat/fun/log_determinant_ldlt.hpp>
 #include <stan/math/prim/mat/fun/mdivide_left_ldlt.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
 #include <stan/math/prim/scal/fun/constants.hpp>
 
 namespace stan {
@@ -34,6 +35,10 @@ namespace math {
  -\frac{\nu}{2} \log(\det(S)) + \frac{\nu-k-1}{2}\log (\det(W)) - \frac{1}{2}
  \mbox{tr} (S^{-1}W) \f}
  *
+ * The density and its partials with respect to W, nu and S are
+ * computed in closed form from one LDLT factorization of each
+ * matrix and attached to the result as a single node.
+ *
  * @param W A scalar matrix
  * @param nu Degrees of freedom
  * @param S The scale matrix
@@ -46,57 +51,99 @@ namespace math {
  * @tparam T_scale Type of scale.
  */
 template <bool propto, typename T_y, typename T_dof, typename T_scale>
-typename boost::math::tools::promote_args<T_y, T_dof, T_scale>::type
-wishart_lpdf(const Eigen::Matrix<T_y, Eigen::Dynamic, Eigen::Dynamic>& W,
-             const T_dof& nu,
-             const Eigen::Matrix<T_scale, Eigen::Dynamic, Eigen::Dynamic>& S) {
+typename return_type<T_y, T_dof, T_scale>::type wishart_lpdf(
+    const Eigen::Matrix<T_y, Eigen::Dynamic, Eigen::Dynamic>& W,
+    const T_dof& nu,
+    const Eigen::Matrix<T_scale, Eigen::Dynamic, Eigen::Dynamic>& S) {
   static const char* function = "wishart_lpdf";
+  typedef typename partials_return_type<T_y, T_dof, T_scale>::type T_partials;
+  typedef Eigen::Matrix<T_partials, Eigen::Dynamic, Eigen::Dynamic> matrix_t;
 
   using Eigen::Dynamic;
   using Eigen::Lower;
   using Eigen::Matrix;
-  using boost::math::tools::promote_args;
 
   typename index_type<Matrix<T_scale, Dynamic, Dynamic> >::type k = W.rows();
-  typename promote_args<T_y, T_dof, T_scale>::type lp(0.0);
   check_greater(function, "Degrees of freedom parameter", nu, k - 1);
   check_square(function, "random variable", W);
   check_square(function, "scale parameter", S);
   check_size_match(function, "Rows of random variable", W.rows(),
                    "columns of scale parameter", S.rows());
 
-  LDLT_factor<T_y, Eigen::Dynamic, Eigen::Dynamic> ldlt_W(W);
+  // both matrices are factored once in the partials type and only
+  // their lower triangles are read
+  const matrix_t W_val = value_of(W).template selfadjointView<Lower>();
+  const matrix_t S_val = value_of(S).template selfadjointView<Lower>();
+  LDLT_factor<T_partials, Eigen::Dynamic, Eigen::Dynamic> ldlt_W(W_val);
   check_ldlt_factor(function, "LDLT_Factor of random variable", ldlt_W);
-
-  LDLT_factor<T_scale, Eigen::Dynamic, Eigen::Dynamic> ldlt_S(S);
+  LDLT_factor<T_partials, Eigen::Dynamic, Eigen::Dynamic> ldlt_S(S_val);
   check_ldlt_factor(function, "LDLT_Factor of scale parameter", ldlt_S);
 
-  if (include_summand<propto, T_dof>::value)
-    lp += nu * k * NEG_LOG_TWO_OVER_TWO;
+  operands_and_partials<Matrix<T_y, Dynamic, Dynamic>, T_dof,
+                        Matrix<T_scale, Dynamic, Dynamic> >
+      ops_partials(W, nu, S);
+  const T_partials nu_val = value_of(nu);
+  T_partials lp(0.0);
+  T_partials nu_adj(0.0);
+  matrix_t W_adj = matrix_t::Zero(k, k);
+  matrix_t S_adj = matrix_t::Zero(k, k);
+  const matrix_t identity = matrix_t::Identity(k, k);
+  matrix_t S_inv;
+  if (!is_constant_all<T_y, T_scale>::value)
+    S_inv = mdivide_left_ldlt(ldlt_S, identity);
 
-  if (include_summand<propto, T_dof>::value)
-    lp -= lmgamma(k, 0.5 * nu);
+  if (include_summand<propto, T_dof>::value) {
+    lp += nu_val * k * NEG_LOG_TWO_OVER_TWO;
+    lp -= lmgamma(k, 0.5 * nu_val);
+    if (!is_constant_all<T_dof>::value) {
+      nu_adj += k * NEG_LOG_TWO_OVER_TWO;
+      for (int j = 1; j <= k; ++j)
+        nu_adj -= 0.5 * digamma(0.5 * (nu_val + 1 - j));
+    }
+  }
 
-  if (include_summand<propto, T_dof, T_scale>::value)
-    lp -= 0.5 * nu * log_determinant_ldlt(ldlt_S);
+  if (include_summand<propto, T_dof, T_scale>::value) {
+    const T_partials log_det_S = log_determinant_ldlt(ldlt_S);
+    lp -= 0.5 * nu_val * log_det_S;
+    nu_adj -= 0.5 * log_det_S;
+    if (!is_constant_all<T_scale>::value)
+      S_adj -= 0.5 * nu_val * S_inv;
+  }
 
   if (include_summand<propto, T_scale, T_y>::value) {
-    Matrix<typename promote_args<T_y, T_scale>::type, Dynamic, Dynamic> Sinv_W(
-        mdivide_left_ldlt(ldlt_S, static_cast<Matrix<T_y, Dynamic, Dynamic> >(
-                                      W.template selfadjointView<Lower>())));
-    lp -= 0.5 * trace(Sinv_W);
+    const matrix_t Sinv_W = mdivide_left_ldlt(ldlt_S, W_val);
+    lp -= 0.5 * Sinv_W.trace();
+    if (!is_constant_all<T_y>::value)
+      W_adj -= 0.5 * S_inv;
+    if (!is_constant_all<T_scale>::value) {
+      const matrix_t Sinv_W_Sinv = Sinv_W * S_inv;
+      S_adj += 0.25 * (Sinv_W_Sinv + Sinv_W_Sinv.transpose());
+    }
+  }
+
+  if (include_summand<propto, T_y, T_dof>::value) {
+    const T_partials log_det_W = log_determinant_ldlt(ldlt_W);
+    lp += 0.5 * (nu_val - k - 1.0) * log_det_W;
+    nu_adj += 0.5 * log_det_W;
+    if (!is_constant_all<T_y>::value)
+      W_adj += 0.5 * (nu_val - k - 1.0)
+               * mdivide_left_ldlt(ldlt_W, identity);
   }
 
-  if (include_summand<propto, T_y, T_dof>::value && nu != (k + 1))
-    lp += 0.5 * (nu - k - 1.0) * log_determinant_ldlt(ldlt_W);
-  return lp;
+  if (!is_constant_all<T_y>::value)
+    ops_partials.edge1_.partials_ = W_adj;
+  if (!is_constant_all<T_dof>::value)
+    ops_partials.edge2_.partials_[0] = nu_adj;
+  if (!is_constant_all<T_scale>::value)
+    ops_partials.edge3_.partials_ = S_adj;
+  return ops_partials.build(lp);
 }
 
 template <typename T_y, typename T_dof, typename T_scale>
-inline typename boost::math::tools::promote_args<T_y, T_dof, T_scale>::type
-wishart_lpdf(const Eigen::Matrix<T_y, Eigen::Dynamic, Eigen::Dynamic>& W,
-             const T_dof& nu,
-             const Eigen::Matrix<T_scale, Eigen::Dynamic, Eigen::Dynamic>& S) {
+inline typename return_type<T_y, T_dof, T_scale>::type wishart_lpdf(
+    const Eigen::Matrix<T_y, Eigen::Dynamic, Eigen::Dynamic>& W,
+    const T_dof& nu,
+    const Eigen::Matrix<T_scale, Eigen::Dynamic, Eigen::Dynamic>& S) {
   return wishart_lpdf<false>(W, nu, S);
 }
 
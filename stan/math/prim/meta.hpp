@@ -26,6 +26,7 @@
 
 #include <stan/math/prim/arr/meta/as_scalar.hpp>
 #include <stan/math/prim/arr/meta/contains_std_vector.hpp>
+#include <stan/math/prim/arr/meta/has_ode_jacobian.hpp>
 #include <stan/math/prim/arr/meta/is_constant.hpp>
 #include <stan/math/prim/arr/meta/scalar_type.hpp>
 #include <stan/math/prim/arr/meta/value_type.hpp>
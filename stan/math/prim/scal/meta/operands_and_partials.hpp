@@ -7,9 +7,10 @@
 namespace stan {
 namespace math {
 template <typename Op1 = double, typename Op2 = double, typename Op3 = double,
-          typename Op4 = double, typename Op5 = double,
+          typename Op4 = double, typename Op5 = double, typename Op6 = double,
+          typename Op7 = double,
           typename T_return_type =
-              typename return_type<Op1, Op2, Op3, Op4, Op5>::type>
+              typename return_type<Op1, Op2, Op3, Op4, Op5, Op6, Op7>::type>
 class operands_and_partials;  // Forward declaration
 
 namespace internal {
@@ -41,7 +42,8 @@ class ops_partials_edge {
   explicit ops_partials_edge(const Op& /* op */) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
 
   void dump_partials(ViewElt* /* partials */) const {}  // reverse mode
@@ -72,7 +74,7 @@ class ops_partials_edge {
  *
  * This base template is instantiated when all operands are
  * primitives and we don't want to calculate derivatives at
- * all. So all Op1 - Op5 must be arithmetic primitives
+ * all. So all Op1 - Op7 must be arithmetic primitives
  * like int or double. This is controlled with the
  * T_return_type type parameter.
  *
@@ -81,12 +83,14 @@ class ops_partials_edge {
  * @tparam Op3 type of the third operand
  * @tparam Op4 type of the fourth operand
  * @tparam Op5 type of the fifth operand
+ * @tparam Op6 type of the sixth operand
+ * @tparam Op7 type of the seventh operand
  * @tparam T_return_type return type of the expression. This defaults
  *   to calling a template metaprogram that calculates the scalar
- *   promotion of Op1..Op4
+ *   promotion of Op1..Op7
  */
 template <typename Op1, typename Op2, typename Op3, typename Op4, typename Op5,
-          typename T_return_type>
+          typename Op6, typename Op7, typename T_return_type>
 class operands_and_partials {
  public:
   explicit operands_and_partials(const Op1& /* op1 */) {}
@@ -98,6 +102,13 @@ class operands_and_partials {
   operands_and_partials(const Op1& /* op1 */, const Op2& /* op2 */,
                         const Op3& /* op3 */, const Op4& /* op4 */,
                         const Op5& /* op5 */) {}
+  operands_and_partials(const Op1& /* op1 */, const Op2& /* op2 */,
+                        const Op3& /* op3 */, const Op4& /* op4 */,
+                        const Op5& /* op5 */, const Op6& /* op6 */) {}
+  operands_and_partials(const Op1& /* op1 */, const Op2& /* op2 */,
+                        const Op3& /* op3 */, const Op4& /* op4 */,
+                        const Op5& /* op5 */, const Op6& /* op6 */,
+                        const Op7& /* op7 */) {}
 
   /**
    * Build the node to be stored on the autodiff graph.
@@ -120,6 +131,8 @@ class operands_and_partials {
   internal::ops_partials_edge<double, Op3> edge3_;
   internal::ops_partials_edge<double, Op4> edge4_;
   internal::ops_partials_edge<double, Op5> edge5_;
+  internal::ops_partials_edge<double, Op6> edge6_;
+  internal::ops_partials_edge<double, Op7> edge7_;
 };
 }  // namespace math
 }  // namespace stan
@@ -8,8 +8,12 @@
 #include <stan/math/rev/scal.hpp>
 
 #include <stan/math/rev/arr/fun/log_sum_exp.hpp>
+#include <stan/math/rev/arr/fun/sort_asc.hpp>
+#include <stan/math/rev/arr/fun/sort_desc.hpp>
 #include <stan/math/rev/arr/fun/to_var.hpp>
 #include <stan/math/rev/arr/functor/coupled_ode_system.hpp>
 #include <stan/math/rev/arr/functor/integrate_1d.hpp>
+#include <stan/math/rev/arr/functor/ode_rhs_jacobian.hpp>
+#include <stan/math/rev/arr/functor/ode_store_sensitivities.hpp>
 
 #endif
@@ -0,0 +1,52 @@
+#ifndef STAN_MATH_REV_ARR_FUN_SORT_BY_VALUE_HPP
+#define STAN_MATH_REV_ARR_FUN_SORT_BY_VALUE_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * Reorder a contiguous sequence of vars by their values.
+ *
+ * The values are copied into a contiguous buffer next to their
+ * vari pointers so the comparisons do not chase the vari
+ * pointers, and the sorted vari pointers are written back.  No
+ * varis are created: the sorted vars share the varis of the
+ * input, so adjoints are scattered back through the permutation
+ * without any extra node on the chaining stack.
+ *
+ * @tparam ascending true to sort in ascending order, false for
+ *   descending order
+ * @param xs Pointer to the first var
+ * @param size Number of vars
+ */
+template <bool ascending>
+inline void sort_by_value(var* xs, size_t size) {
+  typedef std::pair<double, vari*> val_vari;
+  std::vector<val_vari> sorted(size);
+  for (size_t i = 0; i < size; ++i)
+    sorted[i] = val_vari(xs[i].vi_->val_, xs[i].vi_);
+  if (ascending)
+    std::sort(sorted.begin(), sorted.end(),
+              [](const val_vari& a, const val_vari& b) {
+                return a.first < b.first;
+              });
+  else
+    std::sort(sorted.begin(), sorted.end(),
+              [](const val_vari& a, const val_vari& b) {
+                return a.first > b.first;
+              });
+  for (size_t i = 0; i < size; ++i)
+    xs[i].vi_ = sorted[i].second;
+}
+}  // namespace internal
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,28 @@
+#ifndef STAN_MATH_REV_ARR_FUN_SORT_DESC_HPP
+#define STAN_MATH_REV_ARR_FUN_SORT_DESC_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/arr/fun/sort_by_value.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the specified standard vector in descending order.
+ *
+ * @param xs Vector to order.
+ * @return Vector in descending order.
+ * @throw std::domain_error If any of the values are NaN.
+ */
+inline std::vector<var> sort_desc(std::vector<var> xs) {
+  check_not_nan("sort_desc", "container argument", xs);
+  internal::sort_by_value<false>(xs.data(), xs.size());
+  return xs;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
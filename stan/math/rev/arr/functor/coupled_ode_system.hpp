@@ -3,6 +3,8 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_system.hpp>
+#include <stan/math/rev/arr/functor/ode_rhs_jacobian.hpp>
+#include <stan/math/rev/arr/functor/ode_store_sensitivities.hpp>
 #include <stan/math/prim/arr/fun/value_of.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/rev/scal/fun/value_of_rec.hpp>
@@ -113,47 +115,10 @@ struct coupled_ode_system<F, double, var> {
    */
   void operator()(const std::vector<double>& z, std::vector<double>& dz_dt,
                   double t) const {
-    using std::vector;
-
-    try {
-      start_nested();
-
-      const vector<var> y_vars(z.begin(), z.begin() + N_);
-
-      vector<var> dy_dt_vars = f_(t, y_vars, theta_nochain_, x_, x_int_, msgs_);
-
-      check_size_match("coupled_ode_system", "dz_dt", dy_dt_vars.size(),
-                       "states", N_);
-
-      for (size_t i = 0; i < N_; i++) {
-        dz_dt[i] = dy_dt_vars[i].val();
-        dy_dt_vars[i].grad();
-
-        for (size_t j = 0; j < M_; j++) {
-          // orders derivatives by equation (i.e. if there are 2 eqns
-          // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as:
-          // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-          double temp_deriv = theta_nochain_[j].adj();
-          const size_t offset = N_ + N_ * j;
-          for (size_t k = 0; k < N_; k++)
-            temp_deriv += z[offset + k] * y_vars[k].adj();
-
-          dz_dt[offset + i] = temp_deriv;
-        }
-
-        set_zero_all_adjoints_nested();
-        // Parameters stored on the outer (non-nested) nochain stack are not
-        // reset to zero by the last call. This is done as a separate step here.
-        // See efficiency note above on template specalization for more details
-        // on this.
-        for (size_t j = 0; j < M_; ++j)
-          theta_nochain_[j].vi_->set_zero_adjoint();
-      }
-    } catch (const std::exception& e) {
-      recover_memory_nested();
-      throw;
-    }
-    recover_memory_nested();
+    std::vector<double> jacobian;
+    ode_rhs_jacobian("coupled_ode_system", f_, t, &z[0], N_, theta_nochain_,
+                     x_, x_int_, msgs_, &dz_dt[0], jacobian);
+    ode_sensitivities_rhs(N_, 0, M_, jacobian, z, dz_dt);
   }
 
   /**
@@ -267,42 +232,10 @@ struct coupled_ode_system<F, var, double> {
    */
   void operator()(const std::vector<double>& z, std::vector<double>& dz_dt,
                   double t) const {
-    using std::vector;
-
-    try {
-      start_nested();
-
-      const vector<var> y_vars(z.begin(), z.begin() + N_);
-
-      vector<var> dy_dt_vars = f_(t, y_vars, theta_dbl_, x_, x_int_, msgs_);
-
-      check_size_match("coupled_ode_system", "dz_dt", dy_dt_vars.size(),
-                       "states", N_);
-
-      for (size_t i = 0; i < N_; i++) {
-        dz_dt[i] = dy_dt_vars[i].val();
-        dy_dt_vars[i].grad();
-
-        for (size_t j = 0; j < N_; j++) {
-          // orders derivatives by equation (i.e. if there are 2 eqns
-          // (y1, y2) and 2 initial conditions (y0_a, y0_b), dy_dt will be
-          // ordered as: dy1_dt, dy2_dt, dy1_d{y0_a}, dy2_d{y0_a}, dy1_d{y0_b},
-          // dy2_d{y0_b}
-          double temp_deriv = 0;
-          const size_t offset = N_ + N_ * j;
-          for (size_t k = 0; k < N_; k++)
-            temp_deriv += z[offset + k] * y_vars[k].adj();
-
-          dz_dt[offset + i] = temp_deriv;
-        }
-
-        set_zero_all_adjoints_nested();
-      }
-    } catch (const std::exception& e) {
-      recover_memory_nested();
-      throw;
-    }
-    recover_memory_nested();
+    std::vector<double> jacobian;
+    ode_rhs_jacobian("coupled_ode_system", f_, t, &z[0], N_, theta_dbl_, x_,
+                     x_int_, msgs_, &dz_dt[0], jacobian);
+    ode_sensitivities_rhs(N_, N_, 0, jacobian, z, dz_dt);
   }
 
   /**
@@ -441,56 +374,10 @@ struct coupled_ode_system<F, var, var> {
    */
   void operator()(const std::vector<double>& z, std::vector<double>& dz_dt,
                   double t) const {
-    using std::vector;
-
-    try {
-      start_nested();
-
-      const vector<var> y_vars(z.begin(), z.begin() + N_);
-
-      vector<var> dy_dt_vars = f_(t, y_vars, theta_nochain_, x_, x_int_, msgs_);
-
-      check_size_match("coupled_ode_system", "dz_dt", dy_dt_vars.size(),
-                       "states", N_);
-
-      for (size_t i = 0; i < N_; i++) {
-        dz_dt[i] = dy_dt_vars[i].val();
-        dy_dt_vars[i].grad();
-
-        for (size_t j = 0; j < N_; j++) {
-          // orders derivatives by equation (i.e. if there are 2 eqns
-          // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as:
-          // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-          double temp_deriv = 0;
-          const size_t offset = N_ + N_ * j;
-          for (size_t k = 0; k < N_; k++)
-            temp_deriv += z[offset + k] * y_vars[k].adj();
-
-          dz_dt[offset + i] = temp_deriv;
-        }
-
-        for (size_t j = 0; j < M_; j++) {
-          double temp_deriv = theta_nochain_[j].adj();
-          const size_t offset = N_ + N_ * N_ + N_ * j;
-          for (size_t k = 0; k < N_; k++)
-            temp_deriv += z[offset + k] * y_vars[k].adj();
-
-          dz_dt[offset + i] = temp_deriv;
-        }
-
-        set_zero_all_adjoints_nested();
-        // Parameters stored on the outer (non-nested) nochain stack are not
-        // reset to zero by the last call. This is done as a separate step here.
-        // See efficiency note above on template specalization for more details
-        // on this.
-        for (size_t j = 0; j < M_; ++j)
-          theta_nochain_[j].vi_->set_zero_adjoint();
-      }
-    } catch (const std::exception& e) {
-      recover_memory_nested();
-      throw;
-    }
-    recover_memory_nested();
+    std::vector<double> jacobian;
+    ode_rhs_jacobian("coupled_ode_system", f_, t, &z[0], N_, theta_nochain_,
+                     x_, x_int_, msgs_, &dz_dt[0], jacobian);
+    ode_sensitivities_rhs(N_, N_, M_, jacobian, z, dz_dt);
   }
 
   /**
@@ -0,0 +1,233 @@
+#ifndef STAN_MATH_REV_ARR_FUNCTOR_ODE_RHS_JACOBIAN_HPP
+#define STAN_MATH_REV_ARR_FUNCTOR_ODE_RHS_JACOBIAN_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/arr/meta/has_ode_jacobian.hpp>
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/rev/scal/fun/value_of.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <algorithm>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * Copy the adjoints of parameters into the Jacobian row and reset
+ * them.  The parameters are allocated on the outer nochain stack so
+ * that their adjoints are not reset by
+ * <code>set_zero_all_adjoints_nested()</code>.
+ */
+inline void ode_theta_adjoints(const std::vector<var>& theta, double adj[]) {
+  for (size_t m = 0; m < theta.size(); ++m) {
+    adj[m] = theta[m].vi_->adj_;
+    theta[m].vi_->set_zero_adjoint();
+  }
+}
+
+inline void ode_theta_adjoints(const std::vector<double>& theta,
+                               double adj[]) {}
+
+/**
+ * Copy an analytic Jacobian given by rows into the rows of the
+ * Jacobian of the coupled system, starting at the specified column.
+ */
+inline void ode_copy_jacobian(const char* function, const char* name,
+                              const std::vector<std::vector<double>>& rows,
+                              size_t N, size_t num_cols, size_t col_offset,
+                              size_t num_rows_cols, double jacobian[]) {
+  check_size_match(function, name, rows.size(), "states", N);
+  for (size_t i = 0; i < N; ++i) {
+    check_size_match(function, name, rows[i].size(), "expected columns",
+                     num_rows_cols);
+    std::copy(rows[i].begin(), rows[i].end(),
+              jacobian + i * num_cols + col_offset);
+  }
+}
+
+template <typename F>
+inline void ode_jacobian_theta(const char* function, const F& f, double t,
+                               const std::vector<double>& y,
+                               const std::vector<double>& theta,
+                               const std::vector<double>& x,
+                               const std::vector<int>& x_int,
+                               std::ostream* msgs,
+                               std::vector<double>& jacobian, std::true_type) {
+  const size_t N = y.size();
+  ode_copy_jacobian(function, "jacobian_theta",
+                    f.jacobian_theta(t, y, theta, x, x_int, msgs), N,
+                    N + theta.size(), N, theta.size(), &jacobian[0]);
+}
+
+template <typename F>
+inline void ode_jacobian_theta(const char* function, const F& f, double t,
+                               const std::vector<double>& y,
+                               const std::vector<double>& theta,
+                               const std::vector<double>& x,
+                               const std::vector<int>& x_int,
+                               std::ostream* msgs,
+                               std::vector<double>& jacobian, std::false_type) {
+}
+
+/**
+ * Evaluate the right hand side and its Jacobian with the analytic
+ * Jacobian provided by the ODE functor.
+ */
+template <typename F, typename T_param>
+inline void ode_rhs_jacobian(const char* function, const F& f, double t,
+                             const double y[], size_t N,
+                             const std::vector<T_param>& theta,
+                             const std::vector<double>& x,
+                             const std::vector<int>& x_int,
+                             std::ostream* msgs, double dy_dt[],
+                             std::vector<double>& jacobian, std::true_type) {
+  const size_t M = is_var<T_param>::value ? theta.size() : 0;
+  const std::vector<double> y_dbl(y, y + N);
+  const std::vector<double> theta_dbl = value_of(theta);
+  jacobian.resize(N * (N + M));
+
+  const std::vector<double> dy_dt_dbl = f(t, y_dbl, theta_dbl, x, x_int, msgs);
+  check_size_match(function, "dz_dt", dy_dt_dbl.size(), "states", N);
+  std::copy(dy_dt_dbl.begin(), dy_dt_dbl.end(), dy_dt);
+
+  ode_copy_jacobian(function, "jacobian_y",
+                    f.jacobian_y(t, y_dbl, theta_dbl, x, x_int, msgs), N,
+                    N + M, 0, N, &jacobian[0]);
+  ode_jacobian_theta(function, f, t, y_dbl, theta_dbl, x, x_int, msgs,
+                     jacobian,
+                     std::integral_constant<bool, is_var<T_param>::value>());
+}
+
+/**
+ * Evaluate the right hand side and its Jacobian by nested reverse
+ * mode autodiff.
+ */
+template <typename F, typename T_param>
+inline void ode_rhs_jacobian(const char* function, const F& f, double t,
+                             const double y[], size_t N,
+                             const std::vector<T_param>& theta,
+                             const std::vector<double>& x,
+                             const std::vector<int>& x_int,
+                             std::ostream* msgs, double dy_dt[],
+                             std::vector<double>& jacobian, std::false_type) {
+  const size_t M = is_var<T_param>::value ? theta.size() : 0;
+  const size_t num_cols = N + M;
+  jacobian.resize(N * num_cols);
+
+  try {
+    start_nested();
+
+    const std::vector<var> y_vars(y, y + N);
+    std::vector<var> dy_dt_vars = f(t, y_vars, theta, x, x_int, msgs);
+    check_size_match(function, "dz_dt", dy_dt_vars.size(), "states", N);
+
+    for (size_t i = 0; i < N; ++i) {
+      dy_dt[i] = dy_dt_vars[i].val();
+      dy_dt_vars[i].grad();
+      double* row = &jacobian[i * num_cols];
+      for (size_t k = 0; k < N; ++k)
+        row[k] = y_vars[k].adj();
+      ode_theta_adjoints(theta, row + N);
+      set_zero_all_adjoints_nested();
+    }
+  } catch (const std::exception& e) {
+    recover_memory_nested();
+    throw;
+  }
+  recover_memory_nested();
+}
+}  // namespace internal
+
+/**
+ * Evaluate the right hand side of an ODE and its Jacobian with
+ * respect to the states and, if they are autodiff variables, the
+ * parameters.  The right hand side is recorded once on a nested
+ * autodiff stack and each row of the Jacobian is read off one reverse
+ * sweep through it.
+ *
+ * If the ODE functor provides its analytic Jacobian with respect to
+ * the states and, whenever the parameters are autodiff variables,
+ * with respect to the parameters, these are used instead of autodiff
+ * (see <code>has_ode_jacobian_y</code> and
+ * <code>has_ode_jacobian_theta</code>).
+ *
+ * The Jacobian is stored row-major with N + M entries per row, the
+ * derivatives with respect to the states first, such that it
+ * multiplies the sensitivities of the coupled state with contiguous
+ * dot products.  M is zero if the parameters are data.
+ *
+ * @tparam F type of ODE system function.
+ * @tparam T_param type of scalars for parameters, either double or
+ * var allocated without chaining.
+ * @param[in] function name of the calling function for error messages
+ * @param[in] f functor for the base ordinary differential equation.
+ * @param[in] t time
+ * @param[in] y states, N elements
+ * @param[in] N number of states
+ * @param[in] theta parameter vector for the ODE.
+ * @param[in] x continuous data vector for the ODE.
+ * @param[in] x_int integer data vector for the ODE.
+ * @param[in, out] msgs the print stream for warning messages.
+ * @param[out] dy_dt right hand side, N elements
+ * @param[out] jacobian Jacobian of the right hand side
+ * @throw std::invalid_argument if the right hand side or the
+ * analytic Jacobians do not have the expected sizes
+ */
+template <typename F, typename T_param>
+inline void ode_rhs_jacobian(const char* function, const F& f, double t,
+                             const double y[], size_t N,
+                             const std::vector<T_param>& theta,
+                             const std::vector<double>& x,
+                             const std::vector<int>& x_int,
+                             std::ostream* msgs, double dy_dt[],
+                             std::vector<double>& jacobian) {
+  typedef std::integral_constant<bool, has_ode_jacobian_y<F>::value
+                                           && (!is_var<T_param>::value
+                                               || has_ode_jacobian_theta<
+                                                   F>::value)>
+      use_analytic_jacobian;
+  internal::ode_rhs_jacobian(function, f, t, y, N, theta, x, x_int, msgs,
+                             dy_dt, jacobian, use_analytic_jacobian());
+}
+
+/**
+ * Calculate the right hand side of the sensitivities of a coupled ODE
+ * system from the Jacobian of the base ODE, that is the product of
+ * the Jacobian with respect to the states with the sensitivities plus
+ * the Jacobian with respect to the parameters.
+ *
+ * @param[in] N number of states
+ * @param[in] num_y0_sens number of sensitivities for the initial
+ * state, either zero or N
+ * @param[in] M number of sensitivities for the parameters
+ * @param[in] jacobian Jacobian as computed by
+ * <code>ode_rhs_jacobian</code>
+ * @param[in] z coupled state
+ * @param[out] dz_dt right hand side of the coupled state, of which
+ * the elements after the first N are written
+ */
+inline void ode_sensitivities_rhs(size_t N, size_t num_y0_sens, size_t M,
+                                  const std::vector<double>& jacobian,
+                                  const std::vector<double>& z,
+                                  std::vector<double>& dz_dt) {
+  const size_t num_cols = N + M;
+  for (size_t s = 0; s < num_y0_sens + M; ++s) {
+    const size_t offset = N + N * s;
+    const double* sens = &z[offset];
+    for (size_t i = 0; i < N; ++i) {
+      const double* row = &jacobian[i * num_cols];
+      double temp_deriv = s < num_y0_sens ? 0 : row[N + s - num_y0_sens];
+      for (size_t k = 0; k < N; ++k)
+        temp_deriv += row[k] * sens[k];
+      dz_dt[offset + i] = temp_deriv;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
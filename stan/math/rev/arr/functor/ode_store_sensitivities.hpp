@@ -0,0 +1,192 @@
+#ifndef STAN_MATH_REV_ARR_FUNCTOR_ODE_STORE_SENSITIVITIES_HPP
+#define STAN_MATH_REV_ARR_FUNCTOR_ODE_STORE_SENSITIVITIES_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/arr/functor/ode_store_sensitivities.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * The vari for the solution of an ODE at all output times, computed
+ * with forward sensitivities.  It is the first entry of the solution
+ * and the remaining entries are allocated without chaining.  The
+ * sensitivities of all entries are stored contiguously, S for each
+ * entry with S the number of varying initial states and parameters,
+ * so that <code>chain()</code> is a single pass over them which
+ * skips entries without adjoint.  The derivative of an entry with
+ * respect to its output time is the ODE right hand side at that
+ * time.
+ */
+class ode_solution_vari : public vari {
+  const size_t num_y_;
+  const size_t num_sens_;
+  const size_t num_ts_;
+  vari** operands_;
+  vari** ts_;
+  vari** y_;
+  double* sens_;
+  double* dy_dt_;
+
+ public:
+  /**
+   * Construct the vari from the coupled states at the output times.
+   *
+   * @param[in] N number of states of the base ODE
+   * @param[in] operands varying initial states followed by varying
+   * parameters, in the order of the coupled ODE system
+   * @param[in] ts varying output times or empty if they are data
+   * @param[in] coupled_states coupled states at the output times,
+   * stacked
+   * @param[in] dy_dt ODE right hand side at the output times,
+   * stacked, only used if ts is not empty
+   */
+  ode_solution_vari(size_t N, const std::vector<vari*>& operands,
+                    const std::vector<vari*>& ts,
+                    const std::vector<double>& coupled_states,
+                    const std::vector<double>& dy_dt)
+      : vari(coupled_states[0]),
+        num_y_(coupled_states.size() / (N + N * operands.size()) * N),
+        num_sens_(operands.size()),
+        num_ts_(ts.size()),
+        operands_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_sens_)),
+        ts_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_ts_)),
+        y_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_y_)),
+        sens_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            num_sens_ * num_y_)),
+        dy_dt_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            num_ts_ > 0 ? num_y_ : 0)) {
+    const size_t coupled_size = N + N * num_sens_;
+    const size_t T = num_y_ / N;
+    std::copy(operands.begin(), operands.end(), operands_);
+    std::copy(ts.begin(), ts.end(), ts_);
+    if (num_ts_ > 0)
+      std::copy(dy_dt.begin(), dy_dt.end(), dy_dt_);
+
+    y_[0] = this;
+    for (size_t n = 0; n < T; ++n) {
+      const double* z = &coupled_states[n * coupled_size];
+      for (size_t i = 0; i < N; ++i) {
+        if (n > 0 || i > 0)
+          y_[n * N + i] = new vari(z[i], false);
+        // the coupled state holds the sensitivities by operand
+        double* sens_i = sens_ + (n * N + i) * num_sens_;
+        for (size_t k = 0; k < num_sens_; ++k)
+          sens_i[k] = z[N + N * k + i];
+      }
+    }
+  }
+
+  /**
+   * Return the vari of the solution at the specified stacked index.
+   */
+  vari* y(size_t i) const { return y_[i]; }
+
+  void chain() {
+    for (size_t j = 0; j < num_y_; ++j) {
+      const double adj = y_[j]->adj_;
+      if (adj == 0)
+        continue;
+      const double* sens_j = sens_ + j * num_sens_;
+      for (size_t k = 0; k < num_sens_; ++k)
+        operands_[k]->adj_ += adj * sens_j[k];
+      if (num_ts_ > 0)
+        ts_[j / (num_y_ / num_ts_)]->adj_ += adj * dy_dt_[j];
+    }
+  }
+};
+
+namespace internal {
+inline void push_varis(const std::vector<var>& x, std::vector<vari*>& varis) {
+  for (const var& x_i : x)
+    varis.push_back(x_i.vi_);
+}
+
+inline void push_varis(const std::vector<double>& x,
+                       std::vector<vari*>& varis) {}
+}  // namespace internal
+
+/**
+ * Store the solution of an ODE and its sensitivities as one
+ * <code>ode_solution_vari</code>.
+ *
+ * @tparam T1 type of scalars for initial values.
+ * @tparam T2 type of scalars for parameters.
+ * @tparam T_ts type of time-points where ODE solution is returned.
+ * @param[in] y0 initial state.
+ * @param[in] theta parameter vector for the ODE.
+ * @param[in] ts times of the solutions.
+ * @param[in] coupled_states coupled states at the output times,
+ * stacked
+ * @param[in] dy_dt ODE right hand side at the output times,
+ * stacked, only used if the times are not data
+ * @param[out] y solution, one vector of states for each time
+ */
+template <typename T1, typename T2, typename T_ts>
+inline void ode_store_sensitivities(const std::vector<T1>& y0,
+                                    const std::vector<T2>& theta,
+                                    const std::vector<T_ts>& ts,
+                                    const std::vector<double>& coupled_states,
+                                    const std::vector<double>& dy_dt,
+                                    std::vector<std::vector<var>>& y) {
+  const size_t N = y0.size();
+  std::vector<vari*> operands;
+  internal::push_varis(y0, operands);
+  internal::push_varis(theta, operands);
+  std::vector<vari*> ts_varis;
+  internal::push_varis(ts, ts_varis);
+
+  ode_solution_vari* vi
+      = new ode_solution_vari(N, operands, ts_varis, coupled_states, dy_dt);
+  y.assign(ts.size(), std::vector<var>(N));
+  for (size_t n = 0; n < ts.size(); ++n)
+    for (size_t i = 0; i < N; ++i)
+      y[n][i] = var(vi->y(n * N + i));
+}
+
+/**
+ * Store the solution of an ODE with events and its sensitivities as
+ * one <code>ode_solution_vari</code>, whose operands are the varying
+ * initial states, increments and parameters in this order.
+ *
+ * @tparam T1 type of scalars for initial values.
+ * @tparam T_event type of scalars for the increments.
+ * @tparam T2 type of scalars for parameters.
+ * @param[in] y0 initial state.
+ * @param[in] increments increments of the events.
+ * @param[in] theta parameter vector for the ODE.
+ * @param[in] num_ts number of output times.
+ * @param[in] coupled_states coupled states at the output times,
+ * stacked
+ * @param[out] y solution, one vector of states for each time
+ */
+template <typename T1, typename T_event, typename T2>
+inline void ode_store_event_sensitivities(
+    const std::vector<T1>& y0,
+    const std::vector<std::vector<T_event>>& increments,
+    const std::vector<T2>& theta, size_t num_ts,
+    const std::vector<double>& coupled_states,
+    std::vector<std::vector<var>>& y) {
+  const size_t N = y0.size();
+  std::vector<vari*> operands;
+  internal::push_varis(y0, operands);
+  for (const std::vector<T_event>& increment : increments)
+    internal::push_varis(increment, operands);
+  internal::push_varis(theta, operands);
+
+  ode_solution_vari* vi
+      = new ode_solution_vari(N, operands, std::vector<vari*>(),
+                              coupled_states, std::vector<double>());
+  y.assign(num_ts, std::vector<var>(N));
+  for (size_t n = 0; n < num_ts; ++n)
+    for (size_t i = 0; i < N; ++i)
+      y[n][i] = var(vi->y(n * N + i));
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
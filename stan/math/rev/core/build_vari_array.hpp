@@ -27,6 +27,21 @@ vari** build_vari_array(const Eigen::Matrix<var, R, C>& x) {
   return x_vi_;
 }
 
+/**
+ * Overload for matrices of doubles, which have no varis to
+ * reference.  Lets varis templated on the scalar type of their
+ * operands treat constant operands uniformly.
+ *
+ * @tparam R Eigen row type of x
+ * @tparam C Eigen column type of x
+ * @param x Input
+ * @return Null pointer
+ */
+template <int R, int C>
+vari** build_vari_array(const Eigen::Matrix<double, R, C>& x) {
+  return nullptr;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -12,15 +12,23 @@
 #include <stan/math/prim/mat.hpp>
 #include <stan/math/rev/arr.hpp>
 
+#include <stan/math/rev/mat/fun/add.hpp>
+#include <stan/math/rev/mat/fun/cholesky_corr_constrain.hpp>
 #include <stan/math/rev/mat/fun/cholesky_decompose.hpp>
 #include <stan/math/rev/mat/fun/columns_dot_product.hpp>
 #include <stan/math/rev/mat/fun/columns_dot_self.hpp>
 #include <stan/math/rev/mat/fun/cov_exp_quad.hpp>
 #include <stan/math/rev/mat/fun/crossprod.hpp>
+#include <stan/math/rev/mat/fun/csr_matrix_times_vector.hpp>
+#include <stan/math/rev/mat/fun/cumulative_sum.hpp>
 #include <stan/math/rev/mat/fun/determinant.hpp>
+#include <stan/math/rev/mat/fun/diag_post_multiply.hpp>
+#include <stan/math/rev/mat/fun/diag_pre_multiply.hpp>
 #include <stan/math/rev/mat/fun/divide.hpp>
 #include <stan/math/rev/mat/fun/dot_product.hpp>
 #include <stan/math/rev/mat/fun/dot_self.hpp>
+#include <stan/math/rev/mat/fun/elt_divide.hpp>
+#include <stan/math/rev/mat/fun/elt_multiply.hpp>
 #include <stan/math/rev/mat/fun/gp_periodic_cov.hpp>
 #include <stan/math/rev/mat/fun/grad.hpp>
 #include <stan/math/rev/mat/fun/initialize_variable.hpp>
@@ -36,19 +44,25 @@
 #include <stan/math/rev/mat/fun/mdivide_left_ldlt.hpp>
 #include <stan/math/rev/mat/fun/mdivide_left_spd.hpp>
 #include <stan/math/rev/mat/fun/mdivide_left_tri.hpp>
+#include <stan/math/rev/mat/fun/mdivide_left_tri_low.hpp>
 #include <stan/math/rev/mat/fun/multiply.hpp>
 #include <stan/math/rev/mat/fun/multiply_lower_tri_self_transpose.hpp>
 #include <stan/math/rev/mat/fun/ordered_constrain.hpp>
 #include <stan/math/rev/mat/fun/positive_ordered_constrain.hpp>
 #include <stan/math/rev/mat/fun/quad_form.hpp>
+#include <stan/math/rev/mat/fun/quad_form_diag.hpp>
 #include <stan/math/rev/mat/fun/quad_form_sym.hpp>
 #include <stan/math/rev/mat/fun/rows_dot_product.hpp>
 #include <stan/math/rev/mat/fun/scale_matrix_exp_multiply.hpp>
 #include <stan/math/rev/mat/fun/sd.hpp>
 #include <stan/math/rev/mat/fun/simplex_constrain.hpp>
 #include <stan/math/rev/mat/fun/softmax.hpp>
+#include <stan/math/rev/mat/fun/sort_asc.hpp>
+#include <stan/math/rev/mat/fun/sort_desc.hpp>
+#include <stan/math/rev/mat/fun/sparse_cholesky_decompose.hpp>
 #include <stan/math/rev/mat/fun/squared_distance.hpp>
 #include <stan/math/rev/mat/fun/stan_print.hpp>
+#include <stan/math/rev/mat/fun/subtract.hpp>
 #include <stan/math/rev/mat/fun/sum.hpp>
 #include <stan/math/rev/mat/fun/tcrossprod.hpp>
 #include <stan/math/rev/mat/fun/to_var.hpp>
@@ -65,8 +79,15 @@
 #include <stan/math/rev/mat/functor/jacobian.hpp>
 #include <stan/math/rev/mat/functor/cvodes_utils.hpp>
 #include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_event_ode_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_linear_solver.hpp>
+#include <stan/math/rev/mat/functor/cvodes_workspace.hpp>
+#include <stan/math/rev/mat/functor/cvodes_adjoint_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_adjoint_integrator.hpp>
 #include <stan/math/rev/mat/functor/integrate_ode_adams.hpp>
 #include <stan/math/rev/mat/functor/integrate_ode_bdf.hpp>
+#include <stan/math/rev/mat/functor/integrate_ode_batch.hpp>
+#include <stan/math/rev/mat/functor/integrate_ode_events.hpp>
 #include <stan/math/rev/mat/functor/integrate_dae.hpp>
 #include <stan/math/rev/mat/functor/map_rect_concurrent.hpp>
 #include <stan/math/rev/mat/functor/map_rect_reduce.hpp>
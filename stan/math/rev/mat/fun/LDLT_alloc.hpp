@@ -16,6 +16,11 @@ namespace math {
  *
  * This class should only be instantiated as part of an LDLT_factor object
  * and is only used in *ldlt_ functions.
+ *
+ * The inverse of the matrix, which the log determinant needs in the
+ * reverse pass, is computed the first time it is requested and kept
+ * with the factorization.  A factor computed once and passed to
+ * several functions therefore forms the inverse at most once.
  **/
 template <int R, int C>
 class LDLT_alloc : public chainable_alloc {
@@ -32,6 +37,7 @@ class LDLT_alloc : public chainable_alloc {
     N_ = A.rows();
     variA_ = A.vi();
     ldlt_.compute(A.val());
+    has_inverse_ = false;
   }
 
   // Compute the log(abs(det(A))).  This is just a convenience function.
@@ -39,9 +45,28 @@ class LDLT_alloc : public chainable_alloc {
     return ldlt_.vectorD().array().log().sum();
   }
 
+  /**
+   * Return the inverse of the factored matrix, solving for it on the
+   * first call after the factorization is computed.
+   *
+   * @return Inverse of the factored matrix
+   **/
+  inline const Eigen::Matrix<double, R, C> &inverse() {
+    if (!has_inverse_) {
+      invA_.setIdentity(N_, N_);
+      ldlt_.solveInPlace(invA_);
+      has_inverse_ = true;
+    }
+    return invA_;
+  }
+
   size_t N_;
   Eigen::LDLT<Eigen::Matrix<double, R, C> > ldlt_;
   Eigen::Matrix<vari *, R, C> variA_;
+
+ private:
+  Eigen::Matrix<double, R, C> invA_;
+  bool has_inverse_ = false;
 };
 }  // namespace math
 }  // namespace stan
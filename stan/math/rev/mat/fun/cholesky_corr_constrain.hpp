@@ -0,0 +1,164 @@
+#ifndef STAN_MATH_REV_MAT_FUN_CHOLESKY_CORR_CONSTRAIN_HPP
+#define STAN_MATH_REV_MAT_FUN_CHOLESKY_CORR_CONSTRAIN_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/cholesky_corr_constrain.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/fun/log1m.hpp>
+#include <stan/math/prim/scal/fun/square.hpp>
+#include <stan/math/rev/mat/functor/adj_jac_apply.hpp>
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+class cholesky_corr_constrain_op {
+  int K_;
+  double* z_;  // canonical partial correlations, tanh of the free values
+
+ public:
+  /**
+   * Return the Cholesky factor of the correlation matrix
+   * corresponding to the specified free vector.  Row i of the
+   * factor is built by stick-breaking the canonical partial
+   * correlations of that row so that it has unit length.
+   *
+   * @tparam size Number of adjoints to return
+   * @param needs_adj Boolean indicators of if adjoints of arguments will be
+   * needed
+   * @param y Free vector of size K choose 2
+   * @param K Number of rows and columns of the result
+   * @return K x K lower triangular Cholesky factor
+   */
+  template <std::size_t size>
+  Eigen::MatrixXd operator()(const std::array<bool, size>& needs_adj,
+                             const Eigen::VectorXd& y, const int& K) {
+    using std::sqrt;
+    using std::tanh;
+    K_ = K;
+    z_ = ChainableStack::instance_->memalloc_.alloc_array<double>(y.size());
+
+    Eigen::MatrixXd x = Eigen::MatrixXd::Zero(K, K);
+    x(0, 0) = 1;
+    int k = 0;
+    for (int i = 1; i < K; ++i) {
+      double sum_sqs = 0;
+      for (int j = 0; j < i; ++j, ++k) {
+        z_[k] = tanh(y(k));
+        x(i, j) = z_[k] * sqrt(1.0 - sum_sqs);
+        sum_sqs += square(x(i, j));
+      }
+      x(i, i) = sqrt(1.0 - sum_sqs);
+    }
+    return x;
+  }
+
+  /*
+   * Compute the result of multiplying the transpose of the adjoint
+   * matrix times the Jacobian of the cholesky_corr_constrain
+   * operator, one row at a time.
+   *
+   * @tparam size Number of adjoints to return
+   * @param needs_adj Boolean indicators of if adjoints of arguments will be
+   * needed
+   * @param adj Eigen::MatrixXd of adjoints at the output of the transform
+   * @return Eigen::VectorXd of adjoints propagated through the transform
+   */
+  template <std::size_t size>
+  auto multiply_adjoint_jacobian(const std::array<bool, size>& needs_adj,
+                                 const Eigen::MatrixXd& adj) const {
+    using std::sqrt;
+    Eigen::VectorXd adj_times_jac((K_ * (K_ - 1)) / 2);
+    // w(j) = sqrt(1 - sum of squares of the first j entries of the row)
+    Eigen::VectorXd w(K_);
+    for (int i = 1; i < K_; ++i) {
+      const double* z = z_ + (i * (i - 1)) / 2;
+      w(0) = 1;
+      for (int j = 0; j < i; ++j)
+        w(j + 1) = w(j) * sqrt(1.0 - square(z[j]));
+
+      // adjoint of the running sum of squares
+      double sum_sqs_adj = -0.5 * adj(i, i) / w(i);
+      for (int j = i - 1; j >= 0; --j) {
+        const double x_adj = adj(i, j) + 2.0 * sum_sqs_adj * z[j] * w(j);
+        if (j > 0)
+          sum_sqs_adj -= 0.5 * x_adj * z[j] / w(j);
+        adj_times_jac((i * (i - 1)) / 2 + j)
+            = x_adj * w(j) * (1.0 - square(z[j]));
+      }
+    }
+    return std::make_tuple(adj_times_jac, 0);
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the Cholesky factor of the correlation matrix of the
+ * specified dimensionality corresponding to the specified free
+ * vector.
+ *
+ * @param y Free vector of size K choose 2
+ * @param K Number of rows and columns of the result
+ * @return K x K Cholesky factor of a correlation matrix
+ * @throw std::invalid_argument if y is not of size K choose 2
+ */
+inline Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic>
+cholesky_corr_constrain(const Eigen::Matrix<var, Eigen::Dynamic, 1>& y,
+                        int K) {
+  check_size_match("cholesky_corr_constrain", "y.size()", y.size(),
+                   "k_choose_2", (K * (K - 1)) / 2);
+  if (K == 0)
+    return Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic>(0, 0);
+  return adj_jac_apply<internal::cholesky_corr_constrain_op>(y, K);
+}
+
+/**
+ * Return the Cholesky factor of the correlation matrix of the
+ * specified dimensionality corresponding to the specified free
+ * vector, incrementing the specified reference with the log
+ * absolute Jacobian determinant of the transform.
+ *
+ * The squared length left in row i after its first j entries is
+ * the product of (1 - z^2) over those entries, so the log Jacobian
+ * is a weighted sum of log1m(z^2) over the canonical partial
+ * correlations z and enters the autodiff stack as one node.
+ *
+ * @param y Free vector of size K choose 2
+ * @param K Number of rows and columns of the result
+ * @param lp Log probability reference to increment
+ * @return K x K Cholesky factor of a correlation matrix
+ * @throw std::invalid_argument if y is not of size K choose 2
+ */
+inline Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic>
+cholesky_corr_constrain(const Eigen::Matrix<var, Eigen::Dynamic, 1>& y, int K,
+                        var& lp) {
+  using std::tanh;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> x
+      = cholesky_corr_constrain(y, K);
+
+  double log_jacobian = 0;
+  std::vector<double> gradients(y.size());
+  int k = 0;
+  for (int i = 1; i < K; ++i) {
+    for (int j = 0; j < i; ++j, ++k) {
+      const double z = tanh(y(k).val());
+      const double weight = 1.0 + 0.5 * (i - 1 - j);
+      log_jacobian += weight * log1m(square(z));
+      gradients[k] = -2.0 * weight * z;
+    }
+  }
+  lp += precomputed_gradients(
+      log_jacobian, std::vector<var>(y.data(), y.data() + y.size()),
+      gradients);
+  return x;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -5,6 +5,7 @@
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/typedefs.hpp>
 #include <stan/math/prim/mat/fun/cholesky_decompose.hpp>
+#include <stan/math/prim/mat/fun/cholesky_tiled.hpp>
 #include <stan/math/rev/scal/fun/value_of_rec.hpp>
 #include <stan/math/rev/scal/fun/value_of.hpp>
 #include <stan/math/rev/core.hpp>
@@ -12,6 +13,9 @@
 #include <stan/math/prim/mat/err/check_pos_definite.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
 #include <stan/math/prim/mat/err/check_symmetric.hpp>
+#include <stan/math/prim/mat/functor/apply_fixed_size.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/err/domain_error.hpp>
 
 #ifdef STAN_OPENCL
 #include <stan/math/opencl/opencl.hpp>
@@ -50,6 +54,7 @@ class cholesky_block : public vari {
  public:
   int M_;
   int block_size_;
+  int num_threads_;
   typedef Eigen::Block<Eigen::MatrixXd> Block_;
   vari** vari_ref_A_;
   vari** vari_ref_L_;
@@ -65,7 +70,9 @@ class cholesky_block : public vari {
    * and computation. Note that varis for L are constructed externally in
    * cholesky_decompose.
    *
-   * block_size_ determined using the same calculation Eigen/LLT.h
+   * block_size_ determined using the same calculation Eigen/LLT.h,
+   * unless the matrix is large enough for the multithreaded
+   * adjoint, which uses the tile size of cholesky_cpu_tuning_opts().
    *
    * @param A matrix
    * @param L_A matrix, cholesky factor of A
@@ -79,8 +86,13 @@ class cholesky_block : public vari {
         vari_ref_L_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
             A.rows() * (A.rows() + 1) / 2)) {
     size_t pos = 0;
-    block_size_ = std::max(M_ / 8, 8);
-    block_size_ = std::min(block_size_, 128);
+    num_threads_ = internal::cholesky_num_threads(M_);
+    if (num_threads_ > 1) {
+      block_size_ = cholesky_cpu_tuning_opts().tile_size;
+    } else {
+      block_size_ = std::max(M_ / 8, 8);
+      block_size_ = std::min(block_size_, 128);
+    }
     for (size_type j = 0; j < M_; ++j) {
       for (size_type i = j; i < M_; ++i) {
         vari_ref_A_[pos] = A.coeffRef(i, j).vi_;
@@ -108,14 +120,101 @@ class cholesky_block : public vari {
     L.triangularView<Upper>().solveInPlace(L_adj.transpose());
   }
 
+  /**
+   * Blocked adjoint over tiles of block_size_ rows and columns run as
+   * a task graph on num_threads_ threads, see
+   * <code>internal::task_graph</code>.  The steps of the blocked
+   * algorithm of <code>chain()</code> become tasks on single tiles of
+   * the adjoints, so the products of one step overlap with the solves
+   * and the symbolic adjoint of the next.
+   *
+   * @param L cholesky factor, its diagonal tiles are overwritten
+   * @param L_adj matrix of adjoints of L, overwritten with the
+   * adjoints of A
+   */
+  inline void chain_tiled(Eigen::MatrixXd& L, Eigen::MatrixXd& L_adj) {
+    using Eigen::Lower;
+    using Eigen::OnTheRight;
+    using Eigen::StrictlyUpper;
+    const int b = block_size_;
+    const int T = (M_ + b - 1) / b;
+    auto L_tile = [&L, b](int i, int j) {
+      return internal::cholesky_tile(L, b, i, j);
+    };
+    auto adj_tile = [&L_adj, b](int i, int j) {
+      return internal::cholesky_tile(L_adj, b, i, j);
+    };
+    // the tiles of L_adj are resources 0 to T * T - 1, followed by
+    // those of L
+    auto adj_id = [T](int i, int j) { return i * T + j; };
+    auto L_id = [T](int i, int j) { return T * T + i * T + j; };
+
+    internal::task_graph graph(2 * T * T);
+    for (int d = T - 1; d >= 0; --d) {
+      for (int i = d + 1; i < T; ++i)
+        graph.add({L_id(d, d)}, {adj_id(i, d)}, [=]() {
+          L_tile(d, d).triangularView<Lower>().solveInPlace<OnTheRight>(
+              adj_tile(i, d));
+          return true;
+        });
+      for (int i = d + 1; i < T; ++i)
+        for (int c = 0; c < d; ++c)
+          graph.add({adj_id(i, d), L_id(d, c)}, {adj_id(i, c)}, [=]() {
+            adj_tile(i, c).noalias() -= adj_tile(i, d) * L_tile(d, c);
+            return true;
+          });
+      std::vector<int> reads;
+      for (int i = d + 1; i < T; ++i) {
+        reads.push_back(adj_id(i, d));
+        reads.push_back(L_id(i, d));
+      }
+      graph.add(reads, {adj_id(d, d), L_id(d, d)}, [=]() {
+        Block_ D = L_tile(d, d);
+        Block_ D_adj = adj_tile(d, d);
+        for (int i = d + 1; i < T; ++i)
+          D_adj.noalias() -= adj_tile(i, d).transpose() * L_tile(i, d);
+        symbolic_rev(D, D_adj);
+        return true;
+      });
+      for (int c = 0; c < d; ++c) {
+        reads.clear();
+        for (int i = d + 1; i < T; ++i) {
+          reads.push_back(adj_id(i, d));
+          reads.push_back(L_id(i, c));
+        }
+        reads.push_back(adj_id(d, d));
+        reads.push_back(L_id(d, c));
+        graph.add(reads, {adj_id(d, c)}, [=]() {
+          Block_ R_adj = adj_tile(d, c);
+          for (int i = d + 1; i < T; ++i)
+            R_adj.noalias() -= adj_tile(i, d).transpose() * L_tile(i, c);
+          R_adj.noalias()
+              -= adj_tile(d, d).selfadjointView<Lower>() * L_tile(d, c);
+          return true;
+        });
+      }
+      graph.add({}, {adj_id(d, d)}, [=]() {
+        Block_ D_adj = adj_tile(d, d);
+        D_adj.diagonal() *= 0.5;
+        D_adj.triangularView<StrictlyUpper>().setZero();
+        return true;
+      });
+    }
+    graph.run(num_threads_);
+  }
+
   /**
    * Reverse mode differentiation algorithm refernce:
    *
    * Iain Murray: Differentiation of the Cholesky decomposition, 2016.
    *
+   * Matrices at or above the size threshold of
+   * cholesky_cpu_tuning_opts() are processed by
+   * <code>chain_tiled()</code> on num_threads_ threads.
    */
   virtual void chain() {
     using Eigen::Block;
+    using Eigen::OnTheRight;
     using Eigen::Lower;
     using Eigen::MatrixXd;
     using Eigen::StrictlyUpper;
@@ -131,29 +230,30 @@ class cholesky_block : public vari {
       }
     }
 
-    for (int k = M_; k > 0; k -= block_size_) {
-      int j = std::max(0, k - block_size_);
-      Block_ R = L.block(j, 0, k - j, j);
-      Block_ D = L.block(j, j, k - j, k - j);
-      Block_ B = L.block(k, 0, M_ - k, j);
-      Block_ C = L.block(k, j, M_ - k, k - j);
-      Block_ R_adj = L_adj.block(j, 0, k - j, j);
-      Block_ D_adj = L_adj.block(j, j, k - j, k - j);
-      Block_ B_adj = L_adj.block(k, 0, M_ - k, j);
-      Block_ C_adj = L_adj.block(k, j, M_ - k, k - j);
-      if (C_adj.size() > 0) {
-        C_adj = D.transpose()
-                    .triangularView<Upper>()
-                    .solve(C_adj.transpose())
-                    .transpose();
-        B_adj.noalias() -= C_adj * R;
-        D_adj.noalias() -= C_adj.transpose() * C;
+    if (num_threads_ > 1) {
+      chain_tiled(L, L_adj);
+    } else {
+      for (int k = M_; k > 0; k -= block_size_) {
+        int j = std::max(0, k - block_size_);
+        Block_ R = L.block(j, 0, k - j, j);
+        Block_ D = L.block(j, j, k - j, k - j);
+        Block_ B = L.block(k, 0, M_ - k, j);
+        Block_ C = L.block(k, j, M_ - k, k - j);
+        Block_ R_adj = L_adj.block(j, 0, k - j, j);
+        Block_ D_adj = L_adj.block(j, j, k - j, k - j);
+        Block_ B_adj = L_adj.block(k, 0, M_ - k, j);
+        Block_ C_adj = L_adj.block(k, j, M_ - k, k - j);
+        if (C_adj.size() > 0) {
+          D.triangularView<Lower>().solveInPlace<OnTheRight>(C_adj);
+          B_adj.noalias() -= C_adj * R;
+          D_adj.noalias() -= C_adj.transpose() * C;
+        }
+        symbolic_rev(D, D_adj);
+        R_adj.noalias() -= C_adj.transpose() * B;
+        R_adj.noalias() -= D_adj.selfadjointView<Lower>() * R;
+        D_adj.diagonal() *= 0.5;
+        D_adj.triangularView<StrictlyUpper>().setZero();
       }
-      symbolic_rev(D, D_adj);
-      R_adj.noalias() -= C_adj.transpose() * B;
-      R_adj.noalias() -= D_adj.selfadjointView<Lower>() * R;
-      D_adj.diagonal() *= 0.5;
-      D_adj.triangularView<StrictlyUpper>().setZero();
     }
     pos = 0;
     for (size_type j = 0; j < M_; ++j)
@@ -403,8 +503,16 @@ inline Eigen::Matrix<var, -1, -1> cholesky_decompose(
   L_A = cholesky_decompose(L_A);
 #else
   check_symmetric("cholesky_decompose", "A", A);
-  Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>, Eigen::Lower> L_factor(L_A);
-  check_pos_definite("cholesky_decompose", "m", L_factor);
+  const int num_threads = internal::cholesky_num_threads(L_A.rows());
+  if (num_threads > 1) {
+    if (!internal::cholesky_tiled_inplace(
+            L_A, cholesky_cpu_tuning_opts().tile_size, num_threads))
+      domain_error("cholesky_decompose", "m", "is not positive definite.",
+                   "");
+  } else {
+    Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>, Eigen::Lower> L_factor(L_A);
+    check_pos_definite("cholesky_decompose", "m", L_factor);
+  }
 #endif
   // Memory allocated in arena.
   // cholesky_scalar gradient faster for small matrices compared to
@@ -444,6 +552,147 @@ inline Eigen::Matrix<var, -1, -1> cholesky_decompose(
 
   return L;
 }
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the Cholesky factors of
+ * a batch of symmetric positive definite matrices of the same
+ * size.
+ *
+ * The values of all factors are stored in one contiguous arena
+ * block.  chain() applies the symbolic adjoint of the blocked
+ * algorithm (Murray, 2016) to each matrix of the batch with
+ * matrices of compile-time size N.
+ *
+ * @tparam N Compile-time size of the matrices or Eigen::Dynamic
+ */
+template <int N>
+class cholesky_batch_vari : public vari {
+ public:
+  typedef Eigen::Matrix<double, N, N> matrix_n;
+  int M_;
+  int size_;
+  double* L_;
+  vari** vari_ref_A_;
+  vari** vari_ref_L_;
+
+  /**
+   * Constructor for the batched Cholesky vari.
+   *
+   * @param A Matrices that were factored
+   * @param L Arena array with the factors of A stacked column-major,
+   *   with zero upper triangles
+   */
+  cholesky_batch_vari(const std::vector<Eigen::Matrix<var, -1, -1> >& A,
+                      double* L)
+      : vari(0.0),
+        M_(A[0].rows()),
+        size_(A.size()),
+        L_(L),
+        vari_ref_A_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            size_ * M_ * M_)),
+        vari_ref_L_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            size_ * M_ * M_)) {
+    const int MM = M_ * M_;
+    vari* dummy = new vari(0.0, false);
+    for (int b = 0; b < size_; ++b) {
+      Eigen::Map<matrix_vi>(vari_ref_A_ + b * MM, M_, M_) = A[b].vi();
+      for (int j = 0; j < M_; ++j) {
+        for (int i = 0; i < M_; ++i) {
+          int pos = b * MM + j * M_ + i;
+          vari_ref_L_[pos] = i >= j ? new vari(L_[pos], false) : dummy;
+        }
+      }
+    }
+  }
+
+  virtual void chain() {
+    using Eigen::Upper;
+    const int MM = M_ * M_;
+    for (int b = 0; b < size_; ++b) {
+      Eigen::Map<const matrix_n> L(L_ + b * MM, M_, M_);
+      matrix_n L_adj = matrix_n::Zero(M_, M_);
+      for (int j = 0; j < M_; ++j)
+        for (int i = j; i < M_; ++i)
+          L_adj.coeffRef(i, j) = vari_ref_L_[b * MM + j * M_ + i]->adj_;
+      matrix_n A_adj = L.transpose() * L_adj;
+      A_adj.template triangularView<Eigen::StrictlyUpper>()
+          = A_adj.transpose().template triangularView<Eigen::StrictlyUpper>();
+      L.transpose().template triangularView<Upper>().solveInPlace(A_adj);
+      L.transpose().template triangularView<Upper>().solveInPlace(
+          A_adj.transpose());
+      for (int j = 0; j < M_; ++j) {
+        vari_ref_A_[b * MM + j * M_ + j]->adj_ += 0.5 * A_adj.coeff(j, j);
+        for (int i = j + 1; i < M_; ++i)
+          vari_ref_A_[b * MM + j * M_ + i]->adj_ += A_adj.coeff(i, j);
+      }
+    }
+  }
+};
+
+/**
+ * Factor each matrix of a batch with fixed-size code and return
+ * the varis of the factors.
+ *
+ * @tparam N Compile-time size of the matrices or Eigen::Dynamic
+ */
+template <int N>
+struct cholesky_batch {
+  static vari** apply(const std::vector<Eigen::Matrix<var, -1, -1> >& A) {
+    typedef Eigen::Matrix<double, N, N> matrix_n;
+    const int M = A[0].rows();
+    double* L = ChainableStack::instance_->memalloc_.alloc_array<double>(
+        A.size() * M * M);
+    for (size_t b = 0; b < A.size(); ++b) {
+      check_symmetric("cholesky_decompose", "A", A[b]);
+      matrix_n A_d = A[b].val();
+      Eigen::LLT<matrix_n> llt(A_d);
+      check_pos_definite("cholesky_decompose", "m", llt);
+      Eigen::Map<matrix_n>(L + b * M * M, M, M) = llt.matrixL();
+    }
+    return (new cholesky_batch_vari<N>(A, L))->vari_ref_L_;
+  }
+};
+}  // namespace internal
+
+/**
+ * Reverse mode specialization of the Cholesky decomposition of a
+ * batch of square matrices of the same size.
+ *
+ * All factors share one vari, and matrices of up to 8 rows are
+ * processed with fixed-size code in both the forward and reverse
+ * pass.
+ *
+ * @param A Array of symmetric, positive definite matrices of the
+ *   same size
+ * @return Array of the Cholesky factors of the matrices
+ * @throw std::invalid_argument if the matrices are not square or
+ *   not all of the same size
+ * @throw std::domain_error if a matrix is not symmetric or not
+ *   positive definite
+ */
+inline std::vector<Eigen::Matrix<var, -1, -1> > cholesky_decompose(
+    const std::vector<Eigen::Matrix<var, -1, -1> >& A) {
+  std::vector<Eigen::Matrix<var, -1, -1> > L(A.size());
+  if (A.empty())
+    return L;
+  const int M = A[0].rows();
+  for (size_t b = 0; b < A.size(); ++b) {
+    check_square("cholesky_decompose", "A", A[b]);
+    check_size_match("cholesky_decompose", "rows of first matrix", M,
+                     "rows of matrix", A[b].rows());
+  }
+  if (M == 0)
+    return L;
+
+  vari** L_vi = internal::apply_fixed_size<internal::cholesky_batch>(M, A);
+  for (size_t b = 0; b < A.size(); ++b) {
+    L[b].resize(M, M);
+    for (int k = 0; k < M * M; ++k)
+      L[b].coeffRef(k).vi_ = L_vi[b * M * M + k];
+  }
+  return L;
+}
 }  // namespace math
 }  // namespace stan
 #endif
@@ -0,0 +1,174 @@
+#ifndef STAN_MATH_REV_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
+#define STAN_MATH_REV_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/csr_structure.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the product of a
+ * sparse matrix in CSR format with a dense vector, where the
+ * values w of the sparse matrix, the vector b, or both are vars.
+ *
+ * The class stores the zero-based CSR structure, the double
+ * values of w and b, and pointers to their varis (when they are
+ * vars) in the arena, and instantiates the varis of the product
+ * on the var_nochain_stack_.  chain() propagates the adjoints
+ * with one pass over the non-zeros, which computes both the
+ * adjoints of w and the transposed sparse product for b.
+ *
+ * @tparam T1 Type of sparse matrix entries
+ * @tparam T2 Type of dense vector entries
+ */
+template <typename T1, typename T2>
+class csr_matrix_times_vector_vari : public vari {
+ public:
+  int m_;
+  int nnz_;
+  int* v_;
+  int* u_;
+  double* w_d_;
+  double* b_d_;
+  vari** w_vi_;
+  vari** b_vi_;
+  vari** res_;
+
+  /**
+   * Constructor for csr_matrix_times_vector_vari.
+   *
+   * All memory allocated in
+   * ChainableStack's stack_alloc arena.
+   *
+   * @param X Validated structure of the sparse matrix
+   * @param w Vector of non-zero values in matrix
+   * @param b Vector which the matrix is multiplied by
+   */
+  csr_matrix_times_vector_vari(const csr_structure& X,
+                               const Eigen::Matrix<T1, Eigen::Dynamic, 1>& w,
+                               const Eigen::Matrix<T2, Eigen::Dynamic, 1>& b)
+      : vari(0.0),
+        m_(X.rows()),
+        nnz_(X.nonzeros()),
+        v_(ChainableStack::instance_->memalloc_.alloc_array<int>(nnz_)),
+        u_(ChainableStack::instance_->memalloc_.alloc_array<int>(m_ + 1)),
+        w_d_(ChainableStack::instance_->memalloc_.alloc_array<double>(nnz_)),
+        b_d_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            b.size())),
+        w_vi_(build_vari_array(w)),
+        b_vi_(build_vari_array(b)),
+        res_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(m_)) {
+    std::copy(X.col_idx().begin(), X.col_idx().end(), v_);
+    std::copy(X.row_start().begin(), X.row_start().end(), u_);
+    Eigen::Map<Eigen::VectorXd>(w_d_, nnz_) = value_of(w);
+    Eigen::Map<Eigen::VectorXd>(b_d_, b.size()) = value_of(b);
+    for (int row = 0; row < m_; ++row) {
+      double sum = 0;
+      for (int nze = u_[row]; nze < u_[row + 1]; ++nze)
+        sum += w_d_[nze] * b_d_[v_[nze]];
+      res_[row] = new vari(sum, false);
+    }
+  }
+
+  virtual void chain() {
+    for (int row = 0; row < m_; ++row) {
+      double adj = res_[row]->adj_;
+      for (int nze = u_[row]; nze < u_[row + 1]; ++nze) {
+        if (is_var<T1>::value)
+          w_vi_[nze]->adj_ += adj * b_d_[v_[nze]];
+        if (is_var<T2>::value)
+          b_vi_[v_[nze]]->adj_ += adj * w_d_[nze];
+      }
+    }
+  }
+};
+}  // namespace internal
+
+/** \addtogroup csr_format
+ *  @{
+ */
+
+/**
+ * Return the multiplication of the sparse matrix with the
+ * specified pre-validated structure and values by the specified
+ * dense vector.  All entries of the result share a single vari
+ * on the chaining stack.
+ *
+ * @tparam T1 Type of sparse matrix entries.
+ * @tparam T2 Type of dense vector entries.
+ * @param X Validated structure of the sparse matrix.
+ * @param w Vector of non-zero values in matrix.
+ * @param b Eigen vector which the matrix is multiplied by.
+ * @return Dense vector for the product.
+ * @throw std::invalid_argument if the size of w does not match
+ *   the structure or the size of b does not match its columns.
+ */
+template <typename T1, typename T2>
+inline typename std::enable_if<is_var<T1>::value || is_var<T2>::value,
+                               Eigen::Matrix<var, Eigen::Dynamic, 1> >::type
+csr_matrix_times_vector(const csr_structure& X,
+                        const Eigen::Matrix<T1, Eigen::Dynamic, 1>& w,
+                        const Eigen::Matrix<T2, Eigen::Dynamic, 1>& b) {
+  check_size_match("csr_matrix_times_vector", "n", X.cols(), "b", b.size());
+  check_size_match("csr_matrix_times_vector", "w", w.size(), "v",
+                   X.nonzeros());
+
+  internal::csr_matrix_times_vector_vari<T1, T2>* baseVari
+      = new internal::csr_matrix_times_vector_vari<T1, T2>(X, w, b);
+  Eigen::Matrix<var, Eigen::Dynamic, 1> result(X.rows());
+  for (int row = 0; row < X.rows(); ++row)
+    result.coeffRef(row).vi_ = baseVari->res_[row];
+  return result;
+}
+
+/**
+ * Return the multiplication of the sparse matrix (specified by
+ * by values and indexing) by the specified dense vector.  All
+ * entries of the result share a single vari on the chaining
+ * stack.
+ *
+ * @tparam T1 Type of sparse matrix entries.
+ * @tparam T2 Type of dense vector entries.
+ * @param m Number of rows in matrix.
+ * @param n Number of columns in matrix.
+ * @param w Vector of non-zero values in matrix.
+ * @param v Column index of each non-zero value, same
+ *          length as w.
+ * @param u Index of where each row starts in w, length equal to
+ *          the number of rows plus one.
+ * @param b Eigen vector which the matrix is multiplied by.
+ * @return Dense vector for the product.
+ * @throw std::domain_error if m and n are not positive or are nan.
+ * @throw std::invalid_argument if m/n/w/v/u are not internally
+ *   consistent or the implied sparse matrix and b are not
+ *   multiplicable.
+ * @throw std::out_of_range if any of the indexes are out of range.
+ */
+template <typename T1, typename T2>
+inline typename std::enable_if<is_var<T1>::value || is_var<T2>::value,
+                               Eigen::Matrix<var, Eigen::Dynamic, 1> >::type
+csr_matrix_times_vector(int m, int n,
+                        const Eigen::Matrix<T1, Eigen::Dynamic, 1>& w,
+                        const std::vector<int>& v, const std::vector<int>& u,
+                        const Eigen::Matrix<T2, Eigen::Dynamic, 1>& b) {
+  check_positive("csr_matrix_times_vector", "m", m);
+  check_positive("csr_matrix_times_vector", "n", n);
+  check_size_match("csr_matrix_times_vector", "n", n, "b", b.size());
+  check_size_match("csr_matrix_times_vector", "w", w.size(), "v", v.size());
+  return csr_matrix_times_vector(csr_structure(m, n, v, u), w, b);
+}
+/** @}*/  // end of csr_format group
+
+}  // namespace math
+}  // namespace stan
+#endif
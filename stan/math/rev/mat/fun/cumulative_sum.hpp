@@ -0,0 +1,105 @@
+#ifndef STAN_MATH_REV_MAT_FUN_CUMULATIVE_SUM_HPP
+#define STAN_MATH_REV_MAT_FUN_CUMULATIVE_SUM_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the cumulative sum
+ * of a sequence of vars.
+ *
+ * The class stores pointers to the varis of the operands and
+ * instantiates the varis of the partial sums on the
+ * var_nochain_stack_.  In chain() the adjoint of each operand is
+ * the suffix sum of the adjoints of the partial sums, computed
+ * in a single backward pass.
+ */
+class cumulative_sum_vari : public vari {
+ public:
+  size_t size_;
+  vari** x_;
+  vari** res_;
+
+  /**
+   * Constructor for cumulative_sum_vari.
+   *
+   * All memory allocated in
+   * ChainableStack's stack_alloc arena.
+   *
+   * @param x Pointer to the contiguous operands
+   * @param size Number of operands
+   */
+  cumulative_sum_vari(const var* x, size_t size)
+      : vari(0.0),
+        size_(size),
+        x_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(size_)),
+        res_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(size_)) {
+    double sum = 0;
+    for (size_t i = 0; i < size_; ++i) {
+      x_[i] = x[i].vi_;
+      sum += x_[i]->val_;
+      res_[i] = new vari(sum, false);
+    }
+  }
+
+  virtual void chain() {
+    double adj_sum = 0;
+    for (size_t i = size_; i-- > 0;) {
+      adj_sum += res_[i]->adj_;
+      x_[i]->adj_ += adj_sum;
+    }
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the cumulative sum of the specified vector.  All
+ * entries of the result share a single vari on the chaining
+ * stack.
+ *
+ * @param x Vector of values.
+ * @return Cumulative sum of values.
+ */
+inline std::vector<var> cumulative_sum(const std::vector<var>& x) {
+  std::vector<var> result(x.size());
+  if (x.size() == 0)
+    return result;
+  internal::cumulative_sum_vari* baseVari
+      = new internal::cumulative_sum_vari(x.data(), x.size());
+  for (size_t i = 0; i < x.size(); ++i)
+    result[i].vi_ = baseVari->res_[i];
+  return result;
+}
+
+/**
+ * Return the cumulative sum of the specified vector, row vector
+ * or matrix, in column-major order.  All entries of the result
+ * share a single vari on the chaining stack.
+ *
+ * @tparam R Row type of matrix.
+ * @tparam C Column type of matrix.
+ * @param m Matrix of values.
+ * @return Cumulative sum of values.
+ */
+template <int R, int C>
+inline Eigen::Matrix<var, R, C> cumulative_sum(
+    const Eigen::Matrix<var, R, C>& m) {
+  Eigen::Matrix<var, R, C> result(m.rows(), m.cols());
+  if (m.size() == 0)
+    return result;
+  internal::cumulative_sum_vari* baseVari
+      = new internal::cumulative_sum_vari(m.data(), m.size());
+  for (int i = 0; i < m.size(); ++i)
+    result.coeffRef(i).vi_ = baseVari->res_[i];
+  return result;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
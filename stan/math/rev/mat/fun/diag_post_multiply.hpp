@@ -0,0 +1,118 @@
+#ifndef STAN_MATH_REV_MAT_FUN_DIAG_POST_MULTIPLY_HPP
+#define STAN_MATH_REV_MAT_FUN_DIAG_POST_MULTIPLY_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/err/check_vector.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for M * diag(v), where
+ * M is an N by K matrix and v is a vector of size K, at least
+ * one of which holds vars.
+ *
+ * The class stores the double values of M and v, pointers to
+ * their varis (when they are vars), and instantiates the varis
+ * of the result on the var_nochain_stack_.
+ *
+ * @tparam Tm Scalar type for matrix M
+ * @tparam Rm Rows for matrix M
+ * @tparam Cm Columns for matrix M
+ * @tparam Tv Scalar type for vector v
+ * @tparam Rv Rows for vector v
+ * @tparam Cv Columns for vector v
+ */
+template <typename Tm, int Rm, int Cm, typename Tv, int Rv, int Cv>
+class diag_post_multiply_vari : public vari {
+ public:
+  int rows_;
+  int cols_;
+  double* Md_;
+  double* vd_;
+  vari** variRefM_;
+  vari** variRefv_;
+  vari** variRefRes_;
+
+  diag_post_multiply_vari(const Eigen::Matrix<Tm, Rm, Cm>& M,
+                          const Eigen::Matrix<Tv, Rv, Cv>& v)
+      : vari(0.0),
+        rows_(M.rows()),
+        cols_(M.cols()),
+        Md_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            M.size())),
+        vd_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            v.size())),
+        variRefM_(build_vari_array(M)),
+        variRefv_(build_vari_array(v)),
+        variRefRes_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            M.size())) {
+    using Eigen::Map;
+    Map<matrix_d> Md(Md_, rows_, cols_);
+    Map<vector_d> vd(vd_, cols_);
+    Md = value_of(M);
+    vd = Map<const vector_d>(value_of(v).data(), cols_);
+    Map<matrix_vi>(variRefRes_, rows_, cols_)
+        = (Md * vd.asDiagonal()).unaryExpr([](double x) {
+            return new vari(x, false);
+          });
+  }
+
+  virtual void chain() {
+    using Eigen::Map;
+    matrix_d adjRes = Map<matrix_vi>(variRefRes_, rows_, cols_).adj();
+    if (is_var<Tm>::value)
+      Map<matrix_vi>(variRefM_, rows_, cols_).adj()
+          += adjRes * Map<vector_d>(vd_, cols_).asDiagonal();
+    if (is_var<Tv>::value)
+      Map<vector_vi>(variRefv_, cols_).adj()
+          += adjRes.cwiseProduct(Map<matrix_d>(Md_, rows_, cols_))
+                 .colwise()
+                 .sum()
+                 .transpose();
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the product of the matrix m1 and the diagonal matrix
+ * formed from the vector m2.  All entries of the result share a
+ * single vari on the chaining stack.
+ *
+ * @tparam T1 Scalar type of the matrix.
+ * @tparam T2 Scalar type of the vector.
+ * @param m1 Matrix.
+ * @param m2 Vector holding the diagonal.
+ * @return m1 * diag(m2)
+ * @throw std::invalid_argument if m2 is not a vector or its size
+ * does not match the number of columns of m1.
+ */
+template <typename T1, typename T2, int R1, int C1, int R2, int C2>
+inline typename std::enable_if<is_var<T1>::value || is_var<T2>::value,
+                               Eigen::Matrix<var, R1, C1> >::type
+diag_post_multiply(const Eigen::Matrix<T1, R1, C1>& m1,
+                   const Eigen::Matrix<T2, R2, C2>& m2) {
+  check_vector("diag_post_multiply", "m2", m2);
+  check_size_match("diag_post_multiply", "m2.size()", m2.size(), "m1.cols()",
+                   m1.cols());
+  Eigen::Matrix<var, R1, C1> res(m1.rows(), m1.cols());
+  if (m1.size() == 0)
+    return res;
+
+  internal::diag_post_multiply_vari<T1, R1, C1, T2, R2, C2>* baseVari
+      = new internal::diag_post_multiply_vari<T1, R1, C1, T2, R2, C2>(m1, m2);
+  res.vi()
+      = Eigen::Map<matrix_vi>(baseVari->variRefRes_, m1.rows(), m1.cols());
+  return res;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,117 @@
+#ifndef STAN_MATH_REV_MAT_FUN_DIAG_PRE_MULTIPLY_HPP
+#define STAN_MATH_REV_MAT_FUN_DIAG_PRE_MULTIPLY_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/err/check_vector.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for diag(v) * M, where
+ * v is a vector of size N and M is an N by K matrix, at least
+ * one of which holds vars.
+ *
+ * The class stores the double values of v and M, pointers to
+ * their varis (when they are vars), and instantiates the varis
+ * of the result on the var_nochain_stack_.
+ *
+ * @tparam Tv Scalar type for vector v
+ * @tparam Rv Rows for vector v
+ * @tparam Cv Columns for vector v
+ * @tparam Tm Scalar type for matrix M
+ * @tparam Rm Rows for matrix M
+ * @tparam Cm Columns for matrix M
+ */
+template <typename Tv, int Rv, int Cv, typename Tm, int Rm, int Cm>
+class diag_pre_multiply_vari : public vari {
+ public:
+  int rows_;
+  int cols_;
+  double* vd_;
+  double* Md_;
+  vari** variRefv_;
+  vari** variRefM_;
+  vari** variRefRes_;
+
+  diag_pre_multiply_vari(const Eigen::Matrix<Tv, Rv, Cv>& v,
+                         const Eigen::Matrix<Tm, Rm, Cm>& M)
+      : vari(0.0),
+        rows_(M.rows()),
+        cols_(M.cols()),
+        vd_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            v.size())),
+        Md_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            M.size())),
+        variRefv_(build_vari_array(v)),
+        variRefM_(build_vari_array(M)),
+        variRefRes_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            M.size())) {
+    using Eigen::Map;
+    Map<vector_d> vd(vd_, rows_);
+    Map<matrix_d> Md(Md_, rows_, cols_);
+    vd = Map<const vector_d>(value_of(v).data(), rows_);
+    Md = value_of(M);
+    Map<matrix_vi>(variRefRes_, rows_, cols_)
+        = (vd.asDiagonal() * Md).unaryExpr([](double x) {
+            return new vari(x, false);
+          });
+  }
+
+  virtual void chain() {
+    using Eigen::Map;
+    matrix_d adjRes = Map<matrix_vi>(variRefRes_, rows_, cols_).adj();
+    if (is_var<Tv>::value)
+      Map<vector_vi>(variRefv_, rows_).adj()
+          += adjRes.cwiseProduct(Map<matrix_d>(Md_, rows_, cols_))
+                 .rowwise()
+                 .sum();
+    if (is_var<Tm>::value)
+      Map<matrix_vi>(variRefM_, rows_, cols_).adj()
+          += Map<vector_d>(vd_, rows_).asDiagonal() * adjRes;
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the product of the diagonal matrix formed from the
+ * vector m1 and the matrix m2.  All entries of the result share
+ * a single vari on the chaining stack.
+ *
+ * @tparam T1 Scalar type of the vector.
+ * @tparam T2 Scalar type of the matrix.
+ * @param m1 Vector holding the diagonal.
+ * @param m2 Matrix.
+ * @return diag(m1) * m2
+ * @throw std::invalid_argument if m1 is not a vector or its size
+ * does not match the number of rows of m2.
+ */
+template <typename T1, typename T2, int R1, int C1, int R2, int C2>
+inline typename std::enable_if<is_var<T1>::value || is_var<T2>::value,
+                               Eigen::Matrix<var, R2, C2> >::type
+diag_pre_multiply(const Eigen::Matrix<T1, R1, C1>& m1,
+                  const Eigen::Matrix<T2, R2, C2>& m2) {
+  check_vector("diag_pre_multiply", "m1", m1);
+  check_size_match("diag_pre_multiply", "m1.size()", m1.size(), "m2.rows()",
+                   m2.rows());
+  Eigen::Matrix<var, R2, C2> res(m2.rows(), m2.cols());
+  if (m2.size() == 0)
+    return res;
+
+  internal::diag_pre_multiply_vari<T1, R1, C1, T2, R2, C2>* baseVari
+      = new internal::diag_pre_multiply_vari<T1, R1, C1, T2, R2, C2>(m1, m2);
+  res.vi()
+      = Eigen::Map<matrix_vi>(baseVari->variRefRes_, m2.rows(), m2.cols());
+  return res;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
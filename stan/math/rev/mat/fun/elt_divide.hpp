@@ -0,0 +1,110 @@
+#ifndef STAN_MATH_REV_MAT_FUN_ELT_DIVIDE_HPP
+#define STAN_MATH_REV_MAT_FUN_ELT_DIVIDE_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/err/check_matching_dims.hpp>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the elementwise
+ * quotient A ./ B of two matrices, at least one of which holds
+ * vars.
+ *
+ * The class stores the double values of B and of the quotient,
+ * pointers to the varis of A and B (when they are vars), and
+ * instantiates the varis of the quotient on the
+ * var_nochain_stack_.
+ *
+ * @tparam Ta Scalar type for matrix A
+ * @tparam Tb Scalar type for matrix B
+ * @tparam R Rows for both matrices
+ * @tparam C Columns for both matrices
+ */
+template <typename Ta, typename Tb, int R, int C>
+class elt_divide_mat_vari : public vari {
+ public:
+  int rows_;
+  int cols_;
+  double* Bd_;
+  double* Cd_;
+  vari** variRefA_;
+  vari** variRefB_;
+  vari** variRefC_;
+
+  elt_divide_mat_vari(const Eigen::Matrix<Ta, R, C>& A,
+                      const Eigen::Matrix<Tb, R, C>& B)
+      : vari(0.0),
+        rows_(A.rows()),
+        cols_(A.cols()),
+        Bd_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            B.size())),
+        Cd_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            A.size())),
+        variRefA_(build_vari_array(A)),
+        variRefB_(build_vari_array(B)),
+        variRefC_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            A.size())) {
+    using Eigen::Map;
+    Map<matrix_d> Bd(Bd_, rows_, cols_);
+    Map<matrix_d> Cd(Cd_, rows_, cols_);
+    Bd = value_of(B);
+    Cd = value_of(A).cwiseQuotient(Bd);
+    Map<matrix_vi>(variRefC_, rows_, cols_)
+        = Cd.unaryExpr([](double x) { return new vari(x, false); });
+  }
+
+  virtual void chain() {
+    using Eigen::Map;
+    matrix_d adj_over_B = Map<matrix_vi>(variRefC_, rows_, cols_)
+                              .adj()
+                              .cwiseQuotient(Map<matrix_d>(Bd_, rows_, cols_));
+    if (is_var<Ta>::value)
+      Map<matrix_vi>(variRefA_, rows_, cols_).adj() += adj_over_B;
+    if (is_var<Tb>::value)
+      Map<matrix_vi>(variRefB_, rows_, cols_).adj()
+          -= adj_over_B.cwiseProduct(Map<matrix_d>(Cd_, rows_, cols_));
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the elementwise division of the specified matrices.
+ * All entries of the result share a single vari on the
+ * chaining stack.
+ *
+ * @tparam Ta Type of scalars in first matrix.
+ * @tparam Tb Type of scalars in second matrix.
+ * @tparam R Row type of both matrices.
+ * @tparam C Column type of both matrices.
+ * @param A First matrix
+ * @param B Second matrix
+ * @return Elementwise quotient of matrices.
+ * @throw std::invalid_argument if A and B do not have the same
+ * dimensions.
+ */
+template <typename Ta, typename Tb, int R, int C>
+inline typename std::enable_if<is_var<Ta>::value || is_var<Tb>::value,
+                               Eigen::Matrix<var, R, C> >::type
+elt_divide(const Eigen::Matrix<Ta, R, C>& A, const Eigen::Matrix<Tb, R, C>& B) {
+  check_matching_dims("elt_divide", "m1", A, "m2", B);
+  Eigen::Matrix<var, R, C> res(A.rows(), A.cols());
+  if (A.size() == 0)
+    return res;
+
+  internal::elt_divide_mat_vari<Ta, Tb, R, C>* baseVari
+      = new internal::elt_divide_mat_vari<Ta, Tb, R, C>(A, B);
+  res.vi() = Eigen::Map<matrix_vi>(baseVari->variRefC_, A.rows(), A.cols());
+  return res;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
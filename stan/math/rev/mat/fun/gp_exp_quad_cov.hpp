@@ -5,6 +5,8 @@
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/scal/err/check_not_nan.hpp>
 #include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/err/check_positive_finite.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/scal/fun/exp.hpp>
 #include <stan/math/prim/scal/fun/squared_distance.hpp>
 #include <stan/math/rev/core.hpp>
@@ -195,6 +197,185 @@ class gp_exp_quad_cov_vari<T_x, double, T_l> : public vari {
   }
 };
 
+/**
+ * This is a subclass of the vari class for precomputed
+ * gradients of gp_exp_quad_cov with automatic relevance
+ * determination, that is, one length scale per input dimension.
+ *
+ * The class stores the per-dimension squared differences for
+ * every pair of inputs as a D x (N * (N - 1) / 2) column-major
+ * array, so that the length scale adjoints are obtained from a
+ * single matrix-vector product in chain().
+ *
+ * @tparam T_x type of the elements of each input vector
+ * @tparam T_sigma type of sigma
+ * @tparam T_l type of each length scale
+ */
+template <typename T_x, typename T_sigma, typename T_l>
+class gp_exp_quad_cov_ard_vari : public vari {
+ public:
+  const size_t size_;
+  const size_t size_ltri_;
+  const size_t dim_;
+  const double sigma_d_;
+  const double sigma_sq_d_;
+  double *l_d_;
+  double *dist_;
+  vari **l_vari_;
+  vari *sigma_vari_;
+  vari **cov_lower_;
+  vari **cov_diag_;
+
+  /**
+   * Constructor for gp_exp_quad_cov with a vector of length scales.
+   *
+   * All memory allocated in
+   * ChainableStack's stack_alloc arena. The covariance varis
+   * are placed on the var_nochain_stack_.
+   *
+   * @param x std::vector of input vectors, each of size D
+   * @param sigma standard deviation
+   * @param length_scale std::vector of D length scales
+   */
+  gp_exp_quad_cov_ard_vari(const std::vector<Eigen::Matrix<T_x, -1, 1>> &x,
+                           const T_sigma &sigma,
+                           const std::vector<T_l> &length_scale)
+      : vari(0.0),
+        size_(x.size()),
+        size_ltri_(size_ * (size_ - 1) / 2),
+        dim_(length_scale.size()),
+        sigma_d_(value_of(sigma)),
+        sigma_sq_d_(sigma_d_ * sigma_d_),
+        l_d_(ChainableStack::instance_->memalloc_.alloc_array<double>(dim_)),
+        dist_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            size_ltri_ * dim_)),
+        l_vari_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari *>(dim_)),
+        sigma_vari_(sigma.vi_),
+        cov_lower_(ChainableStack::instance_->memalloc_.alloc_array<vari *>(
+            size_ltri_)),
+        cov_diag_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari *>(size_)) {
+    Eigen::VectorXd neg_half_inv_l_sq(dim_);
+    for (size_t k = 0; k < dim_; ++k) {
+      l_d_[k] = value_of(length_scale[k]);
+      l_vari_[k] = length_scale[k].vi_;
+      neg_half_inv_l_sq(k) = -0.5 / (l_d_[k] * l_d_[k]);
+    }
+    Eigen::Map<Eigen::MatrixXd> dist(dist_, dim_, size_ltri_);
+    size_t pos = 0;
+    for (size_t j = 0; j < size_ - 1; ++j) {
+      for (size_t i = j + 1; i < size_; ++i) {
+        dist.col(pos) = (x[i] - x[j]).array().square();
+        cov_lower_[pos] = new vari(
+            sigma_sq_d_ * std::exp(dist.col(pos).dot(neg_half_inv_l_sq)),
+            false);
+        ++pos;
+      }
+    }
+    for (size_t i = 0; i < size_; ++i)
+      cov_diag_[i] = new vari(sigma_sq_d_, false);
+  }
+
+  virtual void chain() {
+    Eigen::VectorXd prod(size_ltri_);
+    for (size_t i = 0; i < size_ltri_; ++i)
+      prod(i) = cov_lower_[i]->adj_ * cov_lower_[i]->val_;
+    double adjsigma = prod.sum();
+    for (size_t i = 0; i < size_; ++i)
+      adjsigma += cov_diag_[i]->adj_ * cov_diag_[i]->val_;
+
+    Eigen::VectorXd adjl
+        = Eigen::Map<Eigen::MatrixXd>(dist_, dim_, size_ltri_) * prod;
+    for (size_t k = 0; k < dim_; ++k)
+      l_vari_[k]->adj_ += adjl(k) / (l_d_[k] * l_d_[k] * l_d_[k]);
+    sigma_vari_->adj_ += adjsigma * 2 / sigma_d_;
+  }
+};
+
+/**
+ * This is a subclass of the vari class for precomputed
+ * gradients of gp_exp_quad_cov with automatic relevance
+ * determination and a constant sigma.
+ *
+ * @tparam T_x type of the elements of each input vector
+ * @tparam T_l type of each length scale
+ */
+template <typename T_x, typename T_l>
+class gp_exp_quad_cov_ard_vari<T_x, double, T_l> : public vari {
+ public:
+  const size_t size_;
+  const size_t size_ltri_;
+  const size_t dim_;
+  const double sigma_d_;
+  const double sigma_sq_d_;
+  double *l_d_;
+  double *dist_;
+  vari **l_vari_;
+  vari **cov_lower_;
+  vari **cov_diag_;
+
+  /**
+   * Constructor for gp_exp_quad_cov with a vector of length scales.
+   *
+   * All memory allocated in
+   * ChainableStack's stack_alloc arena. The covariance varis
+   * are placed on the var_nochain_stack_.
+   *
+   * @param x std::vector of input vectors, each of size D
+   * @param sigma standard deviation
+   * @param length_scale std::vector of D length scales
+   */
+  gp_exp_quad_cov_ard_vari(const std::vector<Eigen::Matrix<T_x, -1, 1>> &x,
+                           double sigma, const std::vector<T_l> &length_scale)
+      : vari(0.0),
+        size_(x.size()),
+        size_ltri_(size_ * (size_ - 1) / 2),
+        dim_(length_scale.size()),
+        sigma_d_(sigma),
+        sigma_sq_d_(sigma_d_ * sigma_d_),
+        l_d_(ChainableStack::instance_->memalloc_.alloc_array<double>(dim_)),
+        dist_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            size_ltri_ * dim_)),
+        l_vari_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari *>(dim_)),
+        cov_lower_(ChainableStack::instance_->memalloc_.alloc_array<vari *>(
+            size_ltri_)),
+        cov_diag_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari *>(size_)) {
+    Eigen::VectorXd neg_half_inv_l_sq(dim_);
+    for (size_t k = 0; k < dim_; ++k) {
+      l_d_[k] = value_of(length_scale[k]);
+      l_vari_[k] = length_scale[k].vi_;
+      neg_half_inv_l_sq(k) = -0.5 / (l_d_[k] * l_d_[k]);
+    }
+    Eigen::Map<Eigen::MatrixXd> dist(dist_, dim_, size_ltri_);
+    size_t pos = 0;
+    for (size_t j = 0; j < size_ - 1; ++j) {
+      for (size_t i = j + 1; i < size_; ++i) {
+        dist.col(pos) = (x[i] - x[j]).array().square();
+        cov_lower_[pos] = new vari(
+            sigma_sq_d_ * std::exp(dist.col(pos).dot(neg_half_inv_l_sq)),
+            false);
+        ++pos;
+      }
+    }
+    for (size_t i = 0; i < size_; ++i)
+      cov_diag_[i] = new vari(sigma_sq_d_, false);
+  }
+
+  virtual void chain() {
+    Eigen::VectorXd prod(size_ltri_);
+    for (size_t i = 0; i < size_ltri_; ++i)
+      prod(i) = cov_lower_[i]->adj_ * cov_lower_[i]->val_;
+
+    Eigen::VectorXd adjl
+        = Eigen::Map<Eigen::MatrixXd>(dist_, dim_, size_ltri_) * prod;
+    for (size_t k = 0; k < dim_; ++k)
+      l_vari_[k]->adj_ += adjl(k) / (l_d_[k] * l_d_[k] * l_d_[k]);
+  }
+};
+
 /**
  * Returns a squared exponential kernel.
  *
@@ -281,6 +462,56 @@ gp_exp_quad_cov(const std::vector<T_x> &x, double sigma,
   return cov;
 }
 
+/**
+ * Returns a squared exponential kernel with one length scale
+ * per input dimension (automatic relevance determination).
+ *
+ * @tparam T_sigma type of sigma, either var or double
+ * @param x std::vector of input vectors, each of size D
+ * @param sigma standard deviation
+ * @param length_scale std::vector of D length scales
+ * @return squared exponential covariance matrix
+ * @throw std::domain_error if sigma <= 0, any length scale <= 0,
+ *   or x is nan
+ * @throw std::invalid_argument if the size of the inputs does
+ *   not match the number of length scales
+ */
+template <typename T_sigma>
+inline typename std::enable_if<
+    std::is_same<T_sigma, var>::value || std::is_same<T_sigma, double>::value,
+    Eigen::Matrix<var, -1, -1>>::type
+gp_exp_quad_cov(const std::vector<Eigen::Matrix<double, -1, 1>> &x,
+                const T_sigma &sigma, const std::vector<var> &length_scale) {
+  check_positive_finite("gp_exp_quad_cov", "magnitude", sigma);
+  check_positive_finite("gp_exp_quad_cov", "length scale", length_scale);
+  size_t x_size = x.size();
+  for (size_t i = 0; i < x_size; ++i)
+    check_not_nan("gp_exp_quad_cov", "x", x[i]);
+
+  Eigen::Matrix<var, -1, -1> cov(x_size, x_size);
+  if (x_size == 0)
+    return cov;
+  for (size_t i = 0; i < x_size; ++i)
+    check_size_match("gp_exp_quad_cov", "x dimension", x[i].size(),
+                     "number of length scales", length_scale.size());
+
+  gp_exp_quad_cov_ard_vari<double, T_sigma, var> *baseVari
+      = new gp_exp_quad_cov_ard_vari<double, T_sigma, var>(x, sigma,
+                                                           length_scale);
+
+  size_t pos = 0;
+  for (size_t j = 0; j < x_size - 1; ++j) {
+    for (size_t i = (j + 1); i < x_size; ++i) {
+      cov.coeffRef(i, j).vi_ = baseVari->cov_lower_[pos];
+      cov.coeffRef(j, i).vi_ = cov.coeffRef(i, j).vi_;
+      ++pos;
+    }
+    cov.coeffRef(j, j).vi_ = baseVari->cov_diag_[j];
+  }
+  cov.coeffRef(x_size - 1, x_size - 1).vi_ = baseVari->cov_diag_[x_size - 1];
+  return cov;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -5,7 +5,10 @@
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/typedefs.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/mat/functor/apply_fixed_size.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/rev/core.hpp>
+#include <vector>
 
 namespace stan {
 namespace math {
@@ -32,6 +35,120 @@ inline var log_determinant(const Eigen::Matrix<var, R, C>& m) {
                                             varis, gradients));
 }
 
+namespace internal {
+/**
+ * This is a subclass of the vari class for the log absolute
+ * determinants of a batch of square matrices of the same size.
+ *
+ * The gradients (inverse transposes) of all matrices are computed
+ * in the forward pass and stored in one contiguous arena block;
+ * chain() scales them by the adjoint of each determinant.
+ */
+class log_determinant_batch_vari : public vari {
+ public:
+  int M_;
+  int size_;
+  double* gradients_;
+  vari** variRefA_;
+  vari** variRefDet_;
+
+  /**
+   * Constructor for the batched log determinant vari.
+   *
+   * @param A Matrices
+   * @param log_det Log absolute determinants of A
+   * @param gradients Arena array with the inverse transposes of A
+   *   stacked column-major
+   */
+  log_determinant_batch_vari(const std::vector<Eigen::Matrix<var, -1, -1> >& A,
+                             const std::vector<double>& log_det,
+                             double* gradients)
+      : vari(0.0),
+        M_(A[0].rows()),
+        size_(A.size()),
+        gradients_(gradients),
+        variRefA_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            size_ * M_ * M_)),
+        variRefDet_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari*>(size_)) {
+    for (int n = 0; n < size_; ++n) {
+      Eigen::Map<matrix_vi>(variRefA_ + n * M_ * M_, M_, M_) = A[n].vi();
+      variRefDet_[n] = new vari(log_det[n], false);
+    }
+  }
+
+  virtual void chain() {
+    const int MM = M_ * M_;
+    for (int n = 0; n < size_; ++n) {
+      double adj = variRefDet_[n]->adj_;
+      for (int k = 0; k < MM; ++k)
+        variRefA_[n * MM + k]->adj_ += adj * gradients_[n * MM + k];
+    }
+  }
+};
+
+/**
+ * Decompose each matrix of a batch with fixed-size code and return
+ * the varis of the log determinants.
+ *
+ * @tparam N Compile-time size of the matrices or Eigen::Dynamic
+ */
+template <int N>
+struct log_determinant_batch {
+  static vari** apply(const std::vector<Eigen::Matrix<var, -1, -1> >& A) {
+    typedef Eigen::Matrix<double, N, N> matrix_n;
+    const int M = A[0].rows();
+    double* gradients
+        = ChainableStack::instance_->memalloc_.alloc_array<double>(
+            A.size() * M * M);
+    std::vector<double> log_det(A.size());
+    for (size_t n = 0; n < A.size(); ++n) {
+      matrix_n A_n = A[n].val();
+      Eigen::FullPivHouseholderQR<matrix_n> hh = A_n.fullPivHouseholderQr();
+      log_det[n] = hh.logAbsDeterminant();
+      Eigen::Map<matrix_n>(gradients + n * M * M, M, M)
+          = hh.inverse().transpose();
+    }
+    return (new log_determinant_batch_vari(A, log_det, gradients))
+        ->variRefDet_;
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the log absolute determinants of a batch of square
+ * matrices of the same size.  All results share one vari, and
+ * matrices of up to 8 rows are decomposed with fixed-size code.
+ *
+ * @param A Square matrices of the same size
+ * @return Log absolute determinants of the matrices
+ * @throw std::invalid_argument if the matrices are not square or
+ *   not all of the same size
+ */
+inline std::vector<var> log_determinant(
+    const std::vector<Eigen::Matrix<var, -1, -1> >& A) {
+  std::vector<var> log_det(A.size());
+  if (A.empty())
+    return log_det;
+  const int M = A[0].rows();
+  for (size_t n = 0; n < A.size(); ++n) {
+    check_square("log_determinant", "m", A[n]);
+    check_size_match("log_determinant", "rows of first matrix", M,
+                     "rows of matrix", A[n].rows());
+  }
+  if (M == 0) {
+    for (size_t n = 0; n < A.size(); ++n)
+      log_det[n] = 0;
+    return log_det;
+  }
+
+  vari** det_vi
+      = internal::apply_fixed_size<internal::log_determinant_batch>(M, A);
+  for (size_t n = 0; n < A.size(); ++n)
+    log_det[n].vi_ = det_vi[n];
+  return log_det;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
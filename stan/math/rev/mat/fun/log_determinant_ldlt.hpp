@@ -27,19 +27,17 @@ class log_det_ldlt_vari : public vari {
       : vari(A.alloc_->log_abs_det()), alloc_ldlt_(A.alloc_) {}
 
   virtual void chain() {
-    Eigen::Matrix<double, R, C> invA;
-
-    // If we start computing Jacobians, this may be a bit inefficient
-    invA.setIdentity(alloc_ldlt_->N_, alloc_ldlt_->N_);
-    alloc_ldlt_->ldlt_.solveInPlace(invA);
-    const_cast<matrix_vi &>(alloc_ldlt_->variA_).adj() += adj_ * invA;
+    // the inverse is formed once per factorization and shared by all
+    // log determinants of it
+    const_cast<matrix_vi &>(alloc_ldlt_->variA_).adj()
+        += adj_ * const_cast<LDLT_alloc<R, C> *>(alloc_ldlt_)->inverse();
   }
   const LDLT_alloc<R, C> *alloc_ldlt_;
 };
 }  // namespace internal
 
 template <int R, int C>
-var log_determinant_ldlt(LDLT_factor<var, R, C> &A) {
+var log_determinant_ldlt(const LDLT_factor<var, R, C> &A) {
   return var(new internal::log_det_ldlt_vari<R, C>(A));
 }
 
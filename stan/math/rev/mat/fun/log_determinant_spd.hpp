@@ -7,6 +7,11 @@
 #include <stan/math/prim/mat/err/check_square.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/log_determinant_spd.hpp>
+#include <stan/math/prim/mat/fun/sparse_llt_cache.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/err/check_symmetric.hpp>
+#include <algorithm>
 #include <stan/math/rev/core.hpp>
 
 namespace stan {
@@ -52,6 +57,62 @@ inline var log_determinant_spd(const Eigen::Matrix<var, R, C>& m) {
       new precomputed_gradients_vari(val, m.size(), operands, gradients));
 }
 
+/**
+ * Returns the log determinant of the specified symmetric, positive
+ * definite sparse matrix.
+ *
+ * The matrix is factored with a fill-reducing (AMD) sparse
+ * Cholesky decomposition whose symbolic analysis is reused while
+ * the sparsity pattern does not change.  The gradient with respect
+ * to each stored entry is the matching entry of the inverse, which
+ * is only needed on the pattern of the factor and is computed with
+ * the Takahashi recursion instead of a dense inverse.
+ *
+ * @param m Specified sparse matrix.
+ * @return log determinant of the matrix.
+ * @throw std::invalid_argument if matrix is not square.
+ * @throw std::domain_error if matrix is not symmetric or not
+ *   positive definite.
+ */
+inline var log_determinant_spd(const Eigen::SparseMatrix<var>& m) {
+  static const char* function = "log_determinant_spd";
+  check_symmetric(function, "m", m);
+  if (m.rows() == 0)
+    return 0;
+
+  Eigen::SparseMatrix<double> m_d = value_of(m);
+  m_d.makeCompressed();
+  const auto& llt
+      = internal::cached_sparse_llt<Eigen::AMDOrdering<int> >(m_d);
+  if (llt.info() != Eigen::Success)
+    domain_error(function, "m", "is not positive definite.", "");
+  Eigen::SparseMatrix<double> L = llt.matrixL();
+
+  double val = 2 * L.diagonal().array().log().sum();
+  check_finite(function, "log determininant of the matrix argument", val);
+
+  // m^-1 on the pattern of the factor of P * m * P^T
+  Eigen::SparseMatrix<double> Z = internal::sparse_selected_inverse(L);
+  const auto& perm = llt.permutationP().indices();
+
+  int nnz = m.nonZeros();
+  vari** operands
+      = ChainableStack::instance_->memalloc_.alloc_array<vari*>(nnz);
+  double* gradients
+      = ChainableStack::instance_->memalloc_.alloc_array<double>(nnz);
+  int t = 0;
+  for (int k = 0; k < m.outerSize(); ++k) {
+    for (Eigen::SparseMatrix<var>::InnerIterator it(m, k); it; ++it, ++t) {
+      int r = perm.size() ? perm(it.row()) : it.row();
+      int c = perm.size() ? perm(it.col()) : it.col();
+      operands[t] = it.value().vi_;
+      gradients[t] = Z.coeff(std::max(r, c), std::min(r, c));
+    }
+  }
+
+  return var(new precomputed_gradients_vari(val, nnz, operands, gradients));
+}
+
 }  // namespace math
 
 }  // namespace stan
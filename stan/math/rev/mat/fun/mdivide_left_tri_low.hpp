@@ -0,0 +1,185 @@
+#ifndef STAN_MATH_REV_MAT_FUN_MDIVIDE_LEFT_TRI_LOW_HPP
+#define STAN_MATH_REV_MAT_FUN_MDIVIDE_LEFT_TRI_LOW_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/mdivide_left_tri_low.hpp>
+#include <stan/math/prim/mat/err/check_multiplicable.hpp>
+#include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/mat/functor/apply_fixed_size.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the solutions of a
+ * batch of lower triangular systems <code>L[i] * x[i] = b[i]</code>
+ * where all L[i] are of the same size and all b[i] have the same
+ * number of columns.
+ *
+ * The values of all operands and solutions are stored in
+ * contiguous arena blocks and chain() runs the adjoint of each
+ * solve with triangular matrices of compile-time size N.
+ *
+ * @tparam N Compile-time size of the triangular matrices or
+ *   Eigen::Dynamic
+ */
+template <int N>
+class mdivide_left_tri_low_batch_vari : public vari {
+ public:
+  typedef Eigen::Matrix<double, N, N> matrix_n;
+  typedef Eigen::Matrix<double, N, Eigen::Dynamic> matrix_nk;
+  int M_;
+  int K_;
+  int size_;
+  double* L_;
+  double* x_;
+  vari** variRefL_;
+  vari** variRefB_;
+  vari** variRefX_;
+
+  /**
+   * Constructor for the batched triangular solve vari.
+   *
+   * @param L Lower triangular matrices
+   * @param b Right hand sides, as their varis stacked column-major
+   * @param K Number of columns of each right hand side
+   * @param L_d Arena array with the values of L stacked column-major
+   * @param x_d Arena array with the solutions stacked column-major
+   */
+  mdivide_left_tri_low_batch_vari(
+      const std::vector<Eigen::Matrix<var, -1, -1> >& L, vari** b, int K,
+      double* L_d, double* x_d)
+      : vari(0.0),
+        M_(L[0].rows()),
+        K_(K),
+        size_(L.size()),
+        L_(L_d),
+        x_(x_d),
+        variRefL_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            size_ * M_ * M_)),
+        variRefB_(b),
+        variRefX_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            size_ * M_ * K_)) {
+    for (int n = 0; n < size_; ++n)
+      Eigen::Map<matrix_vi>(variRefL_ + n * M_ * M_, M_, M_) = L[n].vi();
+    for (int k = 0; k < size_ * M_ * K_; ++k)
+      variRefX_[k] = new vari(x_[k], false);
+  }
+
+  virtual void chain() {
+    const int MM = M_ * M_;
+    const int MK = M_ * K_;
+    for (int n = 0; n < size_; ++n) {
+      Eigen::Map<const matrix_n> L(L_ + n * MM, M_, M_);
+      Eigen::Map<const matrix_nk> x(x_ + n * MK, M_, K_);
+      matrix_nk b_adj(M_, K_);
+      for (int k = 0; k < MK; ++k)
+        b_adj.coeffRef(k) = variRefX_[n * MK + k]->adj_;
+      L.transpose().template triangularView<Eigen::Upper>().solveInPlace(
+          b_adj);
+      matrix_n L_adj = b_adj * x.transpose();
+      for (int k = 0; k < MK; ++k)
+        variRefB_[n * MK + k]->adj_ += b_adj.coeff(k);
+      for (int j = 0; j < M_; ++j)
+        for (int i = j; i < M_; ++i)
+          variRefL_[n * MM + j * M_ + i]->adj_ -= L_adj.coeff(i, j);
+    }
+  }
+};
+
+/**
+ * Solve each system of a batch with fixed-size code and return the
+ * varis of the solutions.
+ *
+ * @tparam N Compile-time size of the matrices or Eigen::Dynamic
+ */
+template <int N>
+struct mdivide_left_tri_low_batch {
+  template <int R, int C>
+  static vari** apply(const std::vector<Eigen::Matrix<var, -1, -1> >& L,
+                      const std::vector<Eigen::Matrix<var, R, C> >& b) {
+    typedef Eigen::Matrix<double, N, N> matrix_n;
+    typedef Eigen::Matrix<double, N, Eigen::Dynamic> matrix_nk;
+    const int M = L[0].rows();
+    const int K = b[0].cols();
+    double* L_d = ChainableStack::instance_->memalloc_.alloc_array<double>(
+        L.size() * M * M);
+    double* x_d = ChainableStack::instance_->memalloc_.alloc_array<double>(
+        L.size() * M * K);
+    vari** b_vi = ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+        L.size() * M * K);
+    for (size_t n = 0; n < L.size(); ++n) {
+      Eigen::Map<matrix_n> L_n(L_d + n * M * M, M, M);
+      L_n = L[n].val();
+      Eigen::Map<matrix_nk> x_n(x_d + n * M * K, M, K);
+      x_n = L_n.template triangularView<Eigen::Lower>().solve(b[n].val());
+      for (int k = 0; k < M * K; ++k)
+        b_vi[n * M * K + k] = b[n].coeff(k).vi_;
+    }
+    return (new mdivide_left_tri_low_batch_vari<N>(L, b_vi, K, L_d, x_d))
+        ->variRefX_;
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the solutions of a batch of lower triangular systems
+ * <code>L[i] * x[i] = b[i]</code>.  Only the lower triangles of
+ * the L[i] are used.
+ *
+ * All solutions share one vari, and systems of up to 8 rows are
+ * solved with fixed-size code in both the forward and reverse
+ * pass.
+ *
+ * @tparam R Rows of the right hand sides
+ * @tparam C Columns of the right hand sides
+ * @param L Lower triangular matrices of the same size
+ * @param b Right hand sides with as many rows as the L have
+ *   columns and the same number of columns
+ * @return Solutions of the systems
+ * @throw std::invalid_argument if the arrays are of different
+ *   sizes, a matrix of L is not square, or the sizes of the
+ *   matrices differ within the batch or do not match
+ */
+template <int R, int C>
+inline std::vector<Eigen::Matrix<var, R, C> > mdivide_left_tri_low(
+    const std::vector<Eigen::Matrix<var, -1, -1> >& L,
+    const std::vector<Eigen::Matrix<var, R, C> >& b) {
+  static const char* function = "mdivide_left_tri_low";
+  check_size_match(function, "size of L", L.size(), "size of b", b.size());
+  std::vector<Eigen::Matrix<var, R, C> > x(b.size());
+  if (L.empty())
+    return x;
+  const int M = L[0].rows();
+  const int K = b[0].cols();
+  for (size_t n = 0; n < L.size(); ++n) {
+    check_square(function, "L", L[n]);
+    check_multiplicable(function, "L", L[n], "b", b[n]);
+    check_size_match(function, "rows of first matrix", M, "rows of matrix",
+                     L[n].rows());
+    check_size_match(function, "columns of first right hand side", K,
+                     "columns of right hand side", b[n].cols());
+  }
+  if (M == 0 || K == 0)
+    return b;
+
+  vari** x_vi
+      = internal::apply_fixed_size<internal::mdivide_left_tri_low_batch>(M, L,
+                                                                        b);
+  for (size_t n = 0; n < b.size(); ++n) {
+    x[n].resize(M, K);
+    for (int k = 0; k < M * K; ++k)
+      x[n].coeffRef(k).vi_ = x_vi[n * M * K + k];
+  }
+  return x;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -7,8 +7,12 @@
 #include <stan/math/rev/core.hpp>
 #include <stan/math/prim/mat/err/check_multiplicable.hpp>
 #include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/functor/apply_fixed_size.hpp>
 #include <boost/math/tools/promotion.hpp>
 #include <type_traits>
+#include <vector>
 
 namespace stan {
 namespace math {
@@ -462,6 +466,215 @@ class multiply_mat_vari<Ta, 1, Ca, double, 1> : public vari {
   }
 };
 
+/**
+ * This is a subclass of the vari class for the product of a
+ * sparse matrix and a dense column vector, where the entries of
+ * the matrix, the vector, or both are vars.
+ *
+ * The class stores the compressed column structure of the matrix,
+ * the double values of both operands, and pointers to their varis
+ * (when they are vars) in the arena, and instantiates the varis of
+ * the product on the var_nochain_stack_.  chain() makes one pass
+ * over the non-zeros.
+ *
+ * @tparam Ta Scalar type of the sparse matrix
+ * @tparam Tb Scalar type of the vector
+ */
+template <typename Ta, typename Tb>
+class multiply_sparse_vari : public vari {
+ public:
+  int rows_;
+  int cols_;
+  int nnz_;
+  int* col_start_;
+  int* row_idx_;
+  double* Ad_;
+  double* Bd_;
+  vari** variRefA_;
+  vari** variRefB_;
+  vari** variRefAB_;
+
+  /**
+   * Constructor for multiply_sparse_vari.
+   *
+   * All memory allocated in
+   * ChainableStack's stack_alloc arena.
+   *
+   * @param A sparse matrix
+   * @param B column vector
+   */
+  multiply_sparse_vari(const Eigen::SparseMatrix<Ta>& A,
+                       const Eigen::Matrix<Tb, Eigen::Dynamic, 1>& B)
+      : vari(0.0),
+        rows_(A.rows()),
+        cols_(A.cols()),
+        nnz_(A.nonZeros()),
+        col_start_(
+            ChainableStack::instance_->memalloc_.alloc_array<int>(cols_ + 1)),
+        row_idx_(ChainableStack::instance_->memalloc_.alloc_array<int>(nnz_)),
+        Ad_(ChainableStack::instance_->memalloc_.alloc_array<double>(nnz_)),
+        Bd_(ChainableStack::instance_->memalloc_.alloc_array<double>(cols_)),
+        variRefB_(build_vari_array(B)),
+        variRefAB_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari*>(rows_)) {
+    Eigen::Map<vector_d>(Bd_, cols_) = value_of(B);
+    Eigen::Matrix<Ta, Eigen::Dynamic, 1> A_values(nnz_);
+    Eigen::VectorXd AB = Eigen::VectorXd::Zero(rows_);
+    int nze = 0;
+    for (int col = 0; col < cols_; ++col) {
+      col_start_[col] = nze;
+      for (typename Eigen::SparseMatrix<Ta>::InnerIterator it(A, col); it;
+           ++it, ++nze) {
+        row_idx_[nze] = it.row();
+        A_values(nze) = it.value();
+        Ad_[nze] = value_of(it.value());
+        AB(it.row()) += Ad_[nze] * Bd_[col];
+      }
+    }
+    col_start_[cols_] = nze;
+    variRefA_ = build_vari_array(A_values);
+    for (int row = 0; row < rows_; ++row)
+      variRefAB_[row] = new vari(AB(row), false);
+  }
+
+  virtual void chain() {
+    for (int col = 0; col < cols_; ++col) {
+      double adjB = 0;
+      for (int nze = col_start_[col]; nze < col_start_[col + 1]; ++nze) {
+        double adjAB = variRefAB_[row_idx_[nze]]->adj_;
+        if (is_var<Ta>::value)
+          variRefA_[nze]->adj_ += adjAB * Bd_[col];
+        adjB += adjAB * Ad_[nze];
+      }
+      if (is_var<Tb>::value)
+        variRefB_[col]->adj_ += adjB;
+    }
+  }
+};
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the products
+ * <code>A[i] * B[i]</code> of a batch of matrices of vars, where
+ * all A[i] have the same size and all B[i] have the same size.
+ *
+ * The values of all operands are stored in contiguous arena
+ * blocks and chain() runs the adjoint of each product with left
+ * factors of compile-time size N (when they are square).
+ *
+ * @tparam N Compile-time size of the square left factors or
+ *   Eigen::Dynamic
+ */
+template <int N>
+class multiply_batch_vari : public vari {
+ public:
+  typedef Eigen::Matrix<double, N, N> matrix_a;
+  typedef Eigen::Matrix<double, N, Eigen::Dynamic> matrix_ab;
+  int rows_;
+  int inner_;
+  int cols_;
+  int size_;
+  double* Ad_;
+  double* Bd_;
+  vari** variRefA_;
+  vari** variRefB_;
+  vari** variRefAB_;
+
+  /**
+   * Constructor for the batched product vari.
+   *
+   * @param A Left factors
+   * @param B Right factors, as their varis stacked column-major
+   * @param inner Rows of each right factor
+   * @param cols Columns of each right factor
+   * @param Ad Arena array with the values of A stacked column-major
+   * @param Bd Arena array with the values of B stacked column-major
+   * @param ABd Values of the products stacked column-major
+   */
+  multiply_batch_vari(const std::vector<Eigen::Matrix<var, -1, -1> >& A,
+                      vari** B, int inner, int cols, double* Ad, double* Bd,
+                      const double* ABd)
+      : vari(0.0),
+        rows_(A[0].rows()),
+        inner_(inner),
+        cols_(cols),
+        size_(A.size()),
+        Ad_(Ad),
+        Bd_(Bd),
+        variRefA_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            size_ * rows_ * inner_)),
+        variRefB_(B),
+        variRefAB_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            size_ * rows_ * cols_)) {
+    for (int n = 0; n < size_; ++n)
+      Eigen::Map<matrix_vi>(variRefA_ + n * rows_ * inner_, rows_, inner_)
+          = A[n].vi();
+    for (int k = 0; k < size_ * rows_ * cols_; ++k)
+      variRefAB_[k] = new vari(ABd[k], false);
+  }
+
+  virtual void chain() {
+    const int size_a = rows_ * inner_;
+    const int size_b = inner_ * cols_;
+    const int size_ab = rows_ * cols_;
+    for (int n = 0; n < size_; ++n) {
+      Eigen::Map<const matrix_a> A(Ad_ + n * size_a, rows_, inner_);
+      Eigen::Map<const matrix_d> B(Bd_ + n * size_b, inner_, cols_);
+      matrix_ab AB_adj(rows_, cols_);
+      for (int k = 0; k < size_ab; ++k)
+        AB_adj.coeffRef(k) = variRefAB_[n * size_ab + k]->adj_;
+      matrix_a A_adj = AB_adj * B.transpose();
+      matrix_d B_adj = A.transpose() * AB_adj;
+      for (int k = 0; k < size_a; ++k)
+        variRefA_[n * size_a + k]->adj_ += A_adj.coeff(k);
+      for (int k = 0; k < size_b; ++k)
+        variRefB_[n * size_b + k]->adj_ += B_adj.coeff(k);
+    }
+  }
+};
+
+/**
+ * Multiply each pair of a batch with fixed-size code and return
+ * the varis of the products.
+ *
+ * @tparam N Compile-time size of the square left factors or
+ *   Eigen::Dynamic
+ */
+template <int N>
+struct multiply_batch {
+  template <int R, int C>
+  static vari** apply(const std::vector<Eigen::Matrix<var, -1, -1> >& A,
+                      const std::vector<Eigen::Matrix<var, R, C> >& B) {
+    typedef Eigen::Matrix<double, N, N> matrix_a;
+    typedef Eigen::Matrix<double, N, Eigen::Dynamic> matrix_ab;
+    const int rows = A[0].rows();
+    const int inner = A[0].cols();
+    const int cols = B[0].cols();
+    const size_t size = A.size();
+    double* Ad = ChainableStack::instance_->memalloc_.alloc_array<double>(
+        size * rows * inner);
+    double* Bd = ChainableStack::instance_->memalloc_.alloc_array<double>(
+        size * inner * cols);
+    vari** B_vi = ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+        size * inner * cols);
+    std::vector<double> ABd(size * rows * cols);
+    for (size_t n = 0; n < size; ++n) {
+      Eigen::Map<matrix_a> A_n(Ad + n * rows * inner, rows, inner);
+      A_n = A[n].val();
+      Eigen::Map<matrix_d> B_n(Bd + n * inner * cols, inner, cols);
+      B_n = B[n].val();
+      Eigen::Map<matrix_ab>(ABd.data() + n * rows * cols, rows, cols)
+          = A_n * B_n;
+      for (int k = 0; k < inner * cols; ++k)
+        B_vi[n * inner * cols + k] = B[n].coeff(k).vi_;
+    }
+    return (new multiply_batch_vari<N>(A, B_vi, inner, cols, Ad, Bd,
+                                       ABd.data()))
+        ->variRefAB_;
+  }
+};
+}  // namespace internal
+
 /**
  * Return the product of two scalars.
  * @tparam T1 scalar type of v
@@ -572,6 +785,81 @@ multiply(const Eigen::Matrix<Ta, 1, Ca>& A, const Eigen::Matrix<Tb, Ca, 1>& B) {
   AB_v.vi_ = baseVari->variRefAB_;
   return AB_v;
 }
+
+/**
+ * Return the products <code>A[i] * B[i]</code> of a batch of
+ * matrices.  All products share one vari, and square left factors
+ * of up to 8 rows are handled with fixed-size code in both the
+ * forward and reverse pass.
+ * @tparam R Rows of the right factors
+ * @tparam C Columns of the right factors
+ * @param[in] A Left factors, all of the same size
+ * @param[in] B Right factors, all of the same size
+ * @return Products of the matrices
+ * @throw std::invalid_argument if the arrays are of different
+ *   sizes, a matrix has zero size, or the sizes of the matrices
+ *   differ within the batch or are not multiplicable
+ */
+template <int R, int C>
+inline std::vector<Eigen::Matrix<var, -1, C> > multiply(
+    const std::vector<Eigen::Matrix<var, -1, -1> >& A,
+    const std::vector<Eigen::Matrix<var, R, C> >& B) {
+  check_size_match("multiply", "size of A", A.size(), "size of B", B.size());
+  std::vector<Eigen::Matrix<var, -1, C> > AB(A.size());
+  if (A.empty())
+    return AB;
+  const int rows = A[0].rows();
+  const int inner = A[0].cols();
+  const int cols = B[0].cols();
+  for (size_t n = 0; n < A.size(); ++n) {
+    check_multiplicable("multiply", "A", A[n], "B", B[n]);
+    check_size_match("multiply", "rows of first matrix", rows,
+                     "rows of matrix", A[n].rows());
+    check_size_match("multiply", "columns of first matrix", inner,
+                     "columns of matrix", A[n].cols());
+    check_size_match("multiply", "columns of first matrix", cols,
+                     "columns of matrix", B[n].cols());
+    check_not_nan("multiply", "A", A[n]);
+    check_not_nan("multiply", "B", B[n]);
+  }
+  vari** AB_vi = internal::apply_fixed_size<internal::multiply_batch>(
+      rows == inner ? rows : Eigen::Dynamic, A, B);
+  for (size_t n = 0; n < A.size(); ++n) {
+    AB[n].resize(rows, cols);
+    for (int k = 0; k < rows * cols; ++k)
+      AB[n].coeffRef(k).vi_ = AB_vi[n * rows * cols + k];
+  }
+  return AB;
+}
+
+/**
+ * Return the product of a sparse matrix and a vector.  All
+ * entries of the product share a single vari on the chaining
+ * stack.
+ * @tparam Ta scalar type sparse matrix A
+ * @tparam Tb scalar type vector B
+ * @param[in] A Sparse matrix
+ * @param[in] B Column vector
+ * @return Dense product of sparse matrix and vector
+ */
+template <typename Ta, typename Tb>
+inline typename std::enable_if<std::is_same<Ta, var>::value
+                                   || std::is_same<Tb, var>::value,
+                               Eigen::Matrix<var, Eigen::Dynamic, 1> >::type
+multiply(const Eigen::SparseMatrix<Ta>& A,
+         const Eigen::Matrix<Tb, Eigen::Dynamic, 1>& B) {
+  check_size_match("multiply", "Columns of A", A.cols(), "Rows of B",
+                   B.rows());
+  check_not_nan("multiply", "B", B);
+
+  // Memory managed with the arena allocator.
+  multiply_sparse_vari<Ta, Tb>* baseVari
+      = new multiply_sparse_vari<Ta, Tb>(A, B);
+  Eigen::Matrix<var, Eigen::Dynamic, 1> AB_v(A.rows());
+  for (int i = 0; i < A.rows(); ++i)
+    AB_v.coeffRef(i).vi_ = baseVari->variRefAB_[i];
+  return AB_v;
+}
 }  // namespace math
 }  // namespace stan
 #endif
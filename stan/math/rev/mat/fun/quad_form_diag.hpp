@@ -0,0 +1,115 @@
+#ifndef STAN_MATH_REV_MAT_FUN_QUAD_FORM_DIAG_HPP
+#define STAN_MATH_REV_MAT_FUN_QUAD_FORM_DIAG_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/mat/err/check_vector.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for diag(v) * M * diag(v),
+ * where M is a square N by N matrix and v a vector of size N, at
+ * least one of which holds vars.
+ *
+ * The class stores the double values of M and v, pointers to
+ * their varis (when they are vars), and instantiates the varis
+ * of the result on the var_nochain_stack_.
+ *
+ * @tparam Tm Scalar type for matrix M
+ * @tparam Tv Scalar type for vector v
+ * @tparam R Rows for vector v
+ * @tparam C Columns for vector v
+ */
+template <typename Tm, typename Tv, int R, int C>
+class quad_form_diag_vari : public vari {
+ public:
+  int size_;
+  double* Md_;
+  double* vd_;
+  vari** variRefM_;
+  vari** variRefv_;
+  vari** variRefRes_;
+
+  quad_form_diag_vari(const Eigen::Matrix<Tm, -1, -1>& M,
+                      const Eigen::Matrix<Tv, R, C>& v)
+      : vari(0.0),
+        size_(M.rows()),
+        Md_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            M.size())),
+        vd_(ChainableStack::instance_->memalloc_.alloc_array<double>(
+            v.size())),
+        variRefM_(build_vari_array(M)),
+        variRefv_(build_vari_array(v)),
+        variRefRes_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            M.size())) {
+    using Eigen::Map;
+    Map<matrix_d> Md(Md_, size_, size_);
+    Map<vector_d> vd(vd_, size_);
+    Md = value_of(M);
+    vd = Map<const vector_d>(value_of(v).data(), size_);
+    Map<matrix_vi>(variRefRes_, size_, size_)
+        = (vd.asDiagonal() * Md * vd.asDiagonal())
+              .unaryExpr([](double x) { return new vari(x, false); });
+  }
+
+  virtual void chain() {
+    using Eigen::Map;
+    matrix_d adjRes = Map<matrix_vi>(variRefRes_, size_, size_).adj();
+    Map<vector_d> vd(vd_, size_);
+    if (is_var<Tm>::value)
+      Map<matrix_vi>(variRefM_, size_, size_).adj()
+          += vd.asDiagonal() * adjRes * vd.asDiagonal();
+    if (is_var<Tv>::value) {
+      matrix_d adj_M = adjRes.cwiseProduct(Map<matrix_d>(Md_, size_, size_));
+      Map<vector_vi>(variRefv_, size_).adj()
+          += adj_M * vd + adj_M.transpose() * vd;
+    }
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the quadratic form diag(vec) * mat * diag(vec).  All
+ * entries of the result share a single vari on the chaining
+ * stack.
+ *
+ * @tparam T1 Scalar type of the matrix.
+ * @tparam T2 Scalar type of the vector.
+ * @param mat Square matrix.
+ * @param vec Vector.
+ * @return diag(vec) * mat * diag(vec)
+ * @throw std::invalid_argument if mat is not square, vec is not a
+ * vector, or their sizes do not match.
+ */
+template <typename T1, typename T2, int R, int C>
+inline typename std::enable_if<is_var<T1>::value || is_var<T2>::value,
+                               Eigen::Matrix<var, -1, -1> >::type
+quad_form_diag(const Eigen::Matrix<T1, -1, -1>& mat,
+               const Eigen::Matrix<T2, R, C>& vec) {
+  check_vector("quad_form_diag", "vec", vec);
+  check_square("quad_form_diag", "mat", mat);
+  check_size_match("quad_form_diag", "rows of mat", mat.rows(), "size of vec",
+                   vec.size());
+  Eigen::Matrix<var, -1, -1> res(mat.rows(), mat.cols());
+  if (mat.size() == 0)
+    return res;
+
+  internal::quad_form_diag_vari<T1, T2, R, C>* baseVari
+      = new internal::quad_form_diag_vari<T1, T2, R, C>(mat, vec);
+  res.vi()
+      = Eigen::Map<matrix_vi>(baseVari->variRefRes_, mat.rows(), mat.cols());
+  return res;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,31 @@
+#ifndef STAN_MATH_REV_MAT_FUN_SORT_ASC_HPP
+#define STAN_MATH_REV_MAT_FUN_SORT_ASC_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/arr/fun/sort_by_value.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the specified vector in ascending order.
+ *
+ * @tparam R Row type of the vector.
+ * @tparam C Column type of the vector.
+ * @param xs Vector to order.
+ * @return Vector in ascending order.
+ * @throw std::domain_error If any of the values are NaN.
+ */
+template <int R, int C>
+inline Eigen::Matrix<var, R, C> sort_asc(Eigen::Matrix<var, R, C> xs) {
+  check_not_nan("sort_asc", "container argument", xs);
+  internal::sort_by_value<true>(xs.data(), xs.size());
+  return xs;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,31 @@
+#ifndef STAN_MATH_REV_MAT_FUN_SORT_DESC_HPP
+#define STAN_MATH_REV_MAT_FUN_SORT_DESC_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/arr/fun/sort_by_value.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the specified vector in descending order.
+ *
+ * @tparam R Row type of the vector.
+ * @tparam C Column type of the vector.
+ * @param xs Vector to order.
+ * @return Vector in descending order.
+ * @throw std::domain_error If any of the values are NaN.
+ */
+template <int R, int C>
+inline Eigen::Matrix<var, R, C> sort_desc(Eigen::Matrix<var, R, C> xs) {
+  check_not_nan("sort_desc", "container argument", xs);
+  internal::sort_by_value<false>(xs.data(), xs.size());
+  return xs;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,198 @@
+#ifndef STAN_MATH_REV_MAT_FUN_SPARSE_CHOLESKY_DECOMPOSE_HPP
+#define STAN_MATH_REV_MAT_FUN_SPARSE_CHOLESKY_DECOMPOSE_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/sparse_llt_cache.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/err/check_symmetric.hpp>
+#include <stan/math/prim/scal/err/domain_error.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the sparse Cholesky
+ * factor of a sparse symmetric positive definite matrix of vars.
+ *
+ * The factor's compressed column structure and values are kept in
+ * the arena together with a row-wise view of the same structure.
+ * chain() runs the scalar reverse-mode Cholesky algorithm of
+ * Giles (2008) restricted to the sparsity pattern of the factor:
+ * the adjoints of entries outside of the pattern only ever flow
+ * into other entries outside of it, so they are never formed.
+ * The adjoints of the lower triangle of the input are accumulated,
+ * as in the dense <code>cholesky_decompose</code>.
+ */
+class sparse_cholesky_vari : public vari {
+ public:
+  int M_;
+  int nnz_L_;
+  int nnz_A_;
+  int* col_start_;
+  int* row_idx_;
+  int* row_start_;
+  int* row_col_;
+  int* row_pos_;
+  double* L_;
+  vari** vari_ref_L_;
+  vari** vari_ref_A_;
+  int* A_pos_;
+
+  /**
+   * Constructor for the sparse Cholesky vari.
+   *
+   * @param A Sparse matrix of vars that was factored
+   * @param L Compressed lower triangular Cholesky factor of the
+   *   values of A with the same (natural) row ordering
+   */
+  sparse_cholesky_vari(const Eigen::SparseMatrix<var>& A,
+                       const Eigen::SparseMatrix<double>& L)
+      : vari(0.0),
+        M_(L.rows()),
+        nnz_L_(L.nonZeros()),
+        nnz_A_(0),
+        col_start_(
+            ChainableStack::instance_->memalloc_.alloc_array<int>(M_ + 1)),
+        row_idx_(ChainableStack::instance_->memalloc_.alloc_array<int>(nnz_L_)),
+        row_start_(
+            ChainableStack::instance_->memalloc_.alloc_array<int>(M_ + 1)),
+        row_col_(ChainableStack::instance_->memalloc_.alloc_array<int>(nnz_L_)),
+        row_pos_(ChainableStack::instance_->memalloc_.alloc_array<int>(nnz_L_)),
+        L_(ChainableStack::instance_->memalloc_.alloc_array<double>(nnz_L_)),
+        vari_ref_L_(
+            ChainableStack::instance_->memalloc_.alloc_array<vari*>(nnz_L_)) {
+    std::copy(L.outerIndexPtr(), L.outerIndexPtr() + M_ + 1, col_start_);
+    std::copy(L.innerIndexPtr(), L.innerIndexPtr() + nnz_L_, row_idx_);
+    std::copy(L.valuePtr(), L.valuePtr() + nnz_L_, L_);
+    for (int p = 0; p < nnz_L_; ++p)
+      vari_ref_L_[p] = new vari(L_[p], false);
+
+    // row-wise view; columns within each row end up sorted
+    std::fill(row_start_, row_start_ + M_ + 1, 0);
+    for (int p = 0; p < nnz_L_; ++p)
+      ++row_start_[row_idx_[p] + 1];
+    for (int i = 0; i < M_; ++i)
+      row_start_[i + 1] += row_start_[i];
+    std::vector<int> next(row_start_, row_start_ + M_);
+    for (int j = 0; j < M_; ++j) {
+      for (int p = col_start_[j]; p < col_start_[j + 1]; ++p) {
+        int q = next[row_idx_[p]]++;
+        row_col_[q] = j;
+        row_pos_[q] = p;
+      }
+    }
+
+    for (int k = 0; k < A.outerSize(); ++k)
+      for (Eigen::SparseMatrix<var>::InnerIterator it(A, k); it; ++it)
+        if (it.row() >= it.col())
+          ++nnz_A_;
+    vari_ref_A_
+        = ChainableStack::instance_->memalloc_.alloc_array<vari*>(nnz_A_);
+    A_pos_ = ChainableStack::instance_->memalloc_.alloc_array<int>(nnz_A_);
+    int t = 0;
+    for (int k = 0; k < A.outerSize(); ++k) {
+      for (Eigen::SparseMatrix<var>::InnerIterator it(A, k); it; ++it) {
+        if (it.row() < it.col())
+          continue;
+        vari_ref_A_[t] = it.value().vi_;
+        A_pos_[t] = std::lower_bound(row_idx_ + col_start_[it.col()],
+                                     row_idx_ + col_start_[it.col() + 1],
+                                     it.row())
+                    - row_idx_;
+        ++t;
+      }
+    }
+  }
+
+  virtual void chain() {
+    std::vector<double> adjL(nnz_L_);
+    std::vector<double> adjA(nnz_L_);
+    for (int p = 0; p < nnz_L_; ++p)
+      adjL[p] = vari_ref_L_[p]->adj_;
+
+    for (int i = M_ - 1; i >= 0; --i) {
+      for (int q = row_start_[i + 1] - 1; q >= row_start_[i]; --q) {
+        int j = row_col_[q];
+        int p = row_pos_[q];
+        int p_jj = col_start_[j];
+        if (i == j) {
+          adjA[p] = 0.5 * adjL[p] / L_[p];
+        } else {
+          adjA[p] = adjL[p] / L_[p_jj];
+          adjL[p_jj] -= adjL[p] * L_[p] / L_[p_jj];
+        }
+        // columns k < j shared by rows i and j
+        int qi = row_start_[i];
+        int qj = row_start_[j];
+        int qj_end = row_start_[j + 1] - 1;
+        while (qi < q && qj < qj_end) {
+          if (row_col_[qi] < row_col_[qj]) {
+            ++qi;
+          } else if (row_col_[qj] < row_col_[qi]) {
+            ++qj;
+          } else {
+            int p_ik = row_pos_[qi++];
+            int p_jk = row_pos_[qj++];
+            adjL[p_ik] -= adjA[p] * L_[p_jk];
+            adjL[p_jk] -= adjA[p] * L_[p_ik];
+          }
+        }
+      }
+    }
+    for (int t = 0; t < nnz_A_; ++t)
+      vari_ref_A_[t]->adj_ += adjA[A_pos_[t]];
+  }
+};
+}  // namespace internal
+
+/**
+ * Reverse mode specialization of the sparse Cholesky
+ * decomposition.
+ *
+ * The symbolic analysis of the sparsity pattern is reused across
+ * calls while the pattern does not change, and all entries of the
+ * factor share a single vari whose chain() only touches the
+ * pattern of the factor.
+ *
+ * @param A Symmetric sparse matrix.
+ * @return Lower triangular sparse Cholesky factor of A.
+ * @throw std::invalid_argument if A is not square.
+ * @throw std::domain_error if A is not symmetric or not positive
+ *   definite.
+ */
+inline Eigen::SparseMatrix<var> sparse_cholesky_decompose(
+    const Eigen::SparseMatrix<var>& A) {
+  static const char* function = "sparse_cholesky_decompose";
+  check_symmetric(function, "A", A);
+  if (A.rows() == 0)
+    return Eigen::SparseMatrix<var>(0, 0);
+
+  Eigen::SparseMatrix<double> A_d = value_of(A);
+  A_d.makeCompressed();
+  const auto& llt
+      = internal::cached_sparse_llt<Eigen::NaturalOrdering<int> >(A_d);
+  if (llt.info() != Eigen::Success)
+    domain_error(function, "A", "is not positive definite.", "");
+  Eigen::SparseMatrix<double> L_d = llt.matrixL();
+
+  internal::sparse_cholesky_vari* baseVari
+      = new internal::sparse_cholesky_vari(A, L_d);
+  Eigen::SparseMatrix<var> L(L_d.rows(), L_d.cols());
+  L.resizeNonZeros(L_d.nonZeros());
+  std::copy(L_d.outerIndexPtr(), L_d.outerIndexPtr() + L_d.outerSize() + 1,
+            L.outerIndexPtr());
+  std::copy(L_d.innerIndexPtr(), L_d.innerIndexPtr() + L_d.nonZeros(),
+            L.innerIndexPtr());
+  for (int p = 0; p < L_d.nonZeros(); ++p)
+    L.valuePtr()[p].vi_ = baseVari->vari_ref_L_[p];
+  return L;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,98 @@
+#ifndef STAN_MATH_REV_MAT_FUN_SUBTRACT_HPP
+#define STAN_MATH_REV_MAT_FUN_SUBTRACT_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/err/check_matching_dims.hpp>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * This is a subclass of the vari class for the elementwise
+ * difference A - B of two matrices, at least one of which holds vars.
+ *
+ * The class stores pointers to the varis of A and B (when they
+ * are vars) and instantiates the varis for A - B on the
+ * var_nochain_stack_, so the whole difference is a single node on the
+ * chaining stack.
+ *
+ * @tparam Ta Scalar type for matrix A
+ * @tparam Tb Scalar type for matrix B
+ * @tparam R Rows for both matrices
+ * @tparam C Columns for both matrices
+ */
+template <typename Ta, typename Tb, int R, int C>
+class subtract_mat_vari : public vari {
+ public:
+  int rows_;
+  int cols_;
+  vari** variRefA_;
+  vari** variRefB_;
+  vari** variRefC_;
+
+  subtract_mat_vari(const Eigen::Matrix<Ta, R, C>& A,
+                    const Eigen::Matrix<Tb, R, C>& B)
+      : vari(0.0),
+        rows_(A.rows()),
+        cols_(A.cols()),
+        variRefA_(build_vari_array(A)),
+        variRefB_(build_vari_array(B)),
+        variRefC_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(
+            A.size())) {
+    Eigen::Map<matrix_vi>(variRefC_, rows_, cols_)
+        = (value_of(A) - value_of(B)).unaryExpr([](double x) {
+            return new vari(x, false);
+          });
+  }
+
+  virtual void chain() {
+    using Eigen::Map;
+    matrix_d adjC = Map<matrix_vi>(variRefC_, rows_, cols_).adj();
+    if (is_var<Ta>::value)
+      Map<matrix_vi>(variRefA_, rows_, cols_).adj() += adjC;
+    if (is_var<Tb>::value)
+      Map<matrix_vi>(variRefB_, rows_, cols_).adj() -= adjC;
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the difference of the specified matrices.  The two
+ * matrices must have the same dimensions.  All entries of the result
+ * share a single vari on the chaining stack.
+ *
+ * @tparam Ta Scalar type of first matrix.
+ * @tparam Tb Scalar type of second matrix.
+ * @tparam R Row type of matrices.
+ * @tparam C Column type of matrices.
+ * @param A First matrix.
+ * @param B Second matrix.
+ * @return First matrix minus the second matrix.
+ * @throw std::invalid_argument if A and B do not have the same
+ * dimensions.
+ */
+template <typename Ta, typename Tb, int R, int C>
+inline typename std::enable_if<is_var<Ta>::value || is_var<Tb>::value,
+                               Eigen::Matrix<var, R, C> >::type
+subtract(const Eigen::Matrix<Ta, R, C>& A,
+         const Eigen::Matrix<Tb, R, C>& B) {
+  check_matching_dims("subtract", "m1", A, "m2", B);
+  Eigen::Matrix<var, R, C> res(A.rows(), A.cols());
+  if (A.size() == 0)
+    return res;
+
+  internal::subtract_mat_vari<Ta, Tb, R, C>* baseVari
+      = new internal::subtract_mat_vari<Ta, Tb, R, C>(A, B);
+  res.vi() = Eigen::Map<matrix_vi>(baseVari->variRefC_, A.rows(), A.cols());
+  return res;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -24,14 +24,14 @@ class trace_inv_quad_form_ldlt_impl : public chainable_alloc {
     if (haveD)
       C_.noalias() = Bd.transpose() * AinvB_;
     else
-      value_ = (Bd.transpose() * AinvB_).trace();
+      value_ = Bd.cwiseProduct(AinvB_).sum();
   }
   inline void initializeB(const Eigen::Matrix<double, R3, C3> &B, bool haveD) {
     AinvB_ = ldlt_.solve(B);
     if (haveD)
       C_.noalias() = B.transpose() * AinvB_;
     else
-      value_ = (B.transpose() * AinvB_).trace();
+      value_ = B.cwiseProduct(AinvB_).sum();
   }
 
   template <int R1, int C1>
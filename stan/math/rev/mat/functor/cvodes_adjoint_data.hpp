@@ -0,0 +1,414 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CVODES_ADJOINT_DATA_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CVODES_ADJOINT_DATA_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/rev/mat/functor/cvodes_utils.hpp>
+#include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
+#include <cvodes/cvodes.h>
+#include <sunmatrix/sunmatrix_dense.h>
+#include <sunlinsol/sunlinsol_dense.h>
+#include <nvector/nvector_serial.h>
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * Installs a fresh autodiff stack on the calling thread during the
+ * lifetime of this object and restores the previous one when it goes
+ * out of scope, also when an exception is thrown.
+ */
+class cvodes_adjoint_stack_scope {
+  typedef ChainableStack::AutodiffStackStorage stack_t;
+  stack_t* outer_stack_;
+  stack_t stack_;
+
+ public:
+  cvodes_adjoint_stack_scope() : outer_stack_(ChainableStack::instance_) {
+    ChainableStack::instance_ = &stack_;
+  }
+  ~cvodes_adjoint_stack_scope() { ChainableStack::instance_ = outer_stack_; }
+
+  cvodes_adjoint_stack_scope(const cvodes_adjoint_stack_scope&) = delete;
+  cvodes_adjoint_stack_scope& operator=(const cvodes_adjoint_stack_scope&)
+      = delete;
+};
+}  // namespace internal
+
+/**
+ * CVODES adjoint sensitivity data holder.  It owns the CVODES
+ * memory, including the checkpoints of the forward solve, for as
+ * long as the autodiff stack it was allocated on so that the
+ * backward problem can be integrated whenever the gradient is
+ * requested.  All the arguments of the ODE are copied since the
+ * backward pass runs after the caller has returned.
+ *
+ * The backward problem for the adjoint lambda of the states and the
+ * quadrature mu for the parameters is
+ * \f[
+ *   \dot{\lambda} = -J_y^T \lambda, \quad
+ *   \dot{\mu} = -J_\theta^T \lambda,
+ * \f]
+ * integrated from the last output time to the initial time, where
+ * the adjoints of the outputs are added to lambda at each output
+ * time.  At the initial time lambda is the gradient with respect
+ * to the initial state and mu with respect to the parameters.  Each
+ * evaluation of the right hand side of lambda or of mu takes one
+ * nested reverse sweep through the ODE right hand side.  CVODES
+ * evaluates the two at different states, so the sweeps cannot be
+ * shared.
+ *
+ * Instances must be created with operator new and are deleted
+ * when the autodiff memory is recovered.
+ *
+ * @tparam F type of functor for the base ode system.
+ */
+template <typename F>
+class cvodes_adjoint_data : public chainable_alloc {
+  typedef cvodes_ode_data<F, double, double> ode_data;
+  typedef cvodes_adjoint_data<F> adjoint_data;
+
+  const F f_;
+  const std::vector<double> y0_;
+  const std::vector<double> theta_;
+  const std::vector<double> x_;
+  const std::vector<int> x_int_;
+  std::ostream* msgs_;
+  const size_t N_;
+  const size_t M_;
+  const double t0_;
+  const std::vector<double> ts_;
+  const double relative_tolerance_;
+  const double absolute_tolerance_;
+  const long int max_num_steps_;  // NOLINT(runtime/int)
+  ode_data ode_data_;
+  int lmm_;
+  void* cvodes_mem_;
+  int index_backward_;
+  bool quadrature_initialized_;
+  std::vector<double> state_adj_;
+  std::vector<double> quad_;
+  N_Vector nv_state_adj_;
+  N_Vector nv_quad_;
+  SUNMatrix A_adj_;
+  SUNLinearSolver LS_adj_;
+
+ public:
+  /**
+   * Construct the adjoint data holder.  The CVODES memory is only
+   * allocated by <code>forward</code>, so construction does not
+   * throw.
+   *
+   * @param[in] f ode functor.
+   * @param[in] y0 initial state of the base ode.
+   * @param[in] t0 initial time.
+   * @param[in] ts times of the desired solutions.
+   * @param[in] theta parameters of the base ode.
+   * @param[in] x continuous data vector for the ODE.
+   * @param[in] x_int integer data vector for the ODE.
+   * @param[in] msgs stream to which messages are printed.
+   * @param[in] relative_tolerance relative tolerance passed to CVODES.
+   * @param[in] absolute_tolerance absolute tolerance passed to CVODES.
+   * @param[in] max_num_steps maximal number of admissable steps
+   * between time-points
+   */
+  cvodes_adjoint_data(const F& f, const std::vector<double>& y0, double t0,
+                      const std::vector<double>& ts,
+                      const std::vector<double>& theta,
+                      const std::vector<double>& x,
+                      const std::vector<int>& x_int, std::ostream* msgs,
+                      double relative_tolerance, double absolute_tolerance,
+                      long int max_num_steps)  // NOLINT(runtime/int)
+      : f_(f),
+        y0_(y0),
+        theta_(theta),
+        x_(x),
+        x_int_(x_int),
+        msgs_(msgs),
+        N_(y0.size()),
+        M_(theta.size()),
+        t0_(t0),
+        ts_(ts),
+        relative_tolerance_(relative_tolerance),
+        absolute_tolerance_(absolute_tolerance),
+        max_num_steps_(max_num_steps),
+        ode_data_(f_, y0_, theta_, x_, x_int_, msgs_),
+        lmm_(CV_BDF),
+        cvodes_mem_(nullptr),
+        index_backward_(-1),
+        quadrature_initialized_(false),
+        state_adj_(N_, 0.0),
+        quad_(M_, 0.0),
+        nv_state_adj_(N_VMake_Serial(N_, &state_adj_[0])),
+        nv_quad_(M_ > 0 ? N_VMake_Serial(M_, &quad_[0]) : nullptr),
+        A_adj_(SUNDenseMatrix(N_, N_)),
+        LS_adj_(SUNDenseLinearSolver(nv_state_adj_, A_adj_)) {}
+
+  ~cvodes_adjoint_data() {
+    if (cvodes_mem_ != nullptr)
+      CVodeFree(&cvodes_mem_);
+    SUNLinSolFree(LS_adj_);
+    SUNMatDestroy(A_adj_);
+    N_VDestroy_Serial(nv_state_adj_);
+    if (nv_quad_ != nullptr)
+      N_VDestroy_Serial(nv_quad_);
+  }
+
+  /**
+   * Solve the base ODE forward in time, storing checkpoints for the
+   * backward pass.
+   *
+   * @param[in] lmm ID of ODE solver (1: ADAMS, 2: BDF)
+   * @param[in] num_steps_between_checkpoints number of integration
+   * steps between two checkpoints of the forward solution
+   * @return the states at each of the output times, stacked
+   */
+  std::vector<double> forward(
+      int lmm, long int num_steps_between_checkpoints) {  // NOLINT(runtime/int)
+    std::vector<double> y(N_ * ts_.size());
+    lmm_ = lmm;
+    cvodes_mem_ = CVodeCreate(lmm);
+    if (cvodes_mem_ == nullptr)
+      throw std::runtime_error("CVodeCreate failed to allocate memory");
+
+    cvodes_check_flag(
+        CVodeInit(cvodes_mem_, &ode_data::cv_rhs, t0_, ode_data_.nv_state_),
+        "CVodeInit");
+    cvodes_check_flag(
+        CVodeSetUserData(cvodes_mem_, reinterpret_cast<void*>(&ode_data_)),
+        "CVodeSetUserData");
+    cvodes_set_options(cvodes_mem_, relative_tolerance_, absolute_tolerance_,
+                       max_num_steps_);
+    cvodes_check_flag(CVodeSetLinearSolver(cvodes_mem_, ode_data_.LS_,
+                                           ode_data_.A_),
+                      "CVodeSetLinearSolver");
+    cvodes_check_flag(
+        CVodeSetJacFn(cvodes_mem_, &ode_data::cv_jacobian_states),
+        "CVodeSetJacFn");
+    cvodes_check_flag(
+        CVodeAdjInit(cvodes_mem_, num_steps_between_checkpoints, CV_HERMITE),
+        "CVodeAdjInit");
+
+    // CVodeF takes single steps internally and ignores the maximal
+    // number of steps, so the steps are taken and counted here
+    double t_init = t0_;
+    int num_checkpoints;
+    for (size_t n = 0; n < ts_.size(); ++n) {
+      long int num_steps = 0;  // NOLINT(runtime/int)
+      while (t_init < ts_[n]) {
+        if (num_steps++ >= max_num_steps_)
+          cvodes_check_flag(CV_TOO_MUCH_WORK, "CVodeF");
+        cvodes_check_flag(CVodeF(cvodes_mem_, ts_[n], ode_data_.nv_state_,
+                                 &t_init, CV_ONE_STEP, &num_checkpoints),
+                          "CVodeF");
+      }
+      cvodes_check_flag(
+          CVodeGetDky(cvodes_mem_, ts_[n], 0, ode_data_.nv_state_),
+          "CVodeGetDky");
+      std::copy(ode_data_.coupled_state_.begin(),
+                ode_data_.coupled_state_.end(), y.begin() + n * N_);
+    }
+    return y;
+  }
+
+  /**
+   * Integrate the adjoint system backward in time from the last
+   * output time to the initial time.
+   *
+   * @param[in] y_adj adjoints of the solution, N for each output
+   * time, stacked
+   * @param[in] need_theta_adj whether the gradient with respect to
+   * the parameters is needed
+   * @param[out] y0_adj gradient with respect to the initial state
+   * @param[out] theta_adj gradient with respect to the parameters
+   */
+  void backward(const std::vector<double>& y_adj, bool need_theta_adj,
+                std::vector<double>& y0_adj, std::vector<double>& theta_adj) {
+    // this is called from chain() while the reverse sweep iterates over
+    // the autodiff stack, so the nested sweeps through the ODE RHS are
+    // recorded on a stack of their own
+    internal::cvodes_adjoint_stack_scope backward_stack;
+    integrate_backward(y_adj, need_theta_adj, y0_adj, theta_adj);
+  }
+
+  /**
+   * Implements the function of type CVRhsFnB which is the RHS of
+   * the adjoint system, -J_y^T lambda.
+   */
+  static int cv_rhs_adj(realtype t, N_Vector y, N_Vector yB, N_Vector yBdot,
+                        void* user_dataB) {
+    const adjoint_data* adjoint = static_cast<const adjoint_data*>(user_dataB);
+    adjoint->adjoint_products(t, NV_DATA_S(y), NV_DATA_S(yB), NV_DATA_S(yBdot),
+                              nullptr);
+    return 0;
+  }
+
+  /**
+   * Implements the function of type CVQuadRhsFnB which is the RHS of
+   * the quadrature for the parameters, -J_theta^T lambda.
+   */
+  static int cv_quad_rhs_adj(realtype t, N_Vector y, N_Vector yB,
+                             N_Vector qBdot, void* user_dataB) {
+    const adjoint_data* adjoint = static_cast<const adjoint_data*>(user_dataB);
+    adjoint->adjoint_products(t, NV_DATA_S(y), NV_DATA_S(yB), nullptr,
+                              NV_DATA_S(qBdot));
+    return 0;
+  }
+
+  /**
+   * Implements the function of type CVLsJacFnB which is the Jacobian
+   * of the adjoint system with respect to lambda, -J_y^T.
+   */
+  static int cv_jacobian_adj(realtype t, N_Vector y, N_Vector yB,
+                             N_Vector fyB, SUNMatrix JB, void* user_dataB,
+                             N_Vector tmp1B, N_Vector tmp2B, N_Vector tmp3B) {
+    adjoint_data* adjoint = static_cast<adjoint_data*>(user_dataB);
+    ode_data::cv_jacobian_states(t, y, fyB, JB,
+                                 reinterpret_cast<void*>(&adjoint->ode_data_),
+                                 tmp1B, tmp2B, tmp3B);
+    Eigen::Map<Eigen::MatrixXd> J(SM_DATA_D(JB), adjoint->N_, adjoint->N_);
+    J = (-J.transpose()).eval();
+    return 0;
+  }
+
+ private:
+  /**
+   * Integrate the adjoint system backward in time, adding the
+   * adjoints of the outputs at the output times.
+   */
+  void integrate_backward(const std::vector<double>& y_adj,
+                          bool need_theta_adj, std::vector<double>& y0_adj,
+                          std::vector<double>& theta_adj) {
+    const size_t T = ts_.size();
+    const bool quadrature = need_theta_adj && M_ > 0;
+    std::copy(y_adj.begin() + (T - 1) * N_, y_adj.end(), state_adj_.begin());
+    std::fill(quad_.begin(), quad_.end(), 0.0);
+
+    if (index_backward_ < 0) {
+      cvodes_check_flag(CVodeCreateB(cvodes_mem_, lmm_,
+                                     &index_backward_),
+                        "CVodeCreateB");
+      cvodes_check_flag(CVodeInitB(cvodes_mem_, index_backward_,
+                                   &adjoint_data::cv_rhs_adj, ts_.back(),
+                                   nv_state_adj_),
+                        "CVodeInitB");
+      cvodes_set_options(CVodeGetAdjCVodeBmem(cvodes_mem_, index_backward_),
+                         relative_tolerance_, absolute_tolerance_,
+                         max_num_steps_);
+      cvodes_check_flag(
+          CVodeSetUserDataB(cvodes_mem_, index_backward_,
+                            reinterpret_cast<void*>(this)),
+          "CVodeSetUserDataB");
+      cvodes_check_flag(CVodeSetLinearSolverB(cvodes_mem_, index_backward_,
+                                              LS_adj_, A_adj_),
+                        "CVodeSetLinearSolverB");
+      cvodes_check_flag(
+          CVodeSetJacFnB(cvodes_mem_, index_backward_,
+                         &adjoint_data::cv_jacobian_adj),
+          "CVodeSetJacFnB");
+    } else {
+      cvodes_check_flag(CVodeReInitB(cvodes_mem_, index_backward_, ts_.back(),
+                                     nv_state_adj_),
+                        "CVodeReInitB");
+    }
+    if (quadrature && !quadrature_initialized_) {
+      cvodes_check_flag(CVodeQuadInitB(cvodes_mem_, index_backward_,
+                                       &adjoint_data::cv_quad_rhs_adj,
+                                       nv_quad_),
+                        "CVodeQuadInitB");
+      cvodes_check_flag(
+          CVodeQuadSStolerancesB(cvodes_mem_, index_backward_,
+                                 relative_tolerance_, absolute_tolerance_),
+          "CVodeQuadSStolerancesB");
+      cvodes_check_flag(
+          CVodeSetQuadErrConB(cvodes_mem_, index_backward_, SUNTRUE),
+          "CVodeSetQuadErrConB");
+      quadrature_initialized_ = true;
+    } else if (quadrature) {
+      cvodes_check_flag(
+          CVodeQuadReInitB(cvodes_mem_, index_backward_, nv_quad_),
+          "CVodeQuadReInitB");
+    }
+
+    double t_init = ts_.back();
+    for (size_t n = T; n-- > 0;) {
+      const double t_final = n > 0 ? ts_[n - 1] : t0_;
+      if (t_final != t_init) {
+        cvodes_check_flag(CVodeB(cvodes_mem_, t_final, CV_NORMAL), "CVodeB");
+        cvodes_check_flag(CVodeGetB(cvodes_mem_, index_backward_, &t_init,
+                                    nv_state_adj_),
+                          "CVodeGetB");
+        if (quadrature)
+          cvodes_check_flag(CVodeGetQuadB(cvodes_mem_, index_backward_,
+                                          &t_init, nv_quad_),
+                            "CVodeGetQuadB");
+      }
+      t_init = t_final;
+      if (n > 0) {
+        // the adjoints of the outputs at t_final enter as a jump
+        for (size_t i = 0; i < N_; ++i)
+          state_adj_[i] += y_adj[(n - 1) * N_ + i];
+        cvodes_check_flag(CVodeReInitB(cvodes_mem_, index_backward_, t_final,
+                                       nv_state_adj_),
+                          "CVodeReInitB");
+        if (quadrature)
+          cvodes_check_flag(
+              CVodeQuadReInitB(cvodes_mem_, index_backward_, nv_quad_),
+              "CVodeQuadReInitB");
+      }
+    }
+    y0_adj = state_adj_;
+    theta_adj = quad_;
+  }
+
+  /**
+   * Calculates the products of the transposed Jacobians of the ODE
+   * RHS with lambda by one nested reverse sweep through lambda^T f,
+   * writing their negation to the requested outputs.
+   *
+   * @param[in] t time
+   * @param[in] y state of the base ODE
+   * @param[in] lambda adjoint state
+   * @param[out] y_adj_dot -J_y^T lambda or nullptr if not needed
+   * @param[out] theta_adj_dot -J_theta^T lambda or nullptr if not needed
+   */
+  inline void adjoint_products(double t, const double y[],
+                               const double lambda[], double y_adj_dot[],
+                               double theta_adj_dot[]) const {
+    try {
+      start_nested();
+      const std::vector<var> y_vars(y, y + N_);
+      const std::vector<var> theta_vars(theta_.begin(), theta_.end());
+      std::vector<var> dy_dt_vars
+          = theta_adj_dot == nullptr
+                ? f_(t, y_vars, theta_, x_, x_int_, msgs_)
+                : f_(t, y_vars, theta_vars, x_, x_int_, msgs_);
+      check_size_match("cvodes_adjoint_data", "dz_dt", dy_dt_vars.size(),
+                       "states", N_);
+      var lambda_dot_f = 0;
+      for (size_t i = 0; i < N_; ++i)
+        lambda_dot_f += lambda[i] * dy_dt_vars[i];
+      lambda_dot_f.grad();
+      if (y_adj_dot != nullptr)
+        for (size_t i = 0; i < N_; ++i)
+          y_adj_dot[i] = -y_vars[i].adj();
+      if (theta_adj_dot != nullptr)
+        for (size_t m = 0; m < M_; ++m)
+          theta_adj_dot[m] = -theta_vars[m].adj();
+    } catch (const std::exception& e) {
+      recover_memory_nested();
+      throw;
+    }
+    recover_memory_nested();
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,198 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CVODES_ADJOINT_INTEGRATOR_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CVODES_ADJOINT_INTEGRATOR_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/rev/mat/functor/cvodes_utils.hpp>
+#include <stan/math/rev/mat/functor/cvodes_adjoint_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_integrator.hpp>
+#include <cvodes/cvodes.h>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * The vari for the solution of an ODE whose gradients are computed
+ * with the adjoint method.  It is the first entry of the solution
+ * and the remaining entries are allocated without chaining, so that
+ * a single backward integration in <code>chain()</code> propagates
+ * the adjoints of all of them to the initial state and parameters.
+ *
+ * @tparam F type of functor for the base ode system.
+ */
+template <typename F>
+class cvodes_adjoint_vari : public vari {
+  cvodes_adjoint_data<F>* data_;
+  const size_t N_;
+  const size_t M_;
+  const size_t num_y_;
+  vari** y0_;
+  vari** theta_;
+  vari** y_;
+
+ public:
+  /**
+   * Construct the vari from the data holder of the solved forward
+   * problem.
+   *
+   * @param[in] data adjoint data holder
+   * @param[in] y0 initial state, only stored if it is not data
+   * @param[in] theta parameters, only stored if they are not data
+   * @param[in] y_dbl stacked solution values
+   */
+  template <typename T_initial, typename T_param>
+  cvodes_adjoint_vari(cvodes_adjoint_data<F>* data,
+                      const std::vector<T_initial>& y0,
+                      const std::vector<T_param>& theta,
+                      const std::vector<double>& y_dbl)
+      : vari(y_dbl[0]),
+        data_(data),
+        N_(is_var<T_initial>::value ? y0.size() : 0),
+        M_(is_var<T_param>::value ? theta.size() : 0),
+        num_y_(y_dbl.size()),
+        y0_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(N_)),
+        theta_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(M_)),
+        y_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_y_)) {
+    for (size_t n = 0; n < N_; ++n)
+      y0_[n] = value_of_vari(y0[n]);
+    for (size_t m = 0; m < M_; ++m)
+      theta_[m] = value_of_vari(theta[m]);
+    y_[0] = this;
+    for (size_t i = 1; i < num_y_; ++i)
+      y_[i] = new vari(y_dbl[i], false);
+  }
+
+  /**
+   * Return the vari of the solution at the specified stacked index.
+   */
+  vari* y(size_t i) const { return y_[i]; }
+
+  void chain() {
+    std::vector<double> y_adj(num_y_);
+    for (size_t i = 0; i < num_y_; ++i)
+      y_adj[i] = y_[i]->adj_;
+    std::vector<double> y0_adj;
+    std::vector<double> theta_adj;
+    data_->backward(y_adj, M_ > 0, y0_adj, theta_adj);
+    for (size_t n = 0; n < N_; ++n)
+      y0_[n]->adj_ += y0_adj[n];
+    for (size_t m = 0; m < M_; ++m)
+      theta_[m]->adj_ += theta_adj[m];
+  }
+
+ private:
+  static vari* value_of_vari(const var& x) { return x.vi_; }
+  static vari* value_of_vari(double x) { return nullptr; }
+};
+
+/**
+ * Integrator interface for CVODES' ODE solvers (Adams & BDF
+ * methods) computing gradients with adjoint sensitivities.
+ *
+ * Forward sensitivities integrate N (N + M) equations for N states
+ * and M parameters.  The adjoint method instead solves the base ODE
+ * forward once, keeping checkpoints, and integrates N adjoint
+ * equations and M quadratures backward once per gradient, so its
+ * cost grows only mildly with the number of parameters.
+ *
+ * @tparam Lmm ID of ODE solver (1: ADAMS, 2: BDF)
+ */
+template <int Lmm>
+class cvodes_adjoint_integrator {
+ public:
+  cvodes_adjoint_integrator() {}
+
+  /**
+   * Return the solutions for the specified system of ordinary
+   * differential equations given the specified initial state,
+   * initial times, times of desired solution, and parameters and
+   * data, writing error and warning messages to the specified
+   * stream.
+   *
+   * The solution is a single node on the autodiff stack whose
+   * <code>chain()</code> integrates the adjoint system backward in
+   * time.  The times are data.
+   *
+   * @tparam F type of ODE system function.
+   * @tparam T_initial type of scalars for initial values.
+   * @tparam T_param type of scalars for parameters.
+   * @param[in] f functor for the base ordinary differential equation.
+   * @param[in] y0 initial state.
+   * @param[in] t0 initial time.
+   * @param[in] ts times of the desired solutions, in strictly
+   * increasing order, all greater than the initial time.
+   * @param[in] theta parameter vector for the ODE.
+   * @param[in] x continuous data vector for the ODE.
+   * @param[in] x_int integer data vector for the ODE.
+   * @param[in, out] msgs the print stream for warning messages.
+   * @param[in] relative_tolerance relative tolerance passed to CVODE.
+   * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
+   * @param[in] max_num_steps maximal number of admissable steps
+   * between time-points
+   * @param[in] num_steps_between_checkpoints number of integration
+   * steps between two checkpoints of the forward solution
+   * @return a vector of states, each state being a vector of the
+   * same size as the state variable, corresponding to a time in ts.
+   */
+  template <typename F, typename T_initial, typename T_param>
+  std::vector<std::vector<typename stan::return_type<T_initial, T_param>::type>>
+  integrate(const F& f, const std::vector<T_initial>& y0, double t0,
+            const std::vector<double>& ts, const std::vector<T_param>& theta,
+            const std::vector<double>& x, const std::vector<int>& x_int,
+            std::ostream* msgs, double relative_tolerance,
+            double absolute_tolerance,
+            long int max_num_steps,                   // NOLINT(runtime/int)
+            long int num_steps_between_checkpoints) {  // NOLINT(runtime/int)
+    typedef typename stan::return_type<T_initial, T_param>::type return_t;
+    cvodes_check_arguments("integrate_ode_cvodes", y0, t0, ts, theta, x,
+                           relative_tolerance, absolute_tolerance,
+                           max_num_steps);
+    if (num_steps_between_checkpoints <= 0)
+      invalid_argument("integrate_ode_cvodes",
+                       "num_steps_between_checkpoints,",
+                       num_steps_between_checkpoints, "",
+                       ", must be greater than 0");
+
+    const size_t N = y0.size();
+    cvodes_adjoint_data<F>* data = new cvodes_adjoint_data<F>(
+        f, value_of(y0), t0, ts, value_of(theta), x, x_int, msgs,
+        relative_tolerance, absolute_tolerance, max_num_steps);
+    const std::vector<double> y_dbl
+        = data->forward(Lmm, num_steps_between_checkpoints);
+
+    cvodes_adjoint_vari<F>* vi
+        = new cvodes_adjoint_vari<F>(data, y0, theta, y_dbl);
+    std::vector<std::vector<return_t>> y(ts.size(), std::vector<return_t>(N));
+    for (size_t n = 0; n < ts.size(); ++n)
+      for (size_t i = 0; i < N; ++i)
+        y[n][i] = var(vi->y(n * N + i));
+    return y;
+  }
+
+  /**
+   * Return the solutions for the specified system of ordinary
+   * differential equations when neither the initial state nor the
+   * parameters are autodiff variables, in which case there is
+   * nothing to differentiate and the forward solver is used.
+   */
+  template <typename F>
+  std::vector<std::vector<double>> integrate(
+      const F& f, const std::vector<double>& y0, double t0,
+      const std::vector<double>& ts, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs, double relative_tolerance, double absolute_tolerance,
+      long int max_num_steps,                   // NOLINT(runtime/int)
+      long int num_steps_between_checkpoints) {  // NOLINT(runtime/int)
+    return cvodes_integrator<Lmm>().integrate(f, y0, t0, ts, theta, x, x_int,
+                                              msgs, relative_tolerance,
+                                              absolute_tolerance,
+                                              max_num_steps);
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,178 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CVODES_EVENT_ODE_DATA_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CVODES_EVENT_ODE_DATA_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/rev/arr/functor/ode_rhs_jacobian.hpp>
+#include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_workspace.hpp>
+#include <cvodes/cvodes.h>
+#include <nvector/nvector_serial.h>
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * Return copies of the parameters on the nochain autodiff stack, see
+ * <code>coupled_ode_system</code>.
+ */
+inline std::vector<var> ode_nochain_copy(const std::vector<var>& theta) {
+  std::vector<var> theta_nochain;
+  theta_nochain.reserve(theta.size());
+  for (const var& p : theta)
+    theta_nochain.emplace_back(new vari(p.val(), false));
+  return theta_nochain;
+}
+
+inline std::vector<double> ode_nochain_copy(const std::vector<double>& theta) {
+  return theta;
+}
+}  // namespace internal
+
+/**
+ * CVODES ode data holder object for ODEs whose states are
+ * incremented at event times, like bolus doses.
+ *
+ * The coupled state holds the N states followed by the
+ * sensitivities, N entries each, with respect to the initial state
+ * if it is an autodiff variable, then to the increments of the
+ * events if they are autodiff variables, ordered by event, and last
+ * to the parameters if they are autodiff variables.
+ *
+ * An increment is added to the states and does not depend on them,
+ * so between events the sensitivities with respect to increments
+ * follow the same equations as those with respect to the initial
+ * state, and at its event the sensitivities with respect to an
+ * increment jump by the identity.  The sensitivities with respect to
+ * the initial state and the parameters are continuous across events.
+ *
+ * @tparam F type of functor for the base ode system.
+ * @tparam T_initial type of initial values
+ * @tparam T_event type of the increments of the events
+ * @tparam T_param type of parameters
+ */
+template <typename F, typename T_initial, typename T_event, typename T_param>
+class cvodes_event_ode_data
+    : public internal::cvodes_ode_data_base<
+          cvodes_event_ode_data<F, T_initial, T_event, T_param>, F> {
+  typedef cvodes_event_ode_data<F, T_initial, T_event, T_param> ode_data;
+  typedef internal::cvodes_ode_data_base<ode_data, F> base;
+  friend base;
+  using base::f_;
+  using base::jacobian_;
+  using base::msgs_;
+  using base::N_;
+  using base::x_;
+  using base::x_int_;
+
+  const std::vector<std::vector<T_event>>& increments_;
+  const std::vector<T_param> theta_nochain_;
+  const size_t num_events_;
+  const size_t num_y0_sens_;
+  const size_t num_event_sens_;
+  const size_t num_param_sens_;
+  const size_t S_;
+  std::vector<double> z_;
+  std::vector<double> dz_dt_;
+
+ public:
+  std::vector<double> coupled_state_;
+  N_Vector nv_state_;
+  N_Vector* nv_state_sens_;
+
+  /**
+   * Construct the ode data with the N_Vectors, Jacobian matrix and
+   * linear solver of the specified workspace, see
+   * <code>cvodes_ode_data</code>.  The coupled state and the RHS of
+   * the sensitivities are computed in buffers of this object which
+   * are reused across the callbacks of CVODES.
+   *
+   * @param[in] f ode functor.
+   * @param[in] y0 initial state of the base ode.
+   * @param[in] theta parameters of the base ode.
+   * @param[in] increments increments of the states, one vector of N
+   * for each event which is applied.
+   * @param[in] x continuous data vector for the ODE.
+   * @param[in] x_int integer data vector for the ODE.
+   * @param[in] msgs stream to which messages are printed.
+   * @param[in, out] workspace CVODES workspace for ODEs of this size,
+   * which must outlive this object.
+   */
+  cvodes_event_ode_data(const F& f, const std::vector<T_initial>& y0,
+                        const std::vector<T_param>& theta,
+                        const std::vector<std::vector<T_event>>& increments,
+                        const std::vector<double>& x,
+                        const std::vector<int>& x_int, std::ostream* msgs,
+                        cvodes_workspace& workspace)
+      : base(f, y0.size(), theta, x, x_int, msgs),
+        increments_(increments),
+        theta_nochain_(internal::ode_nochain_copy(theta)),
+        num_events_(increments.size()),
+        num_y0_sens_(is_var<T_initial>::value ? N_ : 0),
+        num_event_sens_(is_var<T_event>::value ? N_ * num_events_ : 0),
+        num_param_sens_(is_var<T_param>::value ? theta.size() : 0),
+        S_(num_y0_sens_ + num_event_sens_ + num_param_sens_),
+        z_(N_ * (S_ + 1)),
+        dz_dt_(N_ * (S_ + 1)),
+        coupled_state_(N_ * (S_ + 1), 0.0),
+        nv_state_(workspace.nv_state_),
+        nv_state_sens_(workspace.nv_state_sens_) {
+    for (size_t i = 0; i < N_; ++i)
+      coupled_state_[i] = value_of(y0[i]);
+    for (size_t i = 0; i < num_y0_sens_; ++i)
+      coupled_state_[N_ + i * N_ + i] = 1.0;
+    workspace.attach(coupled_state_);
+    workspace.ode_data_ = this;
+  }
+
+  /**
+   * Return the number of sensitivities.
+   */
+  size_t num_sensitivities() const { return S_; }
+
+  /**
+   * Add the increment of the specified event to the states and the
+   * identity to the sensitivities with respect to it.
+   *
+   * @param[in] k index of the event
+   */
+  void apply_event(size_t k) {
+    for (size_t i = 0; i < N_; ++i)
+      coupled_state_[i] += value_of(increments_[k][i]);
+    if (num_event_sens_ > 0) {
+      const size_t offset = N_ + N_ * (num_y0_sens_ + N_ * k);
+      for (size_t i = 0; i < N_; ++i)
+        coupled_state_[offset + i * N_ + i] += 1.0;
+    }
+  }
+
+ private:
+  /**
+   * Calculates the RHS of the sensitivities, for which the
+   * sensitivities with respect to the initial state and the
+   * increments have no inhomogeneous term.
+   */
+  inline void rhs_sens(double t, const double y[], N_Vector* yS,
+                       N_Vector* ySdot) {
+    std::copy(y, y + N_, z_.begin());
+    for (size_t s = 0; s < S_; s++)
+      std::copy(NV_DATA_S(yS[s]), NV_DATA_S(yS[s]) + N_,
+                z_.begin() + (s + 1) * N_);
+    ode_rhs_jacobian("cvodes_event_ode_data", f_, t, y, N_, theta_nochain_,
+                     x_, x_int_, msgs_, &dz_dt_[0], jacobian_);
+    ode_sensitivities_rhs(N_, num_y0_sens_ + num_event_sens_, num_param_sens_,
+                          jacobian_, z_, dz_dt_);
+    for (size_t s = 0; s < S_; s++)
+      std::move(dz_dt_.begin() + (s + 1) * N_, dz_dt_.begin() + (s + 2) * N_,
+                NV_DATA_S(ySdot[s]));
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
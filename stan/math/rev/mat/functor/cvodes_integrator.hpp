@@ -5,16 +5,24 @@
 #include <stan/math/prim/arr/fun/value_of.hpp>
 #include <stan/math/prim/scal/err/check_less.hpp>
 #include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_greater_or_equal.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/prim/arr/err/check_nonzero_size.hpp>
 #include <stan/math/prim/arr/err/check_ordered.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_observer.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_system.hpp>
+#include <stan/math/prim/arr/functor/ode_statistics.hpp>
 #include <stan/math/rev/arr/functor/coupled_ode_system.hpp>
+#include <stan/math/rev/arr/functor/ode_store_sensitivities.hpp>
 #include <stan/math/rev/mat/functor/cvodes_utils.hpp>
 #include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_event_ode_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_linear_solver.hpp>
+#include <stan/math/rev/mat/functor/cvodes_workspace.hpp>
 #include <cvodes/cvodes.h>
 #include <sunlinsol/sunlinsol_dense.h>
 #include <algorithm>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -49,6 +57,14 @@ class cvodes_integrator {
    * formula which is an implicit numerical integration scheme
    * appropiate for stiff ODE systems.
    *
+   * Repeated solves of the same type and size of ODE on a thread
+   * reinitialize the CVODES memory of the previous solve instead of
+   * allocating it again, see <code>cvodes_workspace_cache</code>.
+   *
+   * If collection is switched on for the calling thread, the
+   * counters of CVODES and the wall times of the solve are recorded
+   * under the name of the solver, see <code>ode_statistics</code>.
+   *
    * @tparam F type of ODE system function.
    * @tparam T_initial type of scalars for initial values.
    * @tparam T_param type of scalars for parameters.
@@ -67,6 +83,8 @@ class cvodes_integrator {
    * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
    * @param[in] max_num_steps maximal number of admissable steps
    * between time-points
+   * @param[in] linear_solver linear solver for the Newton iterations,
+   * see <code>cvodes_linear_solver</code>.
    * @return a vector of states, each state being a vector of the
    * same size as the state variable, corresponding to a time in ts.
    */
@@ -79,91 +97,86 @@ class cvodes_integrator {
             const std::vector<double>& x, const std::vector<int>& x_int,
             std::ostream* msgs, double relative_tolerance,
             double absolute_tolerance,
-            long int max_num_steps) {  // NOLINT(runtime/int)
+            long int max_num_steps,  // NOLINT(runtime/int)
+            const cvodes_linear_solver& linear_solver
+            = cvodes_linear_solver()) {
+    std::vector<std::vector<
+        typename stan::return_type<T_initial, T_param, T_t0, T_ts>::type>>
+        y;
+    coupled_ode_observer<F, T_initial, T_param, T_t0, T_ts> observer(
+        f, y0, theta, t0, ts, x, x_int, msgs, y);
+    integrate_observe(f, y0, value_of(t0), value_of(ts), theta, x, x_int, msgs,
+                      relative_tolerance, absolute_tolerance, max_num_steps,
+                      linear_solver, observer);
+    return y;
+  }
+
+  /**
+   * Solve the specified system of ordinary differential equations
+   * like <code>integrate</code> and pass the coupled state at each
+   * output time to the observer, in the layout of the
+   * <code>coupled_ode_system</code>, instead of storing the
+   * solutions.
+   *
+   * @tparam F type of ODE system function.
+   * @tparam T_initial type of scalars for initial values.
+   * @tparam T_param type of scalars for parameters.
+   * @tparam Observer type of the observer, called with the coupled
+   * state and the output time
+   * @param[in, out] observer observer of the coupled states
+   * @see integrate for the other arguments
+   */
+  template <typename F, typename T_initial, typename T_param,
+            typename Observer>
+  void integrate_observe(const F& f, const std::vector<T_initial>& y0,
+                         double t0, const std::vector<double>& ts,
+                         const std::vector<T_param>& theta,
+                         const std::vector<double>& x,
+                         const std::vector<int>& x_int, std::ostream* msgs,
+                         double relative_tolerance, double absolute_tolerance,
+                         long int max_num_steps,  // NOLINT(runtime/int)
+                         const cvodes_linear_solver& linear_solver,
+                         Observer& observer) {
     typedef stan::is_var<T_initial> initial_var;
     typedef stan::is_var<T_param> param_var;
 
     const char* fun = "integrate_ode_cvodes";
 
-    const double t0_dbl = value_of(t0);
-    const std::vector<double> ts_dbl = value_of(ts);
-
-    check_finite(fun, "initial state", y0);
-    check_finite(fun, "initial time", t0_dbl);
-    check_finite(fun, "times", ts_dbl);
-    check_finite(fun, "parameter vector", theta);
-    check_finite(fun, "continuous data", x);
-    check_nonzero_size(fun, "times", ts);
-    check_nonzero_size(fun, "initial state", y0);
-    check_ordered(fun, "times", ts_dbl);
-    check_less(fun, "initial time", t0_dbl, ts_dbl[0]);
-    if (relative_tolerance <= 0)
-      invalid_argument("integrate_ode_cvodes", "relative_tolerance,",
-                       relative_tolerance, "", ", must be greater than 0");
-    if (absolute_tolerance <= 0)
-      invalid_argument("integrate_ode_cvodes", "absolute_tolerance,",
-                       absolute_tolerance, "", ", must be greater than 0");
-    if (max_num_steps <= 0)
-      invalid_argument("integrate_ode_cvodes", "max_num_steps,", max_num_steps,
-                       "", ", must be greater than 0");
+    cvodes_check_arguments(fun, y0, t0, ts, theta, x, relative_tolerance,
+                           absolute_tolerance, max_num_steps);
+    linear_solver.check(fun, y0.size());
 
     const size_t N = y0.size();
     const size_t M = theta.size();
     const size_t S = (initial_var::value ? N : 0) + (param_var::value ? M : 0);
 
     typedef cvodes_ode_data<F, T_initial, T_param> ode_data;
-    ode_data cvodes_data(f, y0, theta, x, x_int, msgs);
+    typedef cvodes_workspace_cache<ode_data> workspace_cache;
+    std::unique_ptr<cvodes_workspace> workspace
+        = workspace_cache::acquire(Lmm, N, S, linear_solver);
+    ode_data cvodes_data(f, y0, theta, x, x_int, msgs, *workspace);
+    void* cvodes_mem = workspace->mem_;
 
-    void* cvodes_mem = CVodeCreate(Lmm);
-    if (cvodes_mem == nullptr)
-      throw std::runtime_error("CVodeCreate failed to allocate memory");
+    // a failed solve frees its workspace when the exception unwinds
+    // this scope instead of returning it to the cache
+    initialize<F, ode_data>(*workspace, t0, S, linear_solver);
 
-    const size_t coupled_size = cvodes_data.coupled_ode_.size();
+    cvodes_set_options(cvodes_mem, relative_tolerance, absolute_tolerance,
+                       max_num_steps);
 
-    std::vector<std::vector<
-        typename stan::return_type<T_initial, T_param, T_t0, T_ts>::type>>
-        y;
-    coupled_ode_observer<F, T_initial, T_param, T_t0, T_ts> observer(
-        f, y0, theta, t0, ts, x, x_int, msgs, y);
+    const char* solver
+        = Lmm == CV_BDF ? "integrate_ode_bdf" : "integrate_ode_adams";
+    const bool collect_statistics = ode_statistics::enabled();
+    ode_solver_statistics statistics;
+    workspace->sensitivity_seconds_
+        = collect_statistics ? &statistics.sensitivity_seconds_ : nullptr;
 
     try {
-      cvodes_check_flag(CVodeInit(cvodes_mem, &ode_data::cv_rhs, t0_dbl,
-                                  cvodes_data.nv_state_),
-                        "CVodeInit");
-
-      // Assign pointer to this as user data
-      cvodes_check_flag(
-          CVodeSetUserData(cvodes_mem, reinterpret_cast<void*>(&cvodes_data)),
-          "CVodeSetUserData");
-
-      cvodes_set_options(cvodes_mem, relative_tolerance, absolute_tolerance,
-                         max_num_steps);
-
-      // for the stiff solvers we need to reserve additional memory
-      // and provide a Jacobian function call. new API since 3.0.0:
-      // create matrix object and linear solver object; resource
-      // (de-)allocation is handled in the cvodes_ode_data
-      cvodes_check_flag(
-          CVodeSetLinearSolver(cvodes_mem, cvodes_data.LS_, cvodes_data.A_),
-          "CVodeSetLinearSolver");
-      cvodes_check_flag(
-          CVodeSetJacFn(cvodes_mem, &ode_data::cv_jacobian_states),
-          "CVodeSetJacFn");
-
-      // initialize forward sensitivity system of CVODES as needed
-      if (S > 0) {
-        cvodes_check_flag(
-            CVodeSensInit(cvodes_mem, static_cast<int>(S), CV_STAGGERED,
-                          &ode_data::cv_rhs_sens, cvodes_data.nv_state_sens_),
-            "CVodeSensInit");
-
-        cvodes_check_flag(CVodeSensEEtolerances(cvodes_mem),
-                          "CVodeSensEEtolerances");
-      }
-
-      double t_init = t0_dbl;
+      ode_statistics::timer forward_timer(
+          collect_statistics ? &statistics.forward_seconds_ : nullptr);
+      double t_init = t0;
       for (size_t n = 0; n < ts.size(); ++n) {
-        double t_final = ts_dbl[n];
+        double t_final = ts[n];
         if (t_final != t_init)
           cvodes_check_flag(CVode(cvodes_mem, t_final, cvodes_data.nv_state_,
                                   &t_init, CV_NORMAL),
@@ -177,14 +190,282 @@ class cvodes_integrator {
         t_init = t_final;
       }
     } catch (const std::exception& e) {
-      CVodeFree(&cvodes_mem);
+      if (collect_statistics) {
+        cvodes_add_statistics(cvodes_mem, S > 0, statistics);
+        ode_statistics::record(solver, statistics, true);
+      }
+      throw;
+    }
+    if (collect_statistics) {
+      cvodes_add_statistics(cvodes_mem, S > 0, statistics);
+      ode_statistics::record(solver, statistics, false);
+    }
+
+    workspace->sensitivity_seconds_ = nullptr;
+    workspace_cache::release(std::move(workspace));
+  }
+
+  /**
+   * Return the solutions for the specified system of ordinary
+   * differential equations whose states are incremented at the
+   * specified event times, like by bolus doses.
+   *
+   * The solution jumps by the increment of an event at its time.  A
+   * solution at an output time includes the events up to and at that
+   * time.  At each event the solver integrates to the event time
+   * without stepping past it, adds the increment to the states and
+   * restarts with <code>CVodeReInit</code>, keeping its memory and a
+   * single sensitivity system for the whole solve, see
+   * <code>cvodes_event_ode_data</code>.  The solutions are stored as a
+   * single node on the autodiff stack.
+   *
+   * If the increments are autodiff variables, there are N
+   * sensitivities for each event up to the last output time.  Events
+   * after it do not change the solutions and are ignored.
+   *
+   * @tparam F type of ODE system function.
+   * @tparam T_initial type of scalars for initial values.
+   * @tparam T_param type of scalars for parameters.
+   * @tparam T_event type of scalars for the increments.
+   * @param[in] f functor for the base ordinary differential equation.
+   * @param[in] y0 initial state.
+   * @param[in] t0 initial time.
+   * @param[in] ts times of the desired solutions, in strictly
+   * increasing order, all greater than the initial time.
+   * @param[in] theta parameter vector for the ODE.
+   * @param[in] event_times times of the events in non-decreasing
+   * order, none less than the initial time.
+   * @param[in] event_increments increments of the states, one vector
+   * of the size of the state for each event.
+   * @param[in] x continuous data vector for the ODE.
+   * @param[in] x_int integer data vector for the ODE.
+   * @param[in, out] msgs the print stream for warning messages.
+   * @param[in] relative_tolerance relative tolerance passed to CVODE.
+   * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
+   * @param[in] max_num_steps maximal number of admissable steps
+   * between an output or event time and the next.
+   * @param[in] linear_solver linear solver for the Newton iterations,
+   * see <code>cvodes_linear_solver</code>.
+   * @return a vector of states, each state being a vector of the
+   * same size as the state variable, corresponding to a time in ts.
+   * @throw std::invalid_argument if the number of increments differs
+   * from the number of event times or an increment has not the size
+   * of the state
+   * @throw std::domain_error if an event time or increment is not
+   * finite, or the event times are not ordered and not less than the
+   * initial time
+   */
+  template <typename F, typename T_initial, typename T_param,
+            typename T_event>
+  std::vector<std::vector<
+      typename stan::return_type<T_initial, T_param, T_event>::type>>
+  integrate_events(const F& f, const std::vector<T_initial>& y0, double t0,
+                   const std::vector<double>& ts,
+                   const std::vector<T_param>& theta,
+                   const std::vector<double>& event_times,
+                   const std::vector<std::vector<T_event>>& event_increments,
+                   const std::vector<double>& x, const std::vector<int>& x_int,
+                   std::ostream* msgs, double relative_tolerance,
+                   double absolute_tolerance,
+                   long int max_num_steps,  // NOLINT(runtime/int)
+                   const cvodes_linear_solver& linear_solver
+                   = cvodes_linear_solver()) {
+    const char* fun = Lmm == CV_BDF ? "integrate_ode_bdf_events"
+                                    : "integrate_ode_adams_events";
+
+    cvodes_check_arguments(fun, y0, t0, ts, theta, x, relative_tolerance,
+                           absolute_tolerance, max_num_steps);
+    linear_solver.check(fun, y0.size());
+    check_size_match(fun, "number of event increments",
+                     event_increments.size(), "number of event times",
+                     event_times.size());
+    check_finite(fun, "event times", event_times);
+    for (size_t k = 0; k < event_times.size(); ++k) {
+      check_size_match(fun, "event increment", event_increments[k].size(),
+                       "states", y0.size());
+      check_finite(fun, "event increment", event_increments[k]);
+      check_greater_or_equal(fun, "event time", event_times[k],
+                             k == 0 ? t0 : event_times[k - 1]);
+    }
+
+    // events after the last output time do not change the solutions
+    const size_t K = std::upper_bound(event_times.begin(), event_times.end(),
+                                      ts.back())
+                     - event_times.begin();
+    const std::vector<std::vector<T_event>> increments(
+        event_increments.begin(), event_increments.begin() + K);
+
+    const size_t N = y0.size();
+    const size_t S = (is_var<T_initial>::value ? N : 0)
+                     + (is_var<T_event>::value ? N * K : 0)
+                     + (is_var<T_param>::value ? theta.size() : 0);
+
+    typedef cvodes_event_ode_data<F, T_initial, T_event, T_param> ode_data;
+    typedef cvodes_workspace_cache<ode_data> workspace_cache;
+    std::unique_ptr<cvodes_workspace> workspace
+        = workspace_cache::acquire(Lmm, N, S, linear_solver);
+    ode_data cvodes_data(f, y0, theta, increments, x, x_int, msgs,
+                         *workspace);
+    void* cvodes_mem = workspace->mem_;
+
+    // events at the initial time change the initial state
+    size_t k = 0;
+    for (; k < K && event_times[k] == t0; ++k)
+      cvodes_data.apply_event(k);
+
+    initialize<F, ode_data>(*workspace, t0, S, linear_solver);
+    cvodes_set_options(cvodes_mem, relative_tolerance, absolute_tolerance,
+                       max_num_steps);
+
+    const bool collect_statistics = ode_statistics::enabled();
+    ode_solver_statistics statistics;
+    workspace->sensitivity_seconds_
+        = collect_statistics ? &statistics.sensitivity_seconds_ : nullptr;
+
+    // integrates to t_final without stepping past the next event,
+    // after which the solution is not smooth
+    auto advance = [&](double t_final, double& t_init) {
+      cvodes_check_flag(
+          CVodeSetStopTime(cvodes_mem, k < K ? event_times[k] : ts.back()),
+          "CVodeSetStopTime");
+      cvodes_check_flag(CVode(cvodes_mem, t_final, cvodes_data.nv_state_,
+                              &t_init, CV_NORMAL),
+                        "CVode");
+      if (S > 0)
+        cvodes_check_flag(
+            CVodeGetSens(cvodes_mem, &t_init, cvodes_data.nv_state_sens_),
+            "CVodeGetSens");
+      t_init = t_final;
+    };
+
+    std::vector<double> coupled_states;
+    coupled_states.reserve(ts.size() * cvodes_data.coupled_state_.size());
+    try {
+      ode_statistics::timer forward_timer(
+          collect_statistics ? &statistics.forward_seconds_ : nullptr);
+      double t_init = t0;
+      for (size_t n = 0; n < ts.size(); ++n) {
+        while (k < K && event_times[k] <= ts[n]) {
+          const double t_event = event_times[k];
+          if (t_event != t_init)
+            advance(t_event, t_init);
+          for (; k < K && event_times[k] == t_event; ++k)
+            cvodes_data.apply_event(k);
+          // reinitializing resets the counters of CVODES
+          if (collect_statistics)
+            cvodes_add_statistics(cvodes_mem, S > 0, statistics);
+          reinitialize(*workspace, t_event, S);
+        }
+        if (ts[n] != t_init)
+          advance(ts[n], t_init);
+        coupled_states.insert(coupled_states.end(),
+                              cvodes_data.coupled_state_.begin(),
+                              cvodes_data.coupled_state_.end());
+      }
+    } catch (const std::exception& e) {
+      if (collect_statistics) {
+        cvodes_add_statistics(cvodes_mem, S > 0, statistics);
+        ode_statistics::record(fun, statistics, true);
+      }
       throw;
     }
+    if (collect_statistics) {
+      cvodes_add_statistics(cvodes_mem, S > 0, statistics);
+      ode_statistics::record(fun, statistics, false);
+    }
 
-    CVodeFree(&cvodes_mem);
+    workspace->sensitivity_seconds_ = nullptr;
+    workspace_cache::release(std::move(workspace));
 
+    std::vector<std::vector<
+        typename stan::return_type<T_initial, T_param, T_event>::type>>
+        y;
+    ode_store_event_sensitivities(y0, increments, theta, ts.size(),
+                                  coupled_states, y);
     return y;
   }
+
+ private:
+  /**
+   * Initialize the CVODES memory of the workspace for a solve from
+   * the initial time with the callbacks of the ode data, or
+   * reinitialize it if an earlier solve initialized it.  The states
+   * and sensitivities are read from the N_Vectors of the workspace.
+   *
+   * @tparam F type of ODE system function.
+   * @tparam Ode_data type of the CVODES ode data
+   * @param[in, out] workspace CVODES workspace
+   * @param[in] t0 initial time
+   * @param[in] S number of sensitivities
+   * @param[in] linear_solver linear solver for the Newton iterations
+   */
+  template <typename F, typename Ode_data>
+  static void initialize(cvodes_workspace& workspace, double t0, size_t S,
+                         const cvodes_linear_solver& linear_solver) {
+    if (workspace.initialized_) {
+      reinitialize(workspace, t0, S);
+      return;
+    }
+    void* cvodes_mem = workspace.mem_;
+    cvodes_check_flag(CVodeInit(cvodes_mem, &cvodes_workspace::cv_rhs<Ode_data>,
+                                t0, workspace.nv_state_),
+                      "CVodeInit");
+
+    // the workspace forwards the callbacks to the ode data of each
+    // solve, see cvodes_workspace
+    cvodes_check_flag(CVodeSetUserData(cvodes_mem, &workspace),
+                      "CVodeSetUserData");
+
+    // for the stiff solvers we need to reserve additional memory
+    // and provide a Jacobian function call. new API since 3.0.0:
+    // create matrix object and linear solver object; resource
+    // (de-)allocation is handled in the cvodes_workspace
+    cvodes_check_flag(
+        CVodeSetLinearSolver(cvodes_mem, workspace.LS_, workspace.A_),
+        "CVodeSetLinearSolver");
+    // the band Jacobian is approximated by CVODES unless the
+    // functor provides it analytically, which is cheaper than N
+    // reverse sweeps for wide systems
+    if (linear_solver.type_ == cvodes_linear_solver::DENSE
+        || (linear_solver.type_ == cvodes_linear_solver::BAND
+            && has_ode_jacobian_y<F>::value))
+      cvodes_check_flag(
+          CVodeSetJacFn(cvodes_mem,
+                        &cvodes_workspace::cv_jacobian_states<Ode_data>),
+          "CVodeSetJacFn");
+
+    // initialize forward sensitivity system of CVODES as needed
+    if (S > 0) {
+      cvodes_check_flag(
+          CVodeSensInit(cvodes_mem, static_cast<int>(S), CV_STAGGERED,
+                        &cvodes_workspace::cv_rhs_sens<Ode_data>,
+                        workspace.nv_state_sens_),
+          "CVodeSensInit");
+
+      cvodes_check_flag(CVodeSensEEtolerances(cvodes_mem),
+                        "CVodeSensEEtolerances");
+    }
+    workspace.initialized_ = true;
+  }
+
+  /**
+   * Restart the initialized CVODES memory of the workspace at the
+   * specified time from the states and sensitivities in its
+   * N_Vectors.  The linear solver, Jacobian function and sensitivity
+   * tolerances carry over.
+   *
+   * @param[in, out] workspace CVODES workspace
+   * @param[in] t time to restart at
+   * @param[in] S number of sensitivities
+   */
+  static void reinitialize(cvodes_workspace& workspace, double t, size_t S) {
+    cvodes_check_flag(CVodeReInit(workspace.mem_, t, workspace.nv_state_),
+                      "CVodeReInit");
+    if (S > 0)
+      cvodes_check_flag(CVodeSensReInit(workspace.mem_, CV_STAGGERED,
+                                        workspace.nv_state_sens_),
+                        "CVodeSensReInit");
+  }
 };  // cvodes integrator
 }  // namespace math
 }  // namespace stan
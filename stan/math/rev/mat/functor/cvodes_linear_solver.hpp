@@ -0,0 +1,142 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CVODES_LINEAR_SOLVER_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CVODES_LINEAR_SOLVER_HPP
+
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_less.hpp>
+#include <sunmatrix/sunmatrix_dense.h>
+#include <sunmatrix/sunmatrix_band.h>
+#include <sunlinsol/sunlinsol_dense.h>
+#include <sunlinsol/sunlinsol_band.h>
+#include <sunlinsol/sunlinsol_spgmr.h>
+#include <nvector/nvector_serial.h>
+
+namespace stan {
+namespace math {
+
+/**
+ * Linear solver used for the Newton iterations of the CVODES
+ * integrators.
+ *
+ * The dense solver factorizes the full N x N Jacobian.  The band
+ * solver only stores and factorizes the band of the Jacobian with
+ * the specified upper and lower bandwidths.  The Krylov solver SPGMR
+ * is matrix-free and only needs products of the Jacobian with
+ * vectors.
+ *
+ * The Jacobian only enters the Newton iterations, so approximating it
+ * does not change the accuracy of the solution.  For the band solver
+ * CVODES approximates it by difference quotients with as many
+ * evaluations of the ODE right hand side as the band is wide, unless
+ * the ODE functor provides its Jacobian analytically.  For SPGMR the
+ * products with vectors are approximated by difference quotients with
+ * one evaluation of the ODE right hand side each.
+ */
+struct cvodes_linear_solver {
+  enum solver_type { DENSE, BAND, SPGMR };
+
+  solver_type type_;
+  long int mupper_;      // NOLINT(runtime/int)
+  long int mlower_;      // NOLINT(runtime/int)
+  int max_krylov_dim_;
+
+  /**
+   * Construct the dense solver.
+   */
+  cvodes_linear_solver()
+      : type_(DENSE), mupper_(0), mlower_(0), max_krylov_dim_(0) {}
+
+  /**
+   * Check that the options are valid for an ODE with N states.
+   *
+   * @param[in] function name of the calling function
+   * @param[in] N number of states
+   * @throw std::domain_error if a bandwidth is negative or not less
+   * than N, or if the Krylov dimension is negative
+   */
+  void check(const char* function, size_t N) const {
+    if (type_ == BAND) {
+      check_nonnegative(function, "upper bandwidth", mupper_);
+      check_nonnegative(function, "lower bandwidth", mlower_);
+      check_less(function, "upper bandwidth", mupper_,
+                 static_cast<long int>(N));  // NOLINT(runtime/int)
+      check_less(function, "lower bandwidth", mlower_,
+                 static_cast<long int>(N));  // NOLINT(runtime/int)
+    } else if (type_ == SPGMR) {
+      check_nonnegative(function, "maximal Krylov dimension",
+                        max_krylov_dim_);
+    }
+  }
+
+  /**
+   * Return the Jacobian matrix for the solver, which is a null pointer
+   * for the matrix-free solver.
+   *
+   * @param[in] N number of states
+   */
+  SUNMatrix create_matrix(size_t N) const {
+    switch (type_) {
+      case BAND:
+        return SUNBandMatrix(N, mupper_, mlower_);
+      case SPGMR:
+        return nullptr;
+      default:
+        return SUNDenseMatrix(N, N);
+    }
+  }
+
+  /**
+   * Return the linear solver.
+   *
+   * @param[in] y template vector of the states
+   * @param[in] A matrix created by <code>create_matrix</code>
+   */
+  SUNLinearSolver create_solver(N_Vector y, SUNMatrix A) const {
+    switch (type_) {
+      case BAND:
+        return SUNBandLinearSolver(y, A);
+      case SPGMR:
+        return SUNSPGMR(y, PREC_NONE, max_krylov_dim_);
+      default:
+        return SUNDenseLinearSolver(y, A);
+    }
+  }
+};
+
+/**
+ * Return the dense linear solver for CVODES, which is the default.
+ */
+inline cvodes_linear_solver cvodes_dense_solver() {
+  return cvodes_linear_solver();
+}
+
+/**
+ * Return the band linear solver for CVODES.
+ *
+ * @param[in] mupper upper bandwidth of the Jacobian
+ * @param[in] mlower lower bandwidth of the Jacobian
+ */
+inline cvodes_linear_solver cvodes_band_solver(
+    long int mupper, long int mlower) {  // NOLINT(runtime/int)
+  cvodes_linear_solver solver;
+  solver.type_ = cvodes_linear_solver::BAND;
+  solver.mupper_ = mupper;
+  solver.mlower_ = mlower;
+  return solver;
+}
+
+/**
+ * Return the matrix-free Krylov linear solver SPGMR for CVODES.
+ *
+ * @param[in] max_krylov_dim maximal dimension of the Krylov subspace,
+ * the SUNDIALS default of 5 is used if 0
+ */
+inline cvodes_linear_solver cvodes_spgmr_solver(int max_krylov_dim = 0) {
+  cvodes_linear_solver solver;
+  solver.type_ = cvodes_linear_solver::SPGMR;
+  solver.max_krylov_dim_ = max_krylov_dim;
+  return solver;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -4,8 +4,12 @@
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_system.hpp>
 #include <stan/math/rev/arr/functor/coupled_ode_system.hpp>
+#include <stan/math/rev/arr/functor/ode_rhs_jacobian.hpp>
+#include <stan/math/rev/mat/functor/cvodes_linear_solver.hpp>
+#include <stan/math/rev/mat/functor/cvodes_workspace.hpp>
 #include <cvodes/cvodes.h>
 #include <sunmatrix/sunmatrix_dense.h>
+#include <sunmatrix/sunmatrix_band.h>
 #include <sunlinsol/sunlinsol_dense.h>
 #include <nvector/nvector_serial.h>
 #include <algorithm>
@@ -14,6 +18,142 @@
 namespace stan {
 namespace math {
 
+/**
+ * Copy the Jacobian of the ODE RHS wrt to the states, stored
+ * row-major as computed by <code>ode_rhs_jacobian</code>, into the
+ * dense or band matrix of CVODES, which is column major.  Of a band
+ * matrix only the band is stored.
+ *
+ * @param[in] jacobian Jacobian with N entries per row
+ * @param[in] N number of states
+ * @param[out] J dense or band matrix of CVODES
+ */
+inline void cvodes_copy_jacobian(const std::vector<double>& jacobian,
+                                 size_t N, SUNMatrix J) {
+  if (SUNMatGetID(J) == SUNMATRIX_BAND) {
+    const sunindextype n = N;
+    for (sunindextype k = 0; k < n; ++k) {
+      const sunindextype first = std::max<sunindextype>(0, k - SM_UBAND_B(J));
+      const sunindextype last
+          = std::min<sunindextype>(n - 1, k + SM_LBAND_B(J));
+      for (sunindextype i = first; i <= last; ++i)
+        SM_ELEMENT_B(J, i, k) = jacobian[i * N + k];
+    }
+    return;
+  }
+  double* J_data = SM_DATA_D(J);
+  for (size_t i = 0; i < N; ++i)
+    for (size_t k = 0; k < N; ++k)
+      J_data[k * N + i] = jacobian[i * N + k];
+}
+
+namespace internal {
+/**
+ * Base of the CVODES ode data holders, which implements the static
+ * callbacks of CVODES for the ODE RHS, the sensitivity RHS and the
+ * Jacobian of the ODE RHS wrt to the states.  The derived ode data
+ * computes the RHS of its sensitivities with <code>rhs_sens</code>.
+ *
+ * The Jacobian is computed into a buffer of the ode data and the
+ * ODE RHS that comes with it into a temporary N_Vector of CVODES,
+ * such that the Jacobian callback does not allocate on each call.
+ *
+ * @tparam Derived type of the ode data
+ * @tparam F type of functor for the base ode system.
+ */
+template <typename Derived, typename F>
+class cvodes_ode_data_base {
+ protected:
+  const F& f_;
+  const std::vector<double> theta_dbl_;
+  const std::vector<double>& x_;
+  const std::vector<int>& x_int_;
+  std::ostream* msgs_;
+  const size_t N_;
+  std::vector<double> jacobian_;
+
+  template <typename T_param>
+  cvodes_ode_data_base(const F& f, size_t N, const std::vector<T_param>& theta,
+                       const std::vector<double>& x,
+                       const std::vector<int>& x_int, std::ostream* msgs)
+      : f_(f),
+        theta_dbl_(value_of(theta)),
+        x_(x),
+        x_int_(x_int),
+        msgs_(msgs),
+        N_(N),
+        jacobian_(N * N) {}
+
+ public:
+  /**
+   * Implements the function of type CVRhsFn which is the user-defined
+   * ODE RHS passed to CVODES.
+   */
+  static int cv_rhs(realtype t, N_Vector y, N_Vector ydot, void* user_data) {
+    static_cast<Derived*>(user_data)->rhs(t, NV_DATA_S(y), NV_DATA_S(ydot));
+    return 0;
+  }
+
+  /**
+   * Implements the function of type CVSensRhsFn which is the
+   * RHS of the sensitivity ODE system.
+   */
+  static int cv_rhs_sens(int Ns, realtype t, N_Vector y, N_Vector ydot,
+                         N_Vector* yS, N_Vector* ySdot, void* user_data,
+                         N_Vector tmp1, N_Vector tmp2) {
+    static_cast<Derived*>(user_data)->rhs_sens(t, NV_DATA_S(y), yS, ySdot);
+    return 0;
+  }
+
+  /**
+   * Implements the function of type CVLsJacFn which is the
+   * user-defined callback for CVODES to calculate the jacobian of the
+   * ode_rhs wrt to the states y. The jacobian is stored in column
+   * major format.
+   */
+  static int cv_jacobian_states(realtype t, N_Vector y, N_Vector fy,
+                                SUNMatrix J, void* user_data, N_Vector tmp1,
+                                N_Vector tmp2, N_Vector tmp3) {
+    return static_cast<Derived*>(user_data)->jacobian_states(
+        t, NV_DATA_S(y), NV_DATA_S(tmp1), J);
+  }
+
+ protected:
+  /**
+   * Calculates the ODE RHS, dy_dt, using the user-supplied functor at
+   * the given time t and state y.
+   */
+  inline void rhs(double t, const double y[], double dy_dt[]) const {
+    const std::vector<double> y_vec(y, y + N_);
+    const std::vector<double>& dy_dt_vec
+        = f_(t, y_vec, theta_dbl_, x_, x_int_, msgs_);
+    check_size_match("cvodes_ode_data", "dz_dt", dy_dt_vec.size(), "states",
+                     N_);
+    std::move(dy_dt_vec.begin(), dy_dt_vec.end(), dy_dt);
+  }
+
+  /**
+   * Calculates the jacobian of the ODE RHS wrt to its states y at the
+   * given time-point t and state y.  The Jacobian is read off the
+   * nested reverse sweeps directly instead of multiplying it with an
+   * identity matrix of sensitivities.  J is either a dense or a band
+   * matrix, see <code>cvodes_copy_jacobian</code>.
+   *
+   * @param[in] t time
+   * @param[in] y states
+   * @param[out] dy_dt ODE RHS, which is computed along, N elements
+   * @param[out] J Jacobian matrix of CVODES
+   */
+  inline int jacobian_states(double t, const double y[], double dy_dt[],
+                             SUNMatrix J) {
+    stan::math::ode_rhs_jacobian("cvodes_ode_data", f_, t, y, N_, theta_dbl_,
+                                 x_, x_int_, msgs_, dy_dt, jacobian_);
+    cvodes_copy_jacobian(jacobian_, N_, J);
+    return 0;
+  }
+};
+}  // namespace internal
+
 /**
  * CVODES ode data holder object which is used during CVODES
  * integration for CVODES callbacks.
@@ -24,22 +164,24 @@ namespace math {
  */
 
 template <typename F, typename T_initial, typename T_param>
-class cvodes_ode_data {
-  const F& f_;
+class cvodes_ode_data
+    : public internal::cvodes_ode_data_base<
+          cvodes_ode_data<F, T_initial, T_param>, F> {
+  typedef cvodes_ode_data<F, T_initial, T_param> ode_data;
+  typedef internal::cvodes_ode_data_base<ode_data, F> base;
+  friend base;
+  using base::N_;
+
   const std::vector<T_initial>& y0_;
   const std::vector<T_param>& theta_;
-  const std::vector<double> theta_dbl_;
-  const size_t N_;
   const size_t M_;
-  const std::vector<double>& x_;
-  const std::vector<int>& x_int_;
-  std::ostream* msgs_;
   const size_t S_;
 
-  typedef cvodes_ode_data<F, T_initial, T_param> ode_data;
   typedef stan::is_var<T_initial> initial_var;
   typedef stan::is_var<T_param> param_var;
 
+  const bool owns_workspace_;
+
  public:
   const coupled_ode_system<F, T_initial, T_param> coupled_ode_;
   std::vector<double> coupled_state_;
@@ -69,27 +211,26 @@ class cvodes_ode_data {
    * @param[in] x continuous data vector for the ODE.
    * @param[in] x_int integer data vector for the ODE.
    * @param[in] msgs stream to which messages are printed.
+   * @param[in] linear_solver linear solver for the Newton iterations,
+   * see <code>cvodes_linear_solver</code>.
    */
-  cvodes_ode_data(const F& f, const std::vector<T_initial>& y0,
-                  const std::vector<T_param>& theta,
-                  const std::vector<double>& x, const std::vector<int>& x_int,
-                  std::ostream* msgs)
-      : f_(f),
+  cvodes_ode_data(
+      const F& f, const std::vector<T_initial>& y0,
+      const std::vector<T_param>& theta, const std::vector<double>& x,
+      const std::vector<int>& x_int, std::ostream* msgs,
+      const cvodes_linear_solver& linear_solver = cvodes_linear_solver())
+      : base(f, y0.size(), theta, x, x_int, msgs),
         y0_(y0),
         theta_(theta),
-        theta_dbl_(value_of(theta)),
-        N_(y0.size()),
         M_(theta.size()),
-        x_(x),
-        x_int_(x_int),
-        msgs_(msgs),
         S_((initial_var::value ? N_ : 0) + (param_var::value ? M_ : 0)),
+        owns_workspace_(true),
         coupled_ode_(f, y0, theta, x, x_int, msgs),
         coupled_state_(coupled_ode_.initial_state()),
         nv_state_(N_VMake_Serial(N_, &coupled_state_[0])),
         nv_state_sens_(nullptr),
-        A_(SUNDenseMatrix(N_, N_)),
-        LS_(SUNDenseLinearSolver(nv_state_, A_)) {
+        A_(linear_solver.create_matrix(N_)),
+        LS_(linear_solver.create_solver(nv_state_, A_)) {
     if (S_ > 0) {
       nv_state_sens_ = N_VCloneVectorArrayEmpty_Serial(S_, nv_state_);
       for (std::size_t i = 0; i < S_; i++) {
@@ -98,82 +239,54 @@ class cvodes_ode_data {
     }
   }
 
+  /**
+   * Construct CVODES ode data object which uses the N_Vectors,
+   * Jacobian matrix and linear solver of the specified workspace
+   * instead of allocating its own.  The N_Vectors of the workspace
+   * are attached to the coupled state of this object, and the
+   * callbacks of the workspace forward to this object.
+   *
+   * @param[in] f ode functor.
+   * @param[in] y0 initial state of the base ode.
+   * @param[in] theta parameters of the base ode.
+   * @param[in] x continuous data vector for the ODE.
+   * @param[in] x_int integer data vector for the ODE.
+   * @param[in] msgs stream to which messages are printed.
+   * @param[in, out] workspace CVODES workspace for ODEs of this size,
+   * which must outlive this object.
+   */
+  cvodes_ode_data(const F& f, const std::vector<T_initial>& y0,
+                  const std::vector<T_param>& theta,
+                  const std::vector<double>& x, const std::vector<int>& x_int,
+                  std::ostream* msgs, cvodes_workspace& workspace)
+      : base(f, y0.size(), theta, x, x_int, msgs),
+        y0_(y0),
+        theta_(theta),
+        M_(theta.size()),
+        S_((initial_var::value ? N_ : 0) + (param_var::value ? M_ : 0)),
+        owns_workspace_(false),
+        coupled_ode_(f, y0, theta, x, x_int, msgs),
+        coupled_state_(coupled_ode_.initial_state()),
+        nv_state_(workspace.nv_state_),
+        nv_state_sens_(workspace.nv_state_sens_),
+        A_(workspace.A_),
+        LS_(workspace.LS_) {
+    workspace.attach(coupled_state_);
+    workspace.ode_data_ = this;
+  }
+
   ~cvodes_ode_data() {
+    if (!owns_workspace_)
+      return;
     SUNLinSolFree(LS_);
-    SUNMatDestroy(A_);
+    if (A_ != nullptr)
+      SUNMatDestroy(A_);
     N_VDestroy_Serial(nv_state_);
     if (S_ > 0)
       N_VDestroyVectorArray_Serial(nv_state_sens_, S_);
   }
 
-  /**
-   * Implements the function of type CVRhsFn which is the user-defined
-   * ODE RHS passed to CVODES.
-   */
-  static int cv_rhs(realtype t, N_Vector y, N_Vector ydot, void* user_data) {
-    const ode_data* explicit_ode = static_cast<const ode_data*>(user_data);
-    explicit_ode->rhs(t, NV_DATA_S(y), NV_DATA_S(ydot));
-    return 0;
-  }
-
-  /**
-   * Implements the function of type CVSensRhsFn which is the
-   * RHS of the sensitivity ODE system.
-   */
-  static int cv_rhs_sens(int Ns, realtype t, N_Vector y, N_Vector ydot,
-                         N_Vector* yS, N_Vector* ySdot, void* user_data,
-                         N_Vector tmp1, N_Vector tmp2) {
-    const ode_data* explicit_ode = static_cast<const ode_data*>(user_data);
-    explicit_ode->rhs_sens(t, NV_DATA_S(y), yS, ySdot);
-    return 0;
-  }
-
-  /**
-   * Implements the function of type CVDlsJacFn which is the
-   * user-defined callback for CVODES to calculate the jacobian of the
-   * ode_rhs wrt to the states y. The jacobian is stored in column
-   * major format.
-   */
-  static int cv_jacobian_states(realtype t, N_Vector y, N_Vector fy,
-                                SUNMatrix J, void* user_data, N_Vector tmp1,
-                                N_Vector tmp2, N_Vector tmp3) {
-    const ode_data* explicit_ode = static_cast<const ode_data*>(user_data);
-    return explicit_ode->jacobian_states(t, NV_DATA_S(y), J);
-  }
-
  private:
-  /**
-   * Calculates the ODE RHS, dy_dt, using the user-supplied functor at
-   * the given time t and state y.
-   */
-  inline void rhs(double t, const double y[], double dy_dt[]) const {
-    const std::vector<double> y_vec(y, y + N_);
-    const std::vector<double>& dy_dt_vec
-        = f_(t, y_vec, theta_dbl_, x_, x_int_, msgs_);
-    check_size_match("cvodes_ode_data", "dz_dt", dy_dt_vec.size(), "states",
-                     N_);
-    std::move(dy_dt_vec.begin(), dy_dt_vec.end(), dy_dt);
-  }
-
-  /**
-   * Calculates the jacobian of the ODE RHS wrt to its states y at the
-   * given time-point t and state y.
-   * Note that the jacobian of the ODE system is the coupled ode system for
-   * varying states evaluated at the state y whenever we choose state
-   * y to be the initial of the coupled ode system.
-   */
-  inline int jacobian_states(double t, const double y[], SUNMatrix J) const {
-    start_nested();
-    const std::vector<var> y_vec_var(y, y + N_);
-    coupled_ode_system<F, var, double> ode_jacobian(f_, y_vec_var, theta_dbl_,
-                                                    x_, x_int_, msgs_);
-    std::vector<double>&& jacobian_y = std::vector<double>(ode_jacobian.size());
-    ode_jacobian(ode_jacobian.initial_state(), jacobian_y, t);
-    std::move(jacobian_y.begin() + N_, jacobian_y.end(), SM_DATA_D(J));
-    recover_memory_nested();
-    return 0;
-  }
-
   /**
    * Calculates the RHS of the sensitivity ODE system which
    * corresponds to the coupled ode system from which the first N
@@ -2,9 +2,17 @@
 #define STAN_MATH_REV_MAT_FUNCTOR_CVODES_UTILS_HPP
 
 #include <stan/math/rev/meta.hpp>
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/prim/scal/err/check_less.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/invalid_argument.hpp>
+#include <stan/math/prim/arr/err/check_nonzero_size.hpp>
+#include <stan/math/prim/arr/err/check_ordered.hpp>
+#include <stan/math/prim/arr/functor/ode_statistics.hpp>
 #include <cvodes/cvodes.h>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 namespace stan {
 namespace math {
@@ -50,6 +58,88 @@ inline void cvodes_set_options(void* cvodes_mem, double rel_tol, double abs_tol,
                     "CVodeSetMaxConvFails");
 }
 
+/**
+ * Add the counters CVODES keeps since its last (re)initialization
+ * to the specified statistics.  Counters CVODES fails to report are
+ * left unchanged, such that this can be called while handling the
+ * error of a failed solve.
+ *
+ * @param[in] cvodes_mem CVODES memory
+ * @param[in] has_sensitivities true if the forward sensitivities are
+ * initialized
+ * @param[in, out] statistics statistics of the solve
+ */
+inline void cvodes_add_statistics(void* cvodes_mem, bool has_sensitivities,
+                                  ode_solver_statistics& statistics) {
+  long int count = 0;  // NOLINT(runtime/int)
+  if (CVodeGetNumSteps(cvodes_mem, &count) == CV_SUCCESS)
+    statistics.num_steps_ += count;
+  if (CVodeGetNumRhsEvals(cvodes_mem, &count) == CV_SUCCESS)
+    statistics.num_rhs_evals_ += count;
+  if (CVodeGetNumJacEvals(cvodes_mem, &count) == CV_SUCCESS)
+    statistics.num_jacobian_evals_ += count;
+  if (CVodeGetNumNonlinSolvIters(cvodes_mem, &count) == CV_SUCCESS)
+    statistics.num_nonlinear_iterations_ += count;
+  if (CVodeGetNumErrTestFails(cvodes_mem, &count) == CV_SUCCESS)
+    statistics.num_error_test_failures_ += count;
+  if (has_sensitivities) {
+    if (CVodeGetSensNumRhsEvals(cvodes_mem, &count) == CV_SUCCESS)
+      statistics.num_sensitivity_rhs_evals_ += count;
+    if (CVodeGetSensNumNonlinSolvIters(cvodes_mem, &count) == CV_SUCCESS)
+      statistics.num_nonlinear_iterations_ += count;
+  }
+}
+
+/**
+ * Check the arguments of the CVODES integrators.
+ *
+ * @param[in] fun name of the calling function
+ * @param[in] y0 initial state.
+ * @param[in] t0 initial time.
+ * @param[in] ts times of the desired solutions.
+ * @param[in] theta parameter vector for the ODE.
+ * @param[in] x continuous data vector for the ODE.
+ * @param[in] relative_tolerance relative tolerance passed to CVODE.
+ * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
+ * @param[in] max_num_steps maximal number of admissable steps
+ * between time-points
+ * @throw std::domain_error if an argument is not finite or the
+ * times are not ordered and greater than the initial time
+ * @throw std::invalid_argument if the initial state or times are
+ * empty or an integrator control is not positive
+ */
+template <typename T_initial, typename T_t0, typename T_ts, typename T_param>
+inline void cvodes_check_arguments(const char* fun,
+                                   const std::vector<T_initial>& y0,
+                                   const T_t0& t0, const std::vector<T_ts>& ts,
+                                   const std::vector<T_param>& theta,
+                                   const std::vector<double>& x,
+                                   double relative_tolerance,
+                                   double absolute_tolerance,
+                                   long int max_num_steps) {  // NOLINT
+  const double t0_dbl = value_of(t0);
+  const std::vector<double> ts_dbl = value_of(ts);
+
+  check_finite(fun, "initial state", y0);
+  check_finite(fun, "initial time", t0_dbl);
+  check_finite(fun, "times", ts_dbl);
+  check_finite(fun, "parameter vector", theta);
+  check_finite(fun, "continuous data", x);
+  check_nonzero_size(fun, "times", ts);
+  check_nonzero_size(fun, "initial state", y0);
+  check_ordered(fun, "times", ts_dbl);
+  check_less(fun, "initial time", t0_dbl, ts_dbl[0]);
+  if (relative_tolerance <= 0)
+    invalid_argument(fun, "relative_tolerance,", relative_tolerance, "",
+                     ", must be greater than 0");
+  if (absolute_tolerance <= 0)
+    invalid_argument(fun, "absolute_tolerance,", absolute_tolerance, "",
+                     ", must be greater than 0");
+  if (max_num_steps <= 0)
+    invalid_argument(fun, "max_num_steps,", max_num_steps, "",
+                     ", must be greater than 0");
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
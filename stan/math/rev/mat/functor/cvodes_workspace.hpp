@@ -0,0 +1,247 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CVODES_WORKSPACE_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CVODES_WORKSPACE_HPP
+
+#include <stan/math/prim/arr/functor/ode_statistics.hpp>
+#include <stan/math/rev/mat/functor/cvodes_linear_solver.hpp>
+#include <cvodes/cvodes.h>
+#include <nvector/nvector_serial.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * CVODES memory together with the N_Vectors, Jacobian matrix and
+ * linear solver for solving ODEs of one size with one linear
+ * multistep method, number of sensitivities and linear solver.
+ *
+ * The N_Vectors do not own their data, which is attached to the
+ * coupled state of each solve.  The first solve initializes the
+ * CVODES memory, later solves only reinitialize it with
+ * <code>CVodeReInit</code> and <code>CVodeSensReInit</code>, such
+ * that repeated solves of ODEs of the same size do not allocate
+ * CVODES memory again.
+ *
+ * CVODES copies its user data pointer for some callbacks when they
+ * are set, so the workspace itself is passed as user data and the
+ * callbacks forward to the ode data of the current solve.
+ */
+class cvodes_workspace {
+ public:
+  const int lmm_;
+  const size_t N_;
+  const size_t S_;
+  const cvodes_linear_solver linear_solver_;
+  void* mem_;
+  N_Vector nv_state_;
+  N_Vector* nv_state_sens_;
+  SUNMatrix A_;
+  SUNLinearSolver LS_;
+  bool initialized_;
+  void* ode_data_;
+  double* sensitivity_seconds_;
+
+  /**
+   * Allocate the CVODES memory for ODEs with N states and S
+   * sensitivities.
+   *
+   * @param[in] lmm linear multistep method, CV_BDF or CV_ADAMS
+   * @param[in] N number of states
+   * @param[in] S number of sensitivities
+   * @param[in] linear_solver linear solver for the Newton iterations
+   * @throw std::runtime_error if CVODES fails to allocate memory
+   */
+  cvodes_workspace(int lmm, size_t N, size_t S,
+                   const cvodes_linear_solver& linear_solver)
+      : lmm_(lmm),
+        N_(N),
+        S_(S),
+        linear_solver_(linear_solver),
+        mem_(create_memory(lmm)),
+        nv_state_(N_VNewEmpty_Serial(N)),
+        nv_state_sens_(nullptr),
+        A_(linear_solver.create_matrix(N)),
+        LS_(linear_solver.create_solver(nv_state_, A_)),
+        initialized_(false),
+        ode_data_(nullptr),
+        sensitivity_seconds_(nullptr) {
+    if (S_ > 0)
+      nv_state_sens_ = N_VCloneVectorArrayEmpty_Serial(S_, nv_state_);
+  }
+
+  cvodes_workspace(const cvodes_workspace&) = delete;
+  cvodes_workspace& operator=(const cvodes_workspace&) = delete;
+
+  ~cvodes_workspace() {
+    CVodeFree(&mem_);
+    SUNLinSolFree(LS_);
+    if (A_ != nullptr)
+      SUNMatDestroy(A_);
+    if (S_ > 0)
+      N_VDestroyVectorArray_Serial(nv_state_sens_, S_);
+    N_VDestroy_Serial(nv_state_);
+  }
+
+  /**
+   * Return true if this workspace solves ODEs with the specified
+   * sizes, method and linear solver.
+   */
+  bool matches(int lmm, size_t N, size_t S,
+               const cvodes_linear_solver& linear_solver) const {
+    return lmm_ == lmm && N_ == N && S_ == S
+           && linear_solver_.type_ == linear_solver.type_
+           && linear_solver_.mupper_ == linear_solver.mupper_
+           && linear_solver_.mlower_ == linear_solver.mlower_
+           && linear_solver_.max_krylov_dim_ == linear_solver.max_krylov_dim_;
+  }
+
+  /**
+   * Implements the function of type CVRhsFn by forwarding to the ode
+   * data of the current solve.
+   *
+   * @tparam Ode_data type of the CVODES ode data
+   */
+  template <typename Ode_data>
+  static int cv_rhs(realtype t, N_Vector y, N_Vector ydot, void* user_data) {
+    return Ode_data::cv_rhs(
+        t, y, ydot, static_cast<cvodes_workspace*>(user_data)->ode_data_);
+  }
+
+  /**
+   * Implements the function of type CVSensRhsFn by forwarding to the
+   * ode data of the current solve, adding the wall time to the
+   * sensitivity seconds if they are set.
+   *
+   * @tparam Ode_data type of the CVODES ode data
+   */
+  template <typename Ode_data>
+  static int cv_rhs_sens(int Ns, realtype t, N_Vector y, N_Vector ydot,
+                         N_Vector* yS, N_Vector* ySdot, void* user_data,
+                         N_Vector tmp1, N_Vector tmp2) {
+    cvodes_workspace* workspace = static_cast<cvodes_workspace*>(user_data);
+    ode_statistics::timer timer(workspace->sensitivity_seconds_);
+    return Ode_data::cv_rhs_sens(Ns, t, y, ydot, yS, ySdot,
+                                 workspace->ode_data_, tmp1, tmp2);
+  }
+
+  /**
+   * Implements the function of type CVLsJacFn by forwarding to the
+   * ode data of the current solve.
+   *
+   * @tparam Ode_data type of the CVODES ode data
+   */
+  template <typename Ode_data>
+  static int cv_jacobian_states(realtype t, N_Vector y, N_Vector fy,
+                                SUNMatrix J, void* user_data, N_Vector tmp1,
+                                N_Vector tmp2, N_Vector tmp3) {
+    return Ode_data::cv_jacobian_states(
+        t, y, fy, J, static_cast<cvodes_workspace*>(user_data)->ode_data_,
+        tmp1, tmp2, tmp3);
+  }
+
+  /**
+   * Point the N_Vectors of the states and sensitivities to the
+   * coupled state, which holds the N states followed by the S
+   * sensitivities.
+   *
+   * @param[in, out] coupled_state coupled state of N * (S + 1)
+   * elements
+   */
+  void attach(std::vector<double>& coupled_state) {
+    NV_DATA_S(nv_state_) = &coupled_state[0];
+    for (size_t s = 0; s < S_; ++s)
+      NV_DATA_S(nv_state_sens_[s]) = &coupled_state[N_] + s * N_;
+  }
+
+ private:
+  /**
+   * Return new CVODES memory.  It is allocated first, before the
+   * N_Vectors, Jacobian matrix and linear solver, so that nothing
+   * leaks if it fails.
+   *
+   * @throw std::runtime_error if CVODES fails to allocate memory
+   */
+  static void* create_memory(int lmm) {
+    void* mem = CVodeCreate(lmm);
+    if (mem == nullptr)
+      throw std::runtime_error("CVodeCreate failed to allocate memory");
+    return mem;
+  }
+};
+
+/**
+ * Per thread cache of CVODES workspaces for the ODE data type Tag.
+ *
+ * The right hand side callbacks of CVODES are bound to the type of
+ * the ODE functor, so workspaces are only shared among solves of the
+ * same type of ODE.  Within a type they are keyed by the linear
+ * multistep method, the number of states and sensitivities and the
+ * linear solver.  A workspace is removed from the cache while it is
+ * in use and is only returned after a successful solve, such that
+ * nested solves and failed solves never share CVODES memory.
+ *
+ * @tparam Tag type of the CVODES ODE data
+ */
+template <typename Tag>
+class cvodes_workspace_cache {
+  typedef std::vector<std::unique_ptr<cvodes_workspace>> workspaces_t;
+
+  static workspaces_t& workspaces() {
+#ifdef STAN_THREADS
+    static thread_local workspaces_t workspaces;
+#else
+    static workspaces_t workspaces;
+#endif
+    return workspaces;
+  }
+
+ public:
+  /**
+   * Maximal number of idle workspaces kept per type of ODE.
+   */
+  static constexpr size_t max_size = 8;
+
+  /**
+   * Return a workspace for the specified sizes, method and linear
+   * solver, taken from the cache if one is available and newly
+   * allocated otherwise.
+   */
+  static std::unique_ptr<cvodes_workspace> acquire(
+      int lmm, size_t N, size_t S, const cvodes_linear_solver& linear_solver) {
+    workspaces_t& cache = workspaces();
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+      if ((*it)->matches(lmm, N, S, linear_solver)) {
+        std::unique_ptr<cvodes_workspace> workspace = std::move(*it);
+        cache.erase(it);
+        return workspace;
+      }
+    }
+    return std::unique_ptr<cvodes_workspace>(
+        new cvodes_workspace(lmm, N, S, linear_solver));
+  }
+
+  /**
+   * Return a workspace to the cache, evicting the least recently
+   * returned workspace if the cache is full.
+   */
+  static void release(std::unique_ptr<cvodes_workspace> workspace) {
+    workspaces_t& cache = workspaces();
+    if (cache.size() == max_size)
+      cache.erase(cache.begin());
+    cache.push_back(std::move(workspace));
+  }
+
+  /**
+   * Return the number of idle workspaces in the cache.
+   */
+  static size_t size() { return workspaces().size(); }
+};
+
+template <typename Tag>
+constexpr size_t cvodes_workspace_cache<Tag>::max_size;
+
+}  // namespace math
+}  // namespace stan
+#endif
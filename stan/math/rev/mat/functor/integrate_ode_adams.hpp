@@ -3,6 +3,7 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/mat/functor/cvodes_integrator.hpp>
+#include <stan/math/rev/mat/functor/cvodes_adjoint_integrator.hpp>
 #include <ostream>
 #include <vector>
 
@@ -27,6 +28,35 @@ integrate_ode_adams(const F& f, const std::vector<T_initial>& y0,
                               max_num_steps);
 }
 
+/**
+ * Return the solutions of the specified system of ordinary
+ * differential equations at the specified times, computing the
+ * gradients with adjoint instead of forward sensitivities.  The
+ * solution is a single node on the autodiff stack and the adjoint
+ * system is integrated backward once per gradient, which is cheaper
+ * than <code>integrate_ode_adams</code> when there are many more
+ * parameters than states.  The times are data.
+ *
+ * @param[in] num_steps_between_checkpoints number of integration
+ * steps between two checkpoints of the forward solution
+ * @see integrate_ode_adams for the other arguments
+ */
+template <typename F, typename T_initial, typename T_param>
+std::vector<std::vector<typename stan::return_type<T_initial, T_param>::type>>
+integrate_ode_adams_adjoint(
+    const F& f, const std::vector<T_initial>& y0, double t0,
+    const std::vector<double>& ts, const std::vector<T_param>& theta,
+    const std::vector<double>& x, const std::vector<int>& x_int,
+    std::ostream* msgs = nullptr, double relative_tolerance = 1e-10,
+    double absolute_tolerance = 1e-10,
+    long int max_num_steps = 1e8,                  // NOLINT(runtime/int)
+    long int num_steps_between_checkpoints = 150) {  // NOLINT(runtime/int)
+  stan::math::cvodes_adjoint_integrator<CV_ADAMS> integrator;
+  return integrator.integrate(f, y0, t0, ts, theta, x, x_int, msgs,
+                              relative_tolerance, absolute_tolerance,
+                              max_num_steps, num_steps_between_checkpoints);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
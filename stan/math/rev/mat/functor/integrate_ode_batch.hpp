@@ -0,0 +1,276 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_BATCH_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_BATCH_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/arr/functor/integrate_ode_rk45.hpp>
+#include <stan/math/prim/arr/functor/ode_statistics.hpp>
+#include <stan/math/prim/mat/functor/map_rect_concurrent.hpp>
+#include <stan/math/rev/arr/functor/ode_store_sensitivities.hpp>
+#include <stan/math/rev/mat/functor/integrate_ode_bdf.hpp>
+#include <stan/math/rev/mat/functor/integrate_ode_adams.hpp>
+#include <future>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+/**
+ * Solve the ODE of one subject of a batch on a nested autodiff stack
+ * of the calling thread and return the values and sensitivities at
+ * all output times in the layout of the coupled states, see
+ * <code>ode_store_sensitivities</code>.  The solver passes the
+ * coupled states to an observer instead of storing the solutions,
+ * and only doubles are passed in and out, such that the solve can
+ * run on any thread.
+ *
+ * @tparam T1 type of scalars for initial values of the caller
+ * @tparam T2 type of scalars for parameters of the caller
+ * @tparam Solve type of the ODE solver
+ */
+template <typename T1, typename T2, typename Solve>
+std::vector<double> ode_batch_solve(const Solve& solve,
+                                    const std::vector<double>& y0, double t0,
+                                    const std::vector<double>& ts,
+                                    const std::vector<double>& theta,
+                                    const std::vector<double>& x,
+                                    const std::vector<int>& x_int,
+                                    std::ostream* msgs) {
+  std::vector<double> coupled_states;
+  auto observer = [&](const std::vector<double>& coupled_state, double t) {
+    coupled_states.insert(coupled_states.end(), coupled_state.begin(),
+                          coupled_state.end());
+  };
+  start_nested();
+  try {
+    const std::vector<T1> y0_local(y0.begin(), y0.end());
+    const std::vector<T2> theta_local(theta.begin(), theta.end());
+    solve(y0_local, t0, ts, theta_local, x, x_int, msgs, observer);
+  } catch (const std::exception& e) {
+    recover_memory_nested();
+    throw;
+  }
+  recover_memory_nested();
+  return coupled_states;
+}
+
+/**
+ * Solve the ODEs of a batch of subjects, distributing the subjects
+ * over threads like <code>map_rect_concurrent</code>.  Each thread
+ * solves on its own autodiff stack and only the values and
+ * sensitivities are returned, from which the solutions of each
+ * subject are stored as a single node on the autodiff stack of the
+ * calling thread.
+ *
+ * @tparam T1 type of scalars for initial values.
+ * @tparam T2 type of scalars for parameters.
+ * @tparam Solve type of the ODE solver, called with initial state,
+ * initial time, output times, parameters, data, message stream and
+ * an observer of the coupled states
+ * @param[in] function name of the calling function
+ * @param[in] solve ODE solver
+ * @see integrate_ode_rk45_batch for the other arguments
+ */
+template <typename T1, typename T2, typename Solve>
+std::vector<std::vector<std::vector<typename stan::return_type<T1, T2>::type>>>
+ode_batch(const char* function, const Solve& solve,
+          const std::vector<std::vector<T1>>& y0, double t0,
+          const std::vector<std::vector<double>>& ts,
+          const std::vector<std::vector<T2>>& theta,
+          const std::vector<std::vector<double>>& x,
+          const std::vector<std::vector<int>>& x_int, std::ostream* msgs) {
+  const size_t num_subjects = y0.size();
+  check_size_match(function, "number of times", ts.size(),
+                   "number of initial states", num_subjects);
+  check_size_match(function, "number of parameters", theta.size(),
+                   "number of initial states", num_subjects);
+  check_size_match(function, "number of continuous data", x.size(),
+                   "number of initial states", num_subjects);
+  check_size_match(function, "number of integer data", x_int.size(),
+                   "number of initial states", num_subjects);
+
+  std::vector<std::vector<std::vector<
+      typename stan::return_type<T1, T2>::type>>>
+      y(num_subjects);
+  if (num_subjects == 0)
+    return y;
+
+  std::vector<std::vector<double>> y0_dbl(num_subjects);
+  std::vector<std::vector<double>> theta_dbl(num_subjects);
+  for (size_t j = 0; j < num_subjects; ++j) {
+    y0_dbl[j] = value_of(y0[j]);
+    theta_dbl[j] = value_of(theta[j]);
+  }
+  std::vector<std::vector<double>> coupled_states(num_subjects);
+
+  const ode_statistics::context statistics_context;
+
+  auto execute_chunk = [&](int start, int size) {
+#ifdef STAN_THREADS
+    ChainableStack thread_stack_instance;
+#endif
+    ode_statistics::scope statistics_scope(statistics_context);
+    for (int j = start; j < start + size; ++j)
+      coupled_states[j] = ode_batch_solve<T1, T2>(
+          solve, y0_dbl[j], t0, ts[j], theta_dbl[j], x[j], x_int[j], msgs);
+  };
+
+  std::vector<std::future<void>> futures
+      = concurrent_chunks(num_subjects, execute_chunk);
+  for (auto& future : futures)
+    future.get();
+
+  const std::vector<double> dy_dt;
+  for (size_t j = 0; j < num_subjects; ++j)
+    ode_store_sensitivities(y0[j], theta[j], ts[j], coupled_states[j], dy_dt,
+                            y[j]);
+  return y;
+}
+
+template <typename F>
+struct ode_batch_rk45 {
+  const F& f_;
+  double relative_tolerance_;
+  double absolute_tolerance_;
+  int max_num_steps_;
+
+  template <typename T1, typename T2, typename Observer>
+  void operator()(const std::vector<T1>& y0, double t0,
+                  const std::vector<double>& ts, const std::vector<T2>& theta,
+                  const std::vector<double>& x, const std::vector<int>& x_int,
+                  std::ostream* msgs, Observer& observer) const {
+    integrate_ode_rk45_observe(f_, y0, t0, ts, theta, x, x_int, msgs,
+                               relative_tolerance_, absolute_tolerance_,
+                               max_num_steps_, observer);
+  }
+};
+
+template <typename F, int Lmm>
+struct ode_batch_cvodes {
+  const F& f_;
+  double relative_tolerance_;
+  double absolute_tolerance_;
+  long int max_num_steps_;  // NOLINT(runtime/int)
+
+  template <typename T1, typename T2, typename Observer>
+  void operator()(const std::vector<T1>& y0, double t0,
+                  const std::vector<double>& ts, const std::vector<T2>& theta,
+                  const std::vector<double>& x, const std::vector<int>& x_int,
+                  std::ostream* msgs, Observer& observer) const {
+    cvodes_integrator<Lmm> integrator;
+    integrator.integrate_observe(f_, y0, t0, ts, theta, x, x_int, msgs,
+                                 relative_tolerance_, absolute_tolerance_,
+                                 max_num_steps_, cvodes_linear_solver(),
+                                 observer);
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the solutions of the same system of ordinary differential
+ * equations for a batch of independent subjects, each with its own
+ * initial state, output times, parameters and data, using
+ * <code>integrate_ode_rk45</code>.
+ *
+ * If compiled with STAN_THREADS, the subjects are solved concurrently
+ * on the number of threads given by the environment variable
+ * STAN_NUM_THREADS, see <code>map_rect</code>.  Each thread solves on
+ * its own autodiff stack and the solutions of each subject are a
+ * single node on the autodiff stack of the calling thread.  The
+ * statistics of the solves are recorded into the sink of the
+ * calling thread, see <code>ode_statistics</code>.
+ *
+ * @tparam F type of ODE system function.
+ * @tparam T1 type of scalars for initial values.
+ * @tparam T2 type of scalars for parameters.
+ * @param[in] f functor for the base ordinary differential equation.
+ * @param[in] y0 initial states, one per subject.
+ * @param[in] t0 initial time shared by all subjects.
+ * @param[in] ts times of the desired solutions, one strictly
+ * increasing vector per subject.
+ * @param[in] theta parameter vectors, one per subject.
+ * @param[in] x continuous data vectors, one per subject.
+ * @param[in] x_int integer data vectors, one per subject.
+ * @param[in, out] msgs the print stream for warning messages.
+ * @param[in] relative_tolerance relative tolerance of each solve.
+ * @param[in] absolute_tolerance absolute tolerance of each solve.
+ * @param[in] max_num_steps maximal number of steps of each solve.
+ * @return for each subject the solutions at its output times
+ * @throw std::invalid_argument if the number of subjects differs
+ * between the arguments
+ * @throw any exception of the solve of a subject
+ */
+template <typename F, typename T1, typename T2>
+std::vector<std::vector<std::vector<typename stan::return_type<T1, T2>::type>>>
+integrate_ode_rk45_batch(const F& f, const std::vector<std::vector<T1>>& y0,
+                         double t0, const std::vector<std::vector<double>>& ts,
+                         const std::vector<std::vector<T2>>& theta,
+                         const std::vector<std::vector<double>>& x,
+                         const std::vector<std::vector<int>>& x_int,
+                         std::ostream* msgs = nullptr,
+                         double relative_tolerance = 1e-6,
+                         double absolute_tolerance = 1e-6,
+                         int max_num_steps = 1e6) {
+  const internal::ode_batch_rk45<F> solve{f, relative_tolerance,
+                                          absolute_tolerance, max_num_steps};
+  return internal::ode_batch("integrate_ode_rk45_batch", solve, y0, t0, ts,
+                             theta, x, x_int, msgs);
+}
+
+/**
+ * Return the solutions of the same system of ordinary differential
+ * equations for a batch of independent subjects using
+ * <code>integrate_ode_bdf</code>.
+ *
+ * @see integrate_ode_rk45_batch for the arguments and threading
+ */
+template <typename F, typename T1, typename T2>
+std::vector<std::vector<std::vector<typename stan::return_type<T1, T2>::type>>>
+integrate_ode_bdf_batch(const F& f, const std::vector<std::vector<T1>>& y0,
+                        double t0, const std::vector<std::vector<double>>& ts,
+                        const std::vector<std::vector<T2>>& theta,
+                        const std::vector<std::vector<double>>& x,
+                        const std::vector<std::vector<int>>& x_int,
+                        std::ostream* msgs = nullptr,
+                        double relative_tolerance = 1e-10,
+                        double absolute_tolerance = 1e-10,
+                        long int max_num_steps = 1e8) {  // NOLINT(runtime/int)
+  const internal::ode_batch_cvodes<F, CV_BDF> solve{
+      f, relative_tolerance, absolute_tolerance, max_num_steps};
+  return internal::ode_batch("integrate_ode_bdf_batch", solve, y0, t0, ts,
+                             theta, x, x_int, msgs);
+}
+
+/**
+ * Return the solutions of the same system of ordinary differential
+ * equations for a batch of independent subjects using
+ * <code>integrate_ode_adams</code>.
+ *
+ * @see integrate_ode_rk45_batch for the arguments and threading
+ */
+template <typename F, typename T1, typename T2>
+std::vector<std::vector<std::vector<typename stan::return_type<T1, T2>::type>>>
+integrate_ode_adams_batch(const F& f, const std::vector<std::vector<T1>>& y0,
+                          double t0,
+                          const std::vector<std::vector<double>>& ts,
+                          const std::vector<std::vector<T2>>& theta,
+                          const std::vector<std::vector<double>>& x,
+                          const std::vector<std::vector<int>>& x_int,
+                          std::ostream* msgs = nullptr,
+                          double relative_tolerance = 1e-10,
+                          double absolute_tolerance = 1e-10,
+                          long int max_num_steps  // NOLINT(runtime/int)
+                          = 1e8) {
+  const internal::ode_batch_cvodes<F, CV_ADAMS> solve{
+      f, relative_tolerance, absolute_tolerance, max_num_steps};
+  return internal::ode_batch("integrate_ode_adams_batch", solve, y0, t0, ts,
+                             theta, x, x_int, msgs);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,99 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_EVENTS_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_EVENTS_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/mat/functor/cvodes_integrator.hpp>
+#include <cvodes/cvodes.h>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the solutions of a system of ordinary differential
+ * equations whose states are incremented at known event times, like
+ * by bolus doses, using the backward differentiation formula of
+ * CVODES.
+ *
+ * The solution jumps by the increment of an event at its time and a
+ * solution at an output time includes the events up to and at that
+ * time.  Events at the initial time are added to the initial state.
+ * The whole solve uses one CVODES memory and one sensitivity system,
+ * which is restarted at each event, and the solutions are a single
+ * node on the autodiff stack.
+ *
+ * If the increments are autodiff variables, the sensitivity system
+ * grows by N sensitivities for each event up to the last output
+ * time, so increments which are data should be passed as data.
+ *
+ * @tparam F type of ODE system function.
+ * @tparam T_initial type of scalars for initial values.
+ * @tparam T_param type of scalars for parameters.
+ * @tparam T_event type of scalars for the increments.
+ * @param[in] f functor for the base ordinary differential equation.
+ * @param[in] y0 initial state.
+ * @param[in] t0 initial time.
+ * @param[in] ts times of the desired solutions, in strictly
+ * increasing order, all greater than the initial time.
+ * @param[in] theta parameter vector for the ODE.
+ * @param[in] event_times times of the events in non-decreasing
+ * order, none less than the initial time.
+ * @param[in] event_increments increments of the states, one vector of
+ * the size of the state for each event.
+ * @param[in] x continuous data vector for the ODE.
+ * @param[in] x_int integer data vector for the ODE.
+ * @param[in, out] msgs the print stream for warning messages.
+ * @param[in] relative_tolerance relative tolerance passed to CVODE.
+ * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
+ * @param[in] max_num_steps maximal number of admissable steps
+ * between an output or event time and the next.
+ * @return a vector of states, each state being a vector of the
+ * same size as the state variable, corresponding to a time in ts.
+ */
+template <typename F, typename T_initial, typename T_param, typename T_event>
+std::vector<std::vector<
+    typename stan::return_type<T_initial, T_param, T_event>::type>>
+integrate_ode_bdf_events(
+    const F& f, const std::vector<T_initial>& y0, double t0,
+    const std::vector<double>& ts, const std::vector<T_param>& theta,
+    const std::vector<double>& event_times,
+    const std::vector<std::vector<T_event>>& event_increments,
+    const std::vector<double>& x, const std::vector<int>& x_int,
+    std::ostream* msgs = nullptr, double relative_tolerance = 1e-10,
+    double absolute_tolerance = 1e-10,
+    long int max_num_steps = 1e8) {  // NOLINT(runtime/int)
+  stan::math::cvodes_integrator<CV_BDF> integrator;
+  return integrator.integrate_events(
+      f, y0, t0, ts, theta, event_times, event_increments, x, x_int, msgs,
+      relative_tolerance, absolute_tolerance, max_num_steps);
+}
+
+/**
+ * Return the solutions of a system of ordinary differential
+ * equations whose states are incremented at known event times using
+ * the Adams-Moulton method of CVODES.
+ *
+ * @see integrate_ode_bdf_events for the arguments
+ */
+template <typename F, typename T_initial, typename T_param, typename T_event>
+std::vector<std::vector<
+    typename stan::return_type<T_initial, T_param, T_event>::type>>
+integrate_ode_adams_events(
+    const F& f, const std::vector<T_initial>& y0, double t0,
+    const std::vector<double>& ts, const std::vector<T_param>& theta,
+    const std::vector<double>& event_times,
+    const std::vector<std::vector<T_event>>& event_increments,
+    const std::vector<double>& x, const std::vector<int>& x_int,
+    std::ostream* msgs = nullptr, double relative_tolerance = 1e-10,
+    double absolute_tolerance = 1e-10,
+    long int max_num_steps = 1e8) {  // NOLINT(runtime/int)
+  stan::math::cvodes_integrator<CV_ADAMS> integrator;
+  return integrator.integrate_events(
+      f, y0, t0, ts, theta, event_times, event_increments, x, x_int, msgs,
+      relative_tolerance, absolute_tolerance, max_num_steps);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
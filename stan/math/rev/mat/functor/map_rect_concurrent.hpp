@@ -6,6 +6,7 @@
 #include <stan/math/prim/mat/functor/map_rect_concurrent.hpp>
 #include <stan/math/prim/mat/functor/map_rect_reduce.hpp>
 #include <stan/math/prim/mat/functor/map_rect_combine.hpp>
+#include <stan/math/prim/arr/functor/ode_statistics.hpp>
 #include <stan/math/rev/core/chainablestack.hpp>
 
 #include <vector>
@@ -31,12 +32,15 @@ map_rect_concurrent(
 
   const int num_jobs = job_params.size();
   const vector_d shared_params_dbl = value_of(shared_params);
-  std::vector<std::future<std::vector<matrix_d>>> futures;
+  // ODE solves of the jobs are recorded into the ODE statistics of
+  // the calling thread
+  const ode_statistics::context statistics_context;
 
   auto execute_chunk = [&](int start, int size) -> std::vector<matrix_d> {
 #ifdef STAN_THREADS
     ChainableStack thread_stack_instance;
 #endif
+    ode_statistics::scope statistics_scope(statistics_context);
     const int end = start + size;
     std::vector<matrix_d> chunk_f_out;
     chunk_f_out.reserve(size);
@@ -46,24 +50,8 @@ map_rect_concurrent(
     return chunk_f_out;
   };
 
-  int num_threads = get_num_threads(num_jobs);
-  int num_jobs_per_thread = num_jobs / num_threads;
-  futures.emplace_back(
-      std::async(std::launch::deferred, execute_chunk, 0, num_jobs_per_thread));
-
-#ifdef STAN_THREADS
-  if (num_threads > 1) {
-    const int num_big_threads = num_jobs % num_threads;
-    const int first_big_thread = num_threads - num_big_threads;
-    for (int i = 1, job_start = num_jobs_per_thread, job_size = 0;
-         i < num_threads; ++i, job_start += job_size) {
-      job_size = i >= first_big_thread ? num_jobs_per_thread + 1
-                                       : num_jobs_per_thread;
-      futures.emplace_back(
-          std::async(std::launch::async, execute_chunk, job_start, job_size));
-    }
-  }
-#endif
+  std::vector<std::future<std::vector<matrix_d>>> futures
+      = concurrent_chunks(num_jobs, execute_chunk);
 
   // collect results
   std::vector<int> world_f_out;
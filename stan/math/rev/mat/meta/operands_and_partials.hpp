@@ -25,7 +25,8 @@ class ops_partials_edge<double, std::vector<var> > {
         operands_(op) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -55,7 +56,8 @@ class ops_partials_edge<double, Eigen::Matrix<var, R, C> > {
         operands_(ops) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -88,7 +90,8 @@ class ops_partials_edge<double, std::vector<Eigen::Matrix<var, R, C> > > {
   }
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -129,7 +132,8 @@ class ops_partials_edge<double, std::vector<std::vector<var> > > {
   }
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const Op& operands_;
 
@@ -21,7 +21,8 @@ class ops_partials_edge<double, var> {
       : partial_(0), partials_(partial_), operand_(op) {}
 
  private:
-  template <typename, typename, typename, typename, typename, typename>
+  template <typename, typename, typename, typename, typename, typename,
+            typename, typename>
   friend class stan::math::operands_and_partials;
   const var& operand_;
 
@@ -63,15 +64,20 @@ class ops_partials_edge<double, var> {
  * @tparam Op3 type of the third operand
  * @tparam Op4 type of the fourth operand
  * @tparam Op5 type of the fifth operand
+ * @tparam Op6 type of the sixth operand
+ * @tparam Op7 type of the seventh operand
  */
-template <typename Op1, typename Op2, typename Op3, typename Op4, typename Op5>
-class operands_and_partials<Op1, Op2, Op3, Op4, Op5, var> {
+template <typename Op1, typename Op2, typename Op3, typename Op4, typename Op5,
+          typename Op6, typename Op7>
+class operands_and_partials<Op1, Op2, Op3, Op4, Op5, Op6, Op7, var> {
  public:
   internal::ops_partials_edge<double, Op1> edge1_;
   internal::ops_partials_edge<double, Op2> edge2_;
   internal::ops_partials_edge<double, Op3> edge3_;
   internal::ops_partials_edge<double, Op4> edge4_;
   internal::ops_partials_edge<double, Op5> edge5_;
+  internal::ops_partials_edge<double, Op6> edge6_;
+  internal::ops_partials_edge<double, Op7> edge7_;
 
   explicit operands_and_partials(const Op1& o1) : edge1_(o1) {}
   operands_and_partials(const Op1& o1, const Op2& o2)
@@ -84,6 +90,24 @@ class operands_and_partials<Op1, Op2, Op3, Op4, Op5, var> {
   operands_and_partials(const Op1& o1, const Op2& o2, const Op3& o3,
                         const Op4& o4, const Op5& o5)
       : edge1_(o1), edge2_(o2), edge3_(o3), edge4_(o4), edge5_(o5) {}
+  operands_and_partials(const Op1& o1, const Op2& o2, const Op3& o3,
+                        const Op4& o4, const Op5& o5, const Op6& o6)
+      : edge1_(o1),
+        edge2_(o2),
+        edge3_(o3),
+        edge4_(o4),
+        edge5_(o5),
+        edge6_(o6) {}
+  operands_and_partials(const Op1& o1, const Op2& o2, const Op3& o3,
+                        const Op4& o4, const Op5& o5, const Op6& o6,
+                        const Op7& o7)
+      : edge1_(o1),
+        edge2_(o2),
+        edge3_(o3),
+        edge4_(o4),
+        edge5_(o5),
+        edge6_(o6),
+        edge7_(o7) {}
 
   /**
    * Build the node to be stored on the autodiff graph.
@@ -100,7 +124,7 @@ class operands_and_partials<Op1, Op2, Op3, Op4, Op5, var> {
    */
   var build(double value) {
     size_t size = edge1_.size() + edge2_.size() + edge3_.size() + edge4_.size()
-                  + edge5_.size();
+                  + edge5_.size() + edge6_.size() + edge7_.size();
     vari** varis
         = ChainableStack::instance_->memalloc_.alloc_array<vari*>(size);
     double* partials
@@ -116,6 +140,10 @@ class operands_and_partials<Op1, Op2, Op3, Op4, Op5, var> {
     edge4_.dump_partials(&partials[idx]);
     edge5_.dump_operands(&varis[idx += edge4_.size()]);
     edge5_.dump_partials(&partials[idx]);
+    edge6_.dump_operands(&varis[idx += edge5_.size()]);
+    edge6_.dump_partials(&partials[idx]);
+    edge7_.dump_operands(&varis[idx += edge6_.size()]);
+    edge7_.dump_partials(&partials[idx]);
 
     return var(new precomputed_gradients_vari(value, size, varis, partials));
   }
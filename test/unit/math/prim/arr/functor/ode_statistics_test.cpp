@@ -0,0 +1,168 @@
+#include <stan/math/prim/arr.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::vector<std::vector<double>> solve_harm_osc(int max_num_steps = 1e6) {
+  std::vector<double> y0 = {1.0, 0.0};
+  std::vector<double> theta = {0.15};
+  std::vector<double> ts = {1.0, 5.0, 10.0};
+  return stan::math::integrate_ode_rk45(harm_osc_ode_fun(), y0, 0.0, ts, theta,
+                                        std::vector<double>(),
+                                        std::vector<int>(), nullptr, 1e-6,
+                                        1e-6, max_num_steps);
+}
+
+}  // namespace
+
+TEST(StanMathOdeStatistics, off_by_default) {
+  using stan::math::ode_statistics;
+  ode_statistics::reset();
+  EXPECT_FALSE(ode_statistics::enabled());
+  solve_harm_osc();
+  EXPECT_TRUE(ode_statistics::sites().empty());
+}
+
+TEST(StanMathOdeStatistics, rk45) {
+  using stan::math::ode_solver_statistics;
+  using stan::math::ode_statistics;
+  ode_statistics::reset();
+  ode_statistics::enable();
+  std::vector<std::vector<double>> y = solve_harm_osc();
+  solve_harm_osc();
+  ode_statistics::enable(false);
+
+  ASSERT_EQ(1U, ode_statistics::sites().size());
+  const ode_solver_statistics& s
+      = ode_statistics::sites().at("integrate_ode_rk45");
+  EXPECT_EQ(2U, s.num_solves_);
+  EXPECT_EQ(0U, s.num_failures_);
+  EXPECT_GT(s.num_steps_, 0);
+  // dopri5 evaluates the right hand side six times per step
+  EXPECT_GE(s.num_rhs_evals_, 6 * s.num_steps_);
+  EXPECT_EQ(0, s.num_sensitivity_rhs_evals_);
+  EXPECT_EQ(0, s.num_jacobian_evals_);
+  EXPECT_EQ(0, s.num_nonlinear_iterations_);
+  EXPECT_EQ(0, s.num_error_test_failures_);
+  EXPECT_GT(s.forward_seconds_, 0.0);
+  EXPECT_EQ(0.0, s.sensitivity_seconds_);
+
+  // collection does not change the solution
+  std::vector<std::vector<double>> y_off = solve_harm_osc();
+  for (size_t n = 0; n < y.size(); ++n)
+    for (size_t i = 0; i < 2; ++i)
+      EXPECT_EQ(y[n][i], y_off[n][i]);
+  EXPECT_EQ(2U, ode_statistics::sites().at("integrate_ode_rk45").num_solves_);
+  ode_statistics::reset();
+  EXPECT_TRUE(ode_statistics::sites().empty());
+}
+
+TEST(StanMathOdeStatistics, call_sites) {
+  using stan::math::ode_statistics;
+  ode_statistics::reset();
+  ode_statistics::enable();
+  {
+    ode_statistics::call_site outer("absorption");
+    solve_harm_osc();
+    {
+      ode_statistics::call_site inner("elimination");
+      solve_harm_osc();
+      solve_harm_osc();
+    }
+    solve_harm_osc();
+  }
+  solve_harm_osc();
+  ode_statistics::enable(false);
+
+  const ode_statistics::sites_t& sites = ode_statistics::sites();
+  ASSERT_EQ(3U, sites.size());
+  EXPECT_EQ(2U, sites.at("absorption").num_solves_);
+  EXPECT_EQ(2U, sites.at("elimination").num_solves_);
+  EXPECT_EQ(1U, sites.at("integrate_ode_rk45").num_solves_);
+  EXPECT_EQ(sites.at("absorption").num_steps_,
+            sites.at("elimination").num_steps_);
+  ode_statistics::reset();
+}
+
+TEST(StanMathOdeStatistics, failed_solve) {
+  using stan::math::ode_statistics;
+  ode_statistics::reset();
+  ode_statistics::enable();
+  EXPECT_THROW(solve_harm_osc(5), std::runtime_error);
+  ode_statistics::enable(false);
+
+  const stan::math::ode_solver_statistics& s
+      = ode_statistics::sites().at("integrate_ode_rk45");
+  EXPECT_EQ(1U, s.num_solves_);
+  EXPECT_EQ(1U, s.num_failures_);
+  EXPECT_GT(s.num_rhs_evals_, 0);
+  ode_statistics::reset();
+}
+
+TEST(StanMathOdeStatistics, accumulate) {
+  stan::math::ode_solver_statistics a, b;
+  a.num_solves_ = 1;
+  a.num_steps_ = 10;
+  a.forward_seconds_ = 0.5;
+  b.num_solves_ = 2;
+  b.num_failures_ = 1;
+  b.num_steps_ = 5;
+  b.num_jacobian_evals_ = 3;
+  b.sensitivity_seconds_ = 0.25;
+  a += b;
+  EXPECT_EQ(3U, a.num_solves_);
+  EXPECT_EQ(1U, a.num_failures_);
+  EXPECT_EQ(15, a.num_steps_);
+  EXPECT_EQ(3, a.num_jacobian_evals_);
+  EXPECT_EQ(0.5, a.forward_seconds_);
+  EXPECT_EQ(0.25, a.sensitivity_seconds_);
+}
+
+TEST(StanMathOdeStatistics, scope) {
+  using stan::math::ode_statistics;
+  ode_statistics::reset();
+
+  // nothing is passed on if collection is off
+  const ode_statistics::context context_off;
+  {
+    ode_statistics::scope scope(context_off);
+    EXPECT_FALSE(ode_statistics::enabled());
+    solve_harm_osc();
+  }
+  EXPECT_TRUE(ode_statistics::sites().empty());
+
+  ode_statistics::enable();
+  std::unique_ptr<ode_statistics::context> context;
+  {
+    ode_statistics::call_site site("population");
+    context.reset(new ode_statistics::context());
+  }
+  solve_harm_osc();
+  ode_statistics::enable(false);
+
+  // solves in a scope are recorded under the call site passed in,
+  // with collection switched on for the scope only
+  {
+    ode_statistics::scope scope(*context);
+    EXPECT_TRUE(ode_statistics::enabled());
+    solve_harm_osc();
+    {
+      ode_statistics::call_site site("subject");
+      solve_harm_osc();
+    }
+    solve_harm_osc();
+  }
+  EXPECT_FALSE(ode_statistics::enabled());
+  solve_harm_osc();
+
+  const ode_statistics::sites_t& sites = ode_statistics::sites();
+  ASSERT_EQ(3U, sites.size());
+  EXPECT_EQ(1U, sites.at("integrate_ode_rk45").num_solves_);
+  EXPECT_EQ(2U, sites.at("population").num_solves_);
+  EXPECT_EQ(1U, sites.at("subject").num_solves_);
+  ode_statistics::reset();
+}
@@ -0,0 +1,46 @@
+#include <stan/math/prim/arr.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <ostream>
+#include <vector>
+
+namespace {
+
+struct jacobian_y_ode_fun : public harm_osc_ode_fun {
+  std::vector<std::vector<double>> jacobian_y(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    return {{0.0, 1.0}, {-1.0, -theta[0]}};
+  }
+};
+
+struct jacobian_ode_fun : public jacobian_y_ode_fun {
+  std::vector<std::vector<double>> jacobian_theta(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    return {{0.0}, {-y[1]}};
+  }
+};
+
+struct wrong_jacobian_ode_fun : public harm_osc_ode_fun {
+  double jacobian_y(double t, const std::vector<double>& y) const {
+    return 0;
+  }
+};
+
+}  // namespace
+
+TEST(MetaTraits, has_ode_jacobian) {
+  using stan::has_ode_jacobian_theta;
+  using stan::has_ode_jacobian_y;
+
+  EXPECT_FALSE(has_ode_jacobian_y<harm_osc_ode_fun>::value);
+  EXPECT_FALSE(has_ode_jacobian_theta<harm_osc_ode_fun>::value);
+  EXPECT_TRUE(has_ode_jacobian_y<jacobian_y_ode_fun>::value);
+  EXPECT_FALSE(has_ode_jacobian_theta<jacobian_y_ode_fun>::value);
+  EXPECT_TRUE(has_ode_jacobian_y<jacobian_ode_fun>::value);
+  EXPECT_TRUE(has_ode_jacobian_theta<jacobian_ode_fun>::value);
+  EXPECT_FALSE(has_ode_jacobian_y<wrong_jacobian_ode_fun>::value);
+}
@@ -153,3 +153,39 @@ TEST(SparseStuff, csr_matrix_times_vector_v_short) {
   EXPECT_THROW(stan::math::csr_matrix_times_vector(2, 3, X_w, X_v, X_u, b),
                std::invalid_argument);
 }
+
+// Test that the pre-validated structure gives the same product.
+TEST(SparseStuff, csr_matrix_times_vector_structure) {
+  stan::math::matrix_d m(3, 3);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a;
+  m << 2.0, 0.0, 6.0, 0.0, 0.0, 0.0, 0.0, 10.0, 12.0;
+  a = m.sparseView();
+
+  stan::math::vector_d X_w = stan::math::csr_extract_w(a);
+  std::vector<int> X_v = stan::math::csr_extract_v(a);
+  std::vector<int> X_u = stan::math::csr_extract_u(a);
+  stan::math::csr_structure X(3, 3, X_v, X_u);
+  EXPECT_EQ(3, X.rows());
+  EXPECT_EQ(3, X.cols());
+  EXPECT_EQ(4, X.nonzeros());
+
+  stan::math::vector_d b(3);
+  b << 22, 33, 44;
+  stan::math::vector_d result = stan::math::csr_matrix_times_vector(X, X_w, b);
+  EXPECT_FLOAT_EQ(308.0, result(0));
+  EXPECT_FLOAT_EQ(0.0, result(1));
+  EXPECT_FLOAT_EQ(858.0, result(2));
+
+  stan::math::vector_d b_short(2);
+  b_short << 1, 2;
+  EXPECT_THROW(stan::math::csr_matrix_times_vector(X, X_w, b_short),
+               std::invalid_argument);
+  stan::math::vector_d w_short = X_w.head(3);
+  EXPECT_THROW(stan::math::csr_matrix_times_vector(X, w_short, b),
+               std::invalid_argument);
+
+  std::vector<int> v_bad = X_v;
+  v_bad[0] = 4;
+  EXPECT_THROW(stan::math::csr_structure(3, 3, v_bad, X_u), std::out_of_range);
+  EXPECT_THROW(stan::math::csr_structure(0, 3, X_v, X_u), std::domain_error);
+}
@@ -0,0 +1,40 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+
+TEST(MathMatrix, sparse_cholesky_decompose) {
+  Eigen::MatrixXd A = 4 * Eigen::MatrixXd::Identity(5, 5);
+  A(1, 0) = A(0, 1) = 1;
+  A(3, 0) = A(0, 3) = 0.5;
+  A(2, 1) = A(1, 2) = -0.7;
+  A(4, 3) = A(3, 4) = 0.3;
+  Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+
+  Eigen::MatrixXd L = A.llt().matrixL();
+  Eigen::MatrixXd L_sparse
+      = Eigen::MatrixXd(stan::math::sparse_cholesky_decompose(A_sparse));
+  for (int i = 0; i < 5; ++i)
+    for (int j = 0; j < 5; ++j)
+      EXPECT_NEAR(L(i, j), L_sparse(i, j), 1e-12);
+
+  EXPECT_FLOAT_EQ(std::log(A.determinant()),
+                  stan::math::log_determinant_spd(A_sparse));
+}
+
+TEST(MathMatrix, sparse_cholesky_decompose_exception) {
+  Eigen::MatrixXd A = 4 * Eigen::MatrixXd::Identity(3, 3);
+  A(1, 0) = 1;
+  Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+  EXPECT_THROW(stan::math::sparse_cholesky_decompose(A_sparse),
+               std::domain_error);
+
+  A(0, 1) = 1;
+  A(2, 2) = -1;
+  A_sparse = A.sparseView();
+  EXPECT_THROW(stan::math::sparse_cholesky_decompose(A_sparse),
+               std::domain_error);
+  EXPECT_THROW(stan::math::log_determinant_spd(A_sparse), std::domain_error);
+
+  Eigen::SparseMatrix<double> B(2, 3);
+  EXPECT_THROW(stan::math::sparse_cholesky_decompose(B),
+               std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+#include <stan/math/prim/mat/functor/task_graph.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+// a serial program on a few accumulators, in which each task
+// combines the values of some of them into another
+void add_program(stan::math::internal::task_graph& graph,
+                 std::vector<double>& x) {
+  const int n = x.size();
+  for (int step = 0; step < 200; ++step) {
+    const int a = (7 * step) % n;
+    const int b = (3 * step + 1) % n;
+    const int c = (5 * step + 2) % n;
+    graph.add({a, b}, {c}, [&x, a, b, c, step]() {
+      x[c] = 0.5 * x[c] + 0.25 * x[a] - 0.125 * x[b] + step;
+      return true;
+    });
+  }
+}
+}  // namespace
+
+TEST(task_graph, matches_program_order) {
+  std::vector<double> x_serial(11);
+  for (size_t i = 0; i < x_serial.size(); ++i)
+    x_serial[i] = i;
+  std::vector<double> x_threads = x_serial;
+
+  stan::math::internal::task_graph serial(x_serial.size());
+  add_program(serial, x_serial);
+  EXPECT_EQ(200, serial.size());
+  EXPECT_TRUE(serial.run(1));
+
+  stan::math::internal::task_graph threads(x_threads.size());
+  add_program(threads, x_threads);
+  EXPECT_TRUE(threads.run(4));
+
+  for (size_t i = 0; i < x_serial.size(); ++i)
+    EXPECT_EQ(x_serial[i], x_threads[i]);
+}
+
+TEST(task_graph, stops_on_failure) {
+  for (int num_threads : {1, 3}) {
+    std::vector<int> counts(2, 0);
+    stan::math::internal::task_graph graph(2);
+    graph.add({}, {0}, [&counts]() {
+      ++counts[0];
+      return false;
+    });
+    for (int k = 0; k < 5; ++k)
+      graph.add({0}, {1}, [&counts]() {
+        ++counts[1];
+        return true;
+      });
+    EXPECT_FALSE(graph.run(num_threads));
+    EXPECT_EQ(1, counts[0]);
+    EXPECT_EQ(0, counts[1]);
+  }
+}
+
+TEST(task_graph, rethrows) {
+  for (int num_threads : {1, 3}) {
+    stan::math::internal::task_graph graph(1);
+    graph.add({}, {0}, []() { return true; });
+    graph.add({}, {0}, []() -> bool { throw std::domain_error("task"); });
+    graph.add({0}, {}, []() { return true; });
+    EXPECT_THROW(graph.run(num_threads), std::domain_error);
+  }
+}
@@ -80,3 +80,29 @@ TEST(ProbDistributionsCategoricalLogit, error) {
   ns[1] = 12;
   EXPECT_THROW(categorical_logit_log(ns, theta), std::domain_error);
 }
+
+TEST(ProbDistributionsCategoricalLogit, CategoricalMatrix) {
+  using stan::math::categorical_logit_lpmf;
+  Matrix<double, Dynamic, Dynamic> beta(4, 3);
+  beta << -1, 2, -10, 0.5, 0.5, 0.5, 3, -2, 1, 800, 799, -800;
+  std::vector<int> ns = {1, 3, 2, 2};
+
+  double lp = 0;
+  for (int i = 0; i < 4; ++i)
+    lp += categorical_logit_lpmf(
+        ns[i], Matrix<double, Dynamic, 1>(beta.row(i).transpose()));
+  EXPECT_FLOAT_EQ(lp, categorical_logit_lpmf(ns, beta));
+  EXPECT_FLOAT_EQ(0, categorical_logit_lpmf<true>(ns, beta));
+  Matrix<double, Dynamic, Dynamic> beta_empty(0, 3);
+  EXPECT_FLOAT_EQ(0, categorical_logit_lpmf(std::vector<int>(0), beta_empty));
+
+  EXPECT_THROW(categorical_logit_lpmf(std::vector<int>(3, 1), beta),
+               std::invalid_argument);
+  ns[2] = 4;
+  EXPECT_THROW(categorical_logit_lpmf(ns, beta), std::domain_error);
+  ns[2] = 0;
+  EXPECT_THROW(categorical_logit_lpmf(ns, beta), std::domain_error);
+  ns[2] = 1;
+  beta(1, 1) = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(categorical_logit_lpmf(ns, beta), std::domain_error);
+}
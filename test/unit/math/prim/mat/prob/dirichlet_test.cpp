@@ -163,3 +163,40 @@ TEST(ProbDistributionsDirichlet, random) {
   beta << 0.001, 0.0001, 1e-10;
   EXPECT_NO_THROW(stan::math::dirichlet_rng(beta, rng));
 }
+
+TEST(ProbDistributions, DirichletVectorized) {
+  using stan::math::dirichlet_log;
+  std::vector<VectorXd> thetas(3, VectorXd(3));
+  thetas[0] << 0.2, 0.3, 0.5;
+  thetas[1] << 0.1, 0.6, 0.3;
+  thetas[2] << 0.7, 0.2, 0.1;
+  std::vector<VectorXd> alphas(3, VectorXd(3));
+  alphas[0] << 1.0, 2.0, 3.0;
+  alphas[1] << 0.5, 4.0, 1.5;
+  alphas[2] << 2.5, 1.2, 0.8;
+
+  double lp_shared = 0;
+  double lp_each = 0;
+  double lp_each_propto = 0;
+  for (int t = 0; t < 3; ++t) {
+    lp_shared += dirichlet_log(thetas[t], alphas[0]);
+    lp_each += dirichlet_log(thetas[t], alphas[t]);
+    lp_each_propto += dirichlet_log<true>(thetas[t], alphas[t]);
+  }
+  EXPECT_FLOAT_EQ(lp_shared, dirichlet_log(thetas, alphas[0]));
+  EXPECT_FLOAT_EQ(lp_each, dirichlet_log(thetas, alphas));
+  EXPECT_FLOAT_EQ(lp_each_propto, dirichlet_log<true>(thetas, alphas));
+  EXPECT_FLOAT_EQ(3 * dirichlet_log(thetas[1], alphas[1]),
+                  dirichlet_log(thetas[1], std::vector<VectorXd>(3, alphas[1])));
+
+  std::vector<VectorXd> bad_thetas = thetas;
+  bad_thetas[2] << 0.7, 0.2, 0.2;
+  EXPECT_THROW(dirichlet_log(bad_thetas, alphas), std::domain_error);
+  std::vector<VectorXd> bad_alphas = alphas;
+  bad_alphas[1](0) = -1;
+  EXPECT_THROW(dirichlet_log(thetas, bad_alphas), std::domain_error);
+  EXPECT_THROW(dirichlet_log(thetas, std::vector<VectorXd>(2, alphas[0])),
+               std::invalid_argument);
+  EXPECT_THROW(dirichlet_log(thetas, VectorXd(VectorXd::Ones(4))),
+               std::invalid_argument);
+}
@@ -0,0 +1,174 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+namespace {
+
+// log marginal density by summing over every hidden state path
+double hmm_marginal_brute_force(const MatrixXd& log_omegas,
+                                const MatrixXd& Gamma, const VectorXd& rho) {
+  const int K = log_omegas.rows();
+  const int N = log_omegas.cols();
+  std::vector<int> z(N, 0);
+  double marginal = 0;
+  while (true) {
+    double p = rho(z[0]) * std::exp(log_omegas(z[0], 0));
+    for (int n = 1; n < N; ++n)
+      p *= Gamma(z[n - 1], z[n]) * std::exp(log_omegas(z[n], n));
+    marginal += p;
+    int n = 0;
+    while (n < N && ++z[n] == K)
+      z[n++] = 0;
+    if (n == N)
+      break;
+  }
+  return std::log(marginal);
+}
+
+// posterior probability of state k at observation m, by enumeration
+double hmm_state_prob_brute_force(const MatrixXd& log_omegas,
+                                  const MatrixXd& Gamma, const VectorXd& rho,
+                                  int k, int m) {
+  MatrixXd log_omegas_k = log_omegas;
+  for (int j = 0; j < log_omegas.rows(); ++j)
+    if (j != k)
+      log_omegas_k(j, m) = -std::numeric_limits<double>::infinity();
+  return std::exp(hmm_marginal_brute_force(log_omegas_k, Gamma, rho)
+                  - hmm_marginal_brute_force(log_omegas, Gamma, rho));
+}
+
+struct hmm_fixture {
+  MatrixXd log_omegas;
+  MatrixXd Gamma;
+  VectorXd rho;
+
+  hmm_fixture() : log_omegas(3, 5), Gamma(3, 3), rho(3) {
+    log_omegas << -1.2, -0.3, -2.5, -0.7, -1.9, -0.4, -1.8, -0.2, -3.1, -0.6,
+        -2.2, -0.9, -1.1, -0.5, -1.4;
+    Gamma << 0.8, 0.15, 0.05, 0.1, 0.7, 0.2, 0.25, 0.25, 0.5;
+    rho << 0.5, 0.3, 0.2;
+  }
+};
+
+}  // namespace
+
+TEST(ProbDistributionsHmm, marginal_matches_enumeration) {
+  hmm_fixture d;
+  EXPECT_FLOAT_EQ(hmm_marginal_brute_force(d.log_omegas, d.Gamma, d.rho),
+                  stan::math::hmm_marginal(d.log_omegas, d.Gamma, d.rho));
+}
+
+TEST(ProbDistributionsHmm, marginal_single_state) {
+  MatrixXd log_omegas(1, 4);
+  log_omegas << -1, -2, -3, -4;
+  MatrixXd Gamma(1, 1);
+  Gamma << 1;
+  VectorXd rho(1);
+  rho << 1;
+  EXPECT_FLOAT_EQ(-10, stan::math::hmm_marginal(log_omegas, Gamma, rho));
+}
+
+TEST(ProbDistributionsHmm, marginal_no_observations) {
+  hmm_fixture d;
+  MatrixXd log_omegas(3, 0);
+  EXPECT_FLOAT_EQ(0, stan::math::hmm_marginal(log_omegas, d.Gamma, d.rho));
+}
+
+TEST(ProbDistributionsHmm, marginal_long_series_is_finite) {
+  hmm_fixture d;
+  MatrixXd log_omegas(3, 20000);
+  for (int n = 0; n < log_omegas.cols(); ++n)
+    log_omegas.col(n) = d.log_omegas.col(n % 5).array() - 50;
+  double lp = stan::math::hmm_marginal(log_omegas, d.Gamma, d.rho);
+  EXPECT_TRUE(std::isfinite(lp));
+  EXPECT_LT(lp, -1e6);
+}
+
+TEST(ProbDistributionsHmm, marginal_zero_probability) {
+  using stan::math::hmm_hidden_state_prob;
+  using stan::math::hmm_marginal;
+  const double inf = std::numeric_limits<double>::infinity();
+  hmm_fixture d;
+
+  MatrixXd log_omegas = d.log_omegas;
+  log_omegas.col(2).setConstant(-inf);
+  EXPECT_EQ(-inf, hmm_marginal(log_omegas, d.Gamma, d.rho));
+  EXPECT_THROW(hmm_hidden_state_prob(log_omegas, d.Gamma, d.rho),
+               std::domain_error);
+
+  // only the second state has a nonzero density at the second
+  // observation and it cannot be reached from the first state
+  MatrixXd Gamma(2, 2);
+  Gamma << 1, 0, 0, 1;
+  VectorXd rho(2);
+  rho << 1, 0;
+  MatrixXd log_omegas_unreachable(2, 3);
+  log_omegas_unreachable << -1, -inf, -1, -2, -0.5, -2;
+  EXPECT_EQ(-inf, hmm_marginal(log_omegas_unreachable, Gamma, rho));
+  EXPECT_THROW(hmm_hidden_state_prob(log_omegas_unreachable, Gamma, rho),
+               std::domain_error);
+}
+
+TEST(ProbDistributionsHmm, hidden_state_prob_matches_enumeration) {
+  hmm_fixture d;
+  MatrixXd probs
+      = stan::math::hmm_hidden_state_prob(d.log_omegas, d.Gamma, d.rho);
+  ASSERT_EQ(3, probs.rows());
+  ASSERT_EQ(5, probs.cols());
+  for (int n = 0; n < 5; ++n) {
+    EXPECT_FLOAT_EQ(1, probs.col(n).sum());
+    for (int k = 0; k < 3; ++k)
+      EXPECT_FLOAT_EQ(
+          hmm_state_prob_brute_force(d.log_omegas, d.Gamma, d.rho, k, n),
+          probs(k, n));
+  }
+}
+
+TEST(ProbDistributionsHmm, errors) {
+  using stan::math::hmm_hidden_state_prob;
+  using stan::math::hmm_marginal;
+  hmm_fixture d;
+
+  MatrixXd Gamma_bad = d.Gamma;
+  Gamma_bad(1, 1) = 0.8;
+  EXPECT_THROW(hmm_marginal(d.log_omegas, Gamma_bad, d.rho),
+               std::domain_error);
+  EXPECT_THROW(hmm_hidden_state_prob(d.log_omegas, Gamma_bad, d.rho),
+               std::domain_error);
+
+  VectorXd rho_bad = d.rho;
+  rho_bad(0) = 0.1;
+  EXPECT_THROW(hmm_marginal(d.log_omegas, d.Gamma, rho_bad),
+               std::domain_error);
+
+  MatrixXd log_omegas_nan = d.log_omegas;
+  log_omegas_nan(2, 3) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(hmm_marginal(log_omegas_nan, d.Gamma, d.rho),
+               std::domain_error);
+
+  MatrixXd Gamma_rect(3, 2);
+  Gamma_rect << 0.5, 0.5, 0.5, 0.5, 0.5, 0.5;
+  EXPECT_THROW(hmm_marginal(d.log_omegas, Gamma_rect, d.rho),
+               std::invalid_argument);
+
+  VectorXd rho_short(2);
+  rho_short << 0.5, 0.5;
+  EXPECT_THROW(hmm_marginal(d.log_omegas, d.Gamma, rho_short),
+               std::invalid_argument);
+
+  MatrixXd log_omegas_short = d.log_omegas.topRows(2);
+  EXPECT_THROW(hmm_marginal(log_omegas_short, d.Gamma, d.rho),
+               std::invalid_argument);
+
+  MatrixXd Gamma_empty(0, 0);
+  VectorXd rho_empty(0);
+  MatrixXd log_omegas_empty(0, 3);
+  EXPECT_THROW(hmm_marginal(log_omegas_empty, Gamma_empty, rho_empty),
+               std::invalid_argument);
+}
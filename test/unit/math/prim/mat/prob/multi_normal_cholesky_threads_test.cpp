@@ -0,0 +1,32 @@
+#ifndef STAN_THREADS
+#define STAN_THREADS
+#endif
+
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/functor/utils_threads.hpp>
+#include <cmath>
+#include <vector>
+
+TEST(ProbDistributionsMultiNormalCholesky, threads_match_serial) {
+  using Eigen::MatrixXd;
+  using Eigen::VectorXd;
+  const int K = 3;
+  MatrixXd Sigma(K, K);
+  Sigma << 2.0, 0.5, 0.1, 0.5, 1.5, -0.3, 0.1, -0.3, 1.0;
+  const MatrixXd L = Sigma.llt().matrixL();
+  const VectorXd mu = VectorXd::Constant(K, 0.2);
+
+  // below and above the number of observations solved on threads
+  for (int N : {100, 5000}) {
+    std::vector<VectorXd> y;
+    for (int n = 0; n < N; ++n)
+      y.push_back(VectorXd::Random(K));
+
+    set_n_threads(1);
+    const double lp_serial = stan::math::multi_normal_cholesky_lpdf(y, mu, L);
+    set_n_threads(4);
+    const double lp_threads = stan::math::multi_normal_cholesky_lpdf(y, mu, L);
+    EXPECT_NEAR(lp_serial, lp_threads, 1e-9 * std::fabs(lp_serial)) << N;
+  }
+}
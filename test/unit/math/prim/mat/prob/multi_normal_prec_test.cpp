@@ -153,3 +153,34 @@ TEST(ProbDistributionsMultiNormalPrec, WrongSize) {
   EXPECT_THROW(stan::math::multi_normal_prec_lpdf(y_3_2, mu_3_3, Sigma),
                std::invalid_argument);
 }
+
+TEST(ProbDistributionsMultiNormalPrec, SparsePrecision) {
+  Matrix<double, Dynamic, 1> y(3);
+  y << 2.0, -2.0, 11.0;
+  Matrix<double, Dynamic, 1> mu(3);
+  mu << 1.0, -1.0, 3.0;
+  Matrix<double, Dynamic, Dynamic> Q(3, 3);
+  Q << 2.0, -0.5, 0.0, -0.5, 1.0, 0.0, 0.0, 0.0, 0.5;
+  Eigen::SparseMatrix<double> Q_sparse = Q.sparseView();
+
+  EXPECT_FLOAT_EQ(stan::math::multi_normal_prec_lpdf(y, mu, Q),
+                  stan::math::multi_normal_prec_lpdf(y, mu, Q_sparse));
+  EXPECT_FLOAT_EQ(stan::math::multi_normal_prec_lpdf<true>(y, mu, Q),
+                  stan::math::multi_normal_prec_lpdf<true>(y, mu, Q_sparse));
+
+  vector<Matrix<double, Dynamic, 1> > ys(2, y);
+  EXPECT_FLOAT_EQ(stan::math::multi_normal_prec_lpdf(ys, mu, Q),
+                  stan::math::multi_normal_prec_lpdf(ys, mu, Q_sparse));
+
+  Matrix<double, Dynamic, 1> y_2(2);
+  y_2 << 1.0, 2.0;
+  EXPECT_THROW(stan::math::multi_normal_prec_lpdf(y_2, mu, Q_sparse),
+               std::invalid_argument);
+  Q_sparse.coeffRef(2, 0) = 1.0;
+  EXPECT_THROW(stan::math::multi_normal_prec_lpdf(y, mu, Q_sparse),
+               std::domain_error);
+  Q(2, 2) = -1.0;
+  Q_sparse = Q.sparseView();
+  EXPECT_THROW(stan::math::multi_normal_prec_lpdf(y, mu, Q_sparse),
+               std::domain_error);
+}
@@ -142,3 +142,40 @@ TEST(ProbDistributionsMultinomial, chiSquareGoodnessFitTest) {
 
   EXPECT_TRUE(chi < quantile(complement(mydist, 1e-6)));
 }
+
+TEST(ProbDistributionsMultinomial, Vectorized) {
+  using Eigen::VectorXd;
+  using stan::math::multinomial_lpmf;
+  std::vector<std::vector<int> > ns(3, std::vector<int>(3));
+  ns[0] = {1, 2, 3};
+  ns[1] = {0, 4, 1};
+  ns[2] = {2, 0, 0};
+  std::vector<VectorXd> thetas(3, VectorXd(3));
+  thetas[0] << 0.2, 0.3, 0.5;
+  thetas[1] << 0.1, 0.6, 0.3;
+  thetas[2] << 0.7, 0.2, 0.1;
+
+  double lp_shared = 0;
+  double lp_each = 0;
+  double lp_each_propto = 0;
+  for (int t = 0; t < 3; ++t) {
+    lp_shared += multinomial_lpmf(ns[t], thetas[0]);
+    lp_each += multinomial_lpmf(ns[t], thetas[t]);
+    lp_each_propto += multinomial_lpmf<true>(ns[t], thetas[t]);
+  }
+  EXPECT_FLOAT_EQ(lp_shared, multinomial_lpmf(ns, thetas[0]));
+  EXPECT_FLOAT_EQ(lp_each, multinomial_lpmf(ns, thetas));
+  EXPECT_FLOAT_EQ(lp_each_propto, multinomial_lpmf<true>(ns, thetas));
+
+  std::vector<std::vector<int> > bad_ns = ns;
+  bad_ns[1][2] = -1;
+  EXPECT_THROW(multinomial_lpmf(bad_ns, thetas), std::domain_error);
+  bad_ns = ns;
+  bad_ns[2].push_back(1);
+  EXPECT_THROW(multinomial_lpmf(bad_ns, thetas[0]), std::invalid_argument);
+  std::vector<VectorXd> bad_thetas = thetas;
+  bad_thetas[1] << 0.1, 0.6, 0.4;
+  EXPECT_THROW(multinomial_lpmf(ns, bad_thetas), std::domain_error);
+  EXPECT_THROW(multinomial_lpmf(ns, std::vector<VectorXd>(2, thetas[0])),
+               std::invalid_argument);
+}
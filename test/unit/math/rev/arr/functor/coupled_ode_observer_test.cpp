@@ -176,6 +176,70 @@ TEST_F(StanRevOde, observe_states_vvdd) {
   }
 }
 
+TEST_F(StanRevOde, observe_states_single_node_vvdv) {
+  using stan::math::ChainableStack;
+  using stan::math::coupled_ode_system;
+  using stan::math::var;
+
+  harm_osc_ode_fun harm_osc;
+
+  std::vector<var> y0 = {1.0, 0.5};
+  std::vector<var> theta = {0.15};
+
+  coupled_ode_system<harm_osc_ode_fun, var, var> coupled_system(
+      harm_osc, y0, theta, x, x_int, &msgs);
+
+  std::vector<std::vector<var>> y;
+  double t0 = 0;
+  int T = 4;
+  std::vector<var> ts = {1.0, 2.0, 3.0, 4.0};
+
+  stan::math::coupled_ode_observer<harm_osc_ode_fun, var, var, double, var>
+      observer(harm_osc, y0, theta, t0, ts, x, x_int, &msgs, y);
+
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  size_t k = 0;
+  std::vector<std::vector<double>> ys_coupled(T);
+  for (size_t t = 0; t < T; t++) {
+    std::vector<double> coupled_state(coupled_system.size(), 0.0);
+    for (size_t n = 0; n < coupled_system.size(); n++)
+      coupled_state[n] = ++k;
+    ys_coupled[t] = coupled_state;
+    observer(coupled_state, ts[t].val());
+  }
+
+  // all outputs share one node which chains the sensitivities
+  EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+  EXPECT_EQ(T, y.size());
+
+  // the sensitivities of all outputs are propagated at once
+  var sum = 0;
+  for (size_t t = 0; t < T; t++)
+    for (size_t n = 0; n < 2; n++)
+      sum += (t + n + 1.0) * y[t][n];
+  sum.grad();
+
+  std::vector<double> y0_adj(2, 0.0);
+  double theta_adj = 0;
+  for (size_t t = 0; t < T; t++) {
+    std::vector<double> yt(ys_coupled[t].begin(), ys_coupled[t].begin() + 2);
+    std::vector<double> dy_dt = harm_osc(ts[t].val(), yt, value_of(theta), x,
+                                         x_int, &msgs);
+    double ts_adj = 0;
+    for (size_t n = 0; n < 2; n++) {
+      double w = t + n + 1.0;
+      y0_adj[0] += w * ys_coupled[t][2 + n];
+      y0_adj[1] += w * ys_coupled[t][2 + 2 + n];
+      theta_adj += w * ys_coupled[t][2 + 2 * 2 + n];
+      ts_adj += w * dy_dt[n];
+    }
+    EXPECT_FLOAT_EQ(ts_adj, ts[t].adj());
+  }
+  EXPECT_FLOAT_EQ(y0_adj[0], y0[0].adj());
+  EXPECT_FLOAT_EQ(y0_adj[1], y0[1].adj());
+  EXPECT_FLOAT_EQ(theta_adj, theta[0].adj());
+}
+
 TEST_F(StanRevOde, observe_states_ddvd) {
   using stan::math::coupled_ode_system;
   using stan::math::var;
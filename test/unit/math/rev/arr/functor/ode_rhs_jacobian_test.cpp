@@ -0,0 +1,162 @@
+#include <stan/math/rev/arr.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// harmonic oscillator with analytic Jacobians which count their calls
+struct analytic_harm_osc_ode_fun : public harm_osc_ode_fun {
+  int* num_calls_;
+  explicit analytic_harm_osc_ode_fun(int* num_calls) : num_calls_(num_calls) {}
+
+  std::vector<std::vector<double>> jacobian_y(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    ++*num_calls_;
+    return {{0.0, 1.0}, {-1.0, -theta[0]}};
+  }
+
+  std::vector<std::vector<double>> jacobian_theta(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    ++*num_calls_;
+    return {{0.0}, {-y[1]}};
+  }
+};
+
+// provides a Jacobian of the wrong size
+struct wrong_jacobian_ode_fun : public harm_osc_ode_fun {
+  std::vector<std::vector<double>> jacobian_y(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    return {{0.0, 1.0}};
+  }
+};
+
+}  // namespace
+
+TEST(StanRevOde, ode_rhs_jacobian_dv) {
+  using stan::math::var;
+  harm_osc_ode_fun harm_osc;
+  std::vector<double> x;
+  std::vector<int> x_int;
+  std::stringstream msgs;
+
+  std::vector<var> theta_nochain = {var(new stan::math::vari(0.15, false))};
+  std::vector<double> y = {1.0, 0.5};
+  std::vector<double> dy_dt(2);
+  std::vector<double> jacobian;
+
+  stan::math::ode_rhs_jacobian("ode_rhs_jacobian_test", harm_osc, 0.0, &y[0],
+                               2, theta_nochain, x, x_int, &msgs, &dy_dt[0],
+                               jacobian);
+
+  EXPECT_FLOAT_EQ(0.5, dy_dt[0]);
+  EXPECT_FLOAT_EQ(-1.0 - 0.15 * 0.5, dy_dt[1]);
+  ASSERT_EQ(6U, jacobian.size());
+  // rows of d/dy followed by d/dtheta
+  EXPECT_FLOAT_EQ(0.0, jacobian[0]);
+  EXPECT_FLOAT_EQ(1.0, jacobian[1]);
+  EXPECT_FLOAT_EQ(0.0, jacobian[2]);
+  EXPECT_FLOAT_EQ(-1.0, jacobian[3]);
+  EXPECT_FLOAT_EQ(-0.15, jacobian[4]);
+  EXPECT_FLOAT_EQ(-0.5, jacobian[5]);
+  EXPECT_FLOAT_EQ(0.0, theta_nochain[0].adj());
+
+  // sensitivities of the initial state (identity) and of theta (zero)
+  std::vector<double> z = {1.0, 0.5, 1.0, 0.0, 0.0, 1.0, 0.0, 0.0};
+  std::vector<double> dz_dt(8);
+  stan::math::ode_sensitivities_rhs(2, 2, 1, jacobian, z, dz_dt);
+  EXPECT_FLOAT_EQ(0.0, dz_dt[2]);
+  EXPECT_FLOAT_EQ(-1.0, dz_dt[3]);
+  EXPECT_FLOAT_EQ(1.0, dz_dt[4]);
+  EXPECT_FLOAT_EQ(-0.15, dz_dt[5]);
+  EXPECT_FLOAT_EQ(0.0, dz_dt[6]);
+  EXPECT_FLOAT_EQ(-0.5, dz_dt[7]);
+  stan::math::recover_memory();
+}
+
+TEST(StanRevOde, ode_rhs_jacobian_dd) {
+  harm_osc_ode_fun harm_osc;
+  std::vector<double> x;
+  std::vector<int> x_int;
+  std::stringstream msgs;
+
+  std::vector<double> theta = {0.15};
+  std::vector<double> y = {1.0, 0.5};
+  std::vector<double> dy_dt(2);
+  std::vector<double> jacobian;
+
+  stan::math::ode_rhs_jacobian("ode_rhs_jacobian_test", harm_osc, 0.0, &y[0],
+                               2, theta, x, x_int, &msgs, &dy_dt[0],
+                               jacobian);
+  ASSERT_EQ(4U, jacobian.size());
+  EXPECT_FLOAT_EQ(0.0, jacobian[0]);
+  EXPECT_FLOAT_EQ(1.0, jacobian[1]);
+  EXPECT_FLOAT_EQ(-1.0, jacobian[2]);
+  EXPECT_FLOAT_EQ(-0.15, jacobian[3]);
+  EXPECT_TRUE(stan::math::empty_nested());
+
+  std::vector<double> y_bad = {1.0, 0.5, 2.0};
+  EXPECT_THROW_MSG(
+      stan::math::ode_rhs_jacobian("ode_rhs_jacobian_test", harm_osc, 0.0,
+                                   &y_bad[0], 3, theta, x, x_int, &msgs,
+                                   &dy_dt[0], jacobian),
+      std::domain_error, "inconsistent state");
+  EXPECT_TRUE(stan::math::empty_nested());
+}
+
+TEST(StanRevOde, ode_rhs_jacobian_analytic) {
+  using stan::math::var;
+  std::vector<double> x;
+  std::vector<int> x_int;
+  std::stringstream msgs;
+  int num_calls = 0;
+  analytic_harm_osc_ode_fun harm_osc(&num_calls);
+
+  std::vector<var> theta_nochain = {var(new stan::math::vari(0.15, false))};
+  std::vector<double> theta = {0.15};
+  std::vector<double> y = {1.0, 0.5};
+  std::vector<double> dy_dt(2);
+  std::vector<double> jacobian;
+  std::vector<double> jacobian_ad;
+
+  stan::math::ode_rhs_jacobian("ode_rhs_jacobian_test", harm_osc, 0.0, &y[0],
+                               2, theta_nochain, x, x_int, &msgs, &dy_dt[0],
+                               jacobian);
+  EXPECT_EQ(2, num_calls);
+  EXPECT_FLOAT_EQ(0.5, dy_dt[0]);
+  EXPECT_FLOAT_EQ(-1.0 - 0.15 * 0.5, dy_dt[1]);
+  stan::math::ode_rhs_jacobian("ode_rhs_jacobian_test", harm_osc_ode_fun(),
+                               0.0, &y[0], 2, theta_nochain, x, x_int, &msgs,
+                               &dy_dt[0], jacobian_ad);
+  ASSERT_EQ(jacobian_ad.size(), jacobian.size());
+  for (size_t i = 0; i < jacobian.size(); ++i)
+    EXPECT_FLOAT_EQ(jacobian_ad[i], jacobian[i]);
+
+  // only the Jacobian wrt the states is needed for data parameters
+  stan::math::ode_rhs_jacobian("ode_rhs_jacobian_test", harm_osc, 0.0, &y[0],
+                               2, theta, x, x_int, &msgs, &dy_dt[0],
+                               jacobian);
+  EXPECT_EQ(3, num_calls);
+  ASSERT_EQ(4U, jacobian.size());
+  EXPECT_FLOAT_EQ(-0.15, jacobian[3]);
+
+  // a Jacobian wrt the states only is not used for varying parameters
+  wrong_jacobian_ode_fun wrong_jacobian;
+  EXPECT_NO_THROW(stan::math::ode_rhs_jacobian(
+      "ode_rhs_jacobian_test", wrong_jacobian, 0.0, &y[0], 2, theta_nochain, x,
+      x_int, &msgs, &dy_dt[0], jacobian));
+  EXPECT_THROW_MSG(stan::math::ode_rhs_jacobian(
+                       "ode_rhs_jacobian_test", wrong_jacobian, 0.0, &y[0], 2,
+                       theta, x, x_int, &msgs, &dy_dt[0], jacobian),
+                   std::invalid_argument, "jacobian_y");
+  stan::math::recover_memory();
+}
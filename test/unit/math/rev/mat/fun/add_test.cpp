@@ -211,3 +211,25 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::add(m, 2.0));
   test::check_varis_on_stack(stan::math::add(1.0, m));
 }
+
+TEST(AgradRevMatrix, add_matrix_single_vari) {
+  using stan::math::add;
+  using stan::math::matrix_d;
+  using stan::math::matrix_v;
+
+  matrix_v a(2, 3);
+  a << 1, 2, 3, 4, 5, 6;
+  matrix_d b(2, 3);
+  b << -1, 0.5, 2, 7, 1, 3;
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  matrix_v c = add(a, b);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  test::check_varis_on_stack(c);
+
+  c(1, 2).grad();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(i == 5 ? 1.0 : 0.0, a(i).adj());
+  stan::math::recover_memory();
+}
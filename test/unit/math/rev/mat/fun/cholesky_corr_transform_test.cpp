@@ -74,3 +74,47 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::cholesky_corr_constrain(y, 3, lp));
   test::check_varis_on_stack(stan::math::cholesky_corr_constrain(y, 3));
 }
+
+TEST(probTransform, choleskyCorrConstrainGradients) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  using stan::math::var;
+
+  Eigen::VectorXd y_d(10);
+  y_d << 1.0, 2.0, -3.0, 1.5, 0.2, 2.0, -0.7, 0.4, -1.1, 0.05;
+  const int K = 5;
+
+  // weights on every entry of the factor and on the log Jacobian
+  for (int with_lp = 0; with_lp < 2; ++with_lp) {
+    Matrix<var, Dynamic, 1> y = y_d;
+    var lp = 0;
+    Matrix<var, Dynamic, Dynamic> x
+        = with_lp ? stan::math::cholesky_corr_constrain(y, K, lp)
+                  : stan::math::cholesky_corr_constrain(y, K);
+    var f = 0.7 * lp;
+    for (int i = 0; i < K; ++i)
+      for (int j = 0; j <= i; ++j)
+        f += (1.0 + i - 0.3 * j) * x(i, j);
+    f.grad();
+    Eigen::VectorXd grad = y.adj();
+    stan::math::set_zero_all_adjoints();
+
+    var lp_ref = 0;
+    Matrix<var, Dynamic, Dynamic> x_ref
+        = with_lp ? stan::math::cholesky_corr_constrain<var>(y, K, lp_ref)
+                  : stan::math::cholesky_corr_constrain<var>(y, K);
+    var f_ref = 0.7 * lp_ref;
+    for (int i = 0; i < K; ++i)
+      for (int j = 0; j <= i; ++j)
+        f_ref += (1.0 + i - 0.3 * j) * x_ref(i, j);
+    f_ref.grad();
+
+    EXPECT_FLOAT_EQ(lp_ref.val(), lp.val());
+    for (int i = 0; i < K; ++i)
+      for (int j = 0; j < K; ++j)
+        EXPECT_FLOAT_EQ(x_ref(i, j).val(), x(i, j).val());
+    for (int n = 0; n < y.size(); ++n)
+      EXPECT_NEAR(y(n).adj(), grad(n), 1e-10);
+    stan::math::recover_memory();
+  }
+}
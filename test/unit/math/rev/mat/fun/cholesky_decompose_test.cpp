@@ -438,6 +438,89 @@ TEST(AgradRevMatrix, check_varis_on_stack_large) {
   test::check_varis_on_stack(stan::math::cholesky_decompose(X));
 }
 
+void test_batch_gradients(int M, int B, double prec) {
+  using stan::math::matrix_v;
+  using stan::math::var;
+  boost::random::mt19937 rng(M + B);
+  std::vector<Eigen::MatrixXd> A_d(B);
+  for (int b = 0; b < B; ++b) {
+    Eigen::MatrixXd X = Eigen::MatrixXd::Zero(M, M);
+    for (int j = 0; j < M; ++j)
+      for (int i = 0; i < M; ++i)
+        X(i, j) = stan::math::normal_rng(0, 1, rng);
+    A_d[b] = X * X.transpose() + M * Eigen::MatrixXd::Identity(M, M);
+  }
+  Eigen::MatrixXd W(M, M);
+  for (int k = 0; k < M * M; ++k)
+    W(k) = stan::math::normal_rng(0, 1, rng);
+
+  std::vector<matrix_v> A(B);
+  for (int b = 0; b < B; ++b)
+    A[b] = A_d[b];
+  std::vector<matrix_v> L = stan::math::cholesky_decompose(A);
+  ASSERT_EQ(B, static_cast<int>(L.size()));
+  var f = 0;
+  for (int b = 0; b < B; ++b)
+    f += (b + 1) * stan::math::sum(stan::math::elt_multiply(W, L[b]));
+  f.grad();
+  std::vector<Eigen::MatrixXd> L_batch(B), grad_batch(B);
+  for (int b = 0; b < B; ++b) {
+    L_batch[b] = stan::math::value_of(L[b]);
+    grad_batch[b] = A[b].adj();
+    test::check_varis_on_stack(L[b]);
+  }
+  stan::math::recover_memory();
+
+  for (int b = 0; b < B; ++b) {
+    matrix_v A_b = A_d[b];
+    matrix_v L_b = stan::math::cholesky_decompose(A_b);
+    var g = (b + 1) * stan::math::sum(stan::math::elt_multiply(W, L_b));
+    g.grad();
+    for (int k = 0; k < M * M; ++k) {
+      EXPECT_NEAR(L_b(k).val(), L_batch[b](k), prec);
+      EXPECT_NEAR(A_b(k).adj(), grad_batch[b](k), prec);
+    }
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevMatrix, mat_cholesky_batch) {
+  test_batch_gradients(1, 3, 1e-10);
+  test_batch_gradients(3, 20, 1e-10);
+  test_batch_gradients(8, 5, 1e-10);
+  test_batch_gradients(12, 4, 1e-10);
+}
+
+TEST(AgradRevMatrix, mat_cholesky_batch_empty) {
+  std::vector<stan::math::matrix_v> A;
+  EXPECT_EQ(0U, stan::math::cholesky_decompose(A).size());
+  A.push_back(stan::math::matrix_v(0, 0));
+  std::vector<stan::math::matrix_v> L = stan::math::cholesky_decompose(A);
+  ASSERT_EQ(1U, L.size());
+  EXPECT_EQ(0, L[0].size());
+}
+
+TEST(AgradRevMatrix, exception_mat_cholesky_batch) {
+  std::vector<stan::math::matrix_v> A(2, stan::math::matrix_v(2, 2));
+  A[0] << 2, 1, 1, 2;
+  A[1] << 2, 1, 1, 2;
+  EXPECT_NO_THROW(stan::math::cholesky_decompose(A));
+
+  A[1] << 1, 2, 3, 4;
+  EXPECT_THROW(stan::math::cholesky_decompose(A), std::domain_error);
+
+  A[1] << 1, 2, 2, 1;
+  EXPECT_THROW(stan::math::cholesky_decompose(A), std::domain_error);
+
+  A[1].resize(3, 3);
+  A[1] << 1, 0, 0, 0, 1, 0, 0, 0, 1;
+  EXPECT_THROW(stan::math::cholesky_decompose(A), std::invalid_argument);
+
+  A[1].resize(2, 3);
+  EXPECT_THROW(stan::math::cholesky_decompose(A), std::invalid_argument);
+  stan::math::recover_memory();
+}
+
 #ifdef STAN_OPENCL
 TEST(AgradRevMatrix, mat_cholesky_1st_deriv_large_gradients_opencl) {
   stan::math::opencl_context.tuning_opts().cholesky_size_worth_transfer = 25;
@@ -0,0 +1,78 @@
+#ifndef STAN_THREADS
+#define STAN_THREADS
+#endif
+
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/functor/utils_threads.hpp>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+namespace {
+Eigen::MatrixXd chol_threads_spd(int M) {
+  Eigen::MatrixXd X = Eigen::MatrixXd::Random(M, M);
+  return X * X.transpose() + M * Eigen::MatrixXd::Identity(M, M);
+}
+
+// values of the factor and gradients of a weighted sum of its
+// entries with respect to the lower triangle of the input
+void chol_threads_grad(const Eigen::MatrixXd& A, Eigen::MatrixXd& L,
+                       Eigen::MatrixXd& grad) {
+  const int M = A.rows();
+  stan::math::matrix_v A_v = A;
+  stan::math::matrix_v L_v = stan::math::cholesky_decompose(A_v);
+  stan::math::var f = 0;
+  for (int j = 0; j < M; ++j)
+    for (int i = j; i < M; ++i)
+      f += (1.0 + 0.01 * i - 0.02 * j) * L_v(i, j);
+  f.grad();
+  L = stan::math::value_of(L_v);
+  grad = A_v.adj();
+  stan::math::recover_memory();
+}
+}  // namespace
+
+TEST(AgradRevMatrix, cholesky_decompose_threads_matches_serial) {
+  const int M = 130;
+  Eigen::MatrixXd A = chol_threads_spd(M);
+
+  set_n_threads(1);
+  Eigen::MatrixXd L_serial, grad_serial;
+  chol_threads_grad(A, L_serial, grad_serial);
+
+  set_n_threads(4);
+  stan::math::internal::cholesky_cpu_tuning saved
+      = stan::math::cholesky_cpu_tuning_opts();
+  stan::math::cholesky_cpu_tuning_opts().parallel_min_size = 50;
+  EXPECT_EQ(4, stan::math::internal::cholesky_num_threads(M));
+  // tile sizes which do and do not divide M
+  for (int tile_size : {13, 24, 65}) {
+    stan::math::cholesky_cpu_tuning_opts().tile_size = tile_size;
+    Eigen::MatrixXd L_threads, grad_threads;
+    chol_threads_grad(A, L_threads, grad_threads);
+
+    for (int j = 0; j < M; ++j) {
+      for (int i = j; i < M; ++i) {
+        EXPECT_NEAR(L_serial(i, j), L_threads(i, j), 1e-10);
+        EXPECT_NEAR(grad_serial(i, j), grad_threads(i, j), 1e-10);
+      }
+    }
+  }
+  stan::math::cholesky_cpu_tuning_opts() = saved;
+}
+
+TEST(AgradRevMatrix, cholesky_decompose_threads_not_pos_definite) {
+  const int M = 80;
+  Eigen::MatrixXd A = chol_threads_spd(M);
+  A(70, 70) = -1e6;
+
+  set_n_threads(3);
+  stan::math::internal::cholesky_cpu_tuning saved
+      = stan::math::cholesky_cpu_tuning_opts();
+  stan::math::cholesky_cpu_tuning_opts().parallel_min_size = 50;
+  stan::math::cholesky_cpu_tuning_opts().tile_size = 16;
+  stan::math::matrix_v A_v = A;
+  EXPECT_THROW(stan::math::cholesky_decompose(A_v), std::domain_error);
+  stan::math::cholesky_cpu_tuning_opts() = saved;
+  stan::math::recover_memory();
+}
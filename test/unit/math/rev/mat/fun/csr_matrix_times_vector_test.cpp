@@ -0,0 +1,95 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+TEST(AgradRevSparse, csr_matrix_times_vector_gradients) {
+  using stan::math::var;
+  using stan::math::vector_v;
+
+  stan::math::matrix_d m(3, 4);
+  m << 2, 0, 6, 0, 0, 0, 0, 0, 1.5, 10, 0, -3;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a = m.sparseView();
+  stan::math::vector_d w_d = stan::math::csr_extract_w(a);
+  std::vector<int> v = stan::math::csr_extract_v(a);
+  std::vector<int> u = stan::math::csr_extract_u(a);
+
+  vector_v w = stan::math::to_var(w_d);
+  vector_v b(4);
+  b << 1, -2, 0.5, 4;
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  vector_v res = stan::math::csr_matrix_times_vector(3, 4, w, v, u, b);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  test::check_varis_on_stack(res);
+
+  stan::math::vector_d expected = m * stan::math::value_of(b);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(expected(i), res(i).val());
+
+  // lp = sum_i c_i res_i, so d lp / d b = m^T c
+  stan::math::vector_d c(3);
+  c << 1, 2, -1;
+  var lp = c(0) * res(0) + c(1) * res(1) + c(2) * res(2);
+  lp.grad();
+  stan::math::vector_d grad_b = m.transpose() * c;
+  for (int j = 0; j < 4; ++j)
+    EXPECT_FLOAT_EQ(grad_b(j), b(j).adj());
+  // w is stored row by row: (0,0), (0,2), (2,0), (2,1), (2,3)
+  EXPECT_FLOAT_EQ(c(0) * 1, w(0).adj());
+  EXPECT_FLOAT_EQ(c(0) * 0.5, w(1).adj());
+  EXPECT_FLOAT_EQ(c(2) * 1, w(2).adj());
+  EXPECT_FLOAT_EQ(c(2) * -2, w(3).adj());
+  EXPECT_FLOAT_EQ(c(2) * 4, w(4).adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, csr_matrix_times_vector_structure_mixed) {
+  using stan::math::var;
+  using stan::math::vector_v;
+
+  stan::math::matrix_d m(2, 3);
+  m << 2, 0, 6, 0, 1, 0;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a = m.sparseView();
+  stan::math::vector_d w_d = stan::math::csr_extract_w(a);
+  stan::math::csr_structure X(2, 3, stan::math::csr_extract_v(a),
+                              stan::math::csr_extract_u(a));
+
+  stan::math::vector_d b_d(3);
+  b_d << 3, 4, 5;
+  vector_v b = stan::math::to_var(b_d);
+  vector_v res = stan::math::csr_matrix_times_vector(X, w_d, b);
+  EXPECT_FLOAT_EQ(36, res(0).val());
+  EXPECT_FLOAT_EQ(4, res(1).val());
+  res(0).grad();
+  EXPECT_FLOAT_EQ(2, b(0).adj());
+  EXPECT_FLOAT_EQ(0, b(1).adj());
+  EXPECT_FLOAT_EQ(6, b(2).adj());
+  stan::math::recover_memory();
+
+  vector_v w = stan::math::to_var(w_d);
+  vector_v res2 = stan::math::csr_matrix_times_vector(X, w, b_d);
+  res2(1).grad();
+  EXPECT_FLOAT_EQ(0, w(0).adj());
+  EXPECT_FLOAT_EQ(0, w(1).adj());
+  EXPECT_FLOAT_EQ(4, w(2).adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, csr_matrix_times_vector_errors) {
+  using stan::math::vector_v;
+  stan::math::matrix_d m(2, 3);
+  m << 2, 0, 6, 0, 1, 0;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a = m.sparseView();
+  vector_v w = stan::math::to_var(stan::math::csr_extract_w(a));
+  std::vector<int> v = stan::math::csr_extract_v(a);
+  std::vector<int> u = stan::math::csr_extract_u(a);
+  vector_v b(2);
+  b << 1, 2;
+  EXPECT_THROW(stan::math::csr_matrix_times_vector(2, 3, w, v, u, b),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::csr_matrix_times_vector(0, 3, w, v, u, b),
+               std::domain_error);
+  stan::math::recover_memory();
+}
@@ -67,3 +67,47 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   x << 1, 2;
   test::check_varis_on_stack(stan::math::cumulative_sum(x));
 }
+
+TEST(AgradRevMatrix, cumulative_sum_single_vari) {
+  using stan::math::var;
+  std::vector<var> x = {1.5, -2, 3, 0.25};
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  std::vector<var> y = stan::math::cumulative_sum(x);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  EXPECT_FLOAT_EQ(2.75, y[3].val());
+
+  // d/dx_i sum_k w_k y_k = sum_{k >= i} w_k
+  var lp = 1 * y[0] + 2 * y[1] + 3 * y[2] + 4 * y[3];
+  lp.grad();
+  EXPECT_FLOAT_EQ(10, x[0].adj());
+  EXPECT_FLOAT_EQ(9, x[1].adj());
+  EXPECT_FLOAT_EQ(7, x[2].adj());
+  EXPECT_FLOAT_EQ(4, x[3].adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrix, cumulative_sum_matrix) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> m(2, 2);
+  m << 1, 3, 2, 4;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> s
+      = stan::math::cumulative_sum(m);
+  ASSERT_EQ(2, s.rows());
+  ASSERT_EQ(2, s.cols());
+  // column-major order, like the prim overload
+  EXPECT_FLOAT_EQ(1, s(0, 0).val());
+  EXPECT_FLOAT_EQ(3, s(1, 0).val());
+  EXPECT_FLOAT_EQ(6, s(0, 1).val());
+  EXPECT_FLOAT_EQ(10, s(1, 1).val());
+
+  s(0, 1).grad();
+  EXPECT_FLOAT_EQ(1, m(0, 0).adj());
+  EXPECT_FLOAT_EQ(1, m(1, 0).adj());
+  EXPECT_FLOAT_EQ(1, m(0, 1).adj());
+  EXPECT_FLOAT_EQ(0, m(1, 1).adj());
+
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> empty;
+  EXPECT_EQ(0, stan::math::cumulative_sum(empty).size());
+  stan::math::recover_memory();
+}
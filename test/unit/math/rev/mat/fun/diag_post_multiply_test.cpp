@@ -206,3 +206,24 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
 
   test::check_varis_on_stack(stan::math::diag_post_multiply(m, v));
 }
+
+TEST(MathMatrix, diagPostMultiplySingleVari) {
+  Matrix<var, Dynamic, Dynamic> m(2, 3);
+  m << 1, 2, 3, 4, 5, 6;
+  Matrix<var, Dynamic, 1> v(3);
+  v << -2, 0.5, 3;
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  Matrix<var, Dynamic, Dynamic> res = diag_post_multiply(m, v);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  test::check_varis_on_stack(res);
+
+  stan::math::sum(res).grad();
+  for (int j = 0; j < 3; ++j) {
+    EXPECT_FLOAT_EQ(m.col(j).val().sum(), v(j).adj());
+    for (int i = 0; i < 2; ++i)
+      EXPECT_FLOAT_EQ(v(j).val(), m(i, j).adj());
+  }
+  stan::math::recover_memory();
+}
@@ -206,3 +206,24 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
 
   test::check_varis_on_stack(stan::math::diag_pre_multiply(v, m));
 }
+
+TEST(MathMatrix, diagPreMultiplySingleVari) {
+  Matrix<var, Dynamic, Dynamic> m(2, 3);
+  m << 1, 2, 3, 4, 5, 6;
+  Matrix<var, 1, Dynamic> v(2);
+  v << -2, 0.5;
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  Matrix<var, Dynamic, Dynamic> res = diag_pre_multiply(v, m);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  test::check_varis_on_stack(res);
+
+  stan::math::sum(res).grad();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_FLOAT_EQ(m.row(i).val().sum(), v(i).adj());
+    for (int j = 0; j < 3; ++j)
+      EXPECT_FLOAT_EQ(v(i).val(), m(i, j).adj());
+  }
+  stan::math::recover_memory();
+}
@@ -231,3 +231,27 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::elt_divide(x, value_of(y)));
   test::check_varis_on_stack(stan::math::elt_divide(value_of(x), y));
 }
+
+TEST(AgradRevMatrix, elt_divide_matrix_single_vari) {
+  using stan::math::elt_divide;
+  using stan::math::matrix_v;
+  using stan::math::sum;
+
+  matrix_v a(2, 3);
+  a << 1, 2, 3, 4, 5, 6;
+  matrix_v b(2, 3);
+  b << -1, 0.5, 2, 7, 1, 3;
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  matrix_v c = elt_divide(a, b);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  test::check_varis_on_stack(c);
+
+  sum(c).grad();
+  for (int i = 0; i < a.size(); ++i) {
+    EXPECT_FLOAT_EQ(1 / b(i).val(), a(i).adj());
+    EXPECT_FLOAT_EQ(-a(i).val() / (b(i).val() * b(i).val()), b(i).adj());
+  }
+  stan::math::recover_memory();
+}
@@ -1394,3 +1394,109 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::gp_exp_quad_cov(x, to_var(sigma), l));
   test::check_varis_on_stack(stan::math::gp_exp_quad_cov(x, sigma, to_var(l)));
 }
+
+TEST(RevMath, gp_exp_quad_cov_ard_grad) {
+  using stan::math::var;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1> vector_d;
+  std::vector<vector_d> x(3, vector_d(2));
+  x[0] << -2, -2;
+  x[1] << 1, 2;
+  x[2] << -0.5, 0.0;
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t j = 0; j < 3; ++j) {
+      var sigma = 0.7;
+      std::vector<var> l(2);
+      l[0] = 1.5;
+      l[1] = 3;
+
+      Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> cov
+          = stan::math::gp_exp_quad_cov(x, sigma, l);
+
+      std::vector<var> params;
+      params.push_back(sigma);
+      params.push_back(l[0]);
+      params.push_back(l[1]);
+      std::vector<double> grad;
+      cov(i, j).grad(params, grad);
+
+      double d0 = stan::math::square(x[i](0) - x[j](0));
+      double d1 = stan::math::square(x[i](1) - x[j](1));
+      double expected = 0.49
+                        * std::exp(-0.5 * d0 / stan::math::square(1.5)
+                                   - 0.5 * d1 / stan::math::square(3.0));
+      EXPECT_FLOAT_EQ(expected, cov(i, j).val());
+      EXPECT_FLOAT_EQ(2 * expected / 0.7, grad[0]);
+      EXPECT_FLOAT_EQ(expected * d0 / std::pow(1.5, 3), grad[1]);
+      EXPECT_FLOAT_EQ(expected * d1 / std::pow(3.0, 3), grad[2]);
+      stan::math::recover_memory();
+    }
+  }
+}
+
+TEST(RevMath, gp_exp_quad_cov_ard_matches_generic) {
+  using stan::math::var;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1> vector_d;
+  typedef Eigen::Matrix<var, Eigen::Dynamic, 1> vector_v;
+  std::vector<vector_d> x(4, vector_d(3));
+  x[0] << -2, -2, 1;
+  x[1] << 1, 2, 0.3;
+  x[2] << -0.5, 0.0, 2;
+  x[3] << 0.1, -1, -1.2;
+  std::vector<double> l_d = {0.8, 2.1, 1.3};
+
+  std::vector<var> l(l_d.begin(), l_d.end());
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> cov
+      = stan::math::gp_exp_quad_cov(x, 1.3, l);
+  var lp = sum(cov);
+  lp.grad();
+  std::vector<double> grad_ard;
+  for (size_t k = 0; k < l.size(); ++k)
+    grad_ard.push_back(l[k].adj());
+  double lp_ard = lp.val();
+  stan::math::recover_memory();
+
+  // generic path through var inputs
+  std::vector<var> l2(l_d.begin(), l_d.end());
+  std::vector<vector_v> x_v(x.size());
+  for (size_t i = 0; i < x.size(); ++i)
+    x_v[i] = stan::math::to_var(x[i]);
+  var lp2 = sum(stan::math::gp_exp_quad_cov(x_v, 1.3, l2));
+  lp2.grad();
+  EXPECT_FLOAT_EQ(lp2.val(), lp_ard);
+  for (size_t k = 0; k < l2.size(); ++k)
+    EXPECT_FLOAT_EQ(l2[k].adj(), grad_ard[k]);
+  stan::math::recover_memory();
+}
+
+TEST(RevMath, gp_exp_quad_cov_ard_errors) {
+  using stan::math::var;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1> vector_d;
+  std::vector<vector_d> x(2, vector_d(2));
+  x[0] << 1, 2;
+  x[1] << 3, 4;
+  std::vector<var> l(2, 1.0);
+  std::vector<var> l_bad(3, 1.0);
+  std::vector<var> l_neg(2, -1.0);
+  EXPECT_THROW(stan::math::gp_exp_quad_cov(x, var(1.0), l_bad),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::gp_exp_quad_cov(x, var(1.0), l_neg),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_exp_quad_cov(x, -1.0, l), std::domain_error);
+  x[1](0) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::gp_exp_quad_cov(x, 1.0, l), std::domain_error);
+}
+
+TEST(AgradRevMatrix, check_varis_on_stack_ard) {
+  using stan::math::to_var;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 1> vector_d;
+  std::vector<vector_d> x(3, vector_d(2));
+  x[0] << -2, -2;
+  x[1] << 1, 2;
+  x[2] << -0.5, 0.0;
+  std::vector<double> l = {1.5, 3};
+
+  test::check_varis_on_stack(
+      stan::math::gp_exp_quad_cov(x, to_var(0.2), to_var(l)));
+  test::check_varis_on_stack(stan::math::gp_exp_quad_cov(x, 0.2, to_var(l)));
+}
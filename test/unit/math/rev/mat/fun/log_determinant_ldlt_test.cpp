@@ -65,3 +65,66 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   ldlt_v.compute(v2);
   test::check_varis_on_stack(stan::math::log_determinant_ldlt(ldlt_v));
 }
+
+TEST(AgradRevMatrix, log_determinant_ldlt_shared_factor) {
+  using stan::math::LDLT_factor;
+  using stan::math::matrix_v;
+  using stan::math::var;
+  using stan::math::vector_d;
+
+  Eigen::MatrixXd A_d(3, 3);
+  A_d << 4, 1, 0.5, 1, 3, -0.5, 0.5, -0.5, 2;
+  vector_d b(3);
+  b << 1, -2, 0.5;
+
+  matrix_v A = A_d;
+  LDLT_factor<var, -1, -1> ldlt_A(A);
+  var f = 2 * log_determinant_ldlt(ldlt_A) - log_determinant_ldlt(ldlt_A)
+          + stan::math::trace_inv_quad_form_ldlt(ldlt_A, b);
+  f.grad();
+  Eigen::MatrixXd A_adj = A.adj();
+
+  // a second reverse pass over the same expression gives the same
+  // adjoints with the inverse kept from the first pass
+  stan::math::set_zero_all_adjoints();
+  f.grad();
+  for (int k = 0; k < 9; ++k)
+    EXPECT_FLOAT_EQ(A_adj(k), A(k).adj());
+  stan::math::recover_memory();
+
+  Eigen::MatrixXd A_inv = A_d.inverse();
+  vector_d A_inv_b = A_inv * b;
+  Eigen::MatrixXd expected = A_inv - A_inv_b * A_inv_b.transpose();
+  for (int k = 0; k < 9; ++k)
+    EXPECT_FLOAT_EQ(expected(k), A_adj(k));
+}
+
+TEST(AgradRevMatrix, log_determinant_ldlt_nested) {
+  using stan::math::LDLT_factor;
+  using stan::math::matrix_v;
+  using stan::math::var;
+  using stan::math::vector_d;
+
+  Eigen::MatrixXd A_d(3, 3);
+  A_d << 4, 1, 0.5, 1, 3, -0.5, 0.5, -0.5, 2;
+  vector_d b(3);
+  b << 1, -2, 0.5;
+  Eigen::MatrixXd A_inv = A_d.inverse();
+  vector_d A_inv_b = A_inv * b;
+  Eigen::MatrixXd expected = A_inv - A_inv_b * A_inv_b.transpose();
+
+  // the factor is computed outside of the nested gradients that use it
+  matrix_v A = A_d;
+  LDLT_factor<var, -1, -1> ldlt_A(A);
+  for (int n = 0; n < 2; ++n) {
+    stan::math::start_nested();
+    var f = log_determinant_ldlt(ldlt_A)
+            + stan::math::trace_inv_quad_form_ldlt(ldlt_A, b);
+    stan::math::set_zero_all_adjoints();
+    f.grad();
+    for (int k = 0; k < 9; ++k)
+      EXPECT_FLOAT_EQ(expected(k), A(k).adj());
+    stan::math::recover_memory_nested();
+  }
+  stan::math::recover_memory();
+}
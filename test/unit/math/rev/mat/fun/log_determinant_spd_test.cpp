@@ -83,3 +83,45 @@ TEST(AgradRevMatrix, log_determinant_grad) {
   EXPECT_FLOAT_EQ(-2.0, g[3]);
 }
 #endif
+
+TEST(AgradRevMatrix, log_determinant_spd_sparse) {
+  using stan::math::log_determinant_spd;
+  using stan::math::matrix_v;
+  using stan::math::var;
+
+  Eigen::MatrixXd A = 4 * Eigen::MatrixXd::Identity(6, 6);
+  A(1, 0) = A(0, 1) = 1;
+  A(3, 0) = A(0, 3) = 0.5;
+  A(2, 1) = A(1, 2) = -0.7;
+  A(4, 3) = A(3, 4) = 0.3;
+  A(5, 2) = A(2, 5) = 0.2;
+  A(5, 4) = A(4, 5) = -0.4;
+
+  Eigen::SparseMatrix<var> A_v = A.sparseView().cast<var>();
+  var f = log_determinant_spd(A_v);
+  f.grad();
+
+  std::vector<double> adj;
+  for (int k = 0; k < A_v.outerSize(); ++k)
+    for (Eigen::SparseMatrix<var>::InnerIterator it(A_v, k); it; ++it)
+      adj.push_back(it.value().adj());
+  stan::math::set_zero_all_adjoints();
+
+  matrix_v A_dense = A;
+  var g = log_determinant_spd(A_dense);
+  g.grad();
+
+  EXPECT_FLOAT_EQ(g.val(), f.val());
+  EXPECT_FLOAT_EQ(log_determinant_spd(Eigen::SparseMatrix<double>(
+                      A.sparseView())),
+                  f.val());
+  size_t t = 0;
+  for (int k = 0; k < A_v.outerSize(); ++k)
+    for (Eigen::SparseMatrix<var>::InnerIterator it(A_v, k); it; ++it)
+      EXPECT_FLOAT_EQ(A_dense(it.row(), it.col()).adj(), adj[t++]);
+
+  A(2, 2) = -10;
+  Eigen::SparseMatrix<var> B_v = A.sparseView().cast<var>();
+  EXPECT_THROW(log_determinant_spd(B_v), std::domain_error);
+  stan::math::recover_memory();
+}
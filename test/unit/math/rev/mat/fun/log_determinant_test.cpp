@@ -81,3 +81,57 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   X << 2, 3, 6, 7;
   test::check_varis_on_stack(stan::math::log_determinant(X));
 }
+
+void test_log_determinant_batch(int M, int B) {
+  using stan::math::matrix_v;
+  using stan::math::var;
+  std::vector<Eigen::MatrixXd> A_d(B);
+  for (int n = 0; n < B; ++n)
+    A_d[n] = Eigen::MatrixXd::Random(M, M);
+
+  std::vector<matrix_v> A(B);
+  for (int n = 0; n < B; ++n)
+    A[n] = A_d[n];
+  std::vector<var> log_det = stan::math::log_determinant(A);
+  ASSERT_EQ(B, static_cast<int>(log_det.size()));
+  var f = 0;
+  for (int n = 0; n < B; ++n)
+    f += (n + 1) * log_det[n];
+  f.grad();
+  std::vector<double> log_det_batch(B);
+  std::vector<Eigen::MatrixXd> A_adj(B);
+  for (int n = 0; n < B; ++n) {
+    log_det_batch[n] = log_det[n].val();
+    A_adj[n] = A[n].adj();
+  }
+  stan::math::recover_memory();
+
+  for (int n = 0; n < B; ++n) {
+    matrix_v A_n = A_d[n];
+    var g = (n + 1) * stan::math::log_determinant(A_n);
+    g.grad();
+    EXPECT_FLOAT_EQ(g.val() / (n + 1), log_det_batch[n]);
+    for (int k = 0; k < M * M; ++k)
+      EXPECT_FLOAT_EQ(A_n(k).adj(), A_adj[n](k));
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevMatrix, log_determinant_batch) {
+  test_log_determinant_batch(1, 4);
+  test_log_determinant_batch(3, 10);
+  test_log_determinant_batch(8, 3);
+  test_log_determinant_batch(11, 2);
+}
+
+TEST(AgradRevMatrix, log_determinant_batch_exceptions) {
+  using stan::math::matrix_v;
+  std::vector<matrix_v> A;
+  EXPECT_EQ(0U, stan::math::log_determinant(A).size());
+  A.push_back(matrix_v::Identity(2, 2));
+  A.push_back(matrix_v::Identity(3, 3));
+  EXPECT_THROW(stan::math::log_determinant(A), std::invalid_argument);
+  A[1] = matrix_v(2, 3);
+  EXPECT_THROW(stan::math::log_determinant(A), std::invalid_argument);
+  stan::math::recover_memory();
+}
@@ -5,6 +5,7 @@
 #include <test/unit/math/rev/mat/util.hpp>
 #include <stdexcept>
 #include <iostream>
+#include <vector>
 
 TEST(AgradRevMatrix, var_var_mdivide_left_tri_low) {
   using stan::math::matrix_d;
@@ -146,3 +147,77 @@ TEST(AgradRevMatrix, double_var_mdivide_left_tri_low) {
   for (int i = 0; i < A2_under_B2.size(); ++i)
     EXPECT_FLOAT_EQ(A2_under_B2(i).val(), A_under_B(i).val());
 }
+
+void test_mdivide_left_tri_low_batch(int M, int K, int B) {
+  using stan::math::matrix_v;
+  using stan::math::var;
+  std::vector<Eigen::MatrixXd> L_d(B), b_d(B);
+  for (int n = 0; n < B; ++n) {
+    L_d[n] = Eigen::MatrixXd::Random(M, M);
+    L_d[n].diagonal().array() += 2 * M;
+    b_d[n] = Eigen::MatrixXd::Random(M, K);
+  }
+
+  std::vector<matrix_v> L(B), b(B);
+  for (int n = 0; n < B; ++n) {
+    L[n] = L_d[n];
+    b[n] = b_d[n];
+  }
+  std::vector<matrix_v> x = stan::math::mdivide_left_tri_low(L, b);
+  ASSERT_EQ(B, static_cast<int>(x.size()));
+  var f = 0;
+  for (int n = 0; n < B; ++n)
+    f += (n + 1) * stan::math::sum(stan::math::square(x[n]));
+  f.grad();
+  std::vector<Eigen::MatrixXd> x_batch(B), L_adj(B), b_adj(B);
+  for (int n = 0; n < B; ++n) {
+    x_batch[n] = stan::math::value_of(x[n]);
+    L_adj[n] = L[n].adj();
+    b_adj[n] = b[n].adj();
+  }
+  stan::math::recover_memory();
+
+  for (int n = 0; n < B; ++n) {
+    matrix_v L_n = L_d[n];
+    matrix_v b_n = b_d[n];
+    matrix_v x_n = stan::math::mdivide_left_tri_low(L_n, b_n);
+    var g = (n + 1) * stan::math::sum(stan::math::square(x_n));
+    g.grad();
+    for (int k = 0; k < M * K; ++k) {
+      EXPECT_FLOAT_EQ(x_n(k).val(), x_batch[n](k));
+      EXPECT_FLOAT_EQ(b_n(k).adj(), b_adj[n](k));
+    }
+    for (int k = 0; k < M * M; ++k)
+      EXPECT_FLOAT_EQ(L_n(k).adj(), L_adj[n](k));
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevMatrix, mdivide_left_tri_low_batch) {
+  test_mdivide_left_tri_low_batch(1, 1, 3);
+  test_mdivide_left_tri_low_batch(3, 1, 10);
+  test_mdivide_left_tri_low_batch(4, 3, 5);
+  test_mdivide_left_tri_low_batch(10, 2, 3);
+}
+
+TEST(AgradRevMatrix, mdivide_left_tri_low_batch_exceptions) {
+  using stan::math::matrix_v;
+  using stan::math::mdivide_left_tri_low;
+  std::vector<matrix_v> L(2, matrix_v::Identity(2, 2));
+  std::vector<matrix_v> b(2, matrix_v::Ones(2, 1));
+  EXPECT_NO_THROW(mdivide_left_tri_low(L, b));
+
+  std::vector<matrix_v> b3(3, matrix_v::Ones(2, 1));
+  EXPECT_THROW(mdivide_left_tri_low(L, b3), std::invalid_argument);
+
+  b[1] = matrix_v::Ones(2, 2);
+  EXPECT_THROW(mdivide_left_tri_low(L, b), std::invalid_argument);
+
+  b[1] = matrix_v::Ones(3, 1);
+  EXPECT_THROW(mdivide_left_tri_low(L, b), std::invalid_argument);
+
+  b[1] = matrix_v::Ones(2, 1);
+  L[1] = matrix_v::Identity(3, 3);
+  EXPECT_THROW(mdivide_left_tri_low(L, b), std::invalid_argument);
+  stan::math::recover_memory();
+}
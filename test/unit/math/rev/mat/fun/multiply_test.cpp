@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/mat/fun/util.hpp>
 #include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
 
 // multiply operates on two matrices A X B
 // A (n, m)
@@ -1722,3 +1723,82 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::multiply(s, value_of(s)));
   test::check_varis_on_stack(stan::math::multiply(value_of(s), s));
 }
+
+template <int C>
+void test_multiply_batch(int N, int M, int K, int B) {
+  using stan::math::matrix_v;
+  using stan::math::var;
+  typedef Eigen::Matrix<var, -1, C> matrix_b;
+  std::vector<Eigen::MatrixXd> A_d(B), B_d(B);
+  for (int n = 0; n < B; ++n) {
+    A_d[n] = Eigen::MatrixXd::Random(N, M);
+    B_d[n] = Eigen::MatrixXd::Random(M, K);
+  }
+
+  std::vector<matrix_v> A(B);
+  std::vector<matrix_b> Bv(B);
+  for (int n = 0; n < B; ++n) {
+    A[n] = A_d[n];
+    Bv[n] = B_d[n];
+  }
+  std::vector<Eigen::Matrix<var, -1, C> > AB = stan::math::multiply(A, Bv);
+  ASSERT_EQ(B, static_cast<int>(AB.size()));
+  var f = 0;
+  for (int n = 0; n < B; ++n)
+    f += (n + 1) * stan::math::sum(stan::math::square(AB[n]));
+  f.grad();
+  std::vector<Eigen::MatrixXd> AB_batch(B), A_adj(B), B_adj(B);
+  for (int n = 0; n < B; ++n) {
+    AB_batch[n] = stan::math::value_of(AB[n]);
+    A_adj[n] = A[n].adj();
+    B_adj[n] = Bv[n].adj();
+  }
+  stan::math::recover_memory();
+
+  for (int n = 0; n < B; ++n) {
+    matrix_v A_n = A_d[n];
+    matrix_v B_n = B_d[n];
+    matrix_v AB_n = stan::math::multiply(A_n, B_n);
+    var g = (n + 1) * stan::math::sum(stan::math::square(AB_n));
+    g.grad();
+    for (int k = 0; k < N * K; ++k)
+      EXPECT_FLOAT_EQ(AB_n(k).val(), AB_batch[n](k));
+    for (int k = 0; k < N * M; ++k)
+      EXPECT_FLOAT_EQ(A_n(k).adj(), A_adj[n](k));
+    for (int k = 0; k < M * K; ++k)
+      EXPECT_FLOAT_EQ(B_n(k).adj(), B_adj[n](k));
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevMatrix, multiply_batch) {
+  test_multiply_batch<-1>(3, 3, 3, 10);
+  test_multiply_batch<-1>(8, 8, 2, 4);
+  test_multiply_batch<-1>(2, 4, 3, 5);
+  test_multiply_batch<-1>(9, 9, 9, 2);
+  test_multiply_batch<1>(5, 5, 1, 6);
+  test_multiply_batch<1>(3, 6, 1, 6);
+}
+
+TEST(AgradRevMatrix, multiply_batch_exceptions) {
+  using stan::math::matrix_v;
+  using stan::math::vector_v;
+  std::vector<matrix_v> A(2, matrix_v::Identity(2, 2));
+  std::vector<vector_v> b(2, vector_v::Ones(2));
+  EXPECT_NO_THROW(stan::math::multiply(A, b));
+
+  std::vector<vector_v> b3(3, vector_v::Ones(2));
+  EXPECT_THROW(stan::math::multiply(A, b3), std::invalid_argument);
+
+  b[1] = vector_v::Ones(3);
+  EXPECT_THROW(stan::math::multiply(A, b), std::invalid_argument);
+
+  b[1] = vector_v::Ones(2);
+  A[1] = matrix_v::Identity(3, 2);
+  EXPECT_THROW(stan::math::multiply(A, b), std::invalid_argument);
+
+  std::vector<matrix_v> A0(2, matrix_v(2, 0));
+  std::vector<vector_v> b0(2, vector_v(0));
+  EXPECT_THROW(stan::math::multiply(A0, b0), std::invalid_argument);
+  stan::math::recover_memory();
+}
@@ -211,3 +211,35 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::quad_form_diag(to_var(m), v));
   test::check_varis_on_stack(stan::math::quad_form_diag(m, to_var(v)));
 }
+
+TEST(MathMatrix, quadFormDiagSingleVari) {
+  Matrix<var, Dynamic, Dynamic> m(3, 3);
+  m << 1, 2, 3, 4, 5, 6, 7, 8, 9;
+  Matrix<var, Dynamic, 1> v(3);
+  v << -2, 0.5, 3;
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  Matrix<var, Dynamic, Dynamic> res = quad_form_diag(m, v);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  test::check_varis_on_stack(res);
+
+  res(0, 2).grad();
+  // res(0, 2) = v(0) * m(0, 2) * v(2)
+  EXPECT_FLOAT_EQ(m(0, 2).val() * v(2).val(), v(0).adj());
+  EXPECT_FLOAT_EQ(0, v(1).adj());
+  EXPECT_FLOAT_EQ(v(0).val() * m(0, 2).val(), v(2).adj());
+  EXPECT_FLOAT_EQ(v(0).val() * v(2).val(), m(0, 2).adj());
+  EXPECT_FLOAT_EQ(0, m(2, 0).adj());
+  stan::math::recover_memory();
+
+  Matrix<double, Dynamic, Dynamic> md(2, 2);
+  md << 2, 1, 1, 3;
+  Matrix<var, Dynamic, 1> v2(2);
+  v2 << 1.5, -1;
+  stan::math::sum(quad_form_diag(md, v2)).grad();
+  // d/dv_k sum_ij v_i m_ij v_j = 2 * (m v)_k for symmetric m
+  EXPECT_FLOAT_EQ(2 * (2 * 1.5 + 1 * -1), v2(0).adj());
+  EXPECT_FLOAT_EQ(2 * (1 * 1.5 + 3 * -1), v2(1).adj());
+  stan::math::recover_memory();
+}
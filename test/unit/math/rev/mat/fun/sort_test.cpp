@@ -210,3 +210,22 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::sort_asc(x));
   test::check_varis_on_stack(stan::math::sort_desc(x));
 }
+
+TEST(AgradRevMatrix, sort_creates_no_varis) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x(4);
+  x << 3, -1, 2.5, 0;
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y = stan::math::sort_desc(x);
+  EXPECT_EQ(stack_size,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  EXPECT_FLOAT_EQ(3, y(0).val());
+  EXPECT_FLOAT_EQ(-1, y(3).val());
+
+  var lp = 2 * y(0) + y(3);
+  lp.grad();
+  EXPECT_FLOAT_EQ(2, x(0).adj());
+  EXPECT_FLOAT_EQ(1, x(1).adj());
+  EXPECT_FLOAT_EQ(0, x(2).adj());
+  stan::math::recover_memory();
+}
@@ -0,0 +1,118 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+namespace {
+// symmetric positive definite with fill-in at (3, 1)
+Eigen::MatrixXd sparse_spd_matrix() {
+  Eigen::MatrixXd A = 4 * Eigen::MatrixXd::Identity(6, 6);
+  A(1, 0) = A(0, 1) = 1;
+  A(3, 0) = A(0, 3) = 0.5;
+  A(2, 1) = A(1, 2) = -0.7;
+  A(4, 3) = A(3, 4) = 0.3;
+  A(5, 2) = A(2, 5) = 0.2;
+  A(5, 4) = A(4, 5) = -0.4;
+  return A;
+}
+}  // namespace
+
+TEST(AgradRevMatrix, sparse_cholesky_decompose_val) {
+  using stan::math::var;
+  Eigen::MatrixXd A = sparse_spd_matrix();
+  Eigen::SparseMatrix<var> A_v = A.sparseView().cast<var>();
+
+  Eigen::SparseMatrix<var> L_v = stan::math::sparse_cholesky_decompose(A_v);
+  Eigen::MatrixXd L = A.llt().matrixL();
+  Eigen::MatrixXd L_dense = Eigen::MatrixXd(stan::math::value_of(L_v));
+  for (int i = 0; i < 6; ++i)
+    for (int j = 0; j < 6; ++j)
+      EXPECT_NEAR(L(i, j), L_dense(i, j), 1e-12);
+  EXPECT_NE(0, L_v.coeff(3, 1).val());
+}
+
+TEST(AgradRevMatrix, sparse_cholesky_decompose_grad) {
+  using stan::math::matrix_v;
+  using stan::math::var;
+  Eigen::MatrixXd A = sparse_spd_matrix();
+
+  Eigen::SparseMatrix<var> A_v = A.sparseView().cast<var>();
+  Eigen::SparseMatrix<var> L_v = stan::math::sparse_cholesky_decompose(A_v);
+  std::vector<int> rows;
+  std::vector<int> cols;
+  var f = 0;
+  for (int k = 0; k < L_v.outerSize(); ++k) {
+    for (Eigen::SparseMatrix<var>::InnerIterator it(L_v, k); it; ++it) {
+      f += (1 + 0.3 * rows.size()) * it.value();
+      rows.push_back(it.row());
+      cols.push_back(it.col());
+    }
+  }
+  f.grad();
+
+  std::vector<double> adj;
+  for (int k = 0; k < A_v.outerSize(); ++k)
+    for (Eigen::SparseMatrix<var>::InnerIterator it(A_v, k); it; ++it)
+      adj.push_back(it.value().adj());
+  stan::math::set_zero_all_adjoints();
+
+  matrix_v A_dense = A;
+  matrix_v L_dense = stan::math::cholesky_decompose(A_dense);
+  var g = 0;
+  for (size_t p = 0; p < rows.size(); ++p)
+    g += (1 + 0.3 * p) * L_dense(rows[p], cols[p]);
+  g.grad();
+
+  EXPECT_FLOAT_EQ(g.val(), f.val());
+  size_t t = 0;
+  for (int k = 0; k < A_v.outerSize(); ++k)
+    for (Eigen::SparseMatrix<var>::InnerIterator it(A_v, k); it; ++it)
+      EXPECT_NEAR(A_dense(it.row(), it.col()).adj(), adj[t++], 1e-10)
+          << it.row() << ", " << it.col();
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrix, sparse_cholesky_decompose_reuses_pattern) {
+  using stan::math::var;
+  Eigen::MatrixXd A = sparse_spd_matrix();
+  Eigen::SparseMatrix<var> A_v = A.sparseView().cast<var>();
+  stan::math::sparse_cholesky_decompose(A_v);
+
+  Eigen::MatrixXd B = 2 * A;
+  Eigen::SparseMatrix<var> B_v = B.sparseView().cast<var>();
+  Eigen::SparseMatrix<var> L_v = stan::math::sparse_cholesky_decompose(B_v);
+  Eigen::MatrixXd L = B.llt().matrixL();
+  Eigen::MatrixXd L_dense = Eigen::MatrixXd(stan::math::value_of(L_v));
+  for (int i = 0; i < 6; ++i)
+    for (int j = 0; j < 6; ++j)
+      EXPECT_NEAR(L(i, j), L_dense(i, j), 1e-12);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrix, sparse_cholesky_decompose_exceptions) {
+  using stan::math::var;
+  Eigen::MatrixXd A = sparse_spd_matrix();
+  A(1, 0) = 2;
+  Eigen::SparseMatrix<var> A_v = A.sparseView().cast<var>();
+  EXPECT_THROW(stan::math::sparse_cholesky_decompose(A_v), std::domain_error);
+
+  Eigen::MatrixXd B = sparse_spd_matrix();
+  B(2, 2) = -1;
+  Eigen::SparseMatrix<var> B_v = B.sparseView().cast<var>();
+  EXPECT_THROW(stan::math::sparse_cholesky_decompose(B_v), std::domain_error);
+
+  Eigen::SparseMatrix<var> C_v(3, 2);
+  EXPECT_THROW(stan::math::sparse_cholesky_decompose(C_v),
+               std::invalid_argument);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrix, check_varis_on_stack_sparse_cholesky) {
+  using stan::math::var;
+  Eigen::MatrixXd A = sparse_spd_matrix();
+  Eigen::SparseMatrix<var> A_v = A.sparseView().cast<var>();
+  Eigen::SparseMatrix<var> L_v = stan::math::sparse_cholesky_decompose(A_v);
+  Eigen::Matrix<var, -1, 1> L_vals
+      = Eigen::Map<Eigen::Matrix<var, -1, 1> >(L_v.valuePtr(), L_v.nonZeros());
+  test::check_varis_on_stack(L_vals);
+}
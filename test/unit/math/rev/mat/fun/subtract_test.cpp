@@ -249,3 +249,25 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::subtract(s, value_of(rv)));
   test::check_varis_on_stack(stan::math::subtract(value_of(s), rv));
 }
+
+TEST(AgradRevMatrix, subtract_matrix_single_vari) {
+  using stan::math::matrix_d;
+  using stan::math::matrix_v;
+  using stan::math::subtract;
+
+  matrix_d a(2, 3);
+  a << 1, 2, 3, 4, 5, 6;
+  matrix_v b(2, 3);
+  b << -1, 0.5, 2, 7, 1, 3;
+
+  size_t stack_size = stan::math::ChainableStack::instance_->var_stack_.size();
+  matrix_v c = subtract(a, b);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  test::check_varis_on_stack(c);
+
+  c(0, 1).grad();
+  for (int i = 0; i < b.size(); ++i)
+    EXPECT_FLOAT_EQ(i == 2 ? -1.0 : 0.0, b(i).adj());
+  stan::math::recover_memory();
+}
@@ -0,0 +1,115 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// independent exponential decays, y_i(t) = y0_i exp(-theta t)
+struct decay_ode_fun {
+  template <typename T0, typename T1, typename T2>
+  std::vector<typename stan::return_type<T1, T2>::type> operator()(
+      const T0& t_in, const std::vector<T1>& y,
+      const std::vector<T2>& theta, const std::vector<double>& x,
+      const std::vector<int>& x_int, std::ostream* msgs) const {
+    std::vector<typename stan::return_type<T1, T2>::type> dy_dt;
+    for (size_t i = 0; i < y.size(); ++i)
+      dy_dt.push_back(-theta[0] * y[i]);
+    return dy_dt;
+  }
+};
+
+typedef stan::math::cvodes_workspace_cache<
+    stan::math::cvodes_ode_data<decay_ode_fun, double, stan::math::var>>
+    dv_cache;
+typedef stan::math::cvodes_workspace_cache<
+    stan::math::cvodes_ode_data<decay_ode_fun, double, double>>
+    dd_cache;
+
+// solves the decay ODE and checks the values and gradients against
+// the analytic solution
+void expect_decay_solution(const std::vector<double>& y0, double theta_val) {
+  using stan::math::var;
+  std::vector<double> ts = {0.5, 1.0, 2.0};
+  std::vector<var> theta = {theta_val};
+  std::vector<std::vector<var>> y = stan::math::integrate_ode_bdf(
+      decay_ode_fun(), y0, 0.0, ts, theta, std::vector<double>(),
+      std::vector<int>(), nullptr, 1e-10, 1e-10, 1e8);
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (size_t i = 0; i < y0.size(); ++i) {
+      double expected = y0[i] * std::exp(-theta_val * ts[n]);
+      EXPECT_NEAR(expected, y[n][i].val(), 1e-7);
+      stan::math::set_zero_all_adjoints();
+      y[n][i].grad();
+      EXPECT_NEAR(-ts[n] * expected, theta[0].adj(), 1e-6);
+    }
+  }
+  stan::math::recover_memory();
+}
+
+}  // namespace
+
+TEST(StanMathRevCvodesWorkspace, reused_across_solves) {
+  const size_t initial_size = dv_cache::size();
+  expect_decay_solution({1.0, 2.0}, 0.5);
+  EXPECT_EQ(initial_size + 1, dv_cache::size());
+
+  // same size and method reuses the workspace
+  expect_decay_solution({-3.0, 0.5}, 1.5);
+  expect_decay_solution({1.0, 2.0}, 0.5);
+  EXPECT_EQ(initial_size + 1, dv_cache::size());
+
+  // a different number of states needs another workspace
+  expect_decay_solution({1.0, 2.0, 3.0}, 0.7);
+  EXPECT_EQ(initial_size + 2, dv_cache::size());
+  expect_decay_solution({1.0, 2.0}, 0.2);
+  EXPECT_EQ(initial_size + 2, dv_cache::size());
+}
+
+TEST(StanMathRevCvodesWorkspace, separate_caches_per_type) {
+  const size_t initial_size = dd_cache::size();
+  std::vector<double> y0 = {1.0, 2.0};
+  std::vector<double> theta = {0.5};
+  std::vector<double> ts = {1.0};
+  for (int k = 0; k < 3; ++k) {
+    std::vector<std::vector<double>> y = stan::math::integrate_ode_adams(
+        decay_ode_fun(), y0, 0.0, ts, theta, std::vector<double>(),
+        std::vector<int>());
+    EXPECT_NEAR(std::exp(-0.5), y[0][0], 1e-7);
+    EXPECT_NEAR(2 * std::exp(-0.5), y[0][1], 1e-7);
+  }
+  EXPECT_EQ(initial_size + 1, dd_cache::size());
+}
+
+TEST(StanMathRevCvodesWorkspace, failed_solve_not_cached) {
+  using stan::math::var;
+  expect_decay_solution({1.0, 2.0}, 0.5);
+  const size_t initial_size = dv_cache::size();
+
+  std::vector<double> y0 = {1.0, 2.0};
+  std::vector<var> theta = {0.5};
+  std::vector<double> ts = {1e6};
+  EXPECT_THROW(stan::math::integrate_ode_bdf(
+                   decay_ode_fun(), y0, 0.0, ts, theta, std::vector<double>(),
+                   std::vector<int>(), nullptr, 1e-10, 1e-10, 2),
+               std::runtime_error);
+  stan::math::recover_memory();
+  EXPECT_EQ(initial_size - 1, dv_cache::size());
+
+  expect_decay_solution({1.0, 2.0}, 0.5);
+  EXPECT_EQ(initial_size, dv_cache::size());
+}
+
+TEST(StanMathRevCvodesWorkspace, matches) {
+  using stan::math::cvodes_band_solver;
+  using stan::math::cvodes_dense_solver;
+  using stan::math::cvodes_workspace;
+  cvodes_workspace workspace(CV_BDF, 4, 2, cvodes_band_solver(1, 1));
+  EXPECT_TRUE(workspace.matches(CV_BDF, 4, 2, cvodes_band_solver(1, 1)));
+  EXPECT_FALSE(workspace.matches(CV_ADAMS, 4, 2, cvodes_band_solver(1, 1)));
+  EXPECT_FALSE(workspace.matches(CV_BDF, 3, 2, cvodes_band_solver(1, 1)));
+  EXPECT_FALSE(workspace.matches(CV_BDF, 4, 0, cvodes_band_solver(1, 1)));
+  EXPECT_FALSE(workspace.matches(CV_BDF, 4, 2, cvodes_band_solver(2, 1)));
+  EXPECT_FALSE(workspace.matches(CV_BDF, 4, 2, cvodes_dense_solver()));
+}
@@ -0,0 +1,52 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <test/unit/math/rev/mat/functor/util_ode_batch.hpp>
+#include <stdexcept>
+#include <vector>
+
+TEST(StanMathOdeIntegrateODEBatch, bdf_matches_single_solves) {
+  ode_batch_test::expect_batch_matches(ode_batch_test::bdf_solver());
+  ode_batch_test::expect_batch_matches_data(ode_batch_test::bdf_solver());
+}
+
+TEST(StanMathOdeIntegrateODEBatch, error_checks) {
+  using ode_batch_test::batch_data;
+  using stan::math::integrate_ode_bdf_batch;
+  const batch_data data;
+  const std::vector<std::vector<double>>& y0_dbl = data.y0_dbl;
+  const std::vector<std::vector<double>>& theta_dbl = data.theta_dbl;
+  const std::vector<std::vector<double>>& ts = data.ts;
+  std::vector<std::vector<double>> x(3);
+  std::vector<std::vector<int>> x_int(3);
+
+  std::vector<std::vector<double>> ts_short(ts.begin(), ts.begin() + 2);
+  EXPECT_THROW(integrate_ode_bdf_batch(harm_osc_ode_fun(), y0_dbl, 0.0,
+                                       ts_short, theta_dbl, x, x_int),
+               std::invalid_argument);
+  std::vector<std::vector<double>> theta_short(theta_dbl.begin(),
+                                               theta_dbl.begin() + 1);
+  EXPECT_THROW(integrate_ode_bdf_batch(harm_osc_ode_fun(), y0_dbl, 0.0, ts,
+                                       theta_short, x, x_int),
+               std::invalid_argument);
+
+  // errors of a single subject propagate
+  std::vector<std::vector<double>> y0_bad = y0_dbl;
+  y0_bad[1].push_back(1.0);
+  EXPECT_THROW(integrate_ode_bdf_batch(harm_osc_ode_fun(), y0_bad, 0.0, ts,
+                                       theta_dbl, x, x_int),
+               std::domain_error);
+  std::vector<std::vector<double>> ts_bad = ts;
+  ts_bad[2][0] = -1.0;
+  EXPECT_THROW(integrate_ode_bdf_batch(harm_osc_ode_fun(), y0_dbl, 0.0, ts_bad,
+                                       theta_dbl, x, x_int),
+               std::domain_error);
+
+  EXPECT_TRUE(stan::math::empty_nested());
+
+  std::vector<std::vector<double>> empty;
+  EXPECT_EQ(0U, integrate_ode_bdf_batch(harm_osc_ode_fun(), empty, 0.0, empty,
+                                        empty, empty,
+                                        std::vector<std::vector<int>>())
+                    .size());
+}
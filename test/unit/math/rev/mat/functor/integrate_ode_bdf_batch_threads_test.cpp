@@ -0,0 +1,33 @@
+// the tests here check that the ODE batches give the same results
+// on any number of threads, they only run if STAN_THREADS is defined
+
+#ifdef STAN_THREADS
+
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/mat/functor/utils_threads.hpp>
+#include <test/unit/math/rev/mat/functor/util_ode_batch.hpp>
+
+TEST(StanMathOdeIntegrateODEBatch, bdf_threads) {
+  for (int num_threads : {1, 2, 3, 8}) {
+    set_n_threads(num_threads);
+    for (size_t num_subjects : {1, 2, 5, 13}) {
+      const ode_batch_test::batch_data data(num_subjects);
+      ode_batch_test::expect_batch_matches(ode_batch_test::bdf_solver(), data);
+      ode_batch_test::expect_batch_matches_data(ode_batch_test::bdf_solver(),
+                                                data);
+    }
+  }
+}
+
+TEST(StanMathOdeIntegrateODEBatch, rk45_threads) {
+  for (int num_threads : {1, 3, 8}) {
+    set_n_threads(num_threads);
+    const ode_batch_test::batch_data data(7);
+    ode_batch_test::expect_batch_matches(ode_batch_test::rk45_solver(), data);
+    ode_batch_test::expect_batch_matches_data(ode_batch_test::rk45_solver(),
+                                              data);
+  }
+}
+
+#endif
@@ -0,0 +1,262 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// first order absorption from a depot into a central compartment
+// with first order elimination, theta = (ka, ke)
+struct absorption_ode_fun {
+  template <typename T0, typename T1, typename T2>
+  std::vector<typename stan::return_type<T1, T2>::type> operator()(
+      const T0& t_in, const std::vector<T1>& y,
+      const std::vector<T2>& theta, const std::vector<double>& x,
+      const std::vector<int>& x_int, std::ostream* msgs) const {
+    std::vector<typename stan::return_type<T1, T2>::type> dy_dt(2);
+    dy_dt[0] = -theta[0] * y[0];
+    dy_dt[1] = theta[0] * y[0] - theta[1] * y[1];
+    return dy_dt;
+  }
+};
+
+// superposition of the analytic solutions from the initial state and
+// from each dose given up to t
+template <typename T1, typename T2, typename T3>
+std::vector<typename stan::return_type<T1, T2, T3>::type> absorption_solution(
+    const std::vector<T1>& y0, const std::vector<T2>& theta,
+    const std::vector<double>& event_times,
+    const std::vector<std::vector<T3>>& doses, double t) {
+  using std::exp;
+  typedef typename stan::return_type<T1, T2, T3>::type T;
+  const T2& ka = theta[0];
+  const T2& ke = theta[1];
+  std::vector<T> y(2);
+  y[0] = y0[0] * exp(-ka * t);
+  y[1] = y0[1] * exp(-ke * t)
+         + y0[0] * ka / (ka - ke) * (exp(-ke * t) - exp(-ka * t));
+  for (size_t k = 0; k < event_times.size() && event_times[k] <= t; ++k) {
+    const double dt = t - event_times[k];
+    y[0] += doses[k][0] * exp(-ka * dt);
+    y[1] += doses[k][1] * exp(-ke * dt)
+            + doses[k][0] * ka / (ka - ke) * (exp(-ke * dt) - exp(-ka * dt));
+  }
+  return y;
+}
+
+const std::vector<double> ts = {0.5, 1.0, 2.0, 3.5, 6.0, 12.0};
+// doses at the initial time, at an output time, twice at the same
+// time and after the last output time
+const std::vector<double> event_times = {0.0, 1.0, 1.7, 1.7, 4.25, 13.0};
+const std::vector<std::vector<double>> doses_dbl = {{100.0, 0.0}, {50.0, 0.0},
+                                                    {20.0, 0.0},  {0.0, 10.0},
+                                                    {80.0, 5.0},  {100.0, 0.0}};
+
+template <typename Solve>
+void expect_events_match(const Solve& solve) {
+  using stan::math::var;
+  std::vector<var> y0 = {1.0, 2.0};
+  std::vector<var> theta = {1.3, 0.2};
+  std::vector<std::vector<var>> doses;
+  for (const std::vector<double>& dose : doses_dbl)
+    doses.emplace_back(dose.begin(), dose.end());
+
+  std::vector<std::vector<var>> y = solve(y0, theta, doses);
+  ASSERT_EQ(ts.size(), y.size());
+
+  for (size_t n = 0; n < ts.size(); ++n) {
+    std::vector<var> y_expected
+        = absorption_solution(y0, theta, event_times, doses, ts[n]);
+    for (size_t i = 0; i < 2; ++i) {
+      EXPECT_NEAR(y_expected[i].val(), y[n][i].val(),
+                  1e-6 * std::fabs(y_expected[i].val()) + 1e-8);
+
+      std::vector<double> grad_expected;
+      stan::math::set_zero_all_adjoints();
+      y_expected[i].grad();
+      for (size_t j = 0; j < 2; ++j)
+        grad_expected.push_back(y0[j].adj());
+      for (size_t j = 0; j < 2; ++j)
+        grad_expected.push_back(theta[j].adj());
+      for (size_t k = 0; k < doses.size(); ++k)
+        for (size_t j = 0; j < 2; ++j)
+          grad_expected.push_back(doses[k][j].adj());
+
+      std::vector<double> grad;
+      stan::math::set_zero_all_adjoints();
+      y[n][i].grad();
+      for (size_t j = 0; j < 2; ++j)
+        grad.push_back(y0[j].adj());
+      for (size_t j = 0; j < 2; ++j)
+        grad.push_back(theta[j].adj());
+      for (size_t k = 0; k < doses.size(); ++k)
+        for (size_t j = 0; j < 2; ++j)
+          grad.push_back(doses[k][j].adj());
+
+      for (size_t j = 0; j < grad.size(); ++j)
+        EXPECT_NEAR(grad_expected[j], grad[j],
+                    1e-5 * std::fabs(grad_expected[j]) + 1e-7)
+            << "output " << n << ", state " << i << ", operand " << j;
+    }
+  }
+  EXPECT_TRUE(stan::math::empty_nested());
+  stan::math::recover_memory();
+}
+
+struct bdf_events {
+  template <typename T1, typename T2, typename T3>
+  std::vector<std::vector<typename stan::return_type<T1, T2, T3>::type>>
+  operator()(const std::vector<T1>& y0, const std::vector<T2>& theta,
+             const std::vector<std::vector<T3>>& doses) const {
+    return stan::math::integrate_ode_bdf_events(
+        absorption_ode_fun(), y0, 0.0, ts, theta, event_times, doses,
+        std::vector<double>(), std::vector<int>());
+  }
+};
+
+struct adams_events {
+  template <typename T1, typename T2, typename T3>
+  std::vector<std::vector<typename stan::return_type<T1, T2, T3>::type>>
+  operator()(const std::vector<T1>& y0, const std::vector<T2>& theta,
+             const std::vector<std::vector<T3>>& doses) const {
+    return stan::math::integrate_ode_adams_events(
+        absorption_ode_fun(), y0, 0.0, ts, theta, event_times, doses,
+        std::vector<double>(), std::vector<int>());
+  }
+};
+
+}  // namespace
+
+TEST(StanMathOdeIntegrateODEEvents, bdf_matches_analytic) {
+  expect_events_match(bdf_events());
+  // a second solve reuses the CVODES memory
+  expect_events_match(bdf_events());
+}
+
+TEST(StanMathOdeIntegrateODEEvents, adams_matches_analytic) {
+  expect_events_match(adams_events());
+}
+
+TEST(StanMathOdeIntegrateODEEvents, data_doses) {
+  using stan::math::var;
+  std::vector<double> y0 = {1.0, 2.0};
+  std::vector<double> theta_dbl = {1.3, 0.2};
+  std::vector<var> theta = {1.3, 0.2};
+
+  std::vector<std::vector<double>> y_dd
+      = bdf_events()(y0, theta_dbl, doses_dbl);
+  std::vector<std::vector<var>> y_dv = bdf_events()(y0, theta, doses_dbl);
+  for (size_t n = 0; n < ts.size(); ++n) {
+    std::vector<double> y_expected
+        = absorption_solution(y0, theta_dbl, event_times, doses_dbl, ts[n]);
+    std::vector<var> y_expected_v
+        = absorption_solution(y0, theta, event_times, doses_dbl, ts[n]);
+    for (size_t i = 0; i < 2; ++i) {
+      EXPECT_NEAR(y_expected[i], y_dd[n][i], 1e-6 * y_expected[i] + 1e-8);
+      EXPECT_NEAR(y_expected[i], y_dv[n][i].val(),
+                  1e-6 * y_expected[i] + 1e-8);
+
+      stan::math::set_zero_all_adjoints();
+      y_expected_v[i].grad();
+      std::vector<double> grad_expected = {theta[0].adj(), theta[1].adj()};
+      stan::math::set_zero_all_adjoints();
+      y_dv[n][i].grad();
+      for (size_t j = 0; j < 2; ++j)
+        EXPECT_NEAR(grad_expected[j], theta[j].adj(),
+                    1e-5 * std::fabs(grad_expected[j]) + 1e-7);
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateODEEvents, many_doses) {
+  using stan::math::var;
+  // a dose into the depot every 12 hours for 100 days
+  std::vector<double> times;
+  std::vector<std::vector<double>> doses;
+  for (int k = 0; k < 200; ++k) {
+    times.push_back(12.0 * k);
+    doses.push_back({100.0, 0.0});
+  }
+  std::vector<double> ts_long = {11.0, 600.0, 1200.0, 2399.0};
+  std::vector<double> y0 = {0.0, 0.0};
+  std::vector<var> theta = {1.3, 0.2};
+  std::vector<std::vector<var>> y = stan::math::integrate_ode_bdf_events(
+      absorption_ode_fun(), y0, 0.0, ts_long, theta, times, doses,
+      std::vector<double>(), std::vector<int>());
+  for (size_t n = 0; n < ts_long.size(); ++n) {
+    std::vector<var> y_expected
+        = absorption_solution(y0, theta, times, doses, ts_long[n]);
+    for (size_t i = 0; i < 2; ++i) {
+      EXPECT_NEAR(y_expected[i].val(), y[n][i].val(),
+                  1e-6 * y_expected[i].val() + 1e-8);
+      stan::math::set_zero_all_adjoints();
+      y_expected[i].grad();
+      const double dka = theta[0].adj();
+      stan::math::set_zero_all_adjoints();
+      y[n][i].grad();
+      EXPECT_NEAR(dka, theta[0].adj(), 1e-5 * std::fabs(dka) + 1e-7);
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateODEEvents, error_checks) {
+  using stan::math::integrate_ode_bdf_events;
+  std::vector<double> y0 = {1.0, 2.0};
+  std::vector<double> theta = {1.3, 0.2};
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  std::vector<std::vector<double>> doses_short(doses_dbl.begin(),
+                                               doses_dbl.end() - 1);
+  EXPECT_THROW(integrate_ode_bdf_events(absorption_ode_fun(), y0, 0.0, ts,
+                                        theta, event_times, doses_short, x,
+                                        x_int),
+               std::invalid_argument);
+
+  std::vector<std::vector<double>> doses_bad = doses_dbl;
+  doses_bad[2].push_back(1.0);
+  EXPECT_THROW(integrate_ode_bdf_events(absorption_ode_fun(), y0, 0.0, ts,
+                                        theta, event_times, doses_bad, x,
+                                        x_int),
+               std::invalid_argument);
+
+  doses_bad = doses_dbl;
+  doses_bad[1][0] = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(integrate_ode_bdf_events(absorption_ode_fun(), y0, 0.0, ts,
+                                        theta, event_times, doses_bad, x,
+                                        x_int),
+               std::domain_error);
+
+  std::vector<double> times_bad = event_times;
+  times_bad[0] = -1.0;
+  EXPECT_THROW(integrate_ode_bdf_events(absorption_ode_fun(), y0, 0.0, ts,
+                                        theta, times_bad, doses_dbl, x, x_int),
+               std::domain_error);
+
+  times_bad = event_times;
+  std::swap(times_bad[1], times_bad[4]);
+  EXPECT_THROW(integrate_ode_bdf_events(absorption_ode_fun(), y0, 0.0, ts,
+                                        theta, times_bad, doses_dbl, x, x_int),
+               std::domain_error);
+
+  times_bad = event_times;
+  times_bad[3] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(integrate_ode_bdf_events(absorption_ode_fun(), y0, 0.0, ts,
+                                        theta, times_bad, doses_dbl, x, x_int),
+               std::domain_error);
+
+  // without events the solutions are those of integrate_ode_bdf
+  std::vector<std::vector<double>> y = integrate_ode_bdf_events(
+      absorption_ode_fun(), y0, 0.0, ts, theta, std::vector<double>(),
+      std::vector<std::vector<double>>(), x, x_int);
+  std::vector<std::vector<double>> y_bdf = stan::math::integrate_ode_bdf(
+      absorption_ode_fun(), y0, 0.0, ts, theta, x, x_int);
+  for (size_t n = 0; n < ts.size(); ++n)
+    for (size_t i = 0; i < 2; ++i)
+      EXPECT_NEAR(y_bdf[n][i], y[n][i], 1e-8);
+}
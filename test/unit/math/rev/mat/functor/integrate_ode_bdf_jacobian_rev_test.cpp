@@ -0,0 +1,96 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/lorenz.hpp>
+#include <vector>
+
+namespace {
+
+// Lorenz system with analytic Jacobians
+struct lorenz_jacobian_ode_fun : public lorenz_ode_fun {
+  std::vector<std::vector<double>> jacobian_y(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    return {{-theta[0], theta[0], 0.0},
+            {theta[1] - y[2], -1.0, -y[0]},
+            {y[1], y[0], -theta[2]}};
+  }
+
+  std::vector<std::vector<double>> jacobian_theta(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    return {{y[1] - y[0], 0.0, 0.0}, {0.0, y[0], 0.0}, {0.0, 0.0, -y[2]}};
+  }
+};
+
+// solves the Lorenz system with and without the analytic Jacobian
+// and compares the gradients of all outputs
+template <typename Solve>
+void expect_analytic_jacobian_matches(const Solve& solve) {
+  using stan::math::var;
+  std::vector<double> ts = {0.1, 0.2, 0.5};
+  std::vector<var> y0_ad = {10.0, 1.0, 1.0};
+  std::vector<var> theta_ad = {10.0, 28.0, 8.0 / 3.0};
+  std::vector<var> y0_an = {10.0, 1.0, 1.0};
+  std::vector<var> theta_an = {10.0, 28.0, 8.0 / 3.0};
+  std::vector<std::vector<var>> y_ad = solve(lorenz_ode_fun(), y0_ad, ts,
+                                             theta_ad);
+  std::vector<std::vector<var>> y_an = solve(lorenz_jacobian_ode_fun(), y0_an,
+                                             ts, theta_an);
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_FLOAT_EQ(y_ad[n][i].val(), y_an[n][i].val());
+      stan::math::set_zero_all_adjoints();
+      y_ad[n][i].grad();
+      std::vector<double> grad_ad;
+      for (size_t k = 0; k < 3; ++k)
+        grad_ad.push_back(y0_ad[k].adj());
+      for (size_t k = 0; k < 3; ++k)
+        grad_ad.push_back(theta_ad[k].adj());
+      stan::math::set_zero_all_adjoints();
+      y_an[n][i].grad();
+      for (size_t k = 0; k < 3; ++k) {
+        EXPECT_NEAR(grad_ad[k], y0_an[k].adj(), 1e-6);
+        EXPECT_NEAR(grad_ad[3 + k], theta_an[k].adj(), 1e-6);
+      }
+    }
+  }
+  stan::math::recover_memory();
+}
+
+struct bdf_solver {
+  template <typename F>
+  std::vector<std::vector<stan::math::var>> operator()(
+      const F& f, const std::vector<stan::math::var>& y0,
+      const std::vector<double>& ts,
+      const std::vector<stan::math::var>& theta) const {
+    return stan::math::integrate_ode_bdf(f, y0, 0.0, ts, theta,
+                                         std::vector<double>(),
+                                         std::vector<int>(), nullptr, 1e-10,
+                                         1e-10, 1e8);
+  }
+};
+
+struct rk45_solver {
+  template <typename F>
+  std::vector<std::vector<stan::math::var>> operator()(
+      const F& f, const std::vector<stan::math::var>& y0,
+      const std::vector<double>& ts,
+      const std::vector<stan::math::var>& theta) const {
+    return stan::math::integrate_ode_rk45(f, y0, 0.0, ts, theta,
+                                          std::vector<double>(),
+                                          std::vector<int>(), nullptr, 1e-10,
+                                          1e-10, 1e8);
+  }
+};
+
+}  // namespace
+
+TEST(StanMathOdeIntegrateODEJacobian, bdf) {
+  expect_analytic_jacobian_matches(bdf_solver());
+}
+
+TEST(StanMathOdeIntegrateODEJacobian, rk45) {
+  expect_analytic_jacobian_matches(rk45_solver());
+}
@@ -0,0 +1,133 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// diffusion with decay on a line, which has a tridiagonal Jacobian
+struct diffusion_ode_fun {
+  template <typename T0, typename T1, typename T2>
+  std::vector<typename stan::return_type<T1, T2>::type> operator()(
+      const T0& t_in, const std::vector<T1>& y,
+      const std::vector<T2>& theta, const std::vector<double>& x,
+      const std::vector<int>& x_int, std::ostream* msgs) const {
+    const size_t N = y.size();
+    std::vector<typename stan::return_type<T1, T2>::type> dy_dt(N);
+    for (size_t i = 0; i < N; ++i) {
+      T1 left = i > 0 ? y[i - 1] : T1(0);
+      T1 right = i + 1 < N ? y[i + 1] : T1(0);
+      dy_dt[i] = theta[0] * (left - 2 * y[i] + right) - theta[1] * y[i];
+    }
+    return dy_dt;
+  }
+};
+
+struct diffusion_jacobian_ode_fun : public diffusion_ode_fun {
+  std::vector<std::vector<double>> jacobian_y(
+      double t, const std::vector<double>& y, const std::vector<double>& theta,
+      const std::vector<double>& x, const std::vector<int>& x_int,
+      std::ostream* msgs) const {
+    const size_t N = y.size();
+    std::vector<std::vector<double>> jac(N, std::vector<double>(N, 0.0));
+    for (size_t i = 0; i < N; ++i) {
+      jac[i][i] = -2 * theta[0] - theta[1];
+      if (i > 0)
+        jac[i][i - 1] = theta[0];
+      if (i + 1 < N)
+        jac[i][i + 1] = theta[0];
+    }
+    return jac;
+  }
+};
+
+template <typename F>
+std::vector<double> solve_and_gradient(
+    const F& f, const stan::math::cvodes_linear_solver& linear_solver,
+    std::vector<double>& values) {
+  using stan::math::var;
+  const size_t N = 10;
+  std::vector<var> y0;
+  for (size_t i = 0; i < N; ++i)
+    y0.push_back(std::sin(0.3 * (i + 1)));
+  std::vector<var> theta = {2.0, 0.5};
+  std::vector<double> ts = {0.1, 0.5, 1.0};
+
+  std::vector<std::vector<var>> y = stan::math::integrate_ode_bdf(
+      f, y0, 0.0, ts, theta, std::vector<double>(), std::vector<int>(),
+      nullptr, 1e-10, 1e-10, 1e8, linear_solver);
+
+  values.clear();
+  std::vector<double> grads;
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (size_t i = 0; i < N; ++i) {
+      values.push_back(y[n][i].val());
+      stan::math::set_zero_all_adjoints();
+      y[n][i].grad();
+      for (size_t k = 0; k < N; ++k)
+        grads.push_back(y0[k].adj());
+      for (size_t k = 0; k < theta.size(); ++k)
+        grads.push_back(theta[k].adj());
+    }
+  }
+  stan::math::recover_memory();
+  return grads;
+}
+
+void expect_near(const std::vector<double>& a, const std::vector<double>& b) {
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    EXPECT_NEAR(a[i], b[i], 1e-6);
+}
+
+}  // namespace
+
+TEST(StanMathOdeIntegrateODEBDFLinearSolver, band_matches_dense) {
+  std::vector<double> dense_values, band_values;
+  std::vector<double> dense_grads = solve_and_gradient(
+      diffusion_ode_fun(), stan::math::cvodes_dense_solver(), dense_values);
+  std::vector<double> band_grads
+      = solve_and_gradient(diffusion_ode_fun(),
+                           stan::math::cvodes_band_solver(1, 1), band_values);
+  expect_near(dense_values, band_values);
+  expect_near(dense_grads, band_grads);
+}
+
+TEST(StanMathOdeIntegrateODEBDFLinearSolver, band_analytic_matches_dense) {
+  std::vector<double> dense_values, band_values;
+  std::vector<double> dense_grads = solve_and_gradient(
+      diffusion_ode_fun(), stan::math::cvodes_dense_solver(), dense_values);
+  std::vector<double> band_grads = solve_and_gradient(
+      diffusion_jacobian_ode_fun(), stan::math::cvodes_band_solver(1, 1),
+      band_values);
+  expect_near(dense_values, band_values);
+  expect_near(dense_grads, band_grads);
+}
+
+TEST(StanMathOdeIntegrateODEBDFLinearSolver, spgmr_matches_dense) {
+  std::vector<double> dense_values, spgmr_values;
+  std::vector<double> dense_grads = solve_and_gradient(
+      diffusion_ode_fun(), stan::math::cvodes_dense_solver(), dense_values);
+  std::vector<double> spgmr_grads
+      = solve_and_gradient(diffusion_ode_fun(),
+                           stan::math::cvodes_spgmr_solver(), spgmr_values);
+  expect_near(dense_values, spgmr_values);
+  expect_near(dense_grads, spgmr_grads);
+}
+
+TEST(StanMathOdeIntegrateODEBDFLinearSolver, error_checks) {
+  std::vector<double> values;
+  EXPECT_THROW(solve_and_gradient(diffusion_ode_fun(),
+                                  stan::math::cvodes_band_solver(10, 1),
+                                  values),
+               std::domain_error);
+  EXPECT_THROW(solve_and_gradient(diffusion_ode_fun(),
+                                  stan::math::cvodes_band_solver(1, -1),
+                                  values),
+               std::domain_error);
+  EXPECT_THROW(solve_and_gradient(diffusion_ode_fun(),
+                                  stan::math::cvodes_spgmr_solver(-1),
+                                  values),
+               std::domain_error);
+}
@@ -0,0 +1,119 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const std::vector<double> y0_data = {1.0, 0.0};
+const std::vector<double> ts_data = {1.0, 5.0, 10.0};
+
+}  // namespace
+
+TEST(StanMathOdeStatistics, bdf_counters) {
+  using stan::math::ode_solver_statistics;
+  using stan::math::ode_statistics;
+  using stan::math::var;
+  ode_statistics::reset();
+  ode_statistics::enable();
+  std::vector<var> theta = {0.15};
+  stan::math::integrate_ode_bdf(harm_osc_ode_fun(), y0_data, 0.0, ts_data,
+                                theta, std::vector<double>(),
+                                std::vector<int>());
+  ode_statistics::enable(false);
+
+  ASSERT_EQ(1U, ode_statistics::sites().size());
+  const ode_solver_statistics s
+      = ode_statistics::sites().at("integrate_ode_bdf");
+  EXPECT_EQ(1U, s.num_solves_);
+  EXPECT_EQ(0U, s.num_failures_);
+  EXPECT_GT(s.num_steps_, 0);
+  EXPECT_GT(s.num_rhs_evals_, s.num_steps_);
+  EXPECT_GT(s.num_sensitivity_rhs_evals_, 0);
+  EXPECT_GT(s.num_jacobian_evals_, 0);
+  EXPECT_GT(s.num_nonlinear_iterations_, 0);
+  EXPECT_GE(s.num_error_test_failures_, 0);
+  EXPECT_GT(s.forward_seconds_, 0.0);
+  EXPECT_GT(s.sensitivity_seconds_, 0.0);
+  EXPECT_LE(s.sensitivity_seconds_, s.forward_seconds_);
+
+  // a solve reinitializing the CVODES memory counts from zero and
+  // uncollected solves are not recorded
+  stan::math::integrate_ode_bdf(harm_osc_ode_fun(), y0_data, 0.0, ts_data,
+                                theta, std::vector<double>(),
+                                std::vector<int>());
+  ode_statistics::enable();
+  stan::math::integrate_ode_bdf(harm_osc_ode_fun(), y0_data, 0.0, ts_data,
+                                theta, std::vector<double>(),
+                                std::vector<int>());
+  ode_statistics::enable(false);
+  const ode_solver_statistics& s2
+      = ode_statistics::sites().at("integrate_ode_bdf");
+  EXPECT_EQ(2U, s2.num_solves_);
+  EXPECT_EQ(2 * s.num_steps_, s2.num_steps_);
+  EXPECT_EQ(2 * s.num_jacobian_evals_, s2.num_jacobian_evals_);
+  ode_statistics::reset();
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeStatistics, adams_and_rk45) {
+  using stan::math::ode_solver_statistics;
+  using stan::math::ode_statistics;
+  using stan::math::var;
+  ode_statistics::reset();
+  ode_statistics::enable();
+  std::vector<double> theta_d = {0.15};
+  stan::math::integrate_ode_adams(harm_osc_ode_fun(), y0_data, 0.0, ts_data,
+                                  theta_d, std::vector<double>(),
+                                  std::vector<int>());
+  std::vector<var> theta = {0.15};
+  stan::math::integrate_ode_rk45(harm_osc_ode_fun(), y0_data, 0.0, ts_data,
+                                 theta, std::vector<double>(),
+                                 std::vector<int>());
+  ode_statistics::enable(false);
+
+  ASSERT_EQ(2U, ode_statistics::sites().size());
+  const ode_solver_statistics& adams
+      = ode_statistics::sites().at("integrate_ode_adams");
+  EXPECT_EQ(1U, adams.num_solves_);
+  EXPECT_GT(adams.num_steps_, 0);
+  EXPECT_EQ(0, adams.num_sensitivity_rhs_evals_);
+  EXPECT_EQ(0.0, adams.sensitivity_seconds_);
+
+  // the coupled system of rk45 includes the sensitivities
+  const ode_solver_statistics& rk45
+      = ode_statistics::sites().at("integrate_ode_rk45");
+  EXPECT_GT(rk45.num_steps_, 0);
+  EXPECT_EQ(rk45.num_rhs_evals_, rk45.num_sensitivity_rhs_evals_);
+  EXPECT_GT(rk45.sensitivity_seconds_, 0.0);
+  EXPECT_LE(rk45.sensitivity_seconds_, rk45.forward_seconds_);
+  ode_statistics::reset();
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeStatistics, bdf_failed_solve) {
+  using stan::math::ode_statistics;
+  using stan::math::var;
+  ode_statistics::reset();
+  ode_statistics::enable();
+  {
+    ode_statistics::call_site site("too_much_work");
+    std::vector<var> theta = {0.15};
+    std::vector<double> ts_long = {1e6};
+    EXPECT_THROW(stan::math::integrate_ode_bdf(
+                     harm_osc_ode_fun(), y0_data, 0.0, ts_long, theta,
+                     std::vector<double>(), std::vector<int>(), nullptr,
+                     1e-10, 1e-10, 10),
+                 std::runtime_error);
+  }
+  ode_statistics::enable(false);
+
+  const stan::math::ode_solver_statistics& s
+      = ode_statistics::sites().at("too_much_work");
+  EXPECT_EQ(1U, s.num_solves_);
+  EXPECT_EQ(1U, s.num_failures_);
+  EXPECT_EQ(10, s.num_steps_);
+  ode_statistics::reset();
+  stan::math::recover_memory();
+}
@@ -0,0 +1,115 @@
+// the tests here check that the statistics of ODE solves on other
+// threads are collected into the calling thread, they only run if
+// STAN_THREADS is defined
+
+#ifdef STAN_THREADS
+
+#ifdef STAN_MPI
+#undef STAN_MPI
+#endif
+
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <test/unit/math/prim/mat/functor/utils_threads.hpp>
+#include <stdexcept>
+#include <vector>
+
+// solves the harmonic oscillator for one job of map_rect with the
+// parameter of the job
+struct harm_osc_job {
+  template <typename T1, typename T2>
+  Eigen::Matrix<typename stan::return_type<T1, T2>::type, Eigen::Dynamic, 1>
+  operator()(const Eigen::Matrix<T1, Eigen::Dynamic, 1>& eta,
+             const Eigen::Matrix<T2, Eigen::Dynamic, 1>& theta,
+             const std::vector<double>& x_r, const std::vector<int>& x_i,
+             std::ostream* msgs = 0) const {
+    const std::vector<double> y0 = {1.0, 0.0};
+    const std::vector<double> ts = {1.0, 5.0};
+    const std::vector<T2> theta_vec = {theta(0)};
+    const std::vector<std::vector<T2>> y = stan::math::integrate_ode_bdf(
+        harm_osc_ode_fun(), y0, 0.0, ts, theta_vec, std::vector<double>(),
+        std::vector<int>());
+    Eigen::Matrix<typename stan::return_type<T1, T2>::type, Eigen::Dynamic, 1>
+        res(2);
+    res << y[1][0], y[1][1];
+    return res;
+  }
+};
+
+STAN_REGISTER_MAP_RECT(0, harm_osc_job)
+
+TEST(StanMathOdeStatistics, batch_threads) {
+  using stan::math::ode_statistics;
+  using stan::math::var;
+  set_n_threads(4);
+  const size_t num_subjects = 9;
+  std::vector<std::vector<double>> y0(num_subjects, {1.0, 0.0});
+  std::vector<std::vector<double>> ts(num_subjects, {1.0, 5.0});
+  std::vector<std::vector<var>> theta;
+  for (size_t j = 0; j < num_subjects; ++j)
+    theta.push_back({0.1 + 0.05 * j});
+  std::vector<std::vector<double>> x(num_subjects);
+  std::vector<std::vector<int>> x_int(num_subjects);
+
+  ode_statistics::reset();
+  ode_statistics::enable();
+  {
+    ode_statistics::call_site site("population");
+    stan::math::integrate_ode_bdf_batch(harm_osc_ode_fun(), y0, 0.0, ts,
+                                        theta, x, x_int);
+  }
+  ASSERT_EQ(1U, ode_statistics::sites().size());
+  const stan::math::ode_solver_statistics s
+      = ode_statistics::sites().at("population");
+  EXPECT_EQ(num_subjects, s.num_solves_);
+  EXPECT_EQ(0U, s.num_failures_);
+  EXPECT_GT(s.num_steps_, 0);
+  EXPECT_GT(s.forward_seconds_, 0.0);
+
+  // failed solves on other threads are recorded as well
+  std::vector<std::vector<double>> ts_bad = ts;
+  ts_bad[num_subjects - 1] = {1.0, 1e4};
+  EXPECT_THROW(stan::math::integrate_ode_bdf_batch(
+                   harm_osc_ode_fun(), y0, 0.0, ts_bad, theta, x, x_int,
+                   nullptr, 1e-10, 1e-10, 10),
+               std::runtime_error);
+  EXPECT_EQ(2U, ode_statistics::sites().size());
+  EXPECT_GE(ode_statistics::sites().at("integrate_ode_bdf").num_failures_, 1U);
+
+  // nothing is collected if collection is off on the calling thread
+  ode_statistics::reset();
+  ode_statistics::enable(false);
+  stan::math::integrate_ode_bdf_batch(harm_osc_ode_fun(), y0, 0.0, ts, theta,
+                                      x, x_int);
+  EXPECT_TRUE(ode_statistics::sites().empty());
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeStatistics, map_rect_threads) {
+  using stan::math::ode_statistics;
+  using stan::math::var;
+  set_n_threads(3);
+  const int num_jobs = 7;
+  Eigen::VectorXd shared_params(0);
+  std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>> job_params;
+  for (int j = 0; j < num_jobs; ++j) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> theta(1);
+    theta << 0.1 + 0.05 * j;
+    job_params.push_back(theta);
+  }
+  std::vector<std::vector<double>> x_r(num_jobs);
+  std::vector<std::vector<int>> x_i(num_jobs);
+
+  ode_statistics::reset();
+  ode_statistics::enable();
+  stan::math::map_rect<0, harm_osc_job>(shared_params, job_params, x_r, x_i);
+  ode_statistics::enable(false);
+  ASSERT_EQ(1U, ode_statistics::sites().size());
+  EXPECT_EQ(static_cast<size_t>(num_jobs),
+            ode_statistics::sites().at("integrate_ode_bdf").num_solves_);
+  ode_statistics::reset();
+  stan::math::recover_memory();
+}
+
+#endif
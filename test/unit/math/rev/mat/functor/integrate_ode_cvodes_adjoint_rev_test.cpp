@@ -0,0 +1,209 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <test/unit/math/prim/arr/functor/lorenz.hpp>
+#include <stdexcept>
+#include <vector>
+
+using stan::math::var;
+
+namespace {
+
+// Michaelis-Menten elimination with more parameters than states
+struct mm_chain_ode_fun {
+  template <typename T0, typename T1, typename T2>
+  inline std::vector<typename stan::return_type<T1, T2>::type> operator()(
+      const T0& t_in, const std::vector<T1>& y_in,
+      const std::vector<T2>& theta, const std::vector<double>& x,
+      const std::vector<int>& x_int, std::ostream* msgs) const {
+    using std::sin;
+    std::vector<typename stan::return_type<T1, T2>::type> res(2);
+    res[0] = -theta[0] * y_in[0] / (theta[1] + y_in[0]) - theta[2] * y_in[0];
+    res[1] = theta[2] * y_in[0] - theta[3] * y_in[1]
+             + theta[4] * sin(theta[5] * t_in);
+    return res;
+  }
+};
+
+std::vector<var> to_vars(const std::vector<double>& x) {
+  return std::vector<var>(x.begin(), x.end());
+}
+
+double adj_of(const var& x) { return x.adj(); }
+double adj_of(double x) { return 0; }
+
+// compares the values and the gradients of every output with the
+// forward sensitivity solution
+template <int Lmm, typename F, typename T_initial, typename T_param>
+void expect_adjoint_matches_forward(const F& f, const std::vector<double>& y0,
+                                    double t0, const std::vector<double>& ts,
+                                    const std::vector<double>& theta,
+                                    double tol) {
+  const std::vector<double> x;
+  const std::vector<int> x_int;
+  const size_t N = y0.size();
+  const size_t M = theta.size();
+
+  std::vector<T_initial> y0_a(y0.begin(), y0.end());
+  std::vector<T_param> theta_a(theta.begin(), theta.end());
+  std::vector<T_initial> y0_f(y0.begin(), y0.end());
+  std::vector<T_param> theta_f(theta.begin(), theta.end());
+
+  stan::math::cvodes_adjoint_integrator<Lmm> adjoint;
+  stan::math::cvodes_integrator<Lmm> forward;
+  std::vector<std::vector<var>> y_a = adjoint.integrate(
+      f, y0_a, t0, ts, theta_a, x, x_int, nullptr, 1e-10, 1e-10, 1e8, 25);
+  std::vector<std::vector<var>> y_f = forward.integrate(
+      f, y0_f, t0, ts, theta_f, x, x_int, nullptr, 1e-10, 1e-10, 1e8);
+
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (size_t i = 0; i < N; ++i) {
+      EXPECT_NEAR(y_f[n][i].val(), y_a[n][i].val(), tol);
+
+      // every sweep runs over both solutions, so they are separated
+      // by resetting the adjoints
+      stan::math::set_zero_all_adjoints();
+      y_a[n][i].grad();
+      std::vector<double> y0_adj(N);
+      std::vector<double> theta_adj(M);
+      for (size_t k = 0; k < N; ++k)
+        y0_adj[k] = adj_of(y0_a[k]);
+      for (size_t m = 0; m < M; ++m)
+        theta_adj[m] = adj_of(theta_a[m]);
+      stan::math::set_zero_all_adjoints();
+      y_f[n][i].grad();
+      for (size_t k = 0; k < N; ++k)
+        EXPECT_NEAR(adj_of(y0_f[k]), y0_adj[k], tol)
+            << "initial state " << k << " of output " << n << ", " << i;
+      for (size_t m = 0; m < M; ++m)
+        EXPECT_NEAR(adj_of(theta_f[m]), theta_adj[m], tol)
+            << "parameter " << m << " of output " << n << ", " << i;
+    }
+  }
+
+  // the adjoints of all outputs propagated at once
+  stan::math::set_zero_all_adjoints();
+  var sum_a = 0;
+  var sum_f = 0;
+  for (size_t n = 0; n < ts.size(); ++n)
+    for (size_t i = 0; i < N; ++i) {
+      sum_a += (i + 1.0) * y_a[n][i];
+      sum_f += (i + 1.0) * y_f[n][i];
+    }
+  sum_a.grad();
+  std::vector<double> y0_adj(N);
+  std::vector<double> theta_adj(M);
+  for (size_t k = 0; k < N; ++k)
+    y0_adj[k] = adj_of(y0_a[k]);
+  for (size_t m = 0; m < M; ++m)
+    theta_adj[m] = adj_of(theta_a[m]);
+  stan::math::set_zero_all_adjoints();
+  sum_f.grad();
+  for (size_t m = 0; m < M; ++m)
+    EXPECT_NEAR(adj_of(theta_f[m]), theta_adj[m], tol);
+  for (size_t k = 0; k < N; ++k)
+    EXPECT_NEAR(adj_of(y0_f[k]), y0_adj[k], tol);
+  stan::math::recover_memory();
+}
+
+}  // namespace
+
+TEST(StanMathOdeIntegrateODEAdjoint, harmonic_oscillator) {
+  harm_osc_ode_fun f;
+  std::vector<double> y0 = {1.0, 0.5};
+  std::vector<double> theta = {0.15};
+  std::vector<double> ts = {0.5, 1.0, 4.0, 10.0};
+  expect_adjoint_matches_forward<CV_BDF, harm_osc_ode_fun, var, var>(
+      f, y0, 0.0, ts, theta, 1e-6);
+  expect_adjoint_matches_forward<CV_BDF, harm_osc_ode_fun, double, var>(
+      f, y0, 0.0, ts, theta, 1e-6);
+  expect_adjoint_matches_forward<CV_BDF, harm_osc_ode_fun, var, double>(
+      f, y0, 0.0, ts, theta, 1e-6);
+  expect_adjoint_matches_forward<CV_ADAMS, harm_osc_ode_fun, var, var>(
+      f, y0, 0.0, ts, theta, 1e-6);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, lorenz) {
+  lorenz_ode_fun f;
+  std::vector<double> y0 = {10.0, 1.0, 1.0};
+  std::vector<double> theta = {10.0, 28.0, 8.0 / 3.0};
+  std::vector<double> ts = {0.1, 0.2, 0.5};
+  expect_adjoint_matches_forward<CV_BDF, lorenz_ode_fun, var, var>(
+      f, y0, 0.0, ts, theta, 1e-4);
+  expect_adjoint_matches_forward<CV_ADAMS, lorenz_ode_fun, var, var>(
+      f, y0, 0.0, ts, theta, 1e-4);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, time_dependent_many_parameters) {
+  mm_chain_ode_fun f;
+  std::vector<double> y0 = {5.0, 0.0};
+  std::vector<double> theta = {1.2, 0.8, 0.3, 0.5, 0.2, 2.0};
+  std::vector<double> ts = {0.25, 1.0, 1.5, 3.0, 6.0, 12.0};
+  expect_adjoint_matches_forward<CV_BDF, mm_chain_ode_fun, double, var>(
+      f, y0, -1.0, ts, theta, 1e-6);
+  expect_adjoint_matches_forward<CV_ADAMS, mm_chain_ode_fun, var, var>(
+      f, y0, -1.0, ts, theta, 1e-6);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, single_node) {
+  using stan::math::ChainableStack;
+  mm_chain_ode_fun f;
+  std::vector<var> y0 = to_vars({5.0, 0.0});
+  std::vector<var> theta = to_vars({1.2, 0.8, 0.3, 0.5, 0.2, 2.0});
+  std::vector<double> ts = {1.0, 2.0, 3.0};
+  std::vector<double> x;
+  std::vector<int> x_int;
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  std::vector<std::vector<var>> y
+      = stan::math::integrate_ode_bdf_adjoint(f, y0, 0.0, ts, theta, x, x_int);
+  EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+  EXPECT_EQ(3U, y.size());
+  EXPECT_EQ(2U, y[0].size());
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, data_only) {
+  harm_osc_ode_fun f;
+  std::vector<double> y0 = {1.0, 0.5};
+  std::vector<double> theta = {0.15};
+  std::vector<double> ts = {0.5, 1.0};
+  std::vector<double> x;
+  std::vector<int> x_int;
+  std::vector<std::vector<double>> y_a
+      = stan::math::integrate_ode_adams_adjoint(f, y0, 0.0, ts, theta, x,
+                                                x_int);
+  std::vector<std::vector<double>> y_f
+      = stan::math::integrate_ode_adams(f, y0, 0.0, ts, theta, x, x_int);
+  for (size_t n = 0; n < ts.size(); ++n)
+    for (size_t i = 0; i < y0.size(); ++i)
+      EXPECT_FLOAT_EQ(y_f[n][i], y_a[n][i]);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, errors) {
+  harm_osc_ode_fun f;
+  std::vector<var> y0 = to_vars({1.0, 0.5});
+  std::vector<var> theta = to_vars({0.15});
+  std::vector<double> ts = {0.5, 1.0};
+  std::vector<double> x;
+  std::vector<int> x_int;
+  using stan::math::integrate_ode_bdf_adjoint;
+
+  EXPECT_THROW(integrate_ode_bdf_adjoint(f, y0, 0.0, ts, theta, x, x_int,
+                                         nullptr, 1e-8, 1e-8, 1000, 0),
+               std::invalid_argument);
+  EXPECT_THROW(integrate_ode_bdf_adjoint(f, y0, 0.0, ts, theta, x, x_int,
+                                         nullptr, -1e-8, 1e-8, 1000),
+               std::invalid_argument);
+  EXPECT_THROW(integrate_ode_bdf_adjoint(f, y0, 0.75, ts, theta, x, x_int),
+               std::domain_error);
+  std::vector<double> ts_bad = {1.0, 0.5};
+  EXPECT_THROW(integrate_ode_bdf_adjoint(f, y0, 0.0, ts_bad, theta, x, x_int),
+               std::domain_error);
+  std::vector<var> y0_bad = to_vars({1.0, 0.5, 0.2});
+  EXPECT_THROW(integrate_ode_bdf_adjoint(f, y0_bad, 0.0, ts, theta, x, x_int),
+               std::domain_error);
+  EXPECT_THROW(integrate_ode_bdf_adjoint(f, y0, 0.0, ts, theta, x, x_int,
+                                         nullptr, 1e-8, 1e-8, 2),
+               std::runtime_error);
+  stan::math::recover_memory();
+}
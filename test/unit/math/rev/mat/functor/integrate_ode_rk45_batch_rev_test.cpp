@@ -0,0 +1,9 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <test/unit/math/rev/mat/functor/util_ode_batch.hpp>
+
+TEST(StanMathOdeIntegrateODEBatch, rk45_matches_single_solves) {
+  ode_batch_test::expect_batch_matches(ode_batch_test::rk45_solver());
+  ode_batch_test::expect_batch_matches_data(ode_batch_test::rk45_solver());
+}
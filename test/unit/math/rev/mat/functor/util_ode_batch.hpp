@@ -0,0 +1,183 @@
+#ifndef TEST_UNIT_MATH_REV_MAT_FUNCTOR_UTIL_ODE_BATCH_HPP
+#define TEST_UNIT_MATH_REV_MAT_FUNCTOR_UTIL_ODE_BATCH_HPP
+
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <vector>
+
+namespace ode_batch_test {
+
+struct rk45_solver {
+  template <typename T1, typename T2>
+  std::vector<std::vector<typename stan::return_type<T1, T2>::type>>
+  operator()(const std::vector<T1>& y0, const std::vector<double>& ts,
+             const std::vector<T2>& theta) const {
+    return stan::math::integrate_ode_rk45(harm_osc_ode_fun(), y0, 0.0, ts,
+                                          theta, std::vector<double>(),
+                                          std::vector<int>());
+  }
+
+  template <typename T1, typename T2>
+  std::vector<
+      std::vector<std::vector<typename stan::return_type<T1, T2>::type>>>
+  batch(const std::vector<std::vector<T1>>& y0,
+        const std::vector<std::vector<double>>& ts,
+        const std::vector<std::vector<T2>>& theta) const {
+    return stan::math::integrate_ode_rk45_batch(
+        harm_osc_ode_fun(), y0, 0.0, ts, theta,
+        std::vector<std::vector<double>>(y0.size()),
+        std::vector<std::vector<int>>(y0.size()));
+  }
+};
+
+struct bdf_solver {
+  template <typename T1, typename T2>
+  std::vector<std::vector<typename stan::return_type<T1, T2>::type>>
+  operator()(const std::vector<T1>& y0, const std::vector<double>& ts,
+             const std::vector<T2>& theta) const {
+    return stan::math::integrate_ode_bdf(harm_osc_ode_fun(), y0, 0.0, ts,
+                                         theta, std::vector<double>(),
+                                         std::vector<int>());
+  }
+
+  template <typename T1, typename T2>
+  std::vector<
+      std::vector<std::vector<typename stan::return_type<T1, T2>::type>>>
+  batch(const std::vector<std::vector<T1>>& y0,
+        const std::vector<std::vector<double>>& ts,
+        const std::vector<std::vector<T2>>& theta) const {
+    return stan::math::integrate_ode_bdf_batch(
+        harm_osc_ode_fun(), y0, 0.0, ts, theta,
+        std::vector<std::vector<double>>(y0.size()),
+        std::vector<std::vector<int>>(y0.size()));
+  }
+};
+
+struct adams_solver {
+  template <typename T1, typename T2>
+  std::vector<std::vector<typename stan::return_type<T1, T2>::type>>
+  operator()(const std::vector<T1>& y0, const std::vector<double>& ts,
+             const std::vector<T2>& theta) const {
+    return stan::math::integrate_ode_adams(harm_osc_ode_fun(), y0, 0.0, ts,
+                                           theta, std::vector<double>(),
+                                           std::vector<int>());
+  }
+
+  template <typename T1, typename T2>
+  std::vector<
+      std::vector<std::vector<typename stan::return_type<T1, T2>::type>>>
+  batch(const std::vector<std::vector<T1>>& y0,
+        const std::vector<std::vector<double>>& ts,
+        const std::vector<std::vector<T2>>& theta) const {
+    return stan::math::integrate_ode_adams_batch(
+        harm_osc_ode_fun(), y0, 0.0, ts, theta,
+        std::vector<std::vector<double>>(y0.size()),
+        std::vector<std::vector<int>>(y0.size()));
+  }
+};
+
+// initial states, parameters and output times of a batch, by default
+// three subjects with different numbers of outputs
+struct batch_data {
+  std::vector<std::vector<double>> y0_dbl;
+  std::vector<std::vector<double>> theta_dbl;
+  std::vector<std::vector<double>> ts;
+
+  batch_data()
+      : y0_dbl({{1.0, 0.0}, {0.5, -0.5}, {-1.0, 2.0}}),
+        theta_dbl({{0.15}, {0.5}, {1.0}}),
+        ts({{0.5, 1.0, 5.0}, {0.1, 10.0}, {2.0, 3.0, 4.0, 5.0}}) {}
+
+  explicit batch_data(size_t num_subjects) {
+    for (size_t j = 0; j < num_subjects; ++j) {
+      y0_dbl.push_back({1.0 - 0.1 * j, 0.05 * j});
+      theta_dbl.push_back({0.1 + 0.02 * j});
+      ts.emplace_back();
+      for (size_t n = 0; n <= j % 4; ++n)
+        ts[j].push_back(1.0 + n + 0.1 * j);
+    }
+  }
+};
+
+// the batch must match the subject by subject solves in values and
+// in the gradients with respect to the initial states and parameters
+template <typename Solver>
+void expect_batch_matches(const Solver& solver,
+                          const batch_data& data = batch_data()) {
+  using stan::math::var;
+  std::vector<std::vector<var>> y0_batch, theta_batch;
+  for (size_t j = 0; j < data.y0_dbl.size(); ++j) {
+    const std::vector<double>& theta_j = data.theta_dbl[j];
+    y0_batch.emplace_back(data.y0_dbl[j].begin(), data.y0_dbl[j].end());
+    theta_batch.emplace_back(theta_j.begin(), theta_j.end());
+  }
+  std::vector<std::vector<std::vector<var>>> y_batch
+      = solver.batch(y0_batch, data.ts, theta_batch);
+  ASSERT_EQ(data.y0_dbl.size(), y_batch.size());
+
+  for (size_t j = 0; j < data.y0_dbl.size(); ++j) {
+    const std::vector<double>& theta_j = data.theta_dbl[j];
+    std::vector<var> y0(data.y0_dbl[j].begin(), data.y0_dbl[j].end());
+    std::vector<var> theta(theta_j.begin(), theta_j.end());
+    std::vector<std::vector<var>> y = solver(y0, data.ts[j], theta);
+    ASSERT_EQ(data.ts[j].size(), y_batch[j].size());
+    for (size_t n = 0; n < data.ts[j].size(); ++n) {
+      for (size_t i = 0; i < 2; ++i) {
+        EXPECT_FLOAT_EQ(y[n][i].val(), y_batch[j][n][i].val());
+        stan::math::set_zero_all_adjoints();
+        y[n][i].grad();
+        std::vector<double> grad;
+        for (size_t k = 0; k < 2; ++k)
+          grad.push_back(y0[k].adj());
+        grad.push_back(theta[0].adj());
+        stan::math::set_zero_all_adjoints();
+        y_batch[j][n][i].grad();
+        for (size_t k = 0; k < 2; ++k)
+          EXPECT_FLOAT_EQ(grad[k], y0_batch[j][k].adj());
+        EXPECT_FLOAT_EQ(grad[2], theta_batch[j][0].adj());
+        // subjects are independent
+        for (size_t l = 0; l < data.y0_dbl.size(); ++l) {
+          if (l == j)
+            continue;
+          EXPECT_FLOAT_EQ(0.0, y0_batch[l][0].adj());
+          EXPECT_FLOAT_EQ(0.0, theta_batch[l][0].adj());
+        }
+      }
+    }
+  }
+  EXPECT_TRUE(stan::math::empty_nested());
+  stan::math::recover_memory();
+}
+
+template <typename Solver>
+void expect_batch_matches_data(const Solver& solver,
+                               const batch_data& data = batch_data()) {
+  using stan::math::var;
+  std::vector<std::vector<std::vector<double>>> y_batch_dd
+      = solver.batch(data.y0_dbl, data.ts, data.theta_dbl);
+  std::vector<std::vector<var>> theta_batch;
+  for (const std::vector<double>& theta_j : data.theta_dbl)
+    theta_batch.emplace_back(theta_j.begin(), theta_j.end());
+  std::vector<std::vector<std::vector<var>>> y_batch_dv
+      = solver.batch(data.y0_dbl, data.ts, theta_batch);
+  // the error control of rk45 includes the sensitivities, so each
+  // batch is compared to single solves of the same types
+  for (size_t j = 0; j < data.y0_dbl.size(); ++j) {
+    std::vector<std::vector<double>> y_dd
+        = solver(data.y0_dbl[j], data.ts[j], data.theta_dbl[j]);
+    std::vector<std::vector<var>> y_dv
+        = solver(data.y0_dbl[j], data.ts[j], theta_batch[j]);
+    for (size_t n = 0; n < data.ts[j].size(); ++n) {
+      for (size_t i = 0; i < 2; ++i) {
+        EXPECT_FLOAT_EQ(y_dd[n][i], y_batch_dd[j][n][i]);
+        EXPECT_FLOAT_EQ(y_dv[n][i].val(), y_batch_dv[j][n][i].val());
+      }
+    }
+  }
+  stan::math::recover_memory();
+}
+
+}  // namespace ode_batch_test
+
+#endif
@@ -9,7 +9,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsScal) {
 
   double d1;
   operands_and_partials<double> o3(d1);
-  EXPECT_EQ(5, sizeof(o3));
+  EXPECT_EQ(7, sizeof(o3));
 
   var v1 = var(0.0);
 
@@ -34,7 +34,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsVec) {
 
   vector_d d_vec(4);
   operands_and_partials<vector_d> o3(d_vec);
-  EXPECT_EQ(6, sizeof(o3));
+  EXPECT_EQ(8, sizeof(o3));
 
   vector_v v_vec(4);
   var v1 = var(0.0);
@@ -71,7 +71,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsStdVec) {
 
   std::vector<double> d_vec(4);
   operands_and_partials<std::vector<double> > o3(d_vec);
-  EXPECT_EQ(5, sizeof(o3));
+  EXPECT_EQ(7, sizeof(o3));
 
   std::vector<var> v_vec;
   var v1 = var(0.0);
@@ -109,7 +109,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsMat) {
   d_mat << 10.0, 20.0, 30.0, 40.0;
   operands_and_partials<matrix_d> o3(d_mat);
 
-  EXPECT_EQ(6, sizeof(o3));
+  EXPECT_EQ(8, sizeof(o3));
 
   matrix_v v_mat(2, 2);
   var v1 = var(0.0);
@@ -152,7 +152,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsMatMultivar) {
   d_mat_vec.push_back(d_mat);
   operands_and_partials<std::vector<matrix_d> > o3(d_mat_vec);
 
-  EXPECT_EQ(5, sizeof(o3));
+  EXPECT_EQ(7, sizeof(o3));
 
   matrix_v v_mat1(2, 2);
   var v1 = var(0.0);
@@ -217,7 +217,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsMultivar) {
   d_vec_vec.push_back(d_vec2);
   operands_and_partials<std::vector<vector_d> > o3(d_vec_vec);
 
-  EXPECT_EQ(5, sizeof(o3));
+  EXPECT_EQ(7, sizeof(o3));
 
   vector_v v_vec1(2);
   var v1 = var(0.0);
@@ -326,3 +326,44 @@ TEST(AgradPartialsVari, OperandsAndPartialsMultivarMixed) {
   }
   o6.edge3_.partials_vec_[0] += d_vec2;
 }
+
+TEST(AgradPartialsVari, OperandsAndPartialsSevenOperands) {
+  using stan::math::operands_and_partials;
+  using stan::math::var;
+  using stan::math::vector_d;
+  using stan::math::vector_v;
+
+  var v1 = var(1.0);
+  var v2 = var(2.0);
+  vector_v v_vec(2);
+  var v3 = var(3.0);
+  var v4 = var(4.0);
+  v_vec << v3, v4;
+  vector_d d_vec(2);
+
+  std::vector<var> v_stdvec;
+  v_stdvec.push_back(v1);
+  v_stdvec.push_back(v2);
+  v_stdvec.push_back(v3);
+  v_stdvec.push_back(v4);
+
+  size_t start = stan::math::ChainableStack::instance_->var_stack_.size();
+  operands_and_partials<var, double, vector_d, double, double, var, vector_v>
+      o(v1, 0.0, d_vec, 0.0, 0.0, v2, v_vec);
+  o.edge1_.partials_[0] += 10.0;
+  o.edge6_.partials_[0] += 20.0;
+  o.edge7_.partials_[0] += 30.0;
+  o.edge7_.partials_[1] += 40.0;
+
+  std::vector<double> grad;
+  var v = o.build(10.0);
+  // a single node for all operands
+  EXPECT_EQ(1U,
+            stan::math::ChainableStack::instance_->var_stack_.size() - start);
+  v.grad(v_stdvec, grad);
+  EXPECT_FLOAT_EQ(10.0, v.val());
+  EXPECT_FLOAT_EQ(10.0, grad[0]);
+  EXPECT_FLOAT_EQ(20.0, grad[1]);
+  EXPECT_FLOAT_EQ(30.0, grad[2]);
+  EXPECT_FLOAT_EQ(40.0, grad[3]);
+}
@@ -0,0 +1,45 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::math::var;
+
+TEST(AgradDistributionsCategoricalLogit, matrix_gradients) {
+  using stan::math::ChainableStack;
+  using stan::math::categorical_logit_lpmf;
+  Matrix<double, Dynamic, Dynamic> beta_d(4, 3);
+  beta_d << -1, 2, -10, 0.5, 0.5, 0.5, 3, -2, 1, 40, 39, -40;
+  std::vector<int> ns = {1, 3, 2, 2};
+
+  Matrix<var, Dynamic, Dynamic> beta = beta_d;
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  var lp = categorical_logit_lpmf(ns, beta);
+  EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+  lp.grad();
+  Matrix<double, Dynamic, Dynamic> beta_adj = beta.adj();
+  stan::math::set_zero_all_adjoints();
+
+  var lp_ref = 0;
+  for (int i = 0; i < 4; ++i)
+    lp_ref += categorical_logit_lpmf(
+        ns[i], Matrix<var, Dynamic, 1>(beta.row(i).transpose()));
+  lp_ref.grad();
+  EXPECT_FLOAT_EQ(lp_ref.val(), lp.val());
+  for (int i = 0; i < beta.size(); ++i)
+    EXPECT_NEAR(beta(i).adj(), beta_adj(i), 1e-12);
+  stan::math::recover_memory();
+}
+
+TEST(AgradDistributionsCategoricalLogit, matrix_propto) {
+  Matrix<double, Dynamic, Dynamic> beta_d(2, 3);
+  beta_d << 1, 1, 1, 1, 1, 1;
+  Matrix<var, Dynamic, Dynamic> beta = beta_d;
+  std::vector<int> ns = {1, 3};
+  EXPECT_FLOAT_EQ(0, stan::math::categorical_logit_lpmf<true>(ns, beta_d));
+  EXPECT_FLOAT_EQ(-2 * std::log(3.0),
+                  stan::math::categorical_logit_lpmf<true>(ns, beta).val());
+  stan::math::recover_memory();
+}
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/mat/prob/expect_eq_diffs.hpp>
 #include <string>
+#include <vector>
 
 template <typename T_prob, typename T_prior_sample_size>
 void expect_propto(T_prob theta, T_prior_sample_size alpha, T_prob theta2,
@@ -122,3 +123,42 @@ TEST_F(AgradDistributionsDirichlet, Bounds) {
                std::invalid_argument)
       << "size mismatch: theta is a 2-vector, alpha is a 4-vector";
 }
+
+TEST_F(AgradDistributionsDirichlet, vectorized_gradients) {
+  using stan::math::ChainableStack;
+  using stan::math::dirichlet_log;
+  typedef Matrix<double, Dynamic, 1> vector_d;
+  typedef Matrix<var, Dynamic, 1> vector_v;
+  std::vector<vector_d> thetas_d(3, vector_d(3));
+  thetas_d[0] << 0.2, 0.3, 0.5;
+  thetas_d[1] << 0.1, 0.6, 0.3;
+  thetas_d[2] << 0.7, 0.2, 0.1;
+  vector_d alpha_d(3);
+  alpha_d << 0.5, 4.0, 1.5;
+
+  std::vector<vector_v> thetas;
+  for (int t = 0; t < 3; ++t)
+    thetas.push_back(to_var(thetas_d[t]));
+  vector_v alpha = to_var(alpha_d);
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  var lp = dirichlet_log(thetas, alpha);
+  EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+  lp.grad();
+  std::vector<vector_d> thetas_adj;
+  for (int t = 0; t < 3; ++t)
+    thetas_adj.push_back(thetas[t].adj());
+  vector_d alpha_adj = alpha.adj();
+  stan::math::set_zero_all_adjoints();
+
+  var lp_ref = 0;
+  for (int t = 0; t < 3; ++t)
+    lp_ref += dirichlet_log(thetas[t], alpha);
+  lp_ref.grad();
+  EXPECT_FLOAT_EQ(lp_ref.val(), lp.val());
+  for (int t = 0; t < 3; ++t)
+    for (int i = 0; i < 3; ++i)
+      EXPECT_FLOAT_EQ(thetas[t](i).adj(), thetas_adj[t](i));
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(alpha(i).adj(), alpha_adj(i));
+  stan::math::recover_memory();
+}
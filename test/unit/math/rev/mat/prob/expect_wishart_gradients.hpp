@@ -0,0 +1,55 @@
+#ifndef TEST_UNIT_MATH_REV_MAT_PROB_EXPECT_WISHART_GRADIENTS_HPP
+#define TEST_UNIT_MATH_REV_MAT_PROB_EXPECT_WISHART_GRADIENTS_HPP
+
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+
+// Checks that the density, called as f(W, nu, S), puts a single node
+// on the autodiff stack and that its gradients match finite
+// differences, where the matrices are perturbed symmetrically.
+template <typename F>
+void expect_wishart_gradients(const F& f) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  using Eigen::MatrixXd;
+  using stan::math::ChainableStack;
+  using stan::math::to_var;
+  using stan::math::var;
+
+  MatrixXd W(3, 3);
+  W << 4.0, 1.2, -0.5, 1.2, 3.0, 0.7, -0.5, 0.7, 2.5;
+  double nu = 4.6;
+  MatrixXd S(3, 3);
+  S << 2.0, -0.3, 0.4, -0.3, 1.5, 0.2, 0.4, 0.2, 1.1;
+
+  Matrix<var, Dynamic, Dynamic> W_v = to_var(W);
+  var nu_v = nu;
+  Matrix<var, Dynamic, Dynamic> S_v = to_var(S);
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  var lp = f(W_v, nu_v, S_v);
+  EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+  EXPECT_FLOAT_EQ(f(W, nu, S), lp.val());
+  lp.grad();
+
+  const double h = 1e-6;
+  EXPECT_NEAR((f(W, nu + h, S) - f(W, nu - h, S)) / (2 * h), nu_v.adj(),
+              1e-6);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      MatrixXd E = MatrixXd::Zero(3, 3);
+      E(i, j) = h;
+      E(j, i) = h;
+      double W_grad = W_v(i, j).adj() + (i == j ? 0 : W_v(j, i).adj());
+      EXPECT_NEAR(
+          (f(MatrixXd(W + E), nu, S) - f(MatrixXd(W - E), nu, S)) / (2 * h),
+          W_grad, 1e-6);
+      double S_grad = S_v(i, j).adj() + (i == j ? 0 : S_v(j, i).adj());
+      EXPECT_NEAR(
+          (f(W, nu, MatrixXd(S + E)) - f(W, nu, MatrixXd(S - E))) / (2 * h),
+          S_grad, 1e-6);
+    }
+  }
+  stan::math::recover_memory();
+}
+
+#endif
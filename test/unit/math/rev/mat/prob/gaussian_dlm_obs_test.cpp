@@ -0,0 +1,169 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::math::var;
+
+namespace {
+
+typedef Matrix<double, Dynamic, Dynamic> matrix_d;
+typedef Matrix<double, Dynamic, 1> vector_d;
+typedef Matrix<var, Dynamic, Dynamic> matrix_v;
+typedef Matrix<var, Dynamic, 1> vector_v;
+
+struct dlm_fixture {
+  matrix_d F, G, V, W, C0, y;
+  vector_d V_diag, m0;
+
+  explicit dlm_fixture(int T) : F(2, 3), G(2, 2), V(3, 3), W(2, 2), C0(2, 2) {
+    F << 0.585528817843856, 0.709466017509524, -0.109303314681054,
+        -0.453497173462763, 0.605887455840394, -1.81795596770373;
+    G << 0.520216457554957, 0.816899839520583, -0.750531994502331,
+        -0.886357521243213;
+    V << 7.19105866377728, -0.311731853764732, 4.87333111936296,
+        -0.311731853764732, 3.27048576782842, 0.457616661474554,
+        4.87333111936296, 0.457616661474554, 5.86564522448303;
+    V_diag = V.diagonal();
+    W << 2.24277594357501, -1.65863136283477, -1.65863136283477,
+        6.69010664813895;
+    C0 << 8.21224673418328, 0.5, 0.5, 5.60195157304406;
+    m0.resize(2);
+    m0 << -0.892071328367409, 3.74785137677115;
+    y.resize(3, T);
+    for (int t = 0; t < T; ++t)
+      for (int i = 0; i < 3; ++i)
+        y(i, t) = std::sin(1.3 * t + 0.7 * i) * (i + 1);
+  }
+};
+
+// central finite difference of f along d(x)
+template <typename F, typename M>
+double finite_diff(const F& f, M& x, int i, int j, bool symmetric) {
+  const double h = 1e-6;
+  const double x_ij = x(i, j);
+  x(i, j) = x_ij + h;
+  if (symmetric)
+    x(j, i) = x(i, j);
+  double fp = f();
+  x(i, j) = x_ij - h;
+  if (symmetric)
+    x(j, i) = x(i, j);
+  double fm = f();
+  x(i, j) = x_ij;
+  if (symmetric)
+    x(j, i) = x_ij;
+  return (fp - fm) / (2 * h);
+}
+
+// compares the gradient of a matrix argument to finite differences,
+// perturbing symmetric matrices in both triangles at once
+template <typename F>
+void expect_matrix_grad(const F& f, matrix_d& x, const matrix_v& x_v,
+                        bool symmetric) {
+  for (int j = 0; j < x.cols(); ++j) {
+    for (int i = symmetric ? j : 0; i < x.rows(); ++i) {
+      double grad = x_v(i, j).adj();
+      if (symmetric && i != j)
+        grad += x_v(j, i).adj();
+      EXPECT_NEAR(finite_diff(f, x, i, j, symmetric), grad, 1e-5)
+          << "(" << i << ", " << j << ")";
+    }
+  }
+}
+
+template <typename F>
+void expect_vector_grad(const F& f, vector_d& x, const vector_v& x_v) {
+  for (int i = 0; i < x.size(); ++i)
+    EXPECT_NEAR(finite_diff(f, x, i, 0, false), x_v(i).adj(), 1e-5)
+        << "(" << i << ")";
+}
+
+}  // namespace
+
+TEST(ProbDistributionsGaussianDLM, gradients_matrix_V) {
+  dlm_fixture d(10);
+  auto f = [&]() {
+    return stan::math::gaussian_dlm_obs_lpdf(d.y, d.F, d.G, d.V, d.W, d.m0,
+                                             d.C0);
+  };
+
+  matrix_v y = d.y, F = d.F, G = d.G, V = d.V, W = d.W, C0 = d.C0;
+  vector_v m0 = d.m0;
+  var lp = stan::math::gaussian_dlm_obs_lpdf(y, F, G, V, W, m0, C0);
+  EXPECT_FLOAT_EQ(f(), lp.val());
+  lp.grad();
+
+  expect_matrix_grad(f, d.y, y, false);
+  expect_matrix_grad(f, d.F, F, false);
+  expect_matrix_grad(f, d.G, G, false);
+  expect_matrix_grad(f, d.V, V, true);
+  expect_matrix_grad(f, d.W, W, true);
+  expect_vector_grad(f, d.m0, m0);
+  expect_matrix_grad(f, d.C0, C0, true);
+  stan::math::recover_memory();
+}
+
+TEST(ProbDistributionsGaussianDLM, gradients_vector_V) {
+  dlm_fixture d(10);
+  auto f = [&]() {
+    return stan::math::gaussian_dlm_obs_lpdf(d.y, d.F, d.G, d.V_diag, d.W,
+                                             d.m0, d.C0);
+  };
+
+  matrix_v y = d.y, F = d.F, G = d.G, W = d.W, C0 = d.C0;
+  vector_v V = d.V_diag, m0 = d.m0;
+  var lp = stan::math::gaussian_dlm_obs_lpdf(y, F, G, V, W, m0, C0);
+  EXPECT_FLOAT_EQ(f(), lp.val());
+  lp.grad();
+
+  expect_matrix_grad(f, d.y, y, false);
+  expect_matrix_grad(f, d.F, F, false);
+  expect_matrix_grad(f, d.G, G, false);
+  expect_vector_grad(f, d.V_diag, V);
+  expect_matrix_grad(f, d.W, W, true);
+  expect_vector_grad(f, d.m0, m0);
+  expect_matrix_grad(f, d.C0, C0, true);
+  stan::math::recover_memory();
+}
+
+TEST(ProbDistributionsGaussianDLM, gradients_subset_of_arguments) {
+  dlm_fixture d(10);
+  auto f = [&]() {
+    return stan::math::gaussian_dlm_obs_lpdf(d.y, d.F, d.G, d.V, d.W, d.m0,
+                                             d.C0);
+  };
+
+  matrix_v G = d.G, W = d.W;
+  var lp = stan::math::gaussian_dlm_obs_lpdf(d.y, d.F, G, d.V, W, d.m0, d.C0);
+  EXPECT_FLOAT_EQ(f(), lp.val());
+  lp.grad();
+
+  expect_matrix_grad(f, d.G, G, false);
+  expect_matrix_grad(f, d.W, W, true);
+  stan::math::recover_memory();
+}
+
+TEST(ProbDistributionsGaussianDLM, tape_independent_of_length) {
+  using stan::math::ChainableStack;
+  dlm_fixture d_short(5);
+  dlm_fixture d_long(200);
+
+  matrix_v G = d_short.G;
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  stan::math::gaussian_dlm_obs_lpdf(d_short.y, d_short.F, G, d_short.V,
+                                    d_short.W, d_short.m0, d_short.C0);
+  size_t short_size = ChainableStack::instance_->var_stack_.size() - start;
+
+  start = ChainableStack::instance_->var_stack_.size();
+  stan::math::gaussian_dlm_obs_lpdf(d_long.y, d_long.F, G, d_long.V, d_long.W,
+                                    d_long.m0, d_long.C0);
+  size_t long_size = ChainableStack::instance_->var_stack_.size() - start;
+
+  // a single node for the density, whatever the number of observations
+  EXPECT_EQ(1U, short_size);
+  EXPECT_EQ(short_size, long_size);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,141 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <limits>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::math::var;
+
+namespace {
+
+typedef Matrix<double, Dynamic, Dynamic> matrix_d;
+typedef Matrix<double, Dynamic, 1> vector_d;
+typedef Matrix<var, Dynamic, Dynamic> matrix_v;
+typedef Matrix<var, Dynamic, 1> vector_v;
+
+// log marginal density by summing over every hidden state path
+template <typename T>
+T hmm_marginal_brute_force(const Matrix<T, Dynamic, Dynamic>& log_omegas,
+                           const Matrix<T, Dynamic, Dynamic>& Gamma,
+                           const Matrix<T, Dynamic, 1>& rho) {
+  const int K = log_omegas.rows();
+  const int N = log_omegas.cols();
+  std::vector<int> z(N, 0);
+  T marginal = 0;
+  while (true) {
+    T p = rho(z[0]) * exp(log_omegas(z[0], 0));
+    for (int n = 1; n < N; ++n)
+      p *= Gamma(z[n - 1], z[n]) * exp(log_omegas(z[n], n));
+    marginal += p;
+    int n = 0;
+    while (n < N && ++z[n] == K)
+      z[n++] = 0;
+    if (n == N)
+      break;
+  }
+  return log(marginal);
+}
+
+void expect_hmm_gradients(const matrix_d& log_omegas_d, const matrix_d& Gamma_d,
+                          const vector_d& rho_d) {
+  matrix_v log_omegas = log_omegas_d;
+  matrix_v Gamma = Gamma_d;
+  vector_v rho = rho_d;
+  var lp = stan::math::hmm_marginal(log_omegas, Gamma, rho);
+  lp.grad();
+  matrix_d log_omegas_adj = log_omegas.adj();
+  matrix_d Gamma_adj = Gamma.adj();
+  vector_d rho_adj = rho.adj();
+  stan::math::set_zero_all_adjoints();
+
+  var lp_ref = hmm_marginal_brute_force(log_omegas, Gamma, rho);
+  lp_ref.grad();
+  EXPECT_FLOAT_EQ(lp_ref.val(), lp.val());
+  for (int i = 0; i < log_omegas.size(); ++i)
+    EXPECT_NEAR(log_omegas(i).adj(), log_omegas_adj(i), 1e-10);
+  for (int i = 0; i < Gamma.size(); ++i)
+    EXPECT_NEAR(Gamma(i).adj(), Gamma_adj(i), 1e-10);
+  for (int i = 0; i < rho.size(); ++i)
+    EXPECT_NEAR(rho(i).adj(), rho_adj(i), 1e-10);
+  stan::math::recover_memory();
+}
+
+}  // namespace
+
+TEST(ProbDistributionsHmm, marginal_gradients) {
+  matrix_d log_omegas(3, 5);
+  log_omegas << -1.2, -0.3, -2.5, -0.7, -1.9, -0.4, -1.8, -0.2, -3.1, -0.6,
+      -2.2, -0.9, -1.1, -0.5, -1.4;
+  matrix_d Gamma(3, 3);
+  Gamma << 0.8, 0.15, 0.05, 0.1, 0.7, 0.2, 0.25, 0.25, 0.5;
+  vector_d rho(3);
+  rho << 0.5, 0.3, 0.2;
+  expect_hmm_gradients(log_omegas, Gamma, rho);
+}
+
+TEST(ProbDistributionsHmm, marginal_gradients_zero_probabilities) {
+  matrix_d log_omegas(2, 4);
+  log_omegas << -0.5, -2.0, -0.1, -1.5, -1.0, -0.2, -3.0, -0.4;
+  matrix_d Gamma(2, 2);
+  Gamma << 1.0, 0.0, 0.3, 0.7;
+  vector_d rho(2);
+  rho << 0.0, 1.0;
+  expect_hmm_gradients(log_omegas, Gamma, rho);
+}
+
+TEST(ProbDistributionsHmm, marginal_zero_probability_gradients) {
+  const double inf = std::numeric_limits<double>::infinity();
+  matrix_d log_omegas_d(2, 3);
+  log_omegas_d << -0.5, -inf, -0.1, -1.0, -inf, -3.0;
+  matrix_v log_omegas = log_omegas_d;
+  matrix_v Gamma = matrix_d::Constant(2, 2, 0.5);
+  vector_v rho = vector_d::Constant(2, 0.5);
+  var lp = stan::math::hmm_marginal(log_omegas, Gamma, rho);
+  EXPECT_EQ(-inf, lp.val());
+  lp.grad();
+  for (int i = 0; i < log_omegas.size(); ++i)
+    EXPECT_EQ(0, log_omegas(i).adj());
+  for (int i = 0; i < Gamma.size(); ++i)
+    EXPECT_EQ(0, Gamma(i).adj());
+  for (int i = 0; i < rho.size(); ++i)
+    EXPECT_EQ(0, rho(i).adj());
+  stan::math::recover_memory();
+}
+
+TEST(ProbDistributionsHmm, marginal_mixed_arguments) {
+  matrix_d log_omegas_d(2, 3);
+  log_omegas_d << -0.5, -2.0, -0.1, -1.0, -0.2, -3.0;
+  matrix_d Gamma_d(2, 2);
+  Gamma_d << 0.9, 0.1, 0.4, 0.6;
+  vector_d rho_d(2);
+  rho_d << 0.6, 0.4;
+
+  matrix_v Gamma = Gamma_d;
+  var lp = stan::math::hmm_marginal(log_omegas_d, Gamma, rho_d);
+  lp.grad();
+  matrix_d Gamma_adj = Gamma.adj();
+  stan::math::set_zero_all_adjoints();
+
+  matrix_v log_omegas = log_omegas_d;
+  vector_v rho = rho_d;
+  var lp_ref = hmm_marginal_brute_force(log_omegas, Gamma, rho);
+  lp_ref.grad();
+  EXPECT_FLOAT_EQ(lp_ref.val(), lp.val());
+  for (int i = 0; i < Gamma.size(); ++i)
+    EXPECT_NEAR(Gamma(i).adj(), Gamma_adj(i), 1e-10);
+  stan::math::recover_memory();
+}
+
+TEST(ProbDistributionsHmm, marginal_single_node) {
+  using stan::math::ChainableStack;
+  matrix_v log_omegas = matrix_d::Constant(4, 1000, -1.0);
+  matrix_v Gamma = matrix_d::Constant(4, 4, 0.25);
+  vector_v rho = vector_d::Constant(4, 0.25);
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  var lp = stan::math::hmm_marginal(log_omegas, Gamma, rho);
+  EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+  EXPECT_FLOAT_EQ(-1000, lp.val());
+  stan::math::recover_memory();
+}
@@ -1,6 +1,7 @@
 #include <stan/math/rev/mat.hpp>
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/mat/prob/expect_eq_diffs.hpp>
+#include <test/unit/math/rev/mat/prob/expect_wishart_gradients.hpp>
 #include <test/unit/math/rev/mat/util.hpp>
 #include <string>
 
@@ -107,3 +108,15 @@ TEST(InvWishart, check_varis_on_stack) {
   test::check_varis_on_stack(
       stan::math::inv_wishart_log<true>(W, nu, to_var(S)));
 }
+
+struct inv_wishart_lpdf_fun {
+  template <typename T_y, typename T_dof, typename T_scale>
+  typename stan::return_type<T_y, T_dof, T_scale>::type operator()(
+      const T_y& W, const T_dof& nu, const T_scale& S) const {
+    return stan::math::inv_wishart_lpdf(W, nu, S);
+  }
+};
+
+TEST(InvWishart, analytic_gradients) {
+  expect_wishart_gradients(inv_wishart_lpdf_fun());
+}
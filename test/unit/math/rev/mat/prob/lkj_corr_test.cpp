@@ -99,3 +99,34 @@ TEST(ProbDistributionsLkjCorrCholesky, gradients) {
   test_grad_eq(grad_1, grad_ad_1);
   EXPECT_FLOAT_EQ(fx, fx_ad);
 }
+
+TEST(ProbDistributionsLkjCorrCholesky, single_node_and_shape_gradient) {
+  using stan::math::ChainableStack;
+  using stan::math::var;
+  int K = 6;
+  Eigen::VectorXd y(15);
+  for (int i = 0; i < y.size(); ++i)
+    y(i) = 0.3 * i - 2.0;
+  Eigen::MatrixXd L_d = stan::math::cholesky_corr_constrain(y, K);
+
+  // the derivative in eta is continuous through eta == 1
+  for (double eta_d : {0.5, 1.0, 3.2}) {
+    Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> L = L_d;
+    var eta = eta_d;
+    size_t start = ChainableStack::instance_->var_stack_.size();
+    var lp = stan::math::lkj_corr_cholesky_lpdf(L, eta);
+    EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+    lp.grad();
+
+    const double h = 1e-6;
+    double fd = (stan::math::lkj_corr_cholesky_lpdf(L_d, eta_d + h)
+                 - stan::math::lkj_corr_cholesky_lpdf(L_d, eta_d - h))
+                / (2 * h);
+    EXPECT_NEAR(fd, eta.adj(), 1e-5) << "eta = " << eta_d;
+    for (int i = 0; i < K; ++i) {
+      const double power = K - i - 1 + 2.0 * (eta_d - 1.0);
+      EXPECT_FLOAT_EQ(i == 0 ? 0 : power / L_d(i, i), L(i, i).adj());
+    }
+    stan::math::recover_memory();
+  }
+}
@@ -417,3 +417,59 @@ TEST(MultiNormal, TestGradFunctionalVectorized) {
   test_all<-1, 1>();
   test_all<-1, -1>();
 }
+
+TEST(MultiNormal, sharedLDLTFactor) {
+  using stan::math::LDLT_factor;
+  using stan::math::multi_normal_lpdf;
+  Matrix<double, Dynamic, Dynamic> Sigma_d(3, 3);
+  Sigma_d << 9.0, -3.0, 0.0, -3.0, 4.0, 0.5, 0.0, 0.5, 5.0;
+  vector<Matrix<double, Dynamic, 1> > y1(4, Matrix<double, Dynamic, 1>(3));
+  for (int n = 0; n < 4; ++n)
+    y1[n] << n - 1.5, 2.0 * n, -n;
+  Matrix<double, Dynamic, 1> y2(3);
+  y2 << 0.3, -1.2, 2.0;
+  Matrix<double, Dynamic, 1> mu_d(3);
+  mu_d << 1.0, -1.0, 3.0;
+
+  Matrix<var, Dynamic, Dynamic> Sigma = Sigma_d;
+  Matrix<var, Dynamic, 1> mu = mu_d;
+  LDLT_factor<var, Dynamic, Dynamic> ldlt_Sigma(Sigma);
+  var lp = multi_normal_lpdf(y1, mu, ldlt_Sigma)
+           + multi_normal_lpdf<true>(y2, mu, ldlt_Sigma);
+  lp.grad();
+  Matrix<double, Dynamic, Dynamic> Sigma_adj = Sigma.adj();
+  Matrix<double, Dynamic, 1> mu_adj = mu.adj();
+  double lp_val = lp.val();
+  stan::math::recover_memory();
+
+  Matrix<var, Dynamic, Dynamic> Sigma_ref = Sigma_d;
+  Matrix<var, Dynamic, 1> mu_ref = mu_d;
+  var lp_ref = multi_normal_lpdf(y1, mu_ref, Sigma_ref)
+               + multi_normal_lpdf<true>(y2, mu_ref, Sigma_ref);
+  lp_ref.grad();
+  EXPECT_FLOAT_EQ(lp_ref.val(), lp_val);
+  for (int k = 0; k < 9; ++k)
+    EXPECT_FLOAT_EQ(Sigma_ref(k).adj(), Sigma_adj(k));
+  for (int k = 0; k < 3; ++k)
+    EXPECT_FLOAT_EQ(mu_ref(k).adj(), mu_adj(k));
+  stan::math::recover_memory();
+}
+
+TEST(MultiNormal, sharedLDLTFactorErrors) {
+  using stan::math::LDLT_factor;
+  using stan::math::multi_normal_lpdf;
+  Matrix<var, Dynamic, Dynamic> Sigma(2, 2);
+  Sigma << 1.0, 2.0, 2.0, 1.0;
+  Matrix<double, Dynamic, 1> y(2), mu(2);
+  y << 1.0, 0.5;
+  mu << 0.0, 0.0;
+  LDLT_factor<var, Dynamic, Dynamic> ldlt_Sigma(Sigma);
+  EXPECT_THROW(multi_normal_lpdf(y, mu, ldlt_Sigma), std::domain_error);
+
+  Sigma << 2.0, 1.0, 1.0, 2.0;
+  ldlt_Sigma.compute(Sigma);
+  Matrix<double, Dynamic, 1> y3(3);
+  y3 << 1.0, 0.5, 2.0;
+  EXPECT_THROW(multi_normal_lpdf(y3, y3, ldlt_Sigma), std::invalid_argument);
+  stan::math::recover_memory();
+}
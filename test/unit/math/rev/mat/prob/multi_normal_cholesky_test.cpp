@@ -59,3 +59,57 @@ TEST(AgradRev, check_varis_on_stack) {
   test::check_varis_on_stack(
       stan::math::multi_normal_cholesky_log<false>(y, mu, to_var(L)));
 }
+
+TEST(ProbDistributionsMultiNormalCholesky, many_observations_gradients) {
+  using stan::math::var;
+  using stan::math::vector_d;
+  using stan::math::vector_v;
+  const int K = 4;
+  const int N = 2500;
+  Matrix<double, Dynamic, Dynamic> Sigma(K, K);
+  Sigma << 4.0, 1.0, 0.5, 0.0, 1.0, 3.0, -0.5, 0.2, 0.5, -0.5, 2.0, 0.1, 0.0,
+      0.2, 0.1, 1.5;
+  Matrix<double, Dynamic, Dynamic> L_d = Sigma.llt().matrixL();
+  vector<vector_d> y_d(N), mu_d(N);
+  for (int n = 0; n < N; ++n) {
+    y_d[n] = vector_d::Random(K) * 3;
+    mu_d[n] = vector_d::Random(K);
+  }
+
+  vector<vector_v> y(N), mu(N);
+  for (int n = 0; n < N; ++n) {
+    y[n] = y_d[n];
+    mu[n] = mu_d[n];
+  }
+  Matrix<var, Dynamic, Dynamic> L = L_d;
+  var lp = stan::math::multi_normal_cholesky_lpdf(y, mu, L);
+  lp.grad();
+  Matrix<double, Dynamic, Dynamic> L_adj = L.adj();
+  double lp_val = lp.val();
+
+  double lp_ref = 0;
+  for (int n = 0; n < N; ++n) {
+    double lp_n = stan::math::multi_normal_lpdf(y_d[n], mu_d[n], Sigma);
+    lp_ref += lp_n;
+    vector_d diff = y_d[n] - mu_d[n];
+    vector_d grad_y = -stan::math::mdivide_left_spd(Sigma, diff);
+    for (int k = 0; k < K; ++k) {
+      EXPECT_FLOAT_EQ(grad_y(k), y[n](k).adj());
+      EXPECT_FLOAT_EQ(-grad_y(k), mu[n](k).adj());
+    }
+  }
+  EXPECT_FLOAT_EQ(lp_ref, lp_val);
+  stan::math::recover_memory();
+
+  Matrix<double, Dynamic, Dynamic> L_adj_ref
+      = Matrix<double, Dynamic, Dynamic>::Zero(K, K);
+  for (int n = 0; n < N; ++n) {
+    Matrix<var, Dynamic, Dynamic> L_n = L_d;
+    var lp_n = stan::math::multi_normal_cholesky_lpdf(y_d[n], mu_d[n], L_n);
+    lp_n.grad();
+    L_adj_ref += L_n.adj();
+    stan::math::recover_memory();
+  }
+  for (int k = 0; k < K * K; ++k)
+    EXPECT_NEAR(L_adj_ref(k), L_adj(k), 1e-8 * std::fabs(L_adj_ref(k)) + 1e-8);
+}
@@ -58,3 +58,46 @@ TEST(AgradRev, check_varis_on_stack) {
   test::check_varis_on_stack(
       stan::math::multi_normal_prec_log<false>(y, mu, to_var(L)));
 }
+
+TEST(ProbDistributionsMultiNormalPrec, SparsePrecisionGradients) {
+  using stan::math::var;
+  Matrix<double, Dynamic, Dynamic> Q(4, 4);
+  Q << 2.0, -0.5, 0.0, 0.3, -0.5, 1.0, 0.2, 0.0, 0.0, 0.2, 0.5, 0.0, 0.3, 0.0,
+      0.0, 1.5;
+
+  Matrix<var, Dynamic, 1> y(4);
+  y << 2.0, -2.0, 1.0, 0.5;
+  Matrix<var, Dynamic, 1> mu(4);
+  mu << 1.0, -1.0, 3.0, 0.0;
+  Eigen::SparseMatrix<var> Q_sparse = Q.sparseView().cast<var>();
+  var f = stan::math::multi_normal_prec_lpdf(y, mu, Q_sparse);
+  f.grad();
+  vector<double> adj;
+  for (int i = 0; i < 4; ++i) {
+    adj.push_back(y(i).adj());
+    adj.push_back(mu(i).adj());
+  }
+  for (int k = 0; k < Q_sparse.outerSize(); ++k)
+    for (Eigen::SparseMatrix<var>::InnerIterator it(Q_sparse, k); it; ++it)
+      adj.push_back(it.value().adj());
+  stan::math::set_zero_all_adjoints();
+
+  Matrix<var, Dynamic, 1> y_d(4);
+  y_d << 2.0, -2.0, 1.0, 0.5;
+  Matrix<var, Dynamic, 1> mu_d(4);
+  mu_d << 1.0, -1.0, 3.0, 0.0;
+  Matrix<var, Dynamic, Dynamic> Q_dense = Q;
+  var g = stan::math::multi_normal_prec_lpdf(y_d, mu_d, Q_dense);
+  g.grad();
+
+  EXPECT_FLOAT_EQ(g.val(), f.val());
+  size_t t = 0;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(y_d(i).adj(), adj[t++]);
+    EXPECT_FLOAT_EQ(mu_d(i).adj(), adj[t++]);
+  }
+  for (int k = 0; k < Q_sparse.outerSize(); ++k)
+    for (Eigen::SparseMatrix<var>::InnerIterator it(Q_sparse, k); it; ++it)
+      EXPECT_FLOAT_EQ(Q_dense(it.row(), it.col()).adj(), adj[t++]);
+  stan::math::recover_memory();
+}
@@ -567,3 +567,41 @@ TEST(MultiNormal, check_varis_on_stack) {
   test::check_varis_on_stack(
       multi_student_t_log<true>(y, nu, mu, to_var(Sigma)));
 }
+
+TEST(ProbDistributionsMultiStudentT, sharedLDLTFactor) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  using stan::math::LDLT_factor;
+  using stan::math::multi_student_t_lpdf;
+  using stan::math::var;
+  Matrix<double, Dynamic, Dynamic> Sigma_d(3, 3);
+  Sigma_d << 9.0, -3.0, 0.0, -3.0, 4.0, 0.5, 0.0, 0.5, 5.0;
+  std::vector<Matrix<double, Dynamic, 1> > y(3,
+                                             Matrix<double, Dynamic, 1>(3));
+  for (int n = 0; n < 3; ++n)
+    y[n] << n - 1.5, 2.0 * n, -n;
+  Matrix<double, Dynamic, 1> mu(3);
+  mu << 1.0, -1.0, 3.0;
+
+  Matrix<var, Dynamic, Dynamic> Sigma = Sigma_d;
+  var nu = 4.5;
+  LDLT_factor<var, Dynamic, Dynamic> ldlt_Sigma(Sigma);
+  var lp = multi_student_t_lpdf(y, nu, mu, ldlt_Sigma)
+           + multi_student_t_lpdf(y[0], nu, y[1], ldlt_Sigma);
+  lp.grad();
+  Matrix<double, Dynamic, Dynamic> Sigma_adj = Sigma.adj();
+  double nu_adj = nu.adj();
+  double lp_val = lp.val();
+  stan::math::recover_memory();
+
+  Matrix<var, Dynamic, Dynamic> Sigma_ref = Sigma_d;
+  var nu_ref = 4.5;
+  var lp_ref = multi_student_t_lpdf(y, nu_ref, mu, Sigma_ref)
+               + multi_student_t_lpdf(y[0], nu_ref, y[1], Sigma_ref);
+  lp_ref.grad();
+  EXPECT_FLOAT_EQ(lp_ref.val(), lp_val);
+  EXPECT_FLOAT_EQ(nu_ref.adj(), nu_adj);
+  for (int k = 0; k < 9; ++k)
+    EXPECT_FLOAT_EQ(Sigma_ref(k).adj(), Sigma_adj(k));
+  stan::math::recover_memory();
+}
@@ -42,3 +42,40 @@ TEST(AgradDistributionsMultinomial, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::multinomial_log<false>(ns, theta));
   test::check_varis_on_stack(stan::math::multinomial_log<true>(ns, theta));
 }
+
+TEST(AgradDistributionsMultinomial, vectorized_gradients) {
+  using stan::math::ChainableStack;
+  using stan::math::multinomial_lpmf;
+  typedef Matrix<double, Dynamic, 1> vector_d;
+  typedef Matrix<var, Dynamic, 1> vector_v;
+  std::vector<std::vector<int> > ns(3, std::vector<int>(3));
+  ns[0] = {1, 2, 3};
+  ns[1] = {0, 4, 1};
+  ns[2] = {2, 0, 0};
+  std::vector<vector_d> thetas_d(3, vector_d(3));
+  thetas_d[0] << 0.2, 0.3, 0.5;
+  thetas_d[1] << 0.1, 0.6, 0.3;
+  thetas_d[2] << 0.7, 0.2, 0.1;
+
+  std::vector<vector_v> thetas;
+  for (int t = 0; t < 3; ++t)
+    thetas.push_back(stan::math::to_var(thetas_d[t]));
+  size_t start = ChainableStack::instance_->var_stack_.size();
+  var lp = multinomial_lpmf(ns, thetas);
+  EXPECT_EQ(1U, ChainableStack::instance_->var_stack_.size() - start);
+  lp.grad();
+  std::vector<vector_d> thetas_adj;
+  for (int t = 0; t < 3; ++t)
+    thetas_adj.push_back(thetas[t].adj());
+  stan::math::set_zero_all_adjoints();
+
+  var lp_ref = 0;
+  for (int t = 0; t < 3; ++t)
+    lp_ref += multinomial_lpmf(ns[t], thetas[t]);
+  lp_ref.grad();
+  EXPECT_FLOAT_EQ(lp_ref.val(), lp.val());
+  for (int t = 0; t < 3; ++t)
+    for (int i = 0; i < 3; ++i)
+      EXPECT_FLOAT_EQ(thetas[t](i).adj(), thetas_adj[t](i));
+  stan::math::recover_memory();
+}
@@ -1,6 +1,7 @@
 #include <stan/math/rev/mat.hpp>
 #include <gtest/gtest.h>
 #include <test/unit/math/rev/mat/prob/expect_eq_diffs.hpp>
+#include <test/unit/math/rev/mat/prob/expect_wishart_gradients.hpp>
 #include <test/unit/math/rev/mat/util.hpp>
 #include <string>
 
@@ -101,3 +102,15 @@ TEST(Wishart, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::wishart_log<true>(W, to_var(nu), S));
   test::check_varis_on_stack(stan::math::wishart_log<true>(W, nu, to_var(S)));
 }
+
+struct wishart_lpdf_fun {
+  template <typename T_y, typename T_dof, typename T_scale>
+  typename stan::return_type<T_y, T_dof, T_scale>::type operator()(
+      const T_y& W, const T_dof& nu, const T_scale& S) const {
+    return stan::math::wishart_lpdf(W, nu, S);
+  }
+};
+
+TEST(Wishart, analytic_gradients) {
+  expect_wishart_gradients(wishart_lpdf_fun());
+}